@@ -23,7 +23,8 @@ ALL_LIBS:=libglslang.a \
 	libshaderc_util.a \
 	libSPIRV.a \
 	libSPIRV-Tools.a \
-	libSPIRV-Tools-opt.a
+	libSPIRV-Tools-opt.a \
+	libSPIRV-Tools-link.a
 
 SHADERC_HEADERS=shaderc.hpp shaderc.h env.h status.h visibility.h
 SHADERC_HEADERS_IN_OUT_DIR=$(foreach H,$(SHADERC_HEADERS),$(NDK_APP_LIBS_OUT)/../include/shaderc/$(H))
@@ -0,0 +1,643 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the cost of compiling shaders with the Shaderc C++ API, and the
+// size and decoding speed of packed SPIR-V.
+//
+// Usage: shaderc-compile-benchmark [--corpus=PATH...] [benchmark...]
+//
+// Runs the named benchmarks, or all of them if none is named, and prints one
+// line per measurement.  Times are wall-clock times per compilation.  Memory
+// is the peak resident set size of the process, which only some platforms
+// can reset, so memory benchmarks are best run on their own.
+//
+// The packed-spirv benchmark runs over the GLSL shaders embedded in the test
+// sources at the --corpus paths, which are files or directories.  By default
+// these are the glslc and libshaderc tests of the source tree.
+//
+// A change is measured by running the same benchmark with builds of the tree
+// before and after it, on an otherwise idle machine.
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include <shaderc/shaderc.hpp>
+
+#include "libshaderc_util/compile_context.h"
+#include "libshaderc_util/packed_spirv.h"
+#include "libshaderc_util/spirv_tools_wrapper.h"
+
+namespace {
+
+// The number of compilations timed by each measurement.
+const int kIterations = 200;
+
+// A tiny compute shader, typical of the many small kernels of a renderer.
+const char kSmallComputeShader[] =
+    "#version 450\n"
+    "layout(local_size_x = 64) in;\n"
+    "layout(std430, binding = 0) buffer Data { float values[]; };\n"
+    "layout(push_constant) uniform Params { float scale; };\n"
+    "void main() {\n"
+    "  uint i = gl_GlobalInvocationID.x;\n"
+    "  values[i] = values[i] * scale + 1.0;\n"
+    "}\n";
+
+// Returns the source of a small compute shader that differs for each i, so
+// that no compilation can be answered by a cache of sources.  The variants
+// differ only in a comment, so they all generate the same SPIR-V.
+std::string SmallComputeShader(int i) {
+  return std::string(kSmallComputeShader) + "// variant " + std::to_string(i) +
+         "\n";
+}
+
+// Times kIterations calls of compile, which is given the iteration number and
+// returns false on failure.  Prints the median and mean time per call, and
+// returns the median in *median_us if it is not null.
+bool Measure(const std::string& name, const std::function<bool(int)>& compile,
+             double* median_us = nullptr) {
+  std::vector<double> microseconds;
+  microseconds.reserve(kIterations);
+  for (int i = 0; i < kIterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    if (!compile(i)) {
+      std::cerr << name << ": compilation failed" << std::endl;
+      return false;
+    }
+    const std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+    microseconds.push_back(elapsed.count());
+  }
+  double total = 0;
+  for (double us : microseconds) total += us;
+  std::sort(microseconds.begin(), microseconds.end());
+  std::cout << std::left << std::setw(40) << name << std::right << std::fixed
+            << std::setprecision(1) << " median " << std::setw(9)
+            << microseconds[microseconds.size() / 2] << " us   mean "
+            << std::setw(9) << total / microseconds.size() << " us"
+            << std::endl;
+  if (median_us) *median_us = microseconds[microseconds.size() / 2];
+  return true;
+}
+
+// Compiles a small compute shader with the given compiler and options.
+bool CompileSmallShader(const shaderc::Compiler& compiler,
+                        const shaderc::CompileOptions& options, int i) {
+  const std::string source = SmallComputeShader(i);
+  const auto result = compiler.CompileGlslToSpv(
+      source, shaderc_glsl_compute_shader, "small.comp", options);
+  return result.GetCompilationStatus() == shaderc_compilation_status_success;
+}
+
+// Compares the latency of small compilations by a new compiler each time,
+// which sets up its scratch state for every compilation, with that of one
+// compiler reused for all of them, which keeps its scratch state.
+bool SmallShaderLatency() {
+  for (auto level : {shaderc_optimization_level_zero,
+                     shaderc_optimization_level_performance}) {
+    shaderc::CompileOptions options;
+    options.SetOptimizationLevel(level);
+    const std::string suffix =
+        level == shaderc_optimization_level_zero ? " -O0" : " -O";
+    shaderc::Compiler reused_compiler;
+    // Warm up glslang's built-in symbol tables outside of the measurements.
+    if (!CompileSmallShader(reused_compiler, options, -1)) return false;
+    if (!Measure("small shader, new compiler" + suffix, [&](int i) {
+          shaderc::Compiler compiler;
+          return CompileSmallShader(compiler, options, i);
+        })) {
+      return false;
+    }
+    if (!Measure("small shader, reused compiler" + suffix, [&](int i) {
+          return CompileSmallShader(reused_compiler, options, i);
+        })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compares the latency of optimized small compilations whose variants differ
+// only in comments, so that they generate the same SPIR-V, with and without a
+// shared optimizer cache.
+bool OptimizerCacheLatency() {
+  shaderc::Compiler compiler;
+  shaderc::CompileOptions options;
+  options.SetOptimizationLevel(shaderc_optimization_level_performance);
+  // Warm up glslang's built-in symbol tables outside of the measurements.
+  if (!CompileSmallShader(compiler, options, -1)) return false;
+  if (!Measure("small shader variants -O", [&](int i) {
+        return CompileSmallShader(compiler, options, i);
+      })) {
+    return false;
+  }
+  shaderc::OptimizerCache cache(16 << 20);
+  options.SetOptimizerCache(&cache);
+  if (!Measure("small shader variants -O, cached", [&](int i) {
+        return CompileSmallShader(compiler, options, i);
+      })) {
+    return false;
+  }
+  std::cout << "optimizer cache: " << cache.GetNumHits() << " hits, "
+            << cache.GetNumMisses() << " misses" << std::endl;
+  return true;
+}
+
+// Compares the latency of assembling a small module, and of compiling a small
+// shader to assembly, by a new compiler each time, which sets up the
+// SPIRV-Tools context and its grammar tables for every call, with that of one
+// compiler reused for all of them, which keeps its SPIRV-Tools contexts.
+// Then times the assembler and disassembler alone, with and without a
+// compile context.
+bool AssemblyRoundTripLatency() {
+  shaderc::Compiler reused_compiler;
+  const shaderc::CompileOptions options;
+  const auto disassembly = reused_compiler.CompileGlslToSpvAssembly(
+      kSmallComputeShader, shaderc_glsl_compute_shader, "small.comp", options);
+  if (disassembly.GetCompilationStatus() !=
+      shaderc_compilation_status_success) {
+    std::cerr << "small shader: compilation failed" << std::endl;
+    return false;
+  }
+  const std::string assembly(disassembly.cbegin(), disassembly.cend());
+  const auto assemble = [&](const shaderc::Compiler& compiler) {
+    return compiler.AssembleToSpv(assembly, options).GetCompilationStatus() ==
+           shaderc_compilation_status_success;
+  };
+  const auto compile_to_assembly = [&](const shaderc::Compiler& compiler,
+                                       int i) {
+    const std::string source = SmallComputeShader(i);
+    return compiler
+               .CompileGlslToSpvAssembly(source, shaderc_glsl_compute_shader,
+                                         "small.comp", options)
+               .GetCompilationStatus() == shaderc_compilation_status_success;
+  };
+  if (!assemble(reused_compiler)) return false;
+  if (!Measure("assemble, new compiler", [&](int) {
+        shaderc::Compiler compiler;
+        return assemble(compiler);
+      })) {
+    return false;
+  }
+  if (!Measure("assemble, reused compiler",
+               [&](int) { return assemble(reused_compiler); })) {
+    return false;
+  }
+  if (!Measure("small shader -S, new compiler", [&](int i) {
+        shaderc::Compiler compiler;
+        return compile_to_assembly(compiler, i);
+      })) {
+    return false;
+  }
+  if (!Measure("small shader -S, reused compiler", [&](int i) {
+        return compile_to_assembly(reused_compiler, i);
+      })) {
+    return false;
+  }
+
+  // Times the SPIRV-Tools calls alone.  Without a compile context each call
+  // sets up and tears down its own SPIRV-Tools context, as every call did
+  // before the contexts were pooled.
+  const auto binary = reused_compiler.CompileGlslToSpv(
+      kSmallComputeShader, shaderc_glsl_compute_shader, "small.comp", options);
+  const std::vector<uint32_t> words(binary.cbegin(), binary.cend());
+  const auto env = shaderc_util::Compiler::TargetEnv::Vulkan;
+  const auto version = shaderc_util::Compiler::TargetEnvVersion::Vulkan_1_0;
+  shaderc_util::CompileContext context;
+  shaderc_util::CompileContext* const contexts[] = {nullptr, &context};
+  for (shaderc_util::CompileContext* c : contexts) {
+    const std::string suffix = c ? ", compile context" : ", no context";
+    if (!Measure("SpirvToolsAssemble" + suffix, [&](int) {
+          spv_binary assembled = nullptr;
+          std::string errors;
+          const bool success = shaderc_util::SpirvToolsAssemble(
+              env, version, assembly, &assembled, &errors, c);
+          spvBinaryDestroy(assembled);
+          return success;
+        })) {
+      return false;
+    }
+    if (!Measure("SpirvToolsDisassemble" + suffix, [&](int) {
+          std::string text;
+          return shaderc_util::SpirvToolsDisassemble(env, version, words,
+                                                     &text, c);
+        })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns a fragment shader with num_functions functions, all called from
+// main, for a module large enough that its AST and its optimizer IR dominate
+// the memory of the process.
+std::string LargeFragmentShader(int num_functions) {
+  std::string source =
+      "#version 450\n"
+      "layout(location = 0) in vec4 v_in;\n"
+      "layout(location = 0) out vec4 color;\n";
+  for (int i = 0; i < num_functions; ++i) {
+    const std::string n = std::to_string(i);
+    source += "vec4 f" + n + "(vec4 x) {\n" + "  vec4 y = x * float(" + n +
+              ") + vec4(" + std::to_string(i % 7) + ".0);\n" +
+              "  for (int j = 0; j < 4; ++j) y = sin(y) * cos(x + float(j));\n"
+              "  return y;\n"
+              "}\n";
+  }
+  source += "void main() {\n  vec4 acc = v_in;\n";
+  for (int i = 0; i < num_functions; ++i) {
+    source += "  acc += f" + std::to_string(i) + "(acc);\n";
+  }
+  source += "  color = acc;\n}\n";
+  return source;
+}
+
+// Resets the peak resident set size of the process to its current resident
+// set size.  Returns false if the platform cannot do that.
+bool ResetPeakMemory() {
+#if defined(__linux__)
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+  clear_refs.close();
+  return !clear_refs.fail();
+#else
+  return false;
+#endif
+}
+
+// Returns the peak resident set size of the process in KiB, or 0 if it is not
+// known.  On Linux this is the VmHWM of /proc/self/status, which is what
+// ResetPeakMemory() resets; the ru_maxrss of getrusage() is not reset.
+long PeakMemoryKiB() {
+#if defined(__linux__)
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return std::strtol(line.c_str() + 6, nullptr, 10);  // In KiB.
+    }
+  }
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024;  // In bytes.
+#else
+  return usage.ru_maxrss;  // In KiB.
+#endif
+#else
+  return 0;
+#endif
+}
+
+// Measures the peak memory of compiling a large shader to SPIR-V binary with
+// and without optimization, and to SPIR-V assembly, each as the increase over
+// the peak before the compilation.
+bool LargeShaderPeakMemory() {
+  if (PeakMemoryKiB() == 0) {
+    std::cout << "peak memory is not known on this platform" << std::endl;
+    return true;
+  }
+  const std::string source = LargeFragmentShader(1000);
+  shaderc::Compiler compiler;
+  // Build glslang's built-in symbol tables outside of the measurements.
+  if (!CompileSmallShader(compiler, shaderc::CompileOptions(), -1)) {
+    return false;
+  }
+  struct Case {
+    const char* name;
+    shaderc_optimization_level level;
+    bool assembly;
+  };
+  for (const Case& c :
+       {Case{"large shader -O0", shaderc_optimization_level_zero, false},
+        Case{"large shader -O", shaderc_optimization_level_performance,
+             false},
+        Case{"large shader -O -S", shaderc_optimization_level_performance,
+             true}}) {
+    shaderc::CompileOptions options;
+    options.SetOptimizationLevel(c.level);
+    const bool reset = ResetPeakMemory();
+    const long before = PeakMemoryKiB();
+    bool success;
+    if (c.assembly) {
+      success = compiler
+                    .CompileGlslToSpvAssembly(source,
+                                              shaderc_glsl_fragment_shader,
+                                              "large.frag", options)
+                    .GetCompilationStatus() ==
+                shaderc_compilation_status_success;
+    } else {
+      success = compiler
+                    .CompileGlslToSpv(source, shaderc_glsl_fragment_shader,
+                                      "large.frag", options)
+                    .GetCompilationStatus() ==
+                shaderc_compilation_status_success;
+    }
+    if (!success) {
+      std::cerr << c.name << ": compilation failed" << std::endl;
+      return false;
+    }
+    const long after = PeakMemoryKiB();
+    std::cout << std::left << std::setw(40) << c.name << std::right
+              << " peak " << std::setw(9) << after << " KiB   increase "
+              << std::setw(9) << after - before << " KiB"
+              << (reset ? "" : " (peak not reset)") << std::endl;
+  }
+  return true;
+}
+
+// The files and directories whose test sources make up the shader corpus of
+// the packed-spirv benchmark.
+std::vector<std::string> corpus_paths = {
+#ifdef SHADERC_SOURCE_DIR
+    SHADERC_SOURCE_DIR "/glslc/test",
+    SHADERC_SOURCE_DIR "/libshaderc/src",
+    SHADERC_SOURCE_DIR "/libshaderc_util/src",
+#endif
+};
+
+// Returns the contents of the string literal starting at source[*pos], which
+// is a quote, and moves *pos past it.  Backslash escapes are decoded.
+std::string ReadQuotedLiteral(const std::string& source, size_t* pos) {
+  const char quote = source[(*pos)++];
+  std::string text;
+  while (*pos < source.size() && source[*pos] != quote &&
+         source[*pos] != '\n') {
+    char c = source[(*pos)++];
+    if (c == '\\' && *pos < source.size()) {
+      c = source[(*pos)++];
+      if (c == 'n') c = '\n';
+      if (c == 't') c = '\t';
+    }
+    text += c;
+  }
+  ++*pos;
+  return text;
+}
+
+// Returns the string literals of source, a C++ or Python test, in order.
+// Adjacent C++ literals are joined, as the C++ compiler joins them.
+std::vector<std::string> StringLiterals(const std::string& source,
+                                        bool python) {
+  std::vector<std::string> literals;
+  bool joining = false;
+  size_t pos = 0;
+  while (pos < source.size()) {
+    const char c = source[pos];
+    const std::string rest3 = source.substr(pos, 3);
+    if (python && (rest3 == "\"\"\"" || rest3 == "'''")) {
+      const size_t end = source.find(rest3, pos + 3);
+      if (end == std::string::npos) break;
+      literals.push_back(source.substr(pos + 3, end - pos - 3));
+      pos = end + 3;
+    } else if (c == '"' || (python && c == '\'')) {
+      std::string text = ReadQuotedLiteral(source, &pos);
+      if (joining) {
+        literals.back() += text;
+      } else {
+        literals.push_back(text);
+      }
+      joining = !python;
+      continue;
+    } else if (!python && source.compare(pos, 2, "R\"") == 0) {
+      const size_t paren = source.find('(', pos);
+      if (paren == std::string::npos) break;
+      const std::string close =
+          ")" + source.substr(pos + 2, paren - pos - 2) + "\"";
+      const size_t end = source.find(close, paren);
+      if (end == std::string::npos) break;
+      std::string text = source.substr(paren + 1, end - paren - 1);
+      if (joining) {
+        literals.back() += text;
+      } else {
+        literals.push_back(text);
+      }
+      joining = true;
+      pos = end + close.size();
+      continue;
+    } else if (!python && c == '\'') {
+      // A character literal, which may be a quote.
+      pos += source.compare(pos, 2, "'\\") == 0 ? 4 : 3;
+    } else if ((python && c == '#') ||
+               (!python && source.compare(pos, 2, "//") == 0)) {
+      pos = source.find('\n', pos);
+      if (pos == std::string::npos) break;
+    } else if (!python && source.compare(pos, 2, "/*") == 0) {
+      pos = source.find("*/", pos);
+      if (pos == std::string::npos) break;
+      pos += 2;
+    } else {
+      ++pos;
+    }
+    if (!std::isspace(static_cast<unsigned char>(c))) joining = false;
+  }
+  return literals;
+}
+
+// Returns the GLSL shaders embedded in the test sources under the corpus
+// paths: every distinct string literal that starts with a #version directive.
+std::vector<std::string> CorpusShaders() {
+  std::vector<std::filesystem::path> files;
+  for (const std::string& path : corpus_paths) {
+    std::error_code error;
+    if (std::filesystem::is_directory(path, error)) {
+      for (const auto& entry :
+           std::filesystem::directory_iterator(path, error)) {
+        files.push_back(entry.path());
+      }
+    } else {
+      files.push_back(path);
+    }
+  }
+  std::sort(files.begin(), files.end());
+  std::set<std::string> seen;
+  std::vector<std::string> shaders;
+  for (const auto& file : files) {
+    const std::string extension = file.extension().string();
+    const bool python = extension == ".py";
+    if (!python && extension != ".cc" && extension != ".h") continue;
+    std::ifstream stream(file);
+    const std::string source((std::istreambuf_iterator<char>(stream)),
+                             std::istreambuf_iterator<char>());
+    for (const std::string& literal : StringLiterals(source, python)) {
+      const size_t first = literal.find_first_not_of(" \t\n");
+      if (first == std::string::npos ||
+          literal.compare(first, 8, "#version") != 0) {
+        continue;
+      }
+      if (seen.insert(literal).second) shaders.push_back(literal);
+    }
+  }
+  return shaders;
+}
+
+// Packs the SPIR-V of the shaders of the test sources of the tree, compiled
+// with and without optimization, and reports the size of the packed modules
+// relative to the binaries, and the throughput of unpacking them.  Each shader
+// is compiled for the stage named by its #pragma shader_stage, or else for the
+// first stage it compiles for; shaders that compile for none, such as those of
+// tests of errors, are skipped.  Unpacking must give
+// back each binary exactly.
+bool PackedSpirvSizeAndSpeed() {
+  const std::vector<std::string> sources = CorpusShaders();
+  if (sources.empty()) {
+    std::cerr << "packed-spirv: no shaders found; name the test sources with "
+                 "--corpus=PATH"
+              << std::endl;
+    return false;
+  }
+  const shaderc_shader_kind kinds[] = {
+      shaderc_glsl_infer_from_source,   shaderc_glsl_vertex_shader,
+      shaderc_glsl_fragment_shader,     shaderc_glsl_compute_shader,
+      shaderc_glsl_geometry_shader,     shaderc_glsl_tess_control_shader,
+      shaderc_glsl_tess_evaluation_shader};
+  shaderc::Compiler compiler;
+  for (auto level : {shaderc_optimization_level_zero,
+                     shaderc_optimization_level_performance}) {
+    shaderc::CompileOptions options;
+    options.SetOptimizationLevel(level);
+    const std::string suffix =
+        level == shaderc_optimization_level_zero ? " -O0" : " -O";
+    std::vector<std::vector<uint32_t>> binaries;
+    std::vector<std::string> packed_modules;
+    size_t binary_bytes = 0;
+    size_t packed_bytes = 0;
+    for (const std::string& source : sources) {
+      for (shaderc_shader_kind kind : kinds) {
+        const auto result =
+            compiler.CompileGlslToSpv(source, kind, "corpus.glsl", options);
+        if (result.GetCompilationStatus() !=
+            shaderc_compilation_status_success) {
+          continue;
+        }
+        binaries.emplace_back(result.cbegin(), result.cend());
+        packed_modules.emplace_back();
+        std::string error;
+        if (!shaderc_util::PackSpirv(binaries.back().data(),
+                                     binaries.back().size(),
+                                     &packed_modules.back(), &error)) {
+          std::cerr << "packing failed: " << error << std::endl;
+          return false;
+        }
+        binary_bytes += binaries.back().size() * sizeof(uint32_t);
+        packed_bytes += packed_modules.back().size();
+        break;
+      }
+    }
+    if (binaries.empty()) {
+      std::cerr << "packed-spirv: no shader of the corpus compiles"
+                << std::endl;
+      return false;
+    }
+    std::cout << "corpus" << suffix << ": " << binaries.size() << " of "
+              << sources.size() << " shaders compiled, packed "
+              << packed_bytes << " of " << binary_bytes << " bytes ("
+              << std::fixed << std::setprecision(1)
+              << 100.0 * packed_bytes / binary_bytes << " %)" << std::endl;
+
+    std::vector<uint32_t> words;
+    std::string error;
+    double median_us = 0;
+    if (!Measure("unpack corpus" + suffix,
+                 [&](int) {
+                   for (const std::string& packed : packed_modules) {
+                     if (!shaderc_util::UnpackSpirv(packed, &words, &error)) {
+                       return false;
+                     }
+                   }
+                   return true;
+                 },
+                 &median_us)) {
+      std::cerr << error << std::endl;
+      return false;
+    }
+    std::cout << "unpack throughput" << suffix << ": " << std::fixed
+              << std::setprecision(1) << binary_bytes / median_us
+              << " MB/s of SPIR-V" << std::endl;
+    for (size_t i = 0; i < binaries.size(); ++i) {
+      if (!shaderc_util::UnpackSpirv(packed_modules[i], &words, &error) ||
+          words != binaries[i]) {
+        std::cerr << "unpacking changed a module" << suffix << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+struct Benchmark {
+  const char* name;
+  bool (*run)();
+};
+
+const Benchmark kBenchmarks[] = {
+    {"small-shader-latency", SmallShaderLatency},
+    {"large-shader-peak-memory", LargeShaderPeakMemory},
+    {"optimizer-cache", OptimizerCacheLatency},
+    {"assembly-round-trip", AssemblyRoundTripLatency},
+    {"packed-spirv", PackedSpirvSizeAndSpeed},
+};
+
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+  std::vector<const char*> names;
+  bool corpus_given = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--corpus=", 9) == 0) {
+      if (!corpus_given) corpus_paths.clear();
+      corpus_given = true;
+      corpus_paths.push_back(argv[i] + 9);
+      continue;
+    }
+    names.push_back(argv[i]);
+    if (std::none_of(std::begin(kBenchmarks), std::end(kBenchmarks),
+                     [&](const Benchmark& benchmark) {
+                       return std::strcmp(argv[i], benchmark.name) == 0;
+                     })) {
+      std::cerr << "unknown benchmark: " << argv[i] << std::endl;
+      return 1;
+    }
+  }
+
+  bool success = true;
+  for (const auto& benchmark : kBenchmarks) {
+    bool selected = names.empty();
+    for (const char* name : names) {
+      selected |= std::strcmp(name, benchmark.name) == 0;
+    }
+    if (!selected) continue;
+    std::cout << "== " << benchmark.name << std::endl;
+    success &= benchmark.run();
+  }
+  return success ? 0 : 1;
+}
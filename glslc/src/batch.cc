@@ -0,0 +1,233 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "batch.h"
+
+#include <sstream>
+
+#include "file.h"
+#include "libshaderc_util/io_shaderc.h"
+#include "libshaderc_util/json.h"
+#include "libshaderc_util/string_piece.h"
+#include "shader_stage.h"
+
+namespace {
+
+using shaderc_util::JsonValue;
+using shaderc_util::string_piece;
+
+// The settings of a job, or of the manifest defaults.
+struct JobSettings {
+  glslc::BatchJob job;
+  bool has_stage = false;
+  bool has_language = false;
+};
+
+// Reads the manifest and reports errors prefixed with its name.
+class ManifestReader {
+ public:
+  ManifestReader(const std::string& manifest_file_name, std::ostream* errs)
+      : manifest_file_name_(manifest_file_name), errs_(errs) {}
+
+  // Applies the members of the given JSON object to *settings.  The input,
+  // output and depfile members are only allowed if is_job is true.
+  bool ApplySettings(const JsonValue& object, const std::string& context,
+                     bool is_job, JobSettings* settings) {
+    if (!object.is_object()) {
+      return Error(context, "expected an object");
+    }
+    glslc::BatchJob& job = settings->job;
+    for (const auto& member : object.members()) {
+      const std::string& key = member.first;
+      const JsonValue& value = member.second;
+      const std::string key_context = context + "." + key;
+      if (is_job && (key == "input" || key == "output" || key == "depfile")) {
+        if (!value.is_string() || value.string_value().empty()) {
+          return Error(key_context, "expected a non-empty string");
+        }
+        if (key == "input") {
+          job.input_file.name = value.string_value();
+        } else if (key == "output") {
+          job.output_file_name = value.string_value();
+        } else {
+          job.dependency_file_name = value.string_value();
+        }
+      } else if (key == "stage") {
+        if (!value.is_string()) return Error(key_context, "expected a string");
+        const shaderc_shader_kind stage =
+            glslc::MapStageNameToForcedKind(value.string_value());
+        if (stage == shaderc_glsl_infer_from_source) {
+          return Error(key_context,
+                       "stage not recognized: '" + value.string_value() + "'");
+        }
+        job.input_file.stage = stage;
+        settings->has_stage = true;
+      } else if (key == "language") {
+        if (value.is_string() && value.string_value() == "glsl") {
+          job.input_file.language = shaderc_source_language_glsl;
+        } else if (value.is_string() && value.string_value() == "hlsl") {
+          job.input_file.language = shaderc_source_language_hlsl;
+        } else {
+          return Error(key_context, "expected \"glsl\" or \"hlsl\"");
+        }
+        settings->has_language = true;
+      } else if (key == "entry_point") {
+        if (!value.is_string()) return Error(key_context, "expected a string");
+        job.input_file.entry_point_name = value.string_value();
+        job.input_file.entry_points.clear();
+      } else if (key == "defines") {
+        if (!ForEachString(value, key_context, [&job](const std::string& str) {
+              const size_t equal_sign = str.find('=');
+              job.macro_definitions.emplace_back(
+                  str.substr(0, equal_sign),
+                  equal_sign == std::string::npos ? ""
+                                                  : str.substr(equal_sign + 1));
+            })) {
+          return false;
+        }
+        for (const auto& macro : job.macro_definitions) {
+          if (macro.first.empty()) {
+            return Error(key_context, "empty macro name");
+          }
+          if (string_piece(macro.first).starts_with("GL_")) {
+            return Error(key_context,
+                         "names beginning with 'GL_' cannot be defined: " +
+                             macro.first);
+          }
+        }
+      } else if (key == "include_dirs") {
+        if (!ForEachString(value, key_context, [&job](const std::string& str) {
+              job.include_directories.push_back(str);
+            })) {
+          return false;
+        }
+      } else {
+        return Error(context, "unknown setting '" + key + "'");
+      }
+    }
+    return true;
+  }
+
+  // Writes an error message about the given part of the manifest.  Always
+  // returns false.
+  bool Error(const std::string& context, const std::string& message) {
+    *errs_ << "glslc: error: " << manifest_file_name_ << ": " << context << ": "
+           << message << std::endl;
+    return false;
+  }
+
+ private:
+  // Calls f with each element of the given array of strings.  Returns false
+  // after reporting an error if value is not such an array.
+  template <typename F>
+  bool ForEachString(const JsonValue& value, const std::string& context,
+                     F f) {
+    if (!value.is_array()) return Error(context, "expected an array");
+    for (const auto& element : value.elements()) {
+      if (!element.is_string()) {
+        return Error(context, "expected an array of strings");
+      }
+      f(element.string_value());
+    }
+    return true;
+  }
+
+  const std::string& manifest_file_name_;
+  std::ostream* errs_;
+};
+
+}  // anonymous namespace
+
+namespace glslc {
+
+bool ReadBatchManifest(const std::string& manifest_file_name,
+                       const InputFileSpec& defaults, bool language_forced,
+                       std::vector<BatchJob>* jobs, std::ostream* errs) {
+  std::vector<char> manifest_data;
+  if (!shaderc_util::ReadFile(manifest_file_name, &manifest_data)) {
+    return false;
+  }
+  return ParseBatchManifest(
+      string_piece(manifest_data.data(),
+                   manifest_data.data() + manifest_data.size()),
+      manifest_file_name, defaults, language_forced, jobs, errs);
+}
+
+bool ParseBatchManifest(const string_piece& manifest_text,
+                        const std::string& manifest_file_name,
+                        const InputFileSpec& defaults, bool language_forced,
+                        std::vector<BatchJob>* jobs, std::ostream* errs) {
+  JsonValue manifest;
+  std::string error_message;
+  if (!shaderc_util::ParseJson(manifest_text, &manifest, &error_message)) {
+    *errs << "glslc: error: " << manifest_file_name << ":" << error_message
+          << std::endl;
+    return false;
+  }
+
+  ManifestReader reader(manifest_file_name, errs);
+  if (!manifest.is_object()) {
+    return reader.Error("manifest", "expected an object");
+  }
+
+  JobSettings batch_settings;
+  batch_settings.job.input_file = defaults;
+  batch_settings.has_stage =
+      defaults.stage != shaderc_glsl_infer_from_source;
+  batch_settings.has_language = language_forced;
+  const JsonValue* job_list = nullptr;
+  for (const auto& member : manifest.members()) {
+    if (member.first == "defaults") {
+      if (!reader.ApplySettings(member.second, "defaults", false,
+                                &batch_settings)) {
+        return false;
+      }
+    } else if (member.first == "jobs") {
+      job_list = &member.second;
+    } else {
+      return reader.Error("manifest",
+                          "unknown member '" + member.first + "'");
+    }
+  }
+  if (!job_list || !job_list->is_array()) {
+    return reader.Error("jobs", "expected an array of jobs");
+  }
+
+  for (size_t i = 0; i < job_list->elements().size(); ++i) {
+    std::ostringstream context;
+    context << "jobs[" << i << "]";
+    JobSettings settings = batch_settings;
+    if (!reader.ApplySettings(job_list->elements()[i], context.str(), true,
+                              &settings)) {
+      return false;
+    }
+    BatchJob& job = settings.job;
+    if (job.input_file.name.empty()) {
+      return reader.Error(context.str(), "missing \"input\"");
+    }
+    if (!settings.has_stage) {
+      job.input_file.stage =
+          DeduceDefaultShaderKindFromFileName(job.input_file.name);
+    }
+    if (!settings.has_language) {
+      job.input_file.language =
+          GetFileExtension(job.input_file.name) == "hlsl"
+              ? shaderc_source_language_hlsl
+              : shaderc_source_language_glsl;
+    }
+    jobs->push_back(std::move(job));
+  }
+  return true;
+}
+
+}  // namespace glslc
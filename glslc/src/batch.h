@@ -0,0 +1,57 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GLSLC_BATCH_H_
+#define GLSLC_BATCH_H_
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "file_compiler.h"
+#include "libshaderc_util/string_piece.h"
+
+namespace glslc {
+
+// Reads the batch manifest in the named file and appends its jobs to *jobs.
+// The manifest is a JSON object of the form:
+//
+//   {
+//     "defaults": { <settings> },
+//     "jobs": [ { "input": "a.frag", "output": "a.spv", <settings> }, ... ]
+//   }
+//
+// where the settings of a job are "stage", "language", "entry_point",
+// "defines", "include_dirs", "output" and "depfile".  A job inherits the
+// settings of "defaults", which in turn inherits from the given defaults,
+// taken from the command line.  Scalar settings override inherited ones,
+// while "defines" and "include_dirs" add to them.  A job without a stage takes
+// the stage of its input file extension, and a job without a language takes
+// HLSL for files ending in .hlsl unless language_forced is true.
+//
+// Returns true on success.  Otherwise writes error messages to *errs, and
+// returns false.
+bool ReadBatchManifest(const std::string& manifest_file_name,
+                       const InputFileSpec& defaults, bool language_forced,
+                       std::vector<BatchJob>* jobs, std::ostream* errs);
+
+// Like ReadBatchManifest(), but parses the manifest from the given text.  The
+// manifest file name is only used in error messages.
+bool ParseBatchManifest(const shaderc_util::string_piece& manifest,
+                        const std::string& manifest_file_name,
+                        const InputFileSpec& defaults, bool language_forced,
+                        std::vector<BatchJob>* jobs, std::ostream* errs);
+
+}  // namespace glslc
+
+#endif  // GLSLC_BATCH_H_
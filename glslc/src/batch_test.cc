@@ -0,0 +1,157 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "batch.h"
+
+#include <gmock/gmock.h>
+
+#include <sstream>
+
+namespace {
+
+using glslc::BatchJob;
+using glslc::InputFileSpec;
+using glslc::ParseBatchManifest;
+using testing::ElementsAre;
+using testing::Eq;
+using testing::HasSubstr;
+using testing::Pair;
+
+class ParseBatchManifestTest : public testing::Test {
+ protected:
+  // Parses the given manifest with the default settings of a command line
+  // without options.
+  bool Parse(const std::string& manifest) {
+    jobs_.clear();
+    errors_.str("");
+    return ParseBatchManifest(manifest, "manifest.json", defaults_,
+                              language_forced_, &jobs_, &errors_);
+  }
+
+  InputFileSpec defaults_{"", shaderc_glsl_infer_from_source,
+                          shaderc_source_language_glsl, "main"};
+  bool language_forced_ = false;
+  std::vector<BatchJob> jobs_;
+  std::ostringstream errors_;
+};
+
+TEST_F(ParseBatchManifestTest, MinimalJobsUseDefaults) {
+  ASSERT_TRUE(Parse(R"({"jobs": [{"input": "a.frag"}, {"input": "b.hlsl"}]})"))
+      << errors_.str();
+  ASSERT_EQ(2u, jobs_.size());
+  EXPECT_EQ("a.frag", jobs_[0].input_file.name);
+  EXPECT_EQ(shaderc_glsl_default_fragment_shader, jobs_[0].input_file.stage);
+  EXPECT_EQ(shaderc_source_language_glsl, jobs_[0].input_file.language);
+  EXPECT_EQ("main", jobs_[0].input_file.entry_point_name);
+  EXPECT_EQ("", jobs_[0].output_file_name);
+  EXPECT_EQ("", jobs_[0].dependency_file_name);
+  EXPECT_TRUE(jobs_[0].macro_definitions.empty());
+  EXPECT_TRUE(jobs_[0].include_directories.empty());
+  EXPECT_EQ(shaderc_source_language_hlsl, jobs_[1].input_file.language);
+  EXPECT_EQ("", errors_.str());
+}
+
+TEST_F(ParseBatchManifestTest, JobSettings) {
+  ASSERT_TRUE(Parse(R"({
+    "jobs": [{
+      "input": "shader.glsl",
+      "output": "out/shader.spv",
+      "depfile": "out/shader.spv.d",
+      "stage": "comp",
+      "language": "hlsl",
+      "entry_point": "CSMain",
+      "defines": ["A", "B=1", "C=x=y"],
+      "include_dirs": ["inc"]
+    }]
+  })")) << errors_.str();
+  ASSERT_EQ(1u, jobs_.size());
+  const BatchJob& job = jobs_[0];
+  EXPECT_EQ("out/shader.spv", job.output_file_name);
+  EXPECT_EQ("out/shader.spv.d", job.dependency_file_name);
+  EXPECT_EQ(shaderc_glsl_compute_shader, job.input_file.stage);
+  EXPECT_EQ(shaderc_source_language_hlsl, job.input_file.language);
+  EXPECT_EQ("CSMain", job.input_file.entry_point_name);
+  EXPECT_THAT(job.macro_definitions,
+              ElementsAre(Pair("A", ""), Pair("B", "1"), Pair("C", "x=y")));
+  EXPECT_THAT(job.include_directories, ElementsAre("inc"));
+}
+
+TEST_F(ParseBatchManifestTest, JobsInheritManifestDefaults) {
+  ASSERT_TRUE(Parse(R"({
+    "defaults": {"stage": "frag", "defines": ["Q=2"], "include_dirs": ["a"],
+                 "entry_point": "fs"},
+    "jobs": [
+      {"input": "x.glsl"},
+      {"input": "y.glsl", "stage": "vert", "defines": ["R"],
+       "include_dirs": ["b"]}
+    ]
+  })")) << errors_.str();
+  ASSERT_EQ(2u, jobs_.size());
+  EXPECT_EQ(shaderc_glsl_fragment_shader, jobs_[0].input_file.stage);
+  EXPECT_EQ("fs", jobs_[0].input_file.entry_point_name);
+  EXPECT_THAT(jobs_[0].macro_definitions, ElementsAre(Pair("Q", "2")));
+  EXPECT_EQ(shaderc_glsl_vertex_shader, jobs_[1].input_file.stage);
+  EXPECT_THAT(jobs_[1].macro_definitions,
+              ElementsAre(Pair("Q", "2"), Pair("R", "")));
+  EXPECT_THAT(jobs_[1].include_directories, ElementsAre("a", "b"));
+}
+
+TEST_F(ParseBatchManifestTest, CommandLineDefaults) {
+  defaults_.stage = shaderc_glsl_vertex_shader;
+  defaults_.language = shaderc_source_language_glsl;
+  language_forced_ = true;
+  ASSERT_TRUE(Parse(R"({"jobs": [{"input": "a.hlsl"}]})")) << errors_.str();
+  ASSERT_EQ(1u, jobs_.size());
+  EXPECT_EQ(shaderc_glsl_vertex_shader, jobs_[0].input_file.stage);
+  EXPECT_EQ(shaderc_source_language_glsl, jobs_[0].input_file.language);
+}
+
+TEST_F(ParseBatchManifestTest, Errors) {
+  EXPECT_FALSE(Parse("{\"jobs\": [}"));
+  EXPECT_THAT(errors_.str(),
+              Eq("glslc: error: manifest.json:1:11: unexpected character\n"));
+
+  EXPECT_FALSE(Parse("[]"));
+  EXPECT_THAT(errors_.str(), HasSubstr("manifest: expected an object"));
+
+  EXPECT_FALSE(Parse("{}"));
+  EXPECT_THAT(errors_.str(), HasSubstr("jobs: expected an array of jobs"));
+
+  EXPECT_FALSE(Parse(R"({"jobs": [], "job": []})"));
+  EXPECT_THAT(errors_.str(), HasSubstr("unknown member 'job'"));
+
+  EXPECT_FALSE(Parse(R"({"jobs": [{"output": "a.spv"}]})"));
+  EXPECT_THAT(errors_.str(),
+              Eq("glslc: error: manifest.json: jobs[0]: missing \"input\"\n"));
+
+  EXPECT_FALSE(Parse(R"({"jobs": [{"input": "a", "stage": "pixel"}]})"));
+  EXPECT_THAT(errors_.str(), HasSubstr("jobs[0].stage: stage not recognized: "
+                                       "'pixel'"));
+
+  EXPECT_FALSE(Parse(R"({"jobs": [{"input": "a", "defines": "A"}]})"));
+  EXPECT_THAT(errors_.str(), HasSubstr("jobs[0].defines: expected an array"));
+
+  EXPECT_FALSE(Parse(R"({"jobs": [{"input": "a", "defines": ["GL_X"]}]})"));
+  EXPECT_THAT(errors_.str(), HasSubstr("names beginning with 'GL_'"));
+
+  EXPECT_FALSE(Parse(R"({"jobs": [{"input": "a", "optimize": true}]})"));
+  EXPECT_THAT(errors_.str(), HasSubstr("jobs[0]: unknown setting 'optimize'"));
+
+  EXPECT_FALSE(Parse(R"({"defaults": {"input": "a"}, "jobs": []})"));
+  EXPECT_THAT(errors_.str(), HasSubstr("defaults: unknown setting 'input'"));
+
+  EXPECT_FALSE(Parse(R"({"jobs": [{"input": "a", "language": "wgsl"}]})"));
+  EXPECT_THAT(errors_.str(), HasSubstr("expected \"glsl\" or \"hlsl\""));
+}
+
+}  // anonymous namespace
@@ -14,12 +14,14 @@
 
 #include "dependency_info.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
 #include "file.h"
 #include "libshaderc_util/io_shaderc.h"
+#include "libshaderc_util/json.h"
 
 namespace glslc {
 
@@ -44,6 +46,13 @@ bool DependencyInfoDumpingHandler::DumpDependencyInfo(
   }
   dep_string_stream << std::endl;
 
+  if (!json_database_file_name_.empty()) {
+    DatabaseEntry entry{dep_target_label, source_file_name,
+                        {dependent_files.begin(), dependent_files.end()}};
+    std::sort(entry.dependencies.begin(), entry.dependencies.end());
+    database_entries_.push_back(std::move(entry));
+  }
+
   if (mode_ == dump_as_compilation_output) {
     compilation_output_ptr->assign(dep_string_stream.str());
   } else if (mode_ == dump_as_extra_file) {
@@ -68,6 +77,40 @@ bool DependencyInfoDumpingHandler::DumpDependencyInfo(
   return true;
 }
 
+bool DependencyInfoDumpingHandler::WriteJsonDatabase() {
+  if (json_database_file_name_.empty()) return true;
+
+  std::ofstream potential_file_stream;
+  std::ostream* out = shaderc_util::GetOutputStream(
+      json_database_file_name_, &potential_file_stream, &std::cerr);
+  if (!out) {
+    // An error message has already been emitted to the stderr stream.
+    return false;
+  }
+  *out << "[";
+  for (size_t i = 0; i < database_entries_.size(); ++i) {
+    const DatabaseEntry& entry = database_entries_[i];
+    *out << (i ? ",\n" : "\n") << "  {\"target\": ";
+    shaderc_util::WriteJsonString(out, entry.target);
+    *out << ", \"source\": ";
+    shaderc_util::WriteJsonString(out, entry.source);
+    *out << ", \"dependencies\": [";
+    for (size_t j = 0; j < entry.dependencies.size(); ++j) {
+      if (j) *out << ", ";
+      shaderc_util::WriteJsonString(out, entry.dependencies[j]);
+    }
+    *out << "]}";
+  }
+  *out << "\n]\n";
+  if (out->fail()) {
+    std::cerr << "glslc: error: error writing dependency database to output "
+                 "file: '"
+              << json_database_file_name_ << "'" << std::endl;
+    return false;
+  }
+  return true;
+}
+
 std::string DependencyInfoDumpingHandler::GetTarget(
     const std::string& compilation_output_file_name) {
   if (!user_specified_dep_target_label_.empty()) {
@@ -15,9 +15,11 @@
 #ifndef GLSLC_DEPENDENCY_INFO_H
 #define GLSLC_DEPENDENCY_INFO_H
 
+#include <iterator>
 #include <unordered_set>
 #include <string>
 #include <string>
+#include <vector>
 
 namespace glslc {
 
@@ -42,6 +44,13 @@ class DependencyInfoDumpingHandler {
     user_specified_dep_file_name_ = dep_file_name;
   }
 
+  // Sets the name of the file where the dependency info of all input files
+  // will be written as a JSON database, in addition to the make rules. It's the
+  // same as the argument to -MJ.
+  void SetJsonDatabaseFileName(const std::string& file_name) {
+    json_database_file_name_ = file_name;
+  }
+
   // Dump depdendency info to a) an extra dependency info file, b) an string
   // which holds the compilation output. The choice depends on the dump
   // mode of the handler. Returns true if dumping is succeeded, false otherwise.
@@ -61,12 +70,32 @@ class DependencyInfoDumpingHandler {
   // will be cleared and this method will write dependency info to it. Then the
   // dependency info should be emitted as normal compilation output.
   //
+  // If a JSON database file name is set, the dependency info is also recorded
+  // for WriteJsonDatabase().
+  //
   // If the dump mode is not set when this method is called, return false.
   bool DumpDependencyInfo(std::string compilation_output_file_name,
                           std::string source_file_name,
                           std::string* compilation_output_ptr,
                           const std::unordered_set<std::string>& dependent_files);
 
+  // Writes the dependency info recorded by all calls to DumpDependencyInfo()
+  // to the JSON database file, as an array with one object per input file:
+  //   [{"target": ..., "source": ..., "dependencies": [...]}, ...]
+  // Dependencies are sorted by name. Returns true on success or if no database
+  // file name was set. Error messages are emitted to stderr.
+  bool WriteJsonDatabase();
+
+  // Moves the dependency info recorded for the JSON database by other to the
+  // end of the info recorded by this handler.
+  void AppendJsonDatabaseEntries(DependencyInfoDumpingHandler* other) {
+    database_entries_.insert(
+        database_entries_.end(),
+        std::make_move_iterator(other->database_entries_.begin()),
+        std::make_move_iterator(other->database_entries_.end()));
+    other->database_entries_.clear();
+  }
+
   // Sets to always dump dependency info as an extra file, instead of the normal
   // compilation output. This means the output name specified by -o options
   // won't be used for the dependency info file.
@@ -127,8 +156,17 @@ class DependencyInfoDumpingHandler {
   std::string GetDependencyFileName(
       const std::string& compilation_output_file_name);
 
+  // The dependency info of one input file, as written to the JSON database.
+  struct DatabaseEntry {
+    std::string target;
+    std::string source;
+    std::vector<std::string> dependencies;
+  };
+
   std::string user_specified_dep_file_name_;
   std::string user_specified_dep_target_label_;
+  std::string json_database_file_name_;
+  std::vector<DatabaseEntry> database_entries_;
   dump_mode mode_;
 };
 }
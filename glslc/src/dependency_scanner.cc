@@ -0,0 +1,687 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dependency_scanner.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+
+#include "libshaderc_util/io_shaderc.h"
+
+namespace {
+using shaderc_util::string_piece;
+
+// The maximum nesting depth of #include directives followed by the scanner.
+const size_t kMaxIncludeDepth = 100;
+
+// The maximum nesting depth of macro expansion in conditional expressions.
+const size_t kMaxExpansionDepth = 64;
+
+bool IsIdentifierStart(char c) {
+  return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool IsIdentifierChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool IsHorizontalSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Returns piece with leading and trailing whitespace removed.
+string_piece Trim(string_piece piece) {
+  while (!piece.empty() && IsHorizontalSpace(piece[0])) {
+    piece = piece.substr(1);
+  }
+  while (!piece.empty() && IsHorizontalSpace(piece[piece.size() - 1])) {
+    piece = piece.substr(0, piece.size() - 1);
+  }
+  return piece;
+}
+
+// Splits an identifier off the front of *text.  Returns an empty piece if
+// *text does not start with one, after any leading whitespace.
+string_piece ConsumeIdentifier(string_piece* text) {
+  string_piece rest = Trim(*text);
+  size_t length = 0;
+  if (!rest.empty() && IsIdentifierStart(rest[0])) {
+    while (length < rest.size() && IsIdentifierChar(rest[length])) ++length;
+  }
+  *text = rest.substr(length);
+  return rest.substr(0, length);
+}
+
+// Returns true if the named macro is defined by the compiler rather than by
+// the source or the command line.  Its value depends on the shader version,
+// profile, target environment and enabled extensions.
+bool IsCompilerMacro(const std::string& name) {
+  return name.compare(0, 3, "GL_") == 0 || name.compare(0, 2, "__") == 0 ||
+         name == "VULKAN";
+}
+
+// Walks source text and returns its preprocessor directives one at a time,
+// skipping everything else.  Comments are removed and continued lines are
+// joined, the same way the preprocessor sees them.
+class DirectiveReader {
+ public:
+  explicit DirectiveReader(const string_piece& source)
+      : pos_(source.begin()), end_(source.end()) {}
+
+  // Finds the next directive.  On success, stores the text following its '#'
+  // in *directive and its 1-based line number in *line, and returns true.
+  // Returns false at the end of the source.
+  bool Next(std::string* directive, size_t* line) {
+    while (pos_ != end_) {
+      const size_t start_line = line_;
+      SkipBlanks();
+      if (pos_ != end_ && *pos_ == '#') {
+        ++pos_;
+        directive->clear();
+        ReadRestOfLine(directive);
+        *line = start_line;
+        return true;
+      }
+      ReadRestOfLine(nullptr);
+    }
+    return false;
+  }
+
+ private:
+  bool StartsWith(char first, char second) const {
+    return pos_ != end_ && *pos_ == first && pos_ + 1 != end_ &&
+           pos_[1] == second;
+  }
+
+  // Consumes a backslash-newline pair if there is one at the current
+  // position, returning true if so.
+  bool SkipContinuation() {
+    if (pos_ == end_ || *pos_ != '\\') return false;
+    const char* next = pos_ + 1;
+    if (next != end_ && *next == '\r') ++next;
+    if (next == end_ || *next != '\n') return false;
+    pos_ = next + 1;
+    ++line_;
+    return true;
+  }
+
+  // Consumes a block comment starting at the current position.
+  void SkipBlockComment() {
+    pos_ += 2;
+    while (pos_ != end_) {
+      if (StartsWith('*', '/')) {
+        pos_ += 2;
+        return;
+      }
+      if (*pos_ == '\n') ++line_;
+      ++pos_;
+    }
+  }
+
+  // Consumes whitespace and block comments, but not the end of the line.
+  void SkipBlanks() {
+    while (pos_ != end_) {
+      if (IsHorizontalSpace(*pos_)) {
+        ++pos_;
+      } else if (StartsWith('/', '*')) {
+        SkipBlockComment();
+      } else if (!SkipContinuation()) {
+        return;
+      }
+    }
+  }
+
+  // Consumes the rest of the logical line, including its newline.  If out is
+  // not null, appends the text of the line to it, with each comment replaced
+  // by a single space.
+  void ReadRestOfLine(std::string* out) {
+    bool in_string = false;
+    while (pos_ != end_) {
+      if (SkipContinuation()) continue;
+      const char c = *pos_;
+      if (c == '\n') {
+        ++pos_;
+        ++line_;
+        return;
+      }
+      if (!in_string && StartsWith('/', '/')) {
+        while (pos_ != end_ && *pos_ != '\n') {
+          if (!SkipContinuation()) ++pos_;
+        }
+        continue;
+      }
+      if (!in_string && StartsWith('/', '*')) {
+        SkipBlockComment();
+        if (out) *out += ' ';
+        continue;
+      }
+      if (c == '"') in_string = !in_string;
+      if (out) *out += c;
+      ++pos_;
+    }
+  }
+
+  const char* pos_;
+  const char* end_;
+  size_t line_ = 1;
+};
+
+}  // anonymous namespace
+
+namespace glslc {
+
+// Evaluates the controlling expression of an #if or #elif directive.  The
+// expression is macro-expanded first.  Any part of it that depends on a
+// macro whose value is not known makes that part unknown, and unknown values
+// propagate through operators except where the result is decided by the
+// other operand, as in "0 && X" or "1 || X".
+class DependencyScanner::ExpressionEvaluator {
+ public:
+  explicit ExpressionEvaluator(const DependencyScanner& scanner)
+      : scanner_(scanner) {}
+
+  Tristate Evaluate(const string_piece& expression) {
+    std::vector<Token> raw;
+    if (!Tokenize(expression, &raw)) return Tristate::kUnknown;
+    std::unordered_set<std::string> expanding;
+    Expand(raw, 0, &expanding, &tokens_);
+    tokens_.push_back(Token{Token::kEnd, 0, ""});
+    next_ = 0;
+    const Value value = ParseConditional();
+    if (failed_ || tokens_[next_].kind != Token::kEnd || !value.known) {
+      return Tristate::kUnknown;
+    }
+    return value.value ? Tristate::kTrue : Tristate::kFalse;
+  }
+
+ private:
+  struct Token {
+    enum Kind { kNumber, kUnknown, kIdentifier, kPunctuator, kEnd } kind;
+    int64_t value;
+    std::string text;
+  };
+
+  struct Value {
+    bool known;
+    int64_t value;
+  };
+
+  static Value Known(int64_t value) { return Value{true, value}; }
+  static Value Unknown() { return Value{false, 0}; }
+
+  // Splits text into tokens.  Returns false if it contains something that
+  // cannot appear in a conditional expression.
+  static bool Tokenize(const string_piece& text, std::vector<Token>* tokens) {
+    static const char* const kTwoCharPunctuators[] = {"&&", "||", "==", "!=",
+                                                      "<=", ">=", "<<", ">>"};
+    size_t i = 0;
+    while (i < text.size()) {
+      const char c = text[i];
+      if (IsHorizontalSpace(c)) {
+        ++i;
+      } else if (IsIdentifierStart(c)) {
+        size_t end = i;
+        while (end < text.size() && IsIdentifierChar(text[end])) ++end;
+        tokens->push_back(
+            Token{Token::kIdentifier, 0, text.substr(i, end - i).str()});
+        i = end;
+      } else if (std::isdigit(static_cast<unsigned char>(c))) {
+        size_t end = i;
+        while (end < text.size() &&
+               (IsIdentifierChar(text[end]) || text[end] == '.')) {
+          ++end;
+        }
+        std::string literal = text.substr(i, end - i).str();
+        while (!literal.empty() &&
+               (literal.back() == 'u' || literal.back() == 'U')) {
+          literal.pop_back();
+        }
+        char* literal_end = nullptr;
+        errno = 0;
+        const long long value = std::strtoll(literal.c_str(), &literal_end, 0);
+        if (errno == 0 && literal_end == literal.c_str() + literal.size()) {
+          tokens->push_back(Token{Token::kNumber, value, ""});
+        } else {
+          tokens->push_back(Token{Token::kUnknown, 0, ""});
+        }
+        i = end;
+      } else {
+        std::string punctuator(1, c);
+        if (i + 1 < text.size()) {
+          const std::string pair = text.substr(i, 2).str();
+          for (const char* candidate : kTwoCharPunctuators) {
+            if (pair == candidate) punctuator = pair;
+          }
+        }
+        if (punctuator.size() == 1 &&
+            std::string("()!~-+*/%<>&^|?:,").find(c) == std::string::npos) {
+          return false;
+        }
+        tokens->push_back(Token{Token::kPunctuator, 0, punctuator});
+        i += punctuator.size();
+      }
+    }
+    return true;
+  }
+
+  // Appends the macro-expanded form of tokens to *out.  The names of the
+  // macros being expanded are in *expanding, to stop recursion.
+  void Expand(const std::vector<Token>& tokens, size_t depth,
+              std::unordered_set<std::string>* expanding,
+              std::vector<Token>* out) const {
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      const Token& token = tokens[i];
+      if (token.kind != Token::kIdentifier) {
+        out->push_back(token);
+        continue;
+      }
+      if (token.text == "defined") {
+        const bool parenthesized = i + 1 < tokens.size() &&
+                                   tokens[i + 1].kind == Token::kPunctuator &&
+                                   tokens[i + 1].text == "(";
+        const size_t name_index = parenthesized ? i + 2 : i + 1;
+        const size_t end_index = parenthesized ? name_index + 1 : name_index;
+        if (name_index >= tokens.size() ||
+            tokens[name_index].kind != Token::kIdentifier ||
+            (parenthesized && (end_index >= tokens.size() ||
+                               tokens[end_index].text != ")"))) {
+          out->push_back(Token{Token::kUnknown, 0, ""});
+          continue;
+        }
+        const Macro* macro = scanner_.FindMacro(tokens[name_index].text);
+        if (!macro) {
+          out->push_back(Token{Token::kNumber, 0, ""});
+        } else if (macro->known) {
+          out->push_back(Token{Token::kNumber, 1, ""});
+        } else {
+          out->push_back(Token{Token::kUnknown, 0, ""});
+        }
+        i = end_index;
+        continue;
+      }
+
+      const Macro* macro = scanner_.FindMacro(token.text);
+      if (!macro) {
+        // Identifiers that are not macros evaluate to 0.
+        out->push_back(Token{Token::kNumber, 0, ""});
+        continue;
+      }
+      if (!macro->known || macro->function_like ||
+          expanding->count(token.text) || depth >= kMaxExpansionDepth) {
+        out->push_back(Token{Token::kUnknown, 0, ""});
+        if (macro->function_like && i + 1 < tokens.size() &&
+            tokens[i + 1].text == "(") {
+          // Skip the argument list.
+          size_t nesting = 0;
+          for (++i; i < tokens.size(); ++i) {
+            if (tokens[i].text == "(") ++nesting;
+            if (tokens[i].text == ")" && --nesting == 0) break;
+          }
+        }
+        continue;
+      }
+      std::vector<Token> body;
+      if (!Tokenize(macro->body, &body)) {
+        out->push_back(Token{Token::kUnknown, 0, ""});
+        continue;
+      }
+      expanding->insert(token.text);
+      Expand(body, depth + 1, expanding, out);
+      expanding->erase(token.text);
+    }
+  }
+
+  bool Accept(const char* punctuator) {
+    const Token& token = tokens_[next_];
+    if (token.kind == Token::kPunctuator && token.text == punctuator) {
+      ++next_;
+      return true;
+    }
+    return false;
+  }
+
+  // Returns the binding strength of the binary operator at the current
+  // position, or 0 if there is none.
+  int BinaryPrecedence() const {
+    const Token& token = tokens_[next_];
+    if (token.kind != Token::kPunctuator) return 0;
+    static const struct {
+      const char* op;
+      int precedence;
+    } kOperators[] = {{"||", 1}, {"&&", 2}, {"|", 3},  {"^", 4},  {"&", 5},
+                      {"==", 6}, {"!=", 6}, {"<", 7},  {">", 7},  {"<=", 7},
+                      {">=", 7}, {"<<", 8}, {">>", 8}, {"+", 9},  {"-", 9},
+                      {"*", 10}, {"/", 10}, {"%", 10}};
+    for (const auto& entry : kOperators) {
+      if (token.text == entry.op) return entry.precedence;
+    }
+    return 0;
+  }
+
+  Value ParseConditional() {
+    const Value condition = ParseBinary(1);
+    if (!Accept("?")) return condition;
+    const Value if_true = ParseConditional();
+    if (!Accept(":")) failed_ = true;
+    const Value if_false = ParseConditional();
+    if (condition.known) return condition.value ? if_true : if_false;
+    if (if_true.known && if_false.known && if_true.value == if_false.value) {
+      return if_true;
+    }
+    return Unknown();
+  }
+
+  Value ParseBinary(int min_precedence) {
+    Value left = ParseUnary();
+    for (int precedence = BinaryPrecedence();
+         precedence && precedence >= min_precedence;
+         precedence = BinaryPrecedence()) {
+      const std::string op = tokens_[next_++].text;
+      const Value right = ParseBinary(precedence + 1);
+      left = Apply(op, left, right);
+    }
+    return left;
+  }
+
+  static Value Apply(const std::string& op, Value left, Value right) {
+    if (op == "&&") {
+      if ((left.known && !left.value) || (right.known && !right.value)) {
+        return Known(0);
+      }
+      return left.known && right.known ? Known(1) : Unknown();
+    }
+    if (op == "||") {
+      if ((left.known && left.value) || (right.known && right.value)) {
+        return Known(1);
+      }
+      return left.known && right.known ? Known(0) : Unknown();
+    }
+    if (!left.known || !right.known) return Unknown();
+    // Wrap on overflow instead of invoking undefined behaviour.
+    const uint64_t l = static_cast<uint64_t>(left.value);
+    const uint64_t r = static_cast<uint64_t>(right.value);
+    if (op == "|") return Known(static_cast<int64_t>(l | r));
+    if (op == "^") return Known(static_cast<int64_t>(l ^ r));
+    if (op == "&") return Known(static_cast<int64_t>(l & r));
+    if (op == "==") return Known(left.value == right.value);
+    if (op == "!=") return Known(left.value != right.value);
+    if (op == "<") return Known(left.value < right.value);
+    if (op == ">") return Known(left.value > right.value);
+    if (op == "<=") return Known(left.value <= right.value);
+    if (op == ">=") return Known(left.value >= right.value);
+    if (op == "+") return Known(static_cast<int64_t>(l + r));
+    if (op == "-") return Known(static_cast<int64_t>(l - r));
+    if (op == "*") return Known(static_cast<int64_t>(l * r));
+    if (op == "<<" || op == ">>") {
+      if (right.value < 0 || right.value >= 64) return Unknown();
+      return Known(op == "<<" ? static_cast<int64_t>(l << r)
+                              : left.value >> right.value);
+    }
+    // Division and remainder.
+    if (right.value == 0 ||
+        (right.value == -1 && left.value == INT64_MIN)) {
+      return Unknown();
+    }
+    return Known(op == "/" ? left.value / right.value
+                           : left.value % right.value);
+  }
+
+  Value ParseUnary() {
+    if (Accept("+")) return ParseUnary();
+    if (Accept("-")) {
+      const Value operand = ParseUnary();
+      return operand.known
+                 ? Known(static_cast<int64_t>(
+                       0 - static_cast<uint64_t>(operand.value)))
+                 : operand;
+    }
+    if (Accept("!")) {
+      const Value operand = ParseUnary();
+      return operand.known ? Known(!operand.value) : operand;
+    }
+    if (Accept("~")) {
+      const Value operand = ParseUnary();
+      return operand.known ? Known(~operand.value) : operand;
+    }
+    if (Accept("(")) {
+      const Value value = ParseConditional();
+      if (!Accept(")")) failed_ = true;
+      return value;
+    }
+    const Token& token = tokens_[next_];
+    if (token.kind == Token::kNumber) {
+      ++next_;
+      return Known(token.value);
+    }
+    if (token.kind == Token::kUnknown) {
+      ++next_;
+      return Unknown();
+    }
+    failed_ = true;
+    return Unknown();
+  }
+
+  const DependencyScanner& scanner_;
+  std::vector<Token> tokens_;
+  size_t next_ = 0;
+  bool failed_ = false;
+};
+
+DependencyScanner::~DependencyScanner() = default;
+
+bool DependencyScanner::Scan(const std::string& file_name,
+                             const string_piece& source,
+                             std::string* error_message) {
+  macros_.clear();
+  undefined_builtins_.clear();
+  dependencies_.clear();
+  for (const auto& macro : predefined_macros_) {
+    macros_[macro.first] = Macro{true, false, macro.second};
+  }
+  return ScanFile(file_name, source, Tristate::kTrue, 0, error_message);
+}
+
+std::string DependencyScanner::FindIncludeFile(
+    const std::string& requesting_file, const std::string& requested_file,
+    bool relative) const {
+  return relative ? file_finder_.FindRelativeReadableFilepath(requesting_file,
+                                                              requested_file)
+                  : file_finder_.FindReadableFilepath(requested_file);
+}
+
+bool DependencyScanner::ReadIncludeFile(const std::string& full_path,
+                                        std::vector<char>* contents) const {
+  return shaderc_util::ReadFile(full_path, contents);
+}
+
+bool DependencyScanner::ScanFile(const std::string& file_name,
+                                 const string_piece& source,
+                                 Tristate enclosing, size_t depth,
+                                 std::string* error_message) {
+  auto And = [](Tristate a, Tristate b) {
+    if (a == Tristate::kFalse || b == Tristate::kFalse) return Tristate::kFalse;
+    if (a == Tristate::kTrue && b == Tristate::kTrue) return Tristate::kTrue;
+    return Tristate::kUnknown;
+  };
+  auto Or = [](Tristate a, Tristate b) {
+    if (a == Tristate::kTrue || b == Tristate::kTrue) return Tristate::kTrue;
+    if (a == Tristate::kFalse && b == Tristate::kFalse) return Tristate::kFalse;
+    return Tristate::kUnknown;
+  };
+  auto Not = [](Tristate a) {
+    if (a == Tristate::kUnknown) return a;
+    return a == Tristate::kTrue ? Tristate::kFalse : Tristate::kTrue;
+  };
+  auto Error = [&file_name, error_message](size_t line,
+                                           const std::string& message) {
+    std::ostringstream stream;
+    stream << file_name << ":" << line << ": error: " << message;
+    *error_message = stream.str();
+    return false;
+  };
+
+  std::vector<Conditional> conditionals;
+  DirectiveReader reader(source);
+  std::string directive;
+  size_t line = 0;
+  while (reader.Next(&directive, &line)) {
+    string_piece rest = directive;
+    const string_piece name = ConsumeIdentifier(&rest);
+    rest = Trim(rest);
+    const Tristate active =
+        conditionals.empty() ? enclosing : conditionals.back().active;
+
+    if (name == "if" || name == "ifdef" || name == "ifndef") {
+      Tristate condition = Tristate::kFalse;
+      if (active != Tristate::kFalse) {
+        if (name == "if") {
+          condition = Evaluate(rest);
+        } else {
+          const Macro* macro = FindMacro(ConsumeIdentifier(&rest).str());
+          condition = !macro ? Tristate::kFalse
+                             : (macro->known ? Tristate::kTrue
+                                             : Tristate::kUnknown);
+          if (name == "ifndef") condition = Not(condition);
+        }
+      }
+      conditionals.push_back(
+          Conditional{active, condition, And(active, condition), false});
+    } else if (name == "elif" || name == "else") {
+      if (conditionals.empty()) {
+        return Error(line, "'#" + name.str() + "' : missing #if");
+      }
+      Conditional& conditional = conditionals.back();
+      if (conditional.seen_else) {
+        return Error(line, "'#" + name.str() + "' : #" + name.str() +
+                               " after #else");
+      }
+      Tristate condition = Tristate::kTrue;
+      if (name == "elif") {
+        condition = (conditional.parent == Tristate::kFalse ||
+                     conditional.taken == Tristate::kTrue)
+                        ? Tristate::kFalse
+                        : Evaluate(rest);
+      } else {
+        conditional.seen_else = true;
+      }
+      conditional.active =
+          And(conditional.parent, And(Not(conditional.taken), condition));
+      conditional.taken = Or(conditional.taken, condition);
+    } else if (name == "endif") {
+      if (conditionals.empty()) {
+        return Error(line, "'#endif' : missing #if");
+      }
+      conditionals.pop_back();
+    } else if (active == Tristate::kFalse) {
+      // Other directives in skipped regions have no effect.
+    } else if (name == "define") {
+      const std::string macro_name = ConsumeIdentifier(&rest).str();
+      if (macro_name.empty()) continue;
+      const bool function_like = !rest.empty() && rest[0] == '(';
+      macros_[macro_name] = Macro{active == Tristate::kTrue, function_like,
+                                  Trim(rest).str()};
+    } else if (name == "undef") {
+      const std::string macro_name = ConsumeIdentifier(&rest).str();
+      if (active == Tristate::kTrue) {
+        macros_.erase(macro_name);
+        if (IsCompilerMacro(macro_name)) undefined_builtins_.insert(macro_name);
+      } else {
+        macros_[macro_name] = Macro{false, false, ""};
+      }
+    } else if (name == "include") {
+      if (!HandleInclude(file_name, line, rest, active, depth, error_message)) {
+        return false;
+      }
+    }
+  }
+
+  if (!conditionals.empty()) {
+    return Error(line, "'#if' : missing #endif");
+  }
+  return true;
+}
+
+bool DependencyScanner::HandleInclude(const std::string& file_name,
+                                      size_t line, const string_piece& operand,
+                                      Tristate active, size_t depth,
+                                      std::string* error_message) {
+  auto Fail = [&](const std::string& message) {
+    if (active != Tristate::kTrue) {
+      // The directive might not be compiled at all, so don't complain.
+      return true;
+    }
+    std::ostringstream stream;
+    stream << file_name << ":" << line << ": error: '#include' : " << message;
+    *error_message = stream.str();
+    return false;
+  };
+
+  const char close = operand.empty() ? '\0'
+                     : operand[0] == '"' ? '"'
+                     : operand[0] == '<' ? '>'
+                                         : '\0';
+  const size_t close_pos =
+      close ? operand.substr(1).find_first_of(close) : string_piece::npos;
+  if (close_pos == string_piece::npos || close_pos == 0) {
+    return Fail("expected \"FILENAME\" or <FILENAME>");
+  }
+  const std::string requested = operand.substr(1, close_pos).str();
+
+  const std::string full_path =
+      FindIncludeFile(file_name, requested, close == '"');
+  if (full_path.empty()) {
+    return Fail("Cannot find or open include file: " + requested);
+  }
+  if (depth >= kMaxIncludeDepth) {
+    return Fail("include nesting is too deep");
+  }
+
+  auto cached = file_cache_.find(full_path);
+  if (cached == file_cache_.end()) {
+    std::vector<char> contents;
+    if (!ReadIncludeFile(full_path, &contents)) {
+      return Fail("Cannot read file: " + full_path);
+    }
+    cached = file_cache_.emplace(full_path, std::move(contents)).first;
+  }
+  dependencies_.insert(full_path);
+
+  const std::vector<char>& contents = cached->second;
+  const string_piece source =
+      contents.empty() ? string_piece("")
+                       : string_piece(contents.data(),
+                                      contents.data() + contents.size());
+  return ScanFile(full_path, source, active, depth + 1, error_message);
+}
+
+DependencyScanner::Tristate DependencyScanner::Evaluate(
+    const string_piece& expression) const {
+  return ExpressionEvaluator(*this).Evaluate(expression);
+}
+
+const DependencyScanner::Macro* DependencyScanner::FindMacro(
+    const std::string& name) const {
+  static const Macro kCompilerMacro{false, false, ""};
+  const auto found = macros_.find(name);
+  if (found != macros_.end()) return &found->second;
+  if (IsCompilerMacro(name) && !undefined_builtins_.count(name)) {
+    return &kCompilerMacro;
+  }
+  return nullptr;
+}
+
+}  // namespace glslc
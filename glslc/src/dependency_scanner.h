@@ -0,0 +1,142 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GLSLC_DEPENDENCY_SCANNER_H_
+#define GLSLC_DEPENDENCY_SCANNER_H_
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "libshaderc_util/file_finder.h"
+#include "libshaderc_util/string_piece.h"
+
+namespace glslc {
+
+// Finds the files a GLSL or HLSL source depends on through #include, without
+// running the full preprocessor.  Only preprocessor directives are tokenized;
+// the rest of the source is skipped over, apart from tracking comments and
+// line continuations.
+//
+// Conditional directives are evaluated when their value is known from the
+// macros defined so far.  When a condition depends on a macro that is only
+// known to the real compiler, such as __VERSION__ or an extension macro, all
+// of its branches are treated as potentially active, so the reported set of
+// dependencies is a superset of what a full preprocessing run would report.
+//
+// Included files are cached by full path, so headers shared by many inputs
+// are read only once per scanner.
+class DependencyScanner {
+ public:
+  explicit DependencyScanner(const shaderc_util::FileFinder* file_finder)
+      : file_finder_(*file_finder) {}
+  virtual ~DependencyScanner();
+
+  // Adds a predefined macro, as if by -Dname=value.
+  void AddMacroDefinition(const std::string& name, const std::string& value) {
+    predefined_macros_[name] = value;
+  }
+
+  // Scans source, which is the contents of the file named file_name, and all
+  // the files it includes.  Returns true on success.  Otherwise returns false
+  // and writes a diagnostic to *error_message.  An #include that cannot be
+  // resolved is only an error if it appears in a region that is certainly
+  // compiled.
+  bool Scan(const std::string& file_name, const shaderc_util::string_piece& source,
+            std::string* error_message);
+
+  // Returns the full paths of the files found by the last call to Scan().
+  const std::unordered_set<std::string>& dependencies() const {
+    return dependencies_;
+  }
+
+ protected:
+  // Returns the full path of the file requested by an #include directive in
+  // requesting_file, or an empty string if it cannot be found.  Quoted
+  // includes are relative, angle-bracket ones are not.  This follows the same
+  // search rules as the FileIncluder used for real compilations.
+  virtual std::string FindIncludeFile(const std::string& requesting_file,
+                                      const std::string& requested_file,
+                                      bool relative) const;
+
+  // Reads the file at full_path into *contents.  Returns false on failure.
+  virtual bool ReadIncludeFile(const std::string& full_path,
+                               std::vector<char>* contents) const;
+
+ private:
+  // Whether a region of source is compiled: certainly not, maybe, or
+  // certainly.  Also used as the value of a conditional expression.
+  enum class Tristate { kFalse, kUnknown, kTrue };
+
+  // What the scanner knows about a macro.  An unknown macro might or might
+  // not be defined, or has a value that cannot be used.
+  struct Macro {
+    bool known;
+    bool function_like;
+    std::string body;
+  };
+
+  // One level of #if nesting.
+  struct Conditional {
+    // Whether the region enclosing the #if is compiled.
+    Tristate parent;
+    // Whether any earlier branch of this #if was taken.
+    Tristate taken;
+    // Whether the current branch is compiled.
+    Tristate active;
+    // Whether an #else has been seen.
+    bool seen_else;
+  };
+
+  // Scans the contents of one file, whose first line is compiled as
+  // indicated by enclosing.  Returns false on a hard error.
+  bool ScanFile(const std::string& file_name,
+                const shaderc_util::string_piece& source, Tristate enclosing,
+                size_t depth, std::string* error_message);
+
+  // Handles the #include directive found at the given line of file_name.
+  bool HandleInclude(const std::string& file_name, size_t line,
+                     const shaderc_util::string_piece& operand, Tristate active,
+                     size_t depth, std::string* error_message);
+
+  // Evaluates the expression of an #if or #elif directive.
+  Tristate Evaluate(const shaderc_util::string_piece& expression) const;
+
+  // Returns the state of the named macro, or nullptr if it is not defined.
+  // Macros predefined by the compiler itself are always unknown.
+  const Macro* FindMacro(const std::string& name) const;
+
+  class ExpressionEvaluator;
+
+  const shaderc_util::FileFinder& file_finder_;
+
+  // Macros given on the command line.
+  std::unordered_map<std::string, std::string> predefined_macros_;
+  // Macros visible at the current point of the scan.
+  std::unordered_map<std::string, Macro> macros_;
+  // Macros that were #undef'd while the scan was certainly active, and so
+  // shadow the compiler's own definitions.
+  std::unordered_set<std::string> undefined_builtins_;
+
+  // Contents of included files, by full path.
+  std::unordered_map<std::string, std::vector<char>> file_cache_;
+
+  // Full paths of all files included during the last scan.
+  std::unordered_set<std::string> dependencies_;
+};
+
+}  // namespace glslc
+
+#endif  // GLSLC_DEPENDENCY_SCANNER_H_
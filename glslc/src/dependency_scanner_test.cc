@@ -0,0 +1,230 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dependency_scanner.h"
+
+#include <gmock/gmock.h>
+
+#include <map>
+#include <string>
+
+namespace {
+
+using glslc::DependencyScanner;
+using testing::Eq;
+using testing::HasSubstr;
+using testing::IsEmpty;
+using testing::UnorderedElementsAre;
+
+// A scanner that reads included files from memory.  Include names are used
+// as full paths as-is.
+class InMemoryScanner : public DependencyScanner {
+ public:
+  InMemoryScanner() : DependencyScanner(&file_finder_) {}
+
+  void AddFile(const std::string& name, const std::string& contents) {
+    files_[name] = contents;
+  }
+
+  // Scans source as file "main.vert".  Returns whether the scan succeeded.
+  bool ScanSource(const std::string& source) {
+    error_.clear();
+    return Scan("main.vert", source, &error_);
+  }
+
+  const std::string& error() const { return error_; }
+
+  // The number of times each file was read.
+  std::map<std::string, int> reads;
+
+ protected:
+  std::string FindIncludeFile(const std::string&, const std::string& requested,
+                              bool) const override {
+    return files_.count(requested) ? requested : "";
+  }
+
+  bool ReadIncludeFile(const std::string& full_path,
+                       std::vector<char>* contents) const override {
+    const std::string& text = files_.at(full_path);
+    contents->assign(text.begin(), text.end());
+    ++const_cast<InMemoryScanner*>(this)->reads[full_path];
+    return true;
+  }
+
+ private:
+  shaderc_util::FileFinder file_finder_;
+  std::map<std::string, std::string> files_;
+  std::string error_;
+};
+
+class DependencyScannerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    scanner_.AddFile("a.h", "");
+    scanner_.AddFile("b.h", "");
+    scanner_.AddFile("c.h", "");
+  }
+  InMemoryScanner scanner_;
+};
+
+TEST_F(DependencyScannerTest, NoIncludes) {
+  EXPECT_TRUE(scanner_.ScanSource("#version 450\nvoid main() {}\n"));
+  EXPECT_THAT(scanner_.dependencies(), IsEmpty());
+}
+
+TEST_F(DependencyScannerTest, QuotedAndAngledIncludes) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#version 450\n#include \"a.h\"\n  #  include <b.h>\nvoid main() {}\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("a.h", "b.h"));
+}
+
+TEST_F(DependencyScannerTest, NestedIncludes) {
+  scanner_.AddFile("outer.h", "#include \"a.h\"\n");
+  EXPECT_TRUE(scanner_.ScanSource("#include \"outer.h\"\n"));
+  EXPECT_THAT(scanner_.dependencies(),
+              UnorderedElementsAre("outer.h", "a.h"));
+}
+
+TEST_F(DependencyScannerTest, IncludesInCommentsAreIgnored) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "// #include \"a.h\"\n/* #include \"b.h\"\n#include \"b.h\" */\n"
+      "#include \"c.h\" // \"a.h\"\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("c.h"));
+}
+
+TEST_F(DependencyScannerTest, LineContinuations) {
+  EXPECT_TRUE(
+      scanner_.ScanSource("#define X \\\n#include \"a.h\"\n#inc\\\nlude \"b.h\"\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("b.h"));
+}
+
+TEST_F(DependencyScannerTest, HashInsideCodeIsNotADirective) {
+  EXPECT_TRUE(scanner_.ScanSource("int x; # include \"a.h\"\n"));
+  EXPECT_THAT(scanner_.dependencies(), IsEmpty());
+}
+
+TEST_F(DependencyScannerTest, KnownConditionsSelectOneBranch) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#define A 2\n"
+      "#if A * 2 == 4 && defined(A)\n#include \"a.h\"\n"
+      "#elif 1\n#include \"b.h\"\n"
+      "#else\n#include \"c.h\"\n#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("a.h"));
+}
+
+TEST_F(DependencyScannerTest, IfdefAndIfndef) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#define A\n#ifdef A\n#include \"a.h\"\n#endif\n"
+      "#ifndef A\n#include \"b.h\"\n#endif\n"
+      "#undef A\n#ifndef A\n#include \"c.h\"\n#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("a.h", "c.h"));
+}
+
+TEST_F(DependencyScannerTest, CommandLineMacros) {
+  scanner_.AddMacroDefinition("QUALITY", "3");
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#if QUALITY > 2\n#include \"a.h\"\n#else\n#include \"b.h\"\n#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("a.h"));
+}
+
+TEST_F(DependencyScannerTest, UndefinedIdentifiersAreZero) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#if NOT_DEFINED\n#include \"a.h\"\n#else\n#include \"b.h\"\n#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("b.h"));
+}
+
+TEST_F(DependencyScannerTest, CompilerMacrosTakeAllBranches) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#if __VERSION__ >= 450\n#include \"a.h\"\n"
+      "#elif defined(GL_ES)\n#include \"b.h\"\n"
+      "#else\n#include \"c.h\"\n#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(),
+              UnorderedElementsAre("a.h", "b.h", "c.h"));
+}
+
+TEST_F(DependencyScannerTest, KnownOperandShortCircuitsUnknown) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#if 0 && __VERSION__\n#include \"a.h\"\n#endif\n"
+      "#if 1 || __VERSION__\n#include \"b.h\"\n#else\n#include \"c.h\"\n"
+      "#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("b.h"));
+}
+
+TEST_F(DependencyScannerTest, DefinitionsInUnknownBranchesAreUnknown) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#ifdef GL_EXT_foo\n#define HAVE_FOO 1\n#endif\n"
+      "#if HAVE_FOO\n#include \"a.h\"\n#else\n#include \"b.h\"\n#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("a.h", "b.h"));
+}
+
+TEST_F(DependencyScannerTest, MacroBodiesAreExpandedAsTokens) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#define SUM 1 + 2\n#if SUM * 3 == 7\n#include \"a.h\"\n#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("a.h"));
+}
+
+TEST_F(DependencyScannerTest, FunctionLikeMacrosAreUnknown) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#define F(x) (x)\n#if F(0)\n#include \"a.h\"\n#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("a.h"));
+}
+
+TEST_F(DependencyScannerTest, IncludedFilesAreReadOnce) {
+  scanner_.AddFile("guarded.h",
+                   "#ifndef GUARDED_H\n#define GUARDED_H\n"
+                   "#include \"a.h\"\n#endif\n");
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#include \"guarded.h\"\n#include \"guarded.h\"\n"));
+  EXPECT_THAT(scanner_.dependencies(),
+              UnorderedElementsAre("guarded.h", "a.h"));
+  EXPECT_THAT(scanner_.reads["guarded.h"], Eq(1));
+}
+
+TEST_F(DependencyScannerTest, RecursiveIncludeIsBounded) {
+  scanner_.AddFile("self.h", "#ifdef GL_foo\n#include \"self.h\"\n#endif\n");
+  EXPECT_TRUE(scanner_.ScanSource("#include \"self.h\"\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("self.h"));
+}
+
+TEST_F(DependencyScannerTest, MissingIncludeIsAnErrorWhenCompiled) {
+  EXPECT_FALSE(scanner_.ScanSource("\n#include \"missing.h\"\n"));
+  EXPECT_THAT(scanner_.error(), HasSubstr("main.vert:2: error: '#include'"));
+  EXPECT_THAT(scanner_.error(), HasSubstr("missing.h"));
+}
+
+TEST_F(DependencyScannerTest, MissingIncludeIsIgnoredWhenMaybeCompiled) {
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#if __VERSION__ > 100\n#include \"missing.h\"\n#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(), IsEmpty());
+}
+
+TEST_F(DependencyScannerTest, UnbalancedConditionals) {
+  EXPECT_FALSE(scanner_.ScanSource("#if 1\n"));
+  EXPECT_THAT(scanner_.error(), HasSubstr("missing #endif"));
+  EXPECT_FALSE(scanner_.ScanSource("#endif\n"));
+  EXPECT_THAT(scanner_.error(), HasSubstr("missing #if"));
+  EXPECT_FALSE(scanner_.ScanSource("#if 1\n#else\n#elif 1\n#endif\n"));
+  EXPECT_THAT(scanner_.error(), HasSubstr("after #else"));
+}
+
+TEST_F(DependencyScannerTest, ScansAreIndependent) {
+  scanner_.AddMacroDefinition("A", "1");
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#undef A\n#define B\n#include \"a.h\"\n"));
+  EXPECT_TRUE(scanner_.ScanSource(
+      "#if A && !defined(B)\n#include \"b.h\"\n#endif\n"));
+  EXPECT_THAT(scanner_.dependencies(), UnorderedElementsAre("b.h"));
+}
+
+}  // anonymous namespace
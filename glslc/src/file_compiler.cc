@@ -14,11 +14,16 @@
 
 #include "file_compiler.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #if SHADERC_ENABLE_WGSL_OUTPUT == 1
 #include "tint/tint.h"
@@ -29,11 +34,33 @@
 #include "shader_stage.h"
 
 #include "libshaderc_util/io_shaderc.h"
+#include "libshaderc_util/json.h"
 #include "libshaderc_util/message.h"
+#include "libshaderc_util/packed_spirv.h"
+#include "libshaderc_util/trace.h"
 
 namespace {
 using shaderc_util::string_piece;
 
+// The most bytes of optimized modules that the jobs of a batch share.
+const size_t kBatchOptimizerCacheBytes = 256 << 20;
+
+// Returns the given output file name with ".<entry_point_name>" inserted
+// before its extension, or appended if it has none.  Standard output, named
+// "-", is returned as it is.
+std::string InsertEntryPointName(const std::string& file_name,
+                                 const std::string& entry_point_name) {
+  if (file_name == "-") return file_name;
+  const size_t slash_pos = file_name.find_last_of("/\\");
+  const size_t dot_pos = file_name.find_last_of('.');
+  if (dot_pos == std::string::npos ||
+      (slash_pos != std::string::npos && dot_pos < slash_pos)) {
+    return file_name + "." + entry_point_name;
+  }
+  return file_name.substr(0, dot_pos) + "." + entry_point_name +
+         file_name.substr(dot_pos);
+}
+
 // A helper function to emit SPIR-V binary code as a list of hex numbers in
 // text form. Returns true if a non-empty compilation result is emitted
 // successfully. Return false if nothing should be emitted, either because the
@@ -66,10 +93,42 @@ bool EmitSpirvBinaryAsCommaSeparatedNumbers(const CompilationResultType& result,
 }  // anonymous namespace
 
 namespace glslc {
+FileCompiler::FileCompiler(const FileCompiler& other)
+    : compiler_(other.compiler_),
+      options_(other.options_),
+      output_type_(other.output_type_),
+      binary_emission_format_(other.binary_emission_format_),
+      include_file_finder_(other.include_file_finder_),
+      needs_linking_(other.needs_linking_),
+      dependency_info_dumping_handler_(
+          other.dependency_info_dumping_handler_
+              ? new DependencyInfoDumpingHandler(
+                    *other.dependency_info_dumping_handler_)
+              : nullptr),
+      dependency_scan_(other.dependency_scan_),
+      syntax_only_(other.syntax_only_),
+      skip_unchanged_output_(other.skip_unchanged_output_),
+      macro_definitions_(other.macro_definitions_),
+      include_cache_(other.include_cache_),
+      archive_(other.archive_),
+      reflection_(other.reflection_),
+      error_stream_(other.error_stream_),
+      output_stream_(other.output_stream_),
+      file_extension_(other.file_extension_),
+      output_file_name_(other.output_file_name_),
+      total_warnings_(0),
+      total_errors_(0) {}
+
 bool FileCompiler::CompileShaderFile(const InputFileSpec& input_file) {
+  shaderc_util::TraceScope trace_scope("Compile", input_file.name);
   std::vector<char> input_data;
   std::string path = input_file.name;
-  if (!shaderc_util::ReadFile(path, &input_data)) {
+  bool read_success;
+  {
+    shaderc_util::TraceScope read_trace_scope("ReadFile", path);
+    read_success = shaderc_util::ReadFile(path, &input_data);
+  }
+  if (!read_success) {
     return false;
   }
 
@@ -88,7 +147,7 @@ bool FileCompiler::CompileShaderFile(const InputFileSpec& input_file) {
   }
 
   std::unique_ptr<FileIncluder> includer(
-      new FileIncluder(&include_file_finder_));
+      new FileIncluder(&include_file_finder_, include_cache_));
   // Get a reference to the dependency trace before we pass the ownership to
   // shaderc::CompileOptions.
   const auto& used_source_files = includer->file_path_trace();
@@ -98,7 +157,7 @@ bool FileCompiler::CompileShaderFile(const InputFileSpec& input_file) {
     // Only act if the requested target is SPIR-V binary.
     if (output_type_ == OutputType::SpirvBinary) {
       const auto result =
-          compiler_.AssembleToSpv(source_string.data(), source_string.size());
+          compiler_->AssembleToSpv(source_string.data(), source_string.size());
       return EmitCompiledResult(result, input_file.name, output_file_name,
                                 error_file_name, used_source_files);
     } else {
@@ -106,14 +165,24 @@ bool FileCompiler::CompileShaderFile(const InputFileSpec& input_file) {
     }
   }
 
+  if (dependency_scan_) {
+    return ScanDependencies(input_file, source_string, output_file_name,
+                            error_file_name);
+  }
+
   // Set the language.  Since we only use the options object in this
   // method, then it's ok to always set it without resetting it after
   // compilation.  A subsequent compilation will set it again anyway.
   options_.SetSourceLanguage(input_file.language);
 
+  if (!input_file.entry_points.empty() && !PreprocessingOnly()) {
+    return CompileEntryPoints(input_file, source_string, output_file_name,
+                              error_file_name, used_source_files);
+  }
+
   switch (output_type_) {
     case OutputType::SpirvBinary: {
-      const auto result = compiler_.CompileGlslToSpv(
+      const auto result = compiler_->CompileGlslToSpv(
           source_string.data(), source_string.size(), input_file.stage,
           error_file_name.data(), input_file.entry_point_name.c_str(),
           options_);
@@ -121,7 +190,7 @@ bool FileCompiler::CompileShaderFile(const InputFileSpec& input_file) {
                                 error_file_name, used_source_files);
     }
     case OutputType::SpirvAssemblyText: {
-      const auto result = compiler_.CompileGlslToSpvAssembly(
+      const auto result = compiler_->CompileGlslToSpvAssembly(
           source_string.data(), source_string.size(), input_file.stage,
           error_file_name.data(), input_file.entry_point_name.c_str(),
           options_);
@@ -129,7 +198,7 @@ bool FileCompiler::CompileShaderFile(const InputFileSpec& input_file) {
                                 error_file_name, used_source_files);
     }
     case OutputType::PreprocessedText: {
-      const auto result = compiler_.PreprocessGlsl(
+      const auto result = compiler_->PreprocessGlsl(
           source_string.data(), source_string.size(), input_file.stage,
           error_file_name.data(), options_);
       return EmitCompiledResult(result, input_file.name, output_file_name,
@@ -139,6 +208,77 @@ bool FileCompiler::CompileShaderFile(const InputFileSpec& input_file) {
   return false;
 }
 
+bool FileCompiler::CompileProgram(
+    const std::vector<InputFileSpec>& input_files) {
+  shaderc_util::TraceScope trace_scope("CompileProgram",
+                                       input_files.front().name);
+  std::vector<std::vector<char>> input_data(input_files.size());
+  std::vector<std::string> error_file_names;
+  for (size_t i = 0; i < input_files.size(); ++i) {
+    const InputFileSpec& input_file = input_files[i];
+    const std::string error_file_name =
+        input_file.name == "-" ? "<stdin>" : input_file.name;
+    if (input_file.stage == shaderc_spirv_assembly ||
+        !input_file.entry_points.empty()) {
+      *error_stream_ << "glslc: error: '" << error_file_name
+                     << "': cannot be linked with other files" << std::endl;
+      return false;
+    }
+    if (input_file.stage == shaderc_glsl_infer_from_source) {
+      *error_stream_ << "glslc: error: '" << error_file_name
+                     << "': the stage of a linked file must be given by its "
+                        "extension or by -fshader-stage"
+                     << std::endl;
+      return false;
+    }
+    if (input_file.language != input_files.front().language) {
+      *error_stream_ << "glslc: error: linked files must all be in the same "
+                        "source language"
+                     << std::endl;
+      return false;
+    }
+    {
+      shaderc_util::TraceScope read_trace_scope("ReadFile", input_file.name);
+      if (!shaderc_util::ReadFile(input_file.name, &input_data[i])) {
+        return false;
+      }
+    }
+    error_file_names.push_back(error_file_name);
+  }
+
+  std::vector<shaderc_program_stage> stages;
+  for (size_t i = 0; i < input_files.size(); ++i) {
+    stages.push_back({input_data[i].empty() ? "" : &input_data[i].front(),
+                      input_data[i].size(), error_file_names[i].c_str(),
+                      input_files[i].stage,
+                      input_files[i].entry_point_name.c_str()});
+  }
+
+  std::unique_ptr<FileIncluder> includer(
+      new FileIncluder(&include_file_finder_, include_cache_));
+  const auto& used_source_files = includer->file_path_trace();
+  options_.SetIncluder(std::move(includer));
+  options_.SetSourceLanguage(input_files.front().language);
+
+  // Only the first result has the messages of the program, so each one is
+  // emitted once.
+  bool success = true;
+  auto emit_results = [&](const auto& results) {
+    for (size_t i = 0; i < results.size(); ++i) {
+      success &= EmitCompiledResult(
+          results[i], input_files[i].name,
+          GetCandidateOutputFileName(input_files[i].name),
+          error_file_names[i], used_source_files);
+    }
+  };
+  if (output_type_ == OutputType::SpirvAssemblyText) {
+    emit_results(compiler_->CompileProgramToSpvAssembly(stages, options_));
+  } else {
+    emit_results(compiler_->CompileProgramToSpv(stages, options_));
+  }
+  return success;
+}
+
 template <typename CompilationResultType>
 bool FileCompiler::EmitCompiledResult(
     const CompilationResultType& result, const std::string& input_file,
@@ -155,21 +295,21 @@ bool FileCompiler::EmitCompiledResult(
       shaderc_compilation_status_invalid_stage) {
     auto glsl_or_hlsl_extension = GetGlslOrHlslExtension(error_file_name);
     if (glsl_or_hlsl_extension != "") {
-      std::cerr << "glslc: error: "
+      *error_stream_ << "glslc: error: "
                 << "'" << error_file_name << "': "
                 << "." << glsl_or_hlsl_extension
                 << " file encountered but no -fshader-stage specified ahead";
     } else if (error_file_name == "<stdin>") {
-      std::cerr
+      *error_stream_
           << "glslc: error: '-': -fshader-stage required when input is from "
              "standard "
              "input \"-\"";
     } else {
-      std::cerr << "glslc: error: "
+      *error_stream_ << "glslc: error: "
                 << "'" << error_file_name << "': "
                 << "file not recognized: File format not recognized";
     }
-    std::cerr << "\n";
+    *error_stream_ << "\n";
 
     return false;
   }
@@ -202,11 +342,41 @@ bool FileCompiler::EmitCompiledResult(
     }
   }
 
+  if (compilation_success && reflection_ &&
+      !result.GetReflection().empty()) {
+    std::lock_guard<std::mutex> lock(reflection_->mutex);
+    if (!reflection_->entries.emplace(output_file_name, result.GetReflection())
+             .second) {
+      *error_stream_ << "glslc: error: more than one output named '"
+                     << output_file_name << "' in reflection file"
+                     << std::endl;
+      return false;
+    }
+  }
+
+  // A syntax-only compilation has no output of its own, but dependency info
+  // dumped as its output is still written.
+  if (syntax_only_ && !PreprocessingOnly() &&
+      potential_dependency_info_output.empty()) {
+    *error_stream_ << result.GetErrorMessage();
+    return compilation_success;
+  }
+
+  // The output is assembled in memory when it goes into the shader archive,
+  // or when skipping unchanged outputs, in which case it is only written out
+  // if it differs from the existing file.
+  const bool write_if_changed =
+      !archive_ && skip_unchanged_output_ && output_file_name != "-";
+  shaderc_util::TraceScope trace_scope("WriteOutput", output_file_name);
   std::ostream* out = nullptr;
   std::ofstream potential_file_stream;
+  std::ostringstream buffered_output;
   if (compilation_success) {
-    out = shaderc_util::GetOutputStream(output_file_name,
-                                        &potential_file_stream, &std::cerr);
+    if (archive_ || write_if_changed) {
+      out = &buffered_output;
+    } else {
+      out = GetOutputStream(output_file_name, &potential_file_stream);
+    }
     if (!out || out->fail()) {
       // An error message has already been emitted to the stderr stream.
       return false;
@@ -250,6 +420,26 @@ bool FileCompiler::EmitCompiledResult(
           *out << "}" << std::endl;
         }
         break;
+      case SpirvBinaryEmissionFormat::Packed: {
+        // The output format is specified to be packed SPIR-V, the compilation
+        // output must be in SPIR-V binary code form.
+        assert(output_type_ == OutputType::SpirvBinary);
+        std::string packed;
+        std::string error;
+        if (!shaderc_util::PackSpirv(
+                reinterpret_cast<const uint32_t*>(compilation_output.data()),
+                compilation_output.size() / sizeof(uint32_t), &packed,
+                &error)) {
+          *error_stream_ << "glslc: error: cannot pack the output of '"
+                         << error_file_name << "': " << error << std::endl;
+          compilation_success = false;
+          break;
+        }
+        if (out == &std::cout) shaderc_util::FlushAndSetBinaryModeOnStdout();
+        out->write(packed.data(), packed.size());
+        if (out == &std::cout) shaderc_util::FlushAndSetTextModeOnStdout();
+        break;
+      }
       case SpirvBinaryEmissionFormat::WGSL: {
 #if SHADERC_ENABLE_WGSL_OUTPUT == 1
         tint::Context ctx;
@@ -273,27 +463,314 @@ bool FileCompiler::EmitCompiledResult(
     }
   }
 
-  // Write error message to std::cerr.
-  std::cerr << result.GetErrorMessage();
+  // Write error message to the error stream.
+  *error_stream_ << result.GetErrorMessage();
   if (out && out->fail()) {
     // Something wrong happened on output.
     if (out == &std::cout) {
-      std::cerr << "glslc: error: error writing to standard output"
+      *error_stream_ << "glslc: error: error writing to standard output"
                 << std::endl;
     } else {
-      std::cerr << "glslc: error: error writing to output file: '"
+      *error_stream_ << "glslc: error: error writing to output file: '"
                 << output_file_name_ << "'" << std::endl;
     }
     return false;
   }
+  if (compilation_success && archive_) {
+    std::lock_guard<std::mutex> lock(archive_->mutex);
+    if (!archive_->writer.Add(output_file_name, buffered_output.str())) {
+      *error_stream_ << "glslc: error: more than one output named '"
+                     << output_file_name << "' in archive" << std::endl;
+      return false;
+    }
+  }
+  if (compilation_success && write_if_changed &&
+      !shaderc_util::WriteFileIfChanged(output_file_name,
+                                        buffered_output.str(), error_stream_)) {
+    return false;
+  }
 
   return compilation_success;
 }
 
+bool FileCompiler::CompileEntryPoints(
+    const InputFileSpec& input_file, string_piece source,
+    const std::string& output_file_name, string_piece error_file_name,
+    const std::unordered_set<std::string>& used_source_files) {
+  std::vector<shaderc_entry_point> entry_points;
+  for (const auto& entry_point : input_file.entry_points) {
+    entry_points.push_back({entry_point.name.c_str(), entry_point.stage});
+  }
+  bool success = true;
+  auto emit_results = [&](const auto& results) {
+    for (size_t i = 0; i < results.size(); ++i) {
+      success &= EmitCompiledResult(
+          results[i], input_file.name,
+          InsertEntryPointName(output_file_name,
+                               input_file.entry_points[i].name),
+          error_file_name, used_source_files);
+    }
+  };
+  if (output_type_ == OutputType::SpirvAssemblyText) {
+    emit_results(compiler_->CompileGlslEntryPointsToSpvAssembly(
+        source.str(), entry_points, error_file_name.data(), options_));
+  } else {
+    emit_results(compiler_->CompileGlslEntryPointsToSpv(
+        source.str(), entry_points, error_file_name.data(), options_));
+  }
+  return success;
+}
+
+bool FileCompiler::ScanDependencies(const InputFileSpec& input_file,
+                                    string_piece source,
+                                    const std::string& output_file_name,
+                                    string_piece error_file_name) {
+  if (!dependency_scanner_) {
+    dependency_scanner_.reset(new DependencyScanner(&include_file_finder_));
+    for (const auto& macro : macro_definitions_) {
+      dependency_scanner_->AddMacroDefinition(macro.first, macro.second);
+    }
+  }
+
+  std::string error_message;
+  if (!dependency_scanner_->Scan(error_file_name.str(), source,
+                                 &error_message)) {
+    *error_stream_ << error_message << std::endl;
+    ++total_errors_;
+    return false;
+  }
+
+  std::string dependency_info;
+  if (!dependency_info_dumping_handler_->DumpDependencyInfo(
+          GetCandidateOutputFileName(input_file.name), error_file_name.data(),
+          &dependency_info, dependency_scanner_->dependencies())) {
+    return false;
+  }
+
+  if (skip_unchanged_output_ && output_file_name != "-") {
+    return shaderc_util::WriteFileIfChanged(output_file_name, dependency_info,
+                                            error_stream_);
+  }
+
+  std::ofstream potential_file_stream;
+  std::ostream* out = GetOutputStream(output_file_name, &potential_file_stream);
+  if (!out || out->fail()) {
+    // An error message has already been emitted to the stderr stream.
+    return false;
+  }
+  out->write(dependency_info.data(), dependency_info.size());
+  if (out->fail()) {
+    if (out == &std::cout) {
+      *error_stream_ << "glslc: error: error writing to standard output"
+                << std::endl;
+    } else {
+      *error_stream_ << "glslc: error: error writing to output file: '"
+                << output_file_name << "'" << std::endl;
+    }
+    return false;
+  }
+  return true;
+}
+
+std::ostream* FileCompiler::GetOutputStream(
+    const std::string& output_file_name, std::ofstream* file_stream) {
+  if (output_file_name == "-") return output_stream_;
+  return shaderc_util::GetOutputStream(output_file_name, file_stream,
+                                       error_stream_);
+}
+
+bool FileCompiler::WriteArchive() {
+  if (!archive_) return true;
+  shaderc_util::TraceScope trace_scope("WriteArchive", archive_->file_name);
+  const std::string archive = archive_->writer.Serialize();
+  if (skip_unchanged_output_) {
+    return shaderc_util::WriteFileIfChanged(archive_->file_name, archive,
+                                            &std::cerr);
+  }
+  std::ofstream potential_file_stream;
+  std::ostream* out = shaderc_util::GetOutputStream(
+      archive_->file_name, &potential_file_stream, &std::cerr);
+  if (!out || out->fail()) return false;
+  if (out == &std::cout) shaderc_util::FlushAndSetBinaryModeOnStdout();
+  const bool written = shaderc_util::WriteFile(out, archive);
+  if (out == &std::cout) shaderc_util::FlushAndSetTextModeOnStdout();
+  if (!written) {
+    std::cerr << "glslc: error: error writing to archive file: '"
+              << archive_->file_name << "'" << std::endl;
+  }
+  return written;
+}
+
+bool FileCompiler::WriteReflection() {
+  if (!reflection_) return true;
+  shaderc_util::TraceScope trace_scope("WriteReflection",
+                                       reflection_->file_name);
+  std::ostringstream json;
+  json << "{";
+  const char* separator = "\n";
+  for (const auto& entry : reflection_->entries) {
+    json << separator;
+    shaderc_util::WriteJsonString(&json, entry.first);
+    // Each description is a JSON object that ends with a newline.
+    const std::string& description = entry.second;
+    json << ": ";
+    json.write(description.data(),
+               description.size() - (description.back() == '\n' ? 1 : 0));
+    separator = ",\n";
+  }
+  json << "\n}\n";
+  if (skip_unchanged_output_) {
+    return shaderc_util::WriteFileIfChanged(reflection_->file_name,
+                                            json.str(), &std::cerr);
+  }
+  std::ofstream potential_file_stream;
+  std::ostream* out = shaderc_util::GetOutputStream(
+      reflection_->file_name, &potential_file_stream, &std::cerr);
+  if (!out || out->fail()) return false;
+  *out << json.str();
+  if (out->fail()) {
+    std::cerr << "glslc: error: error writing to reflection file: '"
+              << reflection_->file_name << "'" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool FileCompiler::CompileBatch(const std::vector<BatchJob>& jobs,
+                                unsigned num_threads) {
+  IncludeCache include_cache;
+  shaderc::OptimizerCache optimizer_cache(kBatchOptimizerCacheBytes);
+  std::atomic_size_t next_job;
+  next_job.store(0);
+  // Protects the writes to *error_stream_ and the members below, as well as
+  // success.
+  std::mutex mutex;
+  bool success = true;
+  // The JSON database entries of each job, merged in job order at the end.
+  std::vector<std::unique_ptr<DependencyInfoDumpingHandler>> job_handlers(
+      jobs.size());
+  // The output of each job to standard output, such as preprocessed source or
+  // dependency rules, written in job order at the end.
+  std::vector<std::string> job_outputs(jobs.size());
+
+  auto worker = [&]() {
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++) {
+      std::ostringstream job_errors;
+      std::ostringstream job_output;
+      FileCompiler job_compiler(*this);
+      job_compiler.include_cache_ = &include_cache;
+      job_compiler.options_.SetOptimizerCache(&optimizer_cache);
+      job_compiler.error_stream_ = &job_errors;
+      job_compiler.output_stream_ = &job_output;
+      const bool job_success = job_compiler.CompileBatchJob(jobs[i]);
+      job_outputs[i] = job_output.str();
+
+      std::lock_guard<std::mutex> lock(mutex);
+      *error_stream_ << job_errors.str();
+      total_warnings_ += job_compiler.total_warnings_;
+      total_errors_ += job_compiler.total_errors_;
+      job_handlers[i] =
+          std::move(job_compiler.dependency_info_dumping_handler_);
+      success &= job_success;
+    }
+  };
+
+  if (num_threads < 1) num_threads = 1;
+  if (num_threads > jobs.size()) num_threads = unsigned(jobs.size());
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < num_threads; ++i) {
+    threads.emplace_back([&worker, i]() {
+      shaderc_util::SetTraceThreadName("worker " + std::to_string(i));
+      worker();
+    });
+  }
+  worker();
+  for (auto& thread : threads) thread.join();
+
+  // The output may be binary SPIR-V, so it is written as it is.
+  if (std::any_of(job_outputs.begin(), job_outputs.end(),
+                  [](const std::string& output) { return !output.empty(); })) {
+    shaderc_util::FlushAndSetBinaryModeOnStdout();
+    for (const std::string& output : job_outputs) {
+      output_stream_->write(output.data(), output.size());
+    }
+    shaderc_util::FlushAndSetTextModeOnStdout();
+    if (output_stream_->fail()) {
+      *error_stream_ << "glslc: error: error writing to standard output"
+                     << std::endl;
+      success = false;
+    }
+  }
+
+  if (dependency_info_dumping_handler_) {
+    for (auto& handler : job_handlers) {
+      if (handler) {
+        dependency_info_dumping_handler_->AppendJsonDatabaseEntries(
+            handler.get());
+      }
+    }
+  }
+  return success;
+}
+
+bool FileCompiler::Prewarm(const std::vector<InputFileSpec>& input_files,
+                           const std::vector<int>& versions) {
+  shaderc_util::TraceScope trace_scope("Prewarm");
+  std::map<shaderc_source_language, std::vector<shaderc_shader_kind>> stages;
+  for (const auto& input_file : input_files) {
+    if (input_file.stage == shaderc_glsl_infer_from_source ||
+        input_file.stage == shaderc_spirv_assembly) {
+      continue;
+    }
+    auto& language_stages = stages[input_file.language];
+    if (std::find(language_stages.begin(), language_stages.end(),
+                  input_file.stage) == language_stages.end()) {
+      language_stages.push_back(input_file.stage);
+    }
+  }
+  for (const auto& language_stages : stages) {
+    options_.SetSourceLanguage(language_stages.first);
+    if (!compiler_->Prewarm(options_, language_stages.second, versions)) {
+      *error_stream_ << "glslc: error: cannot build built-in symbol tables "
+                        "with the given options"
+                     << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FileCompiler::CompileBatchJob(const BatchJob& job) {
+  for (const auto& macro : job.macro_definitions) {
+    AddMacroDefinition(macro.first, macro.second);
+  }
+  for (const auto& dir : job.include_directories) {
+    AddIncludeDirectory(dir);
+  }
+  if (!job.output_file_name.empty()) {
+    output_file_name_ = job.output_file_name;
+  }
+  if (!job.dependency_file_name.empty()) {
+    DependencyInfoDumpingHandler* handler = GetDependencyDumpingHandler();
+    if (handler->DumpingModeNotSet()) {
+      handler->SetDumpToExtraDependencyInfoFiles();
+    }
+    handler->SetDependencyFileName(job.dependency_file_name);
+  }
+  return CompileShaderFile(job.input_file);
+}
+
 void FileCompiler::AddIncludeDirectory(const std::string& path) {
   include_file_finder_.search_path().push_back(path);
 }
 
+void FileCompiler::AddMacroDefinition(const string_piece& name,
+                                      const string_piece& value) {
+  options_.AddMacroDefinition(name.data(), name.size(), value.data(),
+                              value.size());
+  macro_definitions_.emplace_back(name.str(), value.str());
+}
+
 void FileCompiler::SetIndividualCompilationFlag() {
   if (output_type_ != OutputType::SpirvAssemblyText) {
     needs_linking_ = false;
@@ -309,6 +786,12 @@ void FileCompiler::SetDisassemblyFlag() {
   }
 }
 
+void FileCompiler::SetSyntaxOnlyFlag(shaderc_syntax_only_mode mode) {
+  syntax_only_ = true;
+  needs_linking_ = false;
+  options_.SetSyntaxOnly(mode);
+}
+
 void FileCompiler::SetPreprocessingOnlyFlag() {
   output_type_ = OutputType::PreprocessedText;
   needs_linking_ = false;
@@ -323,17 +806,10 @@ bool FileCompiler::ValidateOptions(size_t num_files) {
     return false;
   }
 
-  if (num_files > 1 && needs_linking_) {
-    std::cerr << "glslc: error: linking multiple files is not supported yet. "
-                 "Use -c to compile files individually."
-              << std::endl;
-    return false;
-  }
-
-  // If we are outputting many object files, we cannot specify -o. Also
-  // if we are preprocessing multiple files they must be to stdout.
-  if (num_files > 1 && ((!PreprocessingOnly() && !needs_linking_ &&
-                         !output_file_name_.empty()) ||
+  // If we are outputting many object files, or linking many files, each of
+  // which has an output of its own, we cannot specify -o. Also if we are
+  // preprocessing multiple files they must be to stdout.
+  if (num_files > 1 && ((!PreprocessingOnly() && !output_file_name_.empty()) ||
                         (PreprocessingOnly() && output_file_name_ != "-"))) {
     std::cerr << "glslc: error: cannot specify -o when generating multiple"
                  " output files"
@@ -353,6 +829,13 @@ bool FileCompiler::ValidateOptions(size_t num_files) {
     }
   }
 
+  if (dependency_scan_ && !(dependency_info_dumping_handler_ &&
+                            dependency_info_dumping_handler_
+                                ->DumpingAsCompilationOutput())) {
+    std::cerr << "glslc: error: -fdeps-scan requires -M or -MM" << std::endl;
+    return false;
+  }
+
   // If the output format is specified to be a binary, a list of hex numbers or
   // a C-style initializer list, the output must be in SPIR-V binary code form.
   if (binary_emission_format_ != SpirvBinaryEmissionFormat::Unspecified) {
@@ -368,6 +851,9 @@ bool FileCompiler::ValidateOptions(size_t num_files) {
         case SpirvBinaryEmissionFormat::CInitList:
           std::cerr << "C-style initializer list";
           break;
+        case SpirvBinaryEmissionFormat::Packed:
+          std::cerr << "packed binary";
+          break;
         case SpirvBinaryEmissionFormat::WGSL:
           std::cerr << "WGSL source program";
           break;
@@ -388,6 +874,18 @@ bool FileCompiler::ValidateOptions(size_t num_files) {
     }
   }
 
+  if (archive_ && (output_type_ != OutputType::SpirvBinary ||
+                   (binary_emission_format_ !=
+                        SpirvBinaryEmissionFormat::Unspecified &&
+                    binary_emission_format_ !=
+                        SpirvBinaryEmissionFormat::Binary &&
+                    binary_emission_format_ !=
+                        SpirvBinaryEmissionFormat::Packed))) {
+    std::cerr << "glslc: error: -farchive requires SPIR-V binary output"
+              << std::endl;
+    return false;
+  }
+
   if (binary_emission_format_ == SpirvBinaryEmissionFormat::WGSL) {
 #if SHADERC_ENABLE_WGSL_OUTPUT != 1
     std::cerr << "glslc: error: can't output WGSL: glslc was built without "
@@ -15,22 +15,56 @@
 #ifndef GLSLC_FILE_COMPILER_H
 #define GLSLC_FILE_COMPILER_H
 
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "libshaderc_util/file_finder.h"
+#include "libshaderc_util/shader_archive.h"
 #include "libshaderc_util/string_piece.h"
 #include "shaderc/shaderc.hpp"
 
 #include "dependency_info.h"
+#include "dependency_scanner.h"
+#include "include_cache.h"
 
 namespace glslc {
 
+// Describes one of several entry points to compile from an input file.
+struct EntryPointSpec {
+  std::string name;
+  shaderc_shader_kind stage;
+};
+
 // Describes an input file to be compiled.
 struct InputFileSpec {
   std::string name;
   shaderc_shader_kind stage;
   shaderc_source_language language;
   std::string entry_point_name;
+  // If not empty, each of these entry points is compiled into an output of
+  // its own, instead of entry_point_name as stage.
+  std::vector<EntryPointSpec> entry_points;
+};
+
+// Describes one compilation of a batch, with the settings that it adds to
+// or overrides in the settings of the whole batch.
+struct BatchJob {
+  InputFileSpec input_file;
+  // The output file name, or an empty string for the default name.
+  std::string output_file_name;
+  // The name of a make dependency file to write, as if by -MD -MF, or an
+  // empty string.
+  std::string dependency_file_name;
+  // Macros to predefine, as if by -Dname=value.
+  std::vector<std::pair<std::string, std::string>> macro_definitions;
+  // Directories to search for #include files, after those of the batch.
+  std::vector<std::string> include_directories;
 };
 
 // Context for managing compilation of source GLSL files into destination
@@ -47,15 +81,31 @@ class FileCompiler {
                   // of hex numbers.
     WGSL,         // Emits SPIR-V module converted to WGSL source text.
                   // Requires a build with Tint support.
+    Packed,       // Emits SPIR-V binary code as packed SPIR-V, see
+                  // libshaderc_util/packed_spirv.h.
   };
 
   FileCompiler()
-      : output_type_(OutputType::SpirvBinary),
+      : compiler_(std::make_shared<shaderc::Compiler>()),
+        output_type_(OutputType::SpirvBinary),
         binary_emission_format_(SpirvBinaryEmissionFormat::Unspecified),
         needs_linking_(true),
+        dependency_scan_(false),
+        syntax_only_(false),
+        skip_unchanged_output_(false),
+        include_cache_(nullptr),
+        error_stream_(&std::cerr),
+        output_stream_(&std::cout),
         total_warnings_(0),
         total_errors_(0) {}
 
+  // Creates a compiler with the same settings as other, for compiling one job
+  // of a batch.  The new compiler has its own message counts, starting at
+  // zero, and shares the shaderc compiler of other, with the compile
+  // contexts it keeps, since that is safe to use from several threads.
+  FileCompiler(const FileCompiler& other);
+  FileCompiler& operator=(const FileCompiler&) = delete;
+
   // Compiles a shader received as specified by input_file, returning true
   // on success and false otherwise. If force_shader_stage is not
   // shaderc_glsl_infer_source or any default shader stage then the given
@@ -72,6 +122,29 @@ class FileCompiler {
   // and increment the counts reported by OutputMessages().
   bool CompileShaderFile(const InputFileSpec& input_file);
 
+  // Compiles the given input files, each one a different stage, and links
+  // them as one program.  Each stage's SPIR-V goes into an output file named
+  // after its input file, as with -c.  Outputs that the next stage does not
+  // read are removed from each stage.  Returns true if every stage compiles
+  // and the program links.
+  bool CompileProgram(const std::vector<InputFileSpec>& input_files);
+
+  // Compiles each of the given jobs as if by CompileShaderFile(), with the
+  // settings of this compiler plus those of the job.  Up to num_threads jobs
+  // are compiled at the same time, sharing one IncludeCache and one
+  // shaderc::OptimizerCache.  The messages of each job are written to
+  // std::cerr together once the job is done, and are counted for
+  // OutputMessages().  Returns true if all jobs succeed.
+  bool CompileBatch(const std::vector<BatchJob>& jobs, unsigned num_threads);
+
+  // Builds the built-in symbol tables for the stage and source language of
+  // each of the given input files at each of the given GLSL versions, so that
+  // the first compilations of such files do not have to.  An empty versions
+  // list means the forced version, if any.  Input files that take their stage
+  // from their source are skipped.  Returns true on success.
+  bool Prewarm(const std::vector<InputFileSpec>& input_files,
+               const std::vector<int>& versions);
+
   // Adds a directory to be searched when processing #include directives.
   //
   // Best practice: if you add an empty string before any other path, that will
@@ -79,6 +152,11 @@ class FileCompiler {
   // working directory.
   void AddIncludeDirectory(const std::string& path);
 
+  // Adds a predefined macro, as if by -Dname=value.  The macro is passed to
+  // the compiler options, and also to the dependency scanner.
+  void AddMacroDefinition(const shaderc_util::string_piece& name,
+                          const shaderc_util::string_piece& value);
+
   // Sets the output filename. A name of "-" indicates standard output.
   void SetOutputFileName(const shaderc_util::string_piece& file) {
     output_file_name_ = file;
@@ -93,6 +171,10 @@ class FileCompiler {
   // represents the number of files that will be compiled.
   bool ValidateOptions(size_t num_files);
 
+  // Returns true if several input files are linked together into a program,
+  // rather than compiled individually.
+  bool NeedsLinking() const { return needs_linking_; }
+
   // Outputs to std::cerr the number of warnings and errors if there are any.
   void OutputMessages();
 
@@ -116,6 +198,56 @@ class FileCompiler {
   // overrides disassembly mode and individual compilation mode.
   void SetPreprocessingOnlyFlag();
 
+  // Sets the flag to indicate syntax-only mode, which checks the input files
+  // as far as the given mode says, and reports diagnostics, but writes no
+  // output files.  This method also disables linking.  Preprocessing only
+  // mode overrides this mode.
+  void SetSyntaxOnlyFlag(shaderc_syntax_only_mode mode);
+
+  // Sets the flag to indicate dependency scanning mode. In this mode, which
+  // requires dumping dependency info as compilation output (-M or -MM), the
+  // dependencies are found by a DependencyScanner, which only looks at
+  // preprocessor directives, instead of by preprocessing the source.
+  void SetDependencyScanFlag() { dependency_scan_ = true; }
+
+  // Sets the flag to leave output files untouched when their contents would
+  // not change, and to replace changed output files atomically.  Does not
+  // apply to output written to standard output.
+  void SetSkipUnchangedOutputFlag() { skip_unchanged_output_ = true; }
+
+  // Sets the name of a shader archive file that compilation outputs go into,
+  // instead of into files of their own.  Each output becomes an archive entry
+  // named by the output file name it would otherwise have been written to.
+  void SetArchiveFileName(const std::string& file_name) {
+    archive_ = std::make_shared<ArchiveOutput>();
+    archive_->file_name = file_name;
+  }
+
+  // Writes the shader archive, if one was requested.  Returns true on
+  // success, or if there is nothing to write.
+  bool WriteArchive();
+
+  // Sets the name of a JSON file that the reflection of the compiled shaders
+  // is written to, as an object with a member for each output, named by its
+  // output file name.  See shaderc_result_get_reflection for the description
+  // of each shader.
+  void SetReflectionFileName(const std::string& file_name) {
+    reflection_ = std::make_shared<ReflectionOutput>();
+    reflection_->file_name = file_name;
+    options_.SetGenerateReflection(true);
+  }
+
+  // Writes the reflection file, if one was requested.  Returns true on
+  // success, or if there is nothing to write.
+  bool WriteReflection();
+
+  // Writes the JSON dependency database, if one was requested. Returns true
+  // on success, or if there is nothing to write.
+  bool WriteDependencyDatabase() {
+    return !dependency_info_dumping_handler_ ||
+           dependency_info_dumping_handler_->WriteJsonDatabase();
+  }
+
   // Gets the reference of the compiler options which reflects the command-line
   // arguments.
   shaderc::CompileOptions& options() { return options_; }
@@ -149,6 +281,35 @@ class FileCompiler {
       shaderc_util::string_piece error_file_name,
       const std::unordered_set<std::string>& used_source_files);
 
+  // Applies the settings of the given job to this compiler, then compiles
+  // its input file.
+  bool CompileBatchJob(const BatchJob& job);
+
+  // Compiles each of the entry points of the given input file, from one
+  // preprocessing of its source, and emits each result to the output file
+  // whose name is output_file_name with the entry point name inserted before
+  // its extension.  Returns true if all entry points compile.
+  bool CompileEntryPoints(
+      const InputFileSpec& input_file, shaderc_util::string_piece source,
+      const std::string& output_file_name,
+      shaderc_util::string_piece error_file_name,
+      const std::unordered_set<std::string>& used_source_files);
+
+  // Finds the dependencies of the given source with the dependency scanner,
+  // and writes them as make rules to the output file.  Returns true on
+  // success.  Otherwise emits an error message to the standard error stream,
+  // and returns false.
+  bool ScanDependencies(const InputFileSpec& input_file,
+                        shaderc_util::string_piece source,
+                        const std::string& output_file_name,
+                        shaderc_util::string_piece error_file_name);
+
+  // Returns the stream to write the output file of the given name to, as
+  // shaderc_util::GetOutputStream() does, except that the name "-" stands
+  // for output_stream_.
+  std::ostream* GetOutputStream(const std::string& output_file_name,
+                                std::ofstream* file_stream);
+
   // Returns the final file name to be used for the output file.
   //
   // If an output file name is specified by the SetOutputFileName(), use that
@@ -197,7 +358,8 @@ class FileCompiler {
   }
 
   // Performs actual SPIR-V compilation on the contents of input files.
-  shaderc::Compiler compiler_;
+  // Shared by the compilers of the jobs of a batch.
+  std::shared_ptr<shaderc::Compiler> compiler_;
 
   // Reflects the command-line arguments and goes into
   // compiler_.CompileGlslToSpv().
@@ -220,6 +382,55 @@ class FileCompiler {
   std::unique_ptr<DependencyInfoDumpingHandler>
       dependency_info_dumping_handler_ = nullptr;
 
+  // Indicates whether dependencies are found by scanning directives only.
+  bool dependency_scan_;
+
+  // Indicates whether only diagnostics are wanted, and no output files.
+  bool syntax_only_;
+
+  // A flag for whether output files are only rewritten when their contents
+  // change.
+  bool skip_unchanged_output_;
+
+  // The dependency scanner, created on first use.  It keeps the contents of
+  // included files across input files.
+  std::unique_ptr<DependencyScanner> dependency_scanner_;
+
+  // The macros added by AddMacroDefinition(), for the dependency scanner.
+  std::vector<std::pair<std::string, std::string>> macro_definitions_;
+
+  // The cache used by includers, or nullptr to read include files directly.
+  IncludeCache* include_cache_;
+
+  // The shader archive that outputs are collected into, or nullptr to write
+  // outputs to files of their own.  It is shared with the compilers of batch
+  // jobs, which may add to it concurrently.
+  struct ArchiveOutput {
+    std::string file_name;
+    std::mutex mutex;
+    shaderc_util::ShaderArchiveWriter writer;
+  };
+  std::shared_ptr<ArchiveOutput> archive_;
+
+  // The reflection of each output, by output file name, or nullptr if no
+  // reflection file was requested.  It is shared with the compilers of batch
+  // jobs, as the archive is.
+  struct ReflectionOutput {
+    std::string file_name;
+    std::mutex mutex;
+    std::map<std::string, std::string> entries;
+  };
+  std::shared_ptr<ReflectionOutput> reflection_;
+
+  // Where error messages and warnings go.  This is std::cerr, except for the
+  // compilers of batch jobs, whose messages are buffered.
+  std::ostream* error_stream_;
+
+  // Where the output to standard output goes.  This is std::cout, except for
+  // the compilers of batch jobs, whose output is buffered, and written in job
+  // order once every job is done.
+  std::ostream* output_stream_;
+
   // Reflects the type of file being generated.
   std::string file_extension_;
   // Name of the file where the compilation output will go.
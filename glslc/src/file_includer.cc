@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "libshaderc_util/io_shaderc.h"
+#include "libshaderc_util/trace.h"
 
 namespace glslc {
 
@@ -31,11 +32,16 @@ shaderc_include_result* FileIncluder::GetInclude(
     const char* requested_source, shaderc_include_type include_type,
     const char* requesting_source, size_t) {
 
-  const std::string full_path =
-      (include_type == shaderc_include_type_relative)
-          ? file_finder_.FindRelativeReadableFilepath(requesting_source,
-                                                      requested_source)
-          : file_finder_.FindReadableFilepath(requested_source);
+  std::string full_path;
+  if (include_cache_) {
+    full_path = include_cache_->FindIncludeFile(
+        file_finder_, include_type, requesting_source, requested_source);
+  } else {
+    full_path = (include_type == shaderc_include_type_relative)
+                    ? file_finder_.FindRelativeReadableFilepath(
+                          requesting_source, requested_source)
+                    : file_finder_.FindReadableFilepath(requested_source);
+  }
 
   if (full_path.empty())
     return MakeErrorIncludeResult("Cannot find or open include file.");
@@ -44,16 +50,26 @@ shaderc_include_result* FileIncluder::GetInclude(
   // time.  Protect the included_files.
 
   // Read the file and save its full path and contents into stable addresses.
-  FileInfo* new_file_info = new FileInfo{full_path, {}};
-  if (!shaderc_util::ReadFile(full_path, &(new_file_info->contents))) {
+  std::shared_ptr<const std::vector<char>> contents;
+  shaderc_util::TraceScope trace_scope("ReadInclude", full_path);
+  if (include_cache_) {
+    contents = include_cache_->ReadFile(full_path);
+  } else {
+    auto file_contents = std::make_shared<std::vector<char>>();
+    if (shaderc_util::ReadFile(full_path, file_contents.get())) {
+      contents = std::move(file_contents);
+    }
+  }
+  if (!contents) {
     return MakeErrorIncludeResult("Cannot read file");
   }
+  FileInfo* new_file_info = new FileInfo{full_path, std::move(contents)};
 
   included_files_.insert(full_path);
 
   return new shaderc_include_result{
       new_file_info->full_path.data(), new_file_info->full_path.length(),
-      new_file_info->contents.data(), new_file_info->contents.size(),
+      new_file_info->contents->data(), new_file_info->contents->size(),
       new_file_info};
 }
 
@@ -15,6 +15,7 @@
 #ifndef GLSLC_FILE_INCLUDER_H_
 #define GLSLC_FILE_INCLUDER_H_
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -26,6 +27,8 @@
 #include "libshaderc_util/file_finder.h"
 #include "shaderc/shaderc.hpp"
 
+#include "include_cache.h"
+
 namespace glslc {
 
 // An includer for files implementing shaderc's includer interface. It responds
@@ -36,8 +39,11 @@ namespace glslc {
 // This class provides the basic thread-safety guarantee.
 class FileIncluder : public shaderc::CompileOptions::IncluderInterface {
  public:
-  explicit FileIncluder(const shaderc_util::FileFinder* file_finder)
-      : file_finder_(*file_finder) {}
+  // If include_cache is not null, file lookups and contents are taken from
+  // it, and it must outlive this includer.
+  explicit FileIncluder(const shaderc_util::FileFinder* file_finder,
+                        IncludeCache* include_cache = nullptr)
+      : file_finder_(*file_finder), include_cache_(include_cache) {}
 
   ~FileIncluder() override;
 
@@ -59,10 +65,12 @@ class FileIncluder : public shaderc::CompileOptions::IncluderInterface {
  private:
   // Used by GetInclude() to get the full filepath.
   const shaderc_util::FileFinder& file_finder_;
+  // The cache shared with other includers, or nullptr.
+  IncludeCache* include_cache_;
   // The full path and content of a source file.
   struct FileInfo {
     const std::string full_path;
-    std::vector<char> contents;
+    std::shared_ptr<const std::vector<char>> contents;
   };
 
   // The set of full paths of included files.
@@ -0,0 +1,80 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "include_cache.h"
+
+#include <utility>
+
+#include "libshaderc_util/io_shaderc.h"
+
+namespace glslc {
+
+std::string IncludeCache::FindIncludeFile(
+    const shaderc_util::FileFinder& finder, shaderc_include_type type,
+    const std::string& requesting_file, const std::string& requested_file) {
+  // A relative include is resolved against the directory of the requesting
+  // file, so only that part of its name is significant.
+  std::string key;
+  for (const auto& dir : finder.search_path()) {
+    key += dir;
+    key += '\0';
+  }
+  key += '\0';
+  if (type == shaderc_include_type_relative) {
+    const size_t last_slash = requesting_file.find_last_of("/\\");
+    key += '"';
+    if (last_slash != std::string::npos) {
+      key.append(requesting_file, 0, last_slash);
+    }
+    key += '\0';
+  } else {
+    key += '<';
+  }
+  key += requested_file;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = full_paths_.find(key);
+    if (it != full_paths_.end()) return it->second;
+  }
+
+  // Search without holding the lock.  Two threads may race to search for the
+  // same file, but they find the same result.
+  std::string full_path =
+      (type == shaderc_include_type_relative)
+          ? finder.FindRelativeReadableFilepath(requesting_file,
+                                                requested_file)
+          : finder.FindReadableFilepath(requested_file);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  full_paths_.emplace(std::move(key), full_path);
+  return full_path;
+}
+
+std::shared_ptr<const std::vector<char>> IncludeCache::ReadFile(
+    const std::string& full_path) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = contents_.find(full_path);
+    if (it != contents_.end()) return it->second;
+  }
+
+  auto contents = std::make_shared<std::vector<char>>();
+  if (!shaderc_util::ReadFile(full_path, contents.get())) return nullptr;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // If another thread read the file first, share its copy.
+  return contents_.emplace(full_path, std::move(contents)).first->second;
+}
+
+}  // namespace glslc
@@ -0,0 +1,60 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GLSLC_INCLUDE_CACHE_H_
+#define GLSLC_INCLUDE_CACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "libshaderc_util/file_finder.h"
+#include "shaderc/shaderc.h"
+
+namespace glslc {
+
+// Remembers where include files were found and what they contain, so that
+// many compilations in one process search the file system and read each file
+// only once.  Files are assumed not to change while the cache is in use.
+// This class is thread-safe.
+class IncludeCache {
+ public:
+  // Returns the full path of the file requested by an #include directive in
+  // requesting_file, as found by the given file finder, or an empty string if
+  // it cannot be found.  The search is done once for each combination of
+  // search path, include type, directory of requesting_file and
+  // requested_file.
+  std::string FindIncludeFile(const shaderc_util::FileFinder& finder,
+                              shaderc_include_type type,
+                              const std::string& requesting_file,
+                              const std::string& requested_file);
+
+  // Returns the contents of the file at full_path, reading it on the first
+  // request only.  Returns nullptr if the file cannot be read.
+  std::shared_ptr<const std::vector<char>> ReadFile(
+      const std::string& full_path);
+
+ private:
+  std::mutex mutex_;
+  // Maps a lookup key built by FindIncludeFile() to the full path found.
+  std::unordered_map<std::string, std::string> full_paths_;
+  // Maps full paths to file contents.
+  std::unordered_map<std::string, std::shared_ptr<const std::vector<char>>>
+      contents_;
+};
+
+}  // namespace glslc
+
+#endif  // GLSLC_INCLUDE_CACHE_H_
@@ -12,24 +12,32 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <cstdint>
 #include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <list>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 
+#include "batch.h"
 #include "file.h"
 #include "file_compiler.h"
 #include "libshaderc_util/args.h"
 #include "libshaderc_util/compiler.h"
 #include "libshaderc_util/io_shaderc.h"
+#include "libshaderc_util/json.h"
+#include "libshaderc_util/spirv_tools_wrapper.h"
 #include "libshaderc_util/string_piece.h"
+#include "libshaderc_util/trace.h"
+#include "libshaderc_util/version_profile.h"
 #include "resource_parse.h"
 #include "shader_stage.h"
 #include "shaderc/env.h"
@@ -49,10 +57,19 @@ Usage: glslc [options] file...
 An input file of - represents standard input.
 
 Options:
+  --batch=<manifest>
+                    Compile the jobs described by the given JSON manifest,
+                    instead of input files, in parallel.  Each job may set its
+                    own input, output, stage, entry point, language, macros,
+                    include directories and dependency file, and otherwise
+                    uses the other options.  Implies -c.
   -c                Only run preprocess, compile, and assemble steps.
   -Dmacro[=defn]    Add an implicit macro definition.
   -E                Outputs only the results of the preprocessing step.
                     Output defaults to standard output.
+  -farchive=<file>  Write all compiled SPIR-V modules into a single indexed
+                    shader archive file, as entries named by their output
+                    file names, instead of into files of their own.
   -fauto-bind-uniforms
                     Automatically assign bindings to uniform variables that
                     don't have an explicit 'binding' layout in the shader
@@ -64,9 +81,24 @@ Options:
   -fauto-combined-image-sampler
                     Removes sampler variables and converts existing textures
                     to combined image-samplers.
+  -fcompile-for-linking
+                    Compile into SPIR-V modules to be linked with others, such
+                    as libraries for -flink-library: defined functions are
+                    exported, functions that are only declared are imported,
+                    and no entry point is needed.  Such modules are not
+                    validated.
+  -fdeps-scan       With -M or -MM, find dependencies by scanning only the
+                    preprocessor directives instead of fully preprocessing
+                    the source. Both branches of a conditional are followed
+                    unless its condition can be evaluated.
   -fentry-point=<name>
                     Specify the entry point name for HLSL compilation, for
                     all subsequent source files.  Default is "main".
+  -fentry-point=<name>:<stage>[,<name>:<stage>...]
+                    Compile each of the given entry points of all subsequent
+                    source files, as the given stage, into an output file of
+                    its own.  Each source file is preprocessed once, and its
+                    entry points are compiled in parallel.
   -fhlsl-16bit-types
                     Enable 16-bit type support for HLSL.
   -fhlsl_functionality1, -fhlsl-functionality1
@@ -83,13 +115,45 @@ Options:
                     several times, only the last setting takes effect.
   -flimit-file <file>
                     Set limits as specified in the given file.
+  -flink-library=<file>
+                    Link each compiled shader with the SPIR-V library in the
+                    given file, compiled with -fcompile-for-linking, so that
+                    the functions the shader declares are taken from it.  The
+                    library functions that the shader does not call are then
+                    removed.  May be given several times.
+  -fmacro-spec-constant=<macro>[=<id>]
+                    Make the -D macro <macro> a specialization constant with
+                    SpecId <id>, or by default with the SpecId after that of
+                    the previous such macro, starting at 0.  The macro expands
+                    to the constant wherever it is used as a value, so that
+                    one module serves every value of the macro.  Using it in
+                    #if expressions or layout qualifiers is an error.
+  -fmacro-spec-map=<file>
+                    Write the SpecIds of the macros given to
+                    -fmacro-spec-constant to the given file, as a JSON object.
   -fnan-clamp       Generate code for max and min builtins so that, when given
                     a NaN operand, the other operand is returned. Similarly,
                     the clamp builtin will favour the non-NaN operands, as if
                     clamp were implemented as a composition of max and min.
+  -fpreprocessed    Treat the input as the output of -E: do not run the
+                    preprocessor over it again, do not apply -D definitions,
+                    and reject #include directives.
   -fpreserve-bindings
                     Preserve all binding declarations, even if those bindings
                     are not used.
+  -fprewarm[=<version>,...]
+                    Before compiling, build the built-in symbol tables for
+                    the stages of all input files at the given GLSL versions,
+                    so that concurrent compilations with --batch or -j do not
+                    wait on each other to build them.  The default version is
+                    the one given by -std, or else 450.
+  -fraw-id          With -S, write ids as numbers, such as %4, instead of
+                    naming them after the names in the module, which is
+                    faster for large modules.
+  -freflect=<file>  Write the interface of each compiled shader to the given
+                    JSON file, by output file name: its descriptor sets and
+                    bindings, push constants, input and output locations and
+                    workgroup size.
   -fresource-set-binding [stage] <reg0> <set0> <binding0>
                         [<reg1> <set1> <binding1>...]
                     Explicitly sets the descriptor set and binding for
@@ -131,25 +195,55 @@ Options:
                     Treat subsequent input files as having stage <stage>.
                     Valid stages are vertex, vert, fragment, frag, tesscontrol,
                     tesc, tesseval, tese, geometry, geom, compute, and comp.
+  -fskip-unchanged-output
+                    Do not rewrite output files whose contents would not
+                    change, so that their timestamps are preserved.  Changed
+                    output files are replaced atomically.
+  -fspec-constant=<id>=<value>
+                    Freeze the specialization constant with SpecId <id> to
+                    <value> before optimization, so that the optimizer folds
+                    it like a regular constant.  May be given several times.
+  -fsyntax-only[=validate]
+                    Only check the input files for errors, and write no
+                    output files.  Compilation stops after parsing and
+                    linking, or with =validate, after the generated SPIR-V
+                    is validated.  No optimization is done.
+  -ftime-trace=<file>
+                    Write a Chrome Trace Event JSON file with the time spent
+                    in each phase of each compilation, including file reads
+                    and writes, with one lane per thread.
+  -fvalidate=<policy>
+                    When to check the SPIR-V with the SPIR-V validator:
+                    never, before-opt, after-opt, or always.  By default,
+                    only optimized SPIR-V is validated, before optimization.
   -g                Generate source-level debug information.
   -h                Display available options.
   --help            Display available options.
   -I <value>        Add directory to include search path.
+  -j <N>            Compile up to N input files or --batch jobs at the same
+                    time.  The default for --batch is the number of
+                    hardware threads, and 1 otherwise.
   -mfmt=<format>    Output SPIR-V binary code using the selected format. This
                     option may be specified only when the compilation output is
                     in SPIR-V binary code form. Available options are:
                       bin   - SPIR-V binary words.  This is the default.
                       c     - Binary words as C initializer list of 32-bit ints
                       num   - List of comma-separated 32-bit hex integers
+                      packed - SPIR-V binary in a compact, lossless encoding
   -M                Generate make dependencies. Implies -E and -w.
   -MM               An alias for -M.
   -MD               Generate make dependencies and compile.
   -MF <file>        Write dependency output to the given file.
+  -MJ <file>        Also write the dependency info of all input files to the
+                    given file as a JSON database.
   -MT <target>      Specify the target of the rule emitted by dependency
                     generation.
   -O                Optimize the generated SPIR-V code for better performance.
   -Os               Optimize the generated SPIR-V code for smaller size.
   -O0               Disable optimization.
+  -Oconfig=<file>   Run the optimization passes listed in <file>, as
+                    spirv-opt flags separated by whitespace, instead of
+                    those of the optimization level.
   -o <file>         Write output to <file>.
                     A file name of '-' represents standard output.
   -std=<value>      Version and profile for GLSL input files. Possible values
@@ -245,6 +339,101 @@ bool GetOptionalStageThenOffsetArgument(const shaderc_util::string_piece option,
   return true;
 }
 
+// Writes the recorded trace to the named file.  Returns true on success.
+// Otherwise emits an error message to std::cerr and returns false.
+bool WriteTimeTrace(const std::string& file_name) {
+  std::ostringstream trace;
+  shaderc_util::WriteTrace(&trace);
+  std::ofstream potential_file_stream;
+  std::ostream* out = shaderc_util::GetOutputStream(
+      file_name, &potential_file_stream, &std::cerr);
+  if (!out || out->fail()) return false;
+  if (!shaderc_util::WriteFile(out, trace.str())) {
+    std::cerr << "glslc: error: error writing to trace file: '" << file_name
+              << "'" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Writes the SpecIds of the given macros to the named file, as a JSON object.
+// Returns true on success.  Otherwise emits an error message to std::cerr
+// and returns false.
+bool WriteMacroSpecMap(
+    const std::string& file_name,
+    const std::vector<std::pair<std::string, uint32_t>>& macro_spec_ids) {
+  std::ofstream potential_file_stream;
+  std::ostream* out = shaderc_util::GetOutputStream(
+      file_name, &potential_file_stream, &std::cerr);
+  if (!out || out->fail()) return false;
+  *out << "{";
+  for (size_t i = 0; i < macro_spec_ids.size(); ++i) {
+    *out << (i ? ",\n  " : "\n  ");
+    shaderc_util::WriteJsonString(out, macro_spec_ids[i].first);
+    *out << ": " << macro_spec_ids[i].second;
+  }
+  *out << "\n}\n";
+  if (out->fail()) {
+    std::cerr << "glslc: error: error writing to macro SpecId map file: '"
+              << file_name << "'" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Reads the SPIR-V module in the named file into *words.  Returns true on
+// success.  Otherwise emits an error message to std::cerr and returns false.
+bool ReadSpirvLibrary(const std::string& file_name,
+                      std::vector<uint32_t>* words) {
+  const uint32_t kSpirvMagicNumber = 0x07230203;
+  std::vector<char> contents;
+  if (!shaderc_util::ReadFile(file_name, &contents)) return false;
+  words->resize(contents.size() / sizeof(uint32_t));
+  std::memcpy(words->data(), contents.data(),
+              words->size() * sizeof(uint32_t));
+  if (words->empty() || contents.size() % sizeof(uint32_t) != 0 ||
+      (*words)[0] != kSpirvMagicNumber) {
+    std::cerr << "glslc: error: '" << file_name
+              << "' is not a SPIR-V module" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Parses a comma-separated list of GLSL versions into *versions.  Returns
+// false if any of them is not a known GLSL version.
+bool ParsePrewarmVersions(const string_piece& list,
+                          std::vector<int>* versions) {
+  std::istringstream stream(list.str());
+  std::string version_str;
+  while (std::getline(stream, version_str, ',')) {
+    uint32_t version = 0;
+    if (!shaderc_util::ParseUint32(version_str, &version) ||
+        !shaderc_util::IsKnownVersion(static_cast<int>(version))) {
+      return false;
+    }
+    versions->push_back(static_cast<int>(version));
+  }
+  return !versions->empty();
+}
+
+// Parses a comma-separated list of <name>:<stage> pairs into *entry_points.
+// Returns false if any pair is malformed or names an unknown stage.
+bool ParseEntryPointList(const string_piece& list,
+                         std::vector<glslc::EntryPointSpec>* entry_points) {
+  std::istringstream stream(list.str());
+  std::string pair;
+  while (std::getline(stream, pair, ',')) {
+    const size_t colon_pos = pair.find(':');
+    if (colon_pos == 0 || colon_pos == std::string::npos) return false;
+    const shaderc_shader_kind stage =
+        glslc::MapStageNameToForcedKind(pair.substr(colon_pos + 1));
+    if (stage == shaderc_glsl_infer_from_source) return false;
+    entry_points->push_back({pair.substr(0, colon_pos), stage});
+  }
+  return !entry_points->empty();
+}
+
 }  // anonymous namespace
 
 int main(int argc, char** argv) {
@@ -254,6 +443,8 @@ int main(int argc, char** argv) {
   shaderc_source_language current_source_language =
       shaderc_source_language_glsl;
   std::string current_entry_point_name("main");
+  // The entry points given by -fentry-point=<name>:<stage>,..., if any.
+  std::vector<glslc::EntryPointSpec> current_entry_points;
   glslc::FileCompiler compiler;
   bool success = true;
   bool has_stdin_input = false;
@@ -262,6 +453,22 @@ int main(int argc, char** argv) {
   // Binding base for a single option.
   uint32_t arg_base = 0;
 
+  // The --batch manifest file name, if any.
+  std::string batch_manifest_file_name;
+  // The number of jobs to compile at the same time, or 0 if -j is not given.
+  uint32_t num_threads = 0;
+  // The -ftime-trace file name, if any.
+  std::string time_trace_file_name;
+  // The macros given to -fmacro-spec-constant, with their SpecIds, in the
+  // order they are first given, and the -fmacro-spec-map file name, if any.
+  std::vector<std::pair<std::string, uint32_t>> macro_spec_ids;
+  std::string macro_spec_map_file_name;
+  // Whether -fprewarm is given, and the GLSL versions it names.
+  bool prewarm = false;
+  std::vector<int> prewarm_versions;
+  // Whether -std is given.
+  bool version_profile_forced = false;
+
   // What kind of uniform variable are we setting the binding base for?
   shaderc_uniform_kind u_kind = shaderc_uniform_kind_buffer;
 
@@ -300,6 +507,28 @@ int main(int argc, char** argv) {
       std::cout << "Target: " << spvTargetEnvDescription(SPV_ENV_UNIVERSAL_1_0)
                 << std::endl;
       return 0;
+    } else if (arg.starts_with("--batch=")) {
+      batch_manifest_file_name = arg.substr(std::strlen("--batch=")).str();
+      if (batch_manifest_file_name.empty()) {
+        std::cerr << "glslc: error: missing manifest file name in '" << arg
+                  << "'" << std::endl;
+        return 1;
+      }
+    } else if (arg.starts_with("-j")) {
+      string_piece num_threads_arg;
+      if (!shaderc_util::GetOptionArgument(argc, argv, &i, "-j",
+                                           &num_threads_arg)) {
+        std::cerr
+            << "glslc: error: argument to '-j' is missing (expected 1 value)"
+            << std::endl;
+        return 1;
+      }
+      if (!shaderc_util::ParseUint32(num_threads_arg.str(), &num_threads) ||
+          num_threads == 0) {
+        std::cerr << "glslc: error: invalid value '" << num_threads_arg
+                  << "' in '-j'" << std::endl;
+        return 1;
+      }
     } else if (arg.starts_with("-o")) {
       string_piece file_name;
       if (!shaderc_util::GetOptionArgument(argc, argv, &i, "-o", &file_name)) {
@@ -317,10 +546,21 @@ int main(int argc, char** argv) {
                   << std::endl;
         return 1;
       }
+    } else if (arg.starts_with("-farchive=")) {
+      const std::string archive_file_name =
+          arg.substr(std::strlen("-farchive=")).str();
+      if (archive_file_name.empty()) {
+        std::cerr << "glslc: error: missing archive file name in '" << arg
+                  << "'" << std::endl;
+        return 1;
+      }
+      compiler.SetArchiveFileName(archive_file_name);
     } else if (arg == "-fauto-bind-uniforms") {
       compiler.options().SetAutoBindUniforms(true);
     } else if (arg == "-fauto-combined-image-sampler") {
       compiler.options().SetAutoSampledTextures(true);
+    } else if (arg == "-fdeps-scan") {
+      compiler.SetDependencyScanFlag();
     } else if (arg == "-fauto-map-locations") {
       compiler.options().SetAutoMapLocations(true);
     } else if (arg == "-fhlsl-iomap") {
@@ -336,8 +576,131 @@ int main(int argc, char** argv) {
       compiler.options().SetInvertY(true);
     } else if (arg == "-fnan-clamp") {
       compiler.options().SetNanClamp(true);
+    } else if (arg.starts_with("-ftime-trace=")) {
+      time_trace_file_name = arg.substr(std::strlen("-ftime-trace=")).str();
+      if (time_trace_file_name.empty()) {
+        std::cerr << "glslc: error: missing trace file name in '" << arg
+                  << "'" << std::endl;
+        return 1;
+      }
+      shaderc_util::EnableTrace();
+      shaderc_util::SetTraceThreadName("main");
+    } else if (arg == "-fsyntax-only") {
+      compiler.SetSyntaxOnlyFlag(shaderc_syntax_only_parse);
+    } else if (arg == "-fsyntax-only=validate") {
+      compiler.SetSyntaxOnlyFlag(shaderc_syntax_only_validate);
+    } else if (arg.starts_with("-fsyntax-only=")) {
+      std::cerr << "glslc: error: invalid value '"
+                << arg.substr(std::strlen("-fsyntax-only=")) << "' in '"
+                << arg << "'" << std::endl;
+      return 1;
+    } else if (arg.starts_with("-fvalidate=")) {
+      const string_piece value = arg.substr(std::strlen("-fvalidate="));
+      if (value == "never") {
+        compiler.options().SetValidationPolicy(
+            shaderc_validation_policy_never);
+      } else if (value == "before-opt") {
+        compiler.options().SetValidationPolicy(
+            shaderc_validation_policy_before_optimization);
+      } else if (value == "after-opt") {
+        compiler.options().SetValidationPolicy(
+            shaderc_validation_policy_after_optimization);
+      } else if (value == "always") {
+        compiler.options().SetValidationPolicy(
+            shaderc_validation_policy_always);
+      } else {
+        std::cerr << "glslc: error: invalid value '" << value << "' in '"
+                  << arg << "'" << std::endl;
+        return 1;
+      }
+    } else if (arg == "-fskip-unchanged-output") {
+      compiler.SetSkipUnchangedOutputFlag();
+    } else if (arg == "-fprewarm") {
+      prewarm = true;
+    } else if (arg.starts_with("-fprewarm=")) {
+      prewarm = true;
+      const string_piece versions = arg.substr(std::strlen("-fprewarm="));
+      if (!ParsePrewarmVersions(versions, &prewarm_versions)) {
+        std::cerr << "glslc: error: invalid GLSL versions '" << versions
+                  << "' in '" << arg << "'" << std::endl;
+        return 1;
+      }
+    } else if (arg == "-fraw-id") {
+      compiler.options().SetDisassemblyFriendlyNames(false);
+    } else if (arg.starts_with("-freflect=")) {
+      const std::string reflection_file_name =
+          arg.substr(std::strlen("-freflect=")).str();
+      if (reflection_file_name.empty()) {
+        std::cerr << "glslc: error: missing reflection file name in '" << arg
+                  << "'" << std::endl;
+        return 1;
+      }
+      compiler.SetReflectionFileName(reflection_file_name);
+    } else if (arg == "-fcompile-for-linking") {
+      compiler.options().SetCompileForLinking(true);
+    } else if (arg.starts_with("-flink-library=")) {
+      const std::string library_file_name =
+          arg.substr(std::strlen("-flink-library=")).str();
+      if (library_file_name.empty()) {
+        std::cerr << "glslc: error: missing library file name in '" << arg
+                  << "'" << std::endl;
+        return 1;
+      }
+      std::vector<uint32_t> library;
+      if (!ReadSpirvLibrary(library_file_name, &library)) return 1;
+      compiler.options().AddLinkLibrary(library);
+    } else if (arg == "-fpreprocessed") {
+      compiler.options().SetInputPreprocessed(true);
     } else if (arg.starts_with("-fpreserve-bindings")) {
       compiler.options().SetPreserveBindings(true);
+    } else if (arg.starts_with("-fspec-constant=")) {
+      const string_piece spec = arg.substr(std::strlen("-fspec-constant="));
+      const size_t equals = spec.find_first_of('=');
+      uint32_t spec_id = 0;
+      if (equals == string_piece::npos ||
+          !shaderc_util::ParseUint32(spec.substr(0, equals).str(),
+                                     &spec_id) ||
+          equals + 1 == spec.size()) {
+        std::cerr << "glslc: error: invalid value '" << spec << "' in '"
+                  << arg << "'" << std::endl;
+        return 1;
+      }
+      compiler.options().SetSpecializationConstant(
+          spec_id, spec.substr(equals + 1).str());
+    } else if (arg.starts_with("-fmacro-spec-constant=")) {
+      const string_piece spec =
+          arg.substr(std::strlen("-fmacro-spec-constant="));
+      const size_t equals = spec.find_first_of('=');
+      const std::string name = spec.substr(0, equals).str();
+      uint32_t spec_id =
+          macro_spec_ids.empty() ? 0 : macro_spec_ids.back().second + 1;
+      if (name.empty() ||
+          (equals != string_piece::npos &&
+           !shaderc_util::ParseUint32(spec.substr(equals + 1).str(),
+                                      &spec_id))) {
+        std::cerr << "glslc: error: invalid value '" << spec << "' in '"
+                  << arg << "'" << std::endl;
+        return 1;
+      }
+      auto existing = std::find_if(
+          macro_spec_ids.begin(), macro_spec_ids.end(),
+          [&name](const std::pair<std::string, uint32_t>& macro) {
+            return macro.first == name;
+          });
+      if (existing == macro_spec_ids.end()) {
+        macro_spec_ids.emplace_back(name, spec_id);
+      } else {
+        existing->second = spec_id;
+      }
+      compiler.options().AddMacroSpecConstant(name, spec_id);
+    } else if (arg.starts_with("-fmacro-spec-map=")) {
+      macro_spec_map_file_name =
+          arg.substr(std::strlen("-fmacro-spec-map=")).str();
+      if (macro_spec_map_file_name.empty()) {
+        std::cerr << "glslc: error: missing macro SpecId map file name in '"
+                  << arg << "'" << std::endl;
+        return 1;
+      }
     } else if (arg.starts_with("-fmax-id-bound=")) {
       const string_piece value_str = arg.substr(std::strlen("-fmax-id-bound="));
       uint32_t bound = 0;
@@ -403,8 +766,15 @@ int main(int argc, char** argv) {
       }
       if (!seen_triple) return need_three_args_err();
     } else if (arg.starts_with("-fentry-point=")) {
-      current_entry_point_name =
-          arg.substr(std::strlen("-fentry-point=")).str();
+      const string_piece value = arg.substr(std::strlen("-fentry-point="));
+      current_entry_points.clear();
+      if (value.find_first_of(":,") == string_piece::npos) {
+        current_entry_point_name = value.str();
+      } else if (!ParseEntryPointList(value, &current_entry_points)) {
+        std::cerr << "glslc: error: invalid entry point list '" << value
+                  << "' in '" << arg << "'" << std::endl;
+        return 1;
+      }
     } else if (arg.starts_with("-flimit=")) {
       std::string err;
       if (!SetResourceLimits(arg.substr(std::strlen("-flimit=")).str(),
@@ -445,6 +815,7 @@ int main(int argc, char** argv) {
         return 1;
       }
       compiler.options().SetForcedVersionProfile(version, profile);
+      version_profile_forced = true;
     } else if (arg.starts_with("--target-env=")) {
       shaderc_target_env target_env = shaderc_target_env_default;
       const string_piece target_env_str =
@@ -519,6 +890,9 @@ int main(int argc, char** argv) {
       } else if (binary_output_format == "c") {
         compiler.SetSpirvBinaryOutputFormat(
             glslc::FileCompiler::SpirvBinaryEmissionFormat::CInitList);
+      } else if (binary_output_format == "packed") {
+        compiler.SetSpirvBinaryOutputFormat(
+            glslc::FileCompiler::SpirvBinaryEmissionFormat::Packed);
       } else if (binary_output_format == "wgsl") {
         compiler.SetSpirvBinaryOutputFormat(
             glslc::FileCompiler::SpirvBinaryEmissionFormat::WGSL);
@@ -584,6 +958,17 @@ int main(int argc, char** argv) {
       }
       compiler.GetDependencyDumpingHandler()->SetDependencyFileName(
           std::string(dep_file_name.data(), dep_file_name.size()));
+    } else if (arg == "-MJ") {
+      string_piece database_file_name;
+      if (!shaderc_util::GetOptionArgument(argc, argv, &i, "-MJ",
+                                           &database_file_name)) {
+        std::cerr << "glslc: error: missing dependency database filename "
+                     "after '-MJ'"
+                  << std::endl;
+        return 1;
+      }
+      compiler.GetDependencyDumpingHandler()->SetJsonDatabaseFileName(
+          database_file_name.str());
     } else if (arg == "-MT") {
       string_piece dep_file_name;
       if (!shaderc_util::GetOptionArgument(argc, argv, &i, "-MT",
@@ -627,9 +1012,7 @@ int main(int argc, char** argv) {
                 ? ""
                 : argument.substr(name_length + 1);
         // TODO(deki): check arg for newlines.
-        compiler.options().AddMacroDefinition(
-            name_piece.data(), name_piece.size(), value_piece.data(),
-            value_piece.size());
+        compiler.AddMacroDefinition(name_piece, value_piece);
       }
     } else if (arg.starts_with("-I")) {
       string_piece option_arg;
@@ -643,6 +1026,26 @@ int main(int argc, char** argv) {
       }
     } else if (arg == "-g") {
       compiler.options().SetGenerateDebugInfo();
+    } else if (arg.starts_with("-Oconfig=")) {
+      const std::string config_file =
+          arg.substr(std::strlen("-Oconfig=")).str();
+      std::vector<char> contents;
+      if (!shaderc_util::ReadFile(config_file, &contents)) {
+        std::cerr << "glslc: error: cannot read optimization config file: "
+                  << config_file << std::endl;
+        return 1;
+      }
+      std::vector<std::string> passes;
+      std::istringstream config(std::string(contents.begin(), contents.end()));
+      for (std::string pass; config >> pass;) passes.push_back(pass);
+      std::vector<std::string> flags;
+      std::string err;
+      if (!shaderc_util::ParseSpirvToolsPassFlags(passes, &flags, &err)) {
+        std::cerr << "glslc: error: " << config_file << ": " << err
+                  << std::endl;
+        return 1;
+      }
+      compiler.options().SetOptimizationPasses(flags);
     } else if (arg.starts_with("-O")) {
       if (arg == "-O") {
         compiler.options().SetOptimizationLevel(
@@ -694,16 +1097,78 @@ int main(int argc, char** argv) {
           (current_fshader_stage == shaderc_glsl_infer_from_source
                ? glslc::DeduceDefaultShaderKindFromFileName(arg)
                : current_fshader_stage),
-          language, current_entry_point_name});
+          language, current_entry_point_name, current_entry_points});
+    }
+  }
+
+  // Several input files given without -c, -S, -E or -fsyntax-only are linked
+  // as one program.
+  const bool link_program = batch_manifest_file_name.empty() &&
+                            input_files.size() > 1 && compiler.NeedsLinking();
+  std::vector<glslc::BatchJob> batch_jobs;
+  if (!batch_manifest_file_name.empty()) {
+    if (!input_files.empty()) {
+      std::cerr << "glslc: error: cannot specify input files with --batch"
+                << std::endl;
+      return 1;
+    }
+    compiler.SetIndividualCompilationFlag();
+    const glslc::InputFileSpec defaults{"", current_fshader_stage,
+                                        current_source_language,
+                                        current_entry_point_name,
+                                        current_entry_points};
+    if (!glslc::ReadBatchManifest(batch_manifest_file_name, defaults,
+                                  source_language_forced, &batch_jobs,
+                                  &std::cerr)) {
+      return 1;
+    }
+    if (num_threads == 0) {
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+  } else if (num_threads != 0 && !link_program) {
+    for (const auto& input_file : input_files) {
+      batch_jobs.push_back(glslc::BatchJob{input_file, "", "", {}, {}});
     }
   }
 
-  if (!compiler.ValidateOptions(input_files.size())) return 1;
+  const size_t num_files = batch_jobs.empty() ? input_files.size()
+                                              : batch_jobs.size();
+  if (!compiler.ValidateOptions(num_files)) return 1;
 
   if (!success) return 1;
 
-  for (const auto& input_file : input_files) {
-    success &= compiler.CompileShaderFile(input_file);
+  if (prewarm) {
+    std::vector<glslc::InputFileSpec> prewarm_inputs;
+    if (batch_jobs.empty()) {
+      prewarm_inputs = input_files;
+    } else {
+      for (const auto& job : batch_jobs) {
+        prewarm_inputs.push_back(job.input_file);
+      }
+    }
+    if (prewarm_versions.empty() && !version_profile_forced) {
+      prewarm_versions.push_back(450);
+    }
+    if (!compiler.Prewarm(prewarm_inputs, prewarm_versions)) return 1;
+  }
+
+  if (!batch_jobs.empty()) {
+    success &= compiler.CompileBatch(batch_jobs, num_threads);
+  } else if (link_program) {
+    success &= compiler.CompileProgram(input_files);
+  } else {
+    for (const auto& input_file : input_files) {
+      success &= compiler.CompileShaderFile(input_file);
+    }
+  }
+  success &= compiler.WriteDependencyDatabase();
+  if (success) success = compiler.WriteArchive();
+  if (success) success = compiler.WriteReflection();
+  if (!macro_spec_map_file_name.empty()) {
+    success &= WriteMacroSpecMap(macro_spec_map_file_name, macro_spec_ids);
+  }
+  if (!time_trace_file_name.empty()) {
+    success &= WriteTimeTrace(time_trace_file_name);
   }
 
   compiler.OutputMessages();
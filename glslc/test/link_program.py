@@ -0,0 +1,107 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+
+
+import expect
+import re
+from environment import File, Directory
+from glslc_test_framework import inside_glslc_testsuite
+
+VERTEX_SHADER = """#version 450
+layout(location=0) out vec4 color;
+layout(location=1) out vec4 unused_varying;
+void main() { color = vec4(1.0); unused_varying = vec4(2.0); }
+"""
+FRAGMENT_SHADER = """#version 450
+layout(location=0) in vec4 color;
+layout(location=1) in vec4 unused_varying;
+layout(location=0) out vec4 frag_color;
+void main() { frag_color = color; }
+"""
+
+
+@inside_glslc_testsuite('LinkProgram')
+class TestLinkVertexAndFragment(expect.ValidNamedObjectFile):
+    """Tests that several input files are linked as one program, with an
+    object file for each stage."""
+
+    environment = Directory('.', [File('a.vert', VERTEX_SHADER),
+                                  File('a.frag', FRAGMENT_SHADER)])
+    glslc_args = ['a.vert', 'a.frag']
+    expected_object_filenames = ('a.vert.spv', 'a.frag.spv')
+
+
+@inside_glslc_testsuite('LinkProgram')
+class TestLinkRemovesUnreadVaryingsFromBothStages(expect.ValidNamedAssemblyFile,
+                                                 expect.ValidFileContents):
+    """Tests that a fragment input that is declared but not read leaves the
+    fragment interface along with the vertex output that fed it, and that
+    both stages validate."""
+
+    environment = Directory('.', [File('a.vert', VERTEX_SHADER),
+                                  File('a.frag', FRAGMENT_SHADER)])
+    glslc_args = ['-S', '-fvalidate=always', 'a.vert', 'a.frag']
+    expected_assembly_filenames = ('a.vert.spvasm', 'a.frag.spvasm')
+    target_filename = 'a.frag.spvasm'
+    expected_file_contents = re.compile(
+        r'OpEntryPoint Fragment %main "main"( %(?!unused_varying\b)\w+)+\n')
+
+
+@inside_glslc_testsuite('LinkProgram')
+class TestLinkWithOutputName(expect.ErrorMessage):
+    """Tests that -o cannot name the several outputs of a program."""
+
+    environment = Directory('.', [File('a.vert', VERTEX_SHADER),
+                                  File('a.frag', FRAGMENT_SHADER)])
+    glslc_args = ['a.vert', 'a.frag', '-o', 'out.spv']
+    expected_error = [
+        'glslc: error: cannot specify -o when generating multiple output '
+        'files\n']
+
+
+@inside_glslc_testsuite('LinkProgram')
+class TestLinkTwoShadersForOneStage(expect.ErrorMessageSubstr):
+    """Tests that a program has at most one shader for each stage."""
+
+    environment = Directory('.', [File('a.vert', VERTEX_SHADER),
+                                  File('b.vert', VERTEX_SHADER)])
+    glslc_args = ['a.vert', 'b.vert']
+    expected_error_substr = (
+        'b.vert: error: a program has more than one shader for the same '
+        'stage\n')
+
+
+@inside_glslc_testsuite('LinkProgram')
+class TestLinkFileWithoutStage(expect.ErrorMessage):
+    """Tests that every linked file needs a known stage."""
+
+    environment = Directory('.', [File('a.glsl', VERTEX_SHADER),
+                                  File('a.frag', FRAGMENT_SHADER)])
+    glslc_args = ['a.glsl', 'a.frag']
+    expected_error = [
+        "glslc: error: 'a.glsl': the stage of a linked file must be given by "
+        "its extension or by -fshader-stage\n"]
+
+
+@inside_glslc_testsuite('LinkProgram')
+class TestLinkReportsErrorsOfEveryStage(expect.ErrorMessageSubstr):
+    """Tests that the errors of all of the stages are reported."""
+
+    environment = Directory('.', [
+        File('a.vert', '#version 450\nvoid main() { float a = b; }\n'),
+        File('a.frag', FRAGMENT_SHADER)])
+    glslc_args = ['a.vert', 'a.frag']
+    expected_error_substr = "a.vert:2: error: 'b' : undeclared identifier\n"
@@ -0,0 +1,174 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import expect
+from environment import File, Directory
+from glslc_test_framework import inside_glslc_testsuite
+
+MINIMAL_SHADER = '#version 140\nvoid main() {}'
+# A shader that only compiles when the macro OK is defined.
+NEEDS_OK_SHADER = '#version 140\n#ifndef OK\n#error OK is not defined\n#endif\n' \
+                  'void main() {}'
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestBatchNamedOutputs(expect.ValidNamedObjectFile):
+    """Tests that --batch compiles each job to its own output file."""
+    environment = Directory('.', [
+        File('a.vert', MINIMAL_SHADER),
+        File('b.glsl', MINIMAL_SHADER),
+        File('manifest.json',
+             '{"jobs": [{"input": "a.vert", "output": "a_out.spv"},\n'
+             '          {"input": "b.glsl", "output": "b_out.spv",'
+             ' "stage": "frag"}]}')])
+    glslc_args = ['--batch=manifest.json']
+    expected_object_filenames = ('a_out.spv', 'b_out.spv')
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestBatchDefaultOutputNames(expect.ValidNamedObjectFile):
+    """Tests that --batch implies -c for jobs without an output file name."""
+    environment = Directory('.', [
+        File('a.vert', MINIMAL_SHADER),
+        File('b.frag', MINIMAL_SHADER),
+        File('manifest.json',
+             '{"jobs": [{"input": "a.vert"}, {"input": "b.frag"}]}')])
+    glslc_args = ['--batch=manifest.json', '-j', '2']
+    expected_object_filenames = ('a.vert.spv', 'b.frag.spv')
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestBatchDefinesAreInherited(expect.ValidNamedObjectFile):
+    """Tests that jobs get the macros of the manifest defaults."""
+    environment = Directory('.', [
+        File('a.vert', NEEDS_OK_SHADER),
+        File('b.vert', NEEDS_OK_SHADER),
+        File('manifest.json',
+             '{"defaults": {"defines": ["OK"]},\n'
+             ' "jobs": [{"input": "a.vert"}, {"input": "b.vert"}]}')])
+    glslc_args = ['--batch=manifest.json']
+    expected_object_filenames = ('a.vert.spv', 'b.vert.spv')
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestBatchJobDefine(expect.ValidNamedObjectFile):
+    """Tests that a job's own macros are defined."""
+    environment = Directory('.', [
+        File('c.vert', NEEDS_OK_SHADER),
+        File('manifest.json',
+             '{"jobs": [{"input": "c.vert", "defines": ["OK=1"]}]}')])
+    glslc_args = ['--batch=manifest.json']
+    expected_object_filenames = ('c.vert.spv',)
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestBatchJobDepfile(expect.ValidFileContents):
+    """Tests that a job with a depfile writes make dependencies to it."""
+    environment = Directory('.', [
+        File('a.vert', '#version 140\n#include "inc.glsl"\nvoid main() {}'),
+        File('inc.glsl', '\n'),
+        File('manifest.json',
+             '{"jobs": [{"input": "a.vert", "output": "a.spv",'
+             ' "depfile": "a.d"}]}')])
+    glslc_args = ['--batch=manifest.json']
+    target_filename = 'a.d'
+    expected_file_contents = ['a.spv: a.vert inc.glsl\n']
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestBatchJobFailureIsReported(expect.ErrorMessageSubstr):
+    """Tests that a failing job makes glslc fail, with its messages."""
+    environment = Directory('.', [
+        File('a.vert', NEEDS_OK_SHADER),
+        File('manifest.json', '{"jobs": [{"input": "a.vert"}]}')])
+    glslc_args = ['--batch=manifest.json']
+    expected_error_substr = ['a.vert:3: error: \'#error\' : OK is not defined']
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestBatchWithInputFilesIsAnError(expect.ErrorMessage):
+    """Tests that input files cannot be given with --batch."""
+    environment = Directory('.', [
+        File('a.vert', MINIMAL_SHADER),
+        File('manifest.json', '{"jobs": [{"input": "a.vert"}]}')])
+    glslc_args = ['--batch=manifest.json', 'a.vert']
+    expected_error = ['glslc: error: cannot specify input files with --batch\n']
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestBatchInvalidManifest(expect.ErrorMessage):
+    """Tests that an invalid manifest is reported with its location."""
+    environment = Directory('.', [
+        File('manifest.json', '{"jobs": [{"input": "a.vert", "stage": 1}]}')])
+    glslc_args = ['--batch=manifest.json']
+    expected_error = ['glslc: error: manifest.json: jobs[0].stage: '
+                      'expected a string\n']
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestDashJWithInputFiles(expect.ValidNamedObjectFile):
+    """Tests that -j compiles command line input files in parallel."""
+    environment = Directory('.', [
+        File('a.vert', MINIMAL_SHADER),
+        File('b.frag', MINIMAL_SHADER),
+        File('c.comp', '#version 310 es\nlayout(local_size_x=1) in;\n'
+                       'void main() {}')])
+    glslc_args = ['-c', '-j3', 'a.vert', 'b.frag', 'c.comp']
+    expected_object_filenames = ('a.vert.spv', 'b.frag.spv', 'c.comp.spv')
+
+
+# Shaders whose preprocessed source tells them apart.
+NUMBERED_SHADERS = [
+    File('{}.vert'.format(i),
+         '#version 140\nvoid main() {{ int a = {}; }}'.format(i))
+    for i in range(8)]
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestDashJPreprocessesToStdoutInOrder(expect.StdoutMatch):
+    """Tests that -j with -E writes the preprocessed source of the input
+    files to standard output one after the other, in their order."""
+    environment = Directory('.', NUMBERED_SHADERS)
+    glslc_args = ['-E', '-j4'] + ['{}.vert'.format(i) for i in range(8)]
+    expected_stdout = ''.join(
+        '#version 140\nvoid main() {{ int a = {}; }}\n'.format(i)
+        for i in range(8))
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestDashJDependencyRulesToStdoutInOrder(expect.StdoutMatch):
+    """Tests that -j with -M writes the dependency rules of the input files
+    to standard output in their order."""
+    environment = Directory('.', NUMBERED_SHADERS)
+    glslc_args = ['-M', '-j4'] + ['{}.vert'.format(i) for i in range(8)]
+    expected_stdout = ''.join(
+        '{0}.vert.spv: {0}.vert\n'.format(i) for i in range(8))
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestDashJDependencyScanToStdoutInOrder(expect.StdoutMatch):
+    """Tests that -j with -M -fdeps-scan writes the dependency rules of the
+    input files to standard output in their order."""
+    environment = Directory('.', NUMBERED_SHADERS)
+    glslc_args = (['-M', '-fdeps-scan', '-j4'] +
+                  ['{}.vert'.format(i) for i in range(8)])
+    expected_stdout = ''.join(
+        '{0}.vert.spv: {0}.vert\n'.format(i) for i in range(8))
+
+
+@inside_glslc_testsuite('OptionBatch')
+class TestDashJInvalidValue(expect.ErrorMessage):
+    """Tests that -j requires a positive number."""
+    glslc_args = ['-j0', 'a.vert']
+    expected_error = ['glslc: error: invalid value \'0\' in \'-j\'\n']
@@ -762,3 +762,94 @@ class TestErrorDashMFUnwritableFile(expect.ErrorMessageSubstr):
     bad_file = '/file/should/not/exist/today.d'
     glslc_args = ['-MD', '-MF', bad_file, 'shader.vert']
     expected_error_substr = ['cannot open output file']
+
+
+@inside_glslc_testsuite('OptionsCapM')
+class TestDashCapMWithDepsScan(DependencyInfoStdoutMatch):
+    """Tests that -fdeps-scan finds included files without fully preprocessing
+    the source, and follows both branches of a conditional that depends on a
+    macro predefined by the compiler.
+    e.g. glslc -M -fdeps-scan shader.vert
+      => shader.vert.spv: shader.vert a.glsl b.glsl
+    """
+    environment = Directory('.', [
+        File('shader.vert', '#version 140\n'
+                            '#ifdef GL_SPIRV\n'
+                            '#include "a.glsl"\n'
+                            '#else\n'
+                            '#include "b.glsl"\n'
+                            '#endif\n'
+                            'void main() {}\n'),
+        File('a.glsl', '// a.glsl\n'),
+        File('b.glsl', '// b.glsl\n')])
+    glslc_args = ['-M', '-fdeps-scan', 'shader.vert']
+    dependency_rules_expected = [{'target': 'shader.vert.spv',
+                                  'dependency': {'shader.vert', 'a.glsl',
+                                                 'b.glsl'}}]
+
+
+@inside_glslc_testsuite('OptionsCapM')
+class TestDashCapMWithDepsScanEvaluatesDefines(DependencyInfoStdoutMatch):
+    """Tests that -fdeps-scan skips branches excluded by -D macros.
+    e.g. glslc -M -fdeps-scan -DUSE_A shader.vert
+      => shader.vert.spv: shader.vert a.glsl
+    """
+    environment = Directory('.', [
+        File('shader.vert', '#version 140\n'
+                            '#if defined(USE_A)\n'
+                            '#include "a.glsl"\n'
+                            '#else\n'
+                            '#include "b.glsl"\n'
+                            '#endif\n'
+                            'void main() {}\n'),
+        File('a.glsl', '// a.glsl\n'),
+        File('b.glsl', '// b.glsl\n')])
+    glslc_args = ['-M', '-fdeps-scan', '-DUSE_A', 'shader.vert']
+    dependency_rules_expected = [{'target': 'shader.vert.spv',
+                                  'dependency': {'shader.vert', 'a.glsl'}}]
+
+
+@inside_glslc_testsuite('OptionsCapM')
+class TestErrorDepsScanMissingIncludeFile(expect.ErrorMessageSubstr):
+    """Tests that -fdeps-scan reports an include file that cannot be found."""
+    environment = Directory('.', [
+        File('shader.vert', '#version 140\n#include "missing.glsl"\n')])
+    glslc_args = ['-M', '-fdeps-scan', 'shader.vert']
+    expected_error_substr = ['Cannot find or open include file: missing.glsl']
+
+
+@inside_glslc_testsuite('OptionsCapM')
+class TestErrorDepsScanWithoutDashCapM(expect.StderrMatch):
+    """Tests that -fdeps-scan is rejected without -M or -MM."""
+    environment = EMPTY_SHADER_IN_CURDIR
+    glslc_args = ['-c', '-fdeps-scan', 'shader.vert']
+    expected_stderr = ['glslc: error: -fdeps-scan requires -M or -MM\n']
+
+
+@inside_glslc_testsuite('OptionsCapM')
+class TestDashCapMJ(expect.ValidFileContents):
+    """Tests that -MJ writes the dependency info of all input files as a JSON
+    database.
+    e.g. glslc -M a.vert b.vert -MJ deps.json
+      => <deps.json: JSON array with one entry per input file>
+    """
+    environment = Directory('.', [File('a.vert', MINIMAL_SHADER),
+                                  File('b.vert', MINIMAL_SHADER)])
+    glslc_args = ['-M', 'a.vert', 'b.vert', '-MJ', 'deps.json']
+    target_filename = 'deps.json'
+    expected_file_contents = [
+        '[\n'
+        '  {"target": "a.vert.spv", "source": "a.vert", '
+        '"dependencies": []},\n'
+        '  {"target": "b.vert.spv", "source": "b.vert", '
+        '"dependencies": []}\n'
+        ']\n']
+
+
+@inside_glslc_testsuite('OptionsCapM')
+class TestErrorMissingDependencyDatabaseFileName(expect.StderrMatch):
+    """Tests that the database file name is missing when -MJ is specified."""
+    environment = EMPTY_SHADER_IN_CURDIR
+    glslc_args = ['-M', 'shader.vert', '-MJ']
+    expected_stderr = ['glslc: error: '
+                       'missing dependency database filename after \'-MJ\'\n']
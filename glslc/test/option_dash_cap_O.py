@@ -178,3 +178,63 @@ class TestWrongOptLevel(expect.NoGeneratedFiles, expect.ErrorMessage):
     shader = FileShader(MINIMAL_SHADER, '.vert')
     glslc_args = ['-c', '-O2', shader]
     expected_error = "glslc: error: invalid value '2' in '-O2'\n"
+
+
+SHADER_WITH_FUNCTION_CALL = """#version 310 es
+float f() { return 1.0; }
+void main() { gl_Position = vec4(f()); }"""
+
+
+@inside_glslc_testsuite('OptionDashCapO')
+class TestDashCapOconfig(expect.ValidAssemblyFileWithoutSubstr):
+    """Tests that -Oconfig runs the passes listed in the file."""
+
+    environment = Directory('.', [
+        File('passes.cfg', '--inline-entry-points-exhaustive\n'
+             'eliminate-dead-functions\n')])
+    shader = FileShader(SHADER_WITH_FUNCTION_CALL, '.vert')
+    glslc_args = ['-S', '-Oconfig=passes.cfg', shader]
+    unexpected_assembly_substr = 'OpFunctionCall'
+
+
+@inside_glslc_testsuite('OptionDashCapO')
+class TestDashCapOconfigReplacesTheLevel(expect.ValidAssemblyFileWithSubstr):
+    """Tests that the passes of -Oconfig run instead of those of -Os."""
+
+    environment = Directory('.', [File('passes.cfg', '--compact-ids')])
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-S', '-Os', '-Oconfig=passes.cfg', shader]
+    expected_assembly_substr = 'OpName %main "main"'
+
+
+@inside_glslc_testsuite('OptionDashCapO')
+class TestDashCapOAfterOconfig(expect.ValidAssemblyFileWithoutSubstr):
+    """Tests that a later -Os takes the place of -Oconfig."""
+
+    environment = Directory('.', [File('passes.cfg', '--compact-ids')])
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-S', '-Oconfig=passes.cfg', '-Os', shader]
+    unexpected_assembly_substr = 'OpName'
+
+
+@inside_glslc_testsuite('OptionDashCapO')
+class TestDashCapOconfigUnknownPass(expect.NoGeneratedFiles,
+                                    expect.ErrorMessage):
+    """Tests that -Oconfig rejects passes unknown to SPIRV-Tools."""
+
+    environment = Directory('.', [File('passes.cfg', '--strip-debug --bogus')])
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-c', '-Oconfig=passes.cfg', shader]
+    expected_error = ("glslc: error: passes.cfg: unknown optimization pass: "
+                      "'--bogus'\n")
+
+
+@inside_glslc_testsuite('OptionDashCapO')
+class TestDashCapOconfigMissingFile(expect.NoGeneratedFiles,
+                                   expect.ErrorMessageSubstr):
+    """Tests that -Oconfig reports a file it cannot read."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-c', '-Oconfig=missing.cfg', shader]
+    expected_error_substr = ("glslc: error: cannot read optimization config "
+                             "file: missing.cfg\n")
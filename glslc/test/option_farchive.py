@@ -0,0 +1,125 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import expect
+import os
+import struct
+from environment import File, Directory
+from glslc_test_framework import inside_glslc_testsuite
+
+MINIMAL_SHADER = '#version 140\nvoid main() {}'
+SPIRV_MAGIC = 0x07230203
+ARCHIVE_MAGIC = 0x52414853
+
+
+def read_archive(path):
+    """Returns a dict from entry name to entry data of a shader archive, or
+    an error message string."""
+    with open(path, 'rb') as f:
+        archive = f.read()
+    magic, version, count, names_offset, names_size = struct.unpack_from(
+        '<5I', archive, 0)
+    if magic != ARCHIVE_MAGIC or version != 1:
+        return 'bad archive header'
+    entries = {}
+    for i in range(count):
+        (_, _, name_offset, name_size, data_offset,
+         data_size) = struct.unpack_from('<6I', archive, 20 + 24 * i)
+        if data_offset % 4 != 0:
+            return 'unaligned data'
+        name = archive[name_offset:name_offset + name_size].decode('utf-8')
+        entries[name] = archive[data_offset:data_offset + data_size]
+    return entries
+
+
+class ValidArchive(expect.SuccessfulReturn):
+    """Mixin class to check that the archive holds SPIR-V modules with the
+    expected names, which are not also written as files of their own.
+    To mix in this class, subclasses need to provide archive_filename and
+    expected_entry_names."""
+
+    def check_archive(self, status):
+        path = os.path.join(status.directory, self.archive_filename)
+        if not os.path.isfile(path):
+            return False, 'Cannot find archive: ' + path
+        entries = read_archive(path)
+        if isinstance(entries, str):
+            return False, entries
+        if sorted(entries) != sorted(self.expected_entry_names):
+            return False, 'Unexpected archive entries: ' + str(sorted(entries))
+        for name, data in entries.items():
+            if (len(data) < 4 or
+                    struct.unpack_from('<I', data)[0] != SPIRV_MAGIC):
+                return False, 'Entry is not a SPIR-V module: ' + name
+            if os.path.exists(os.path.join(status.directory, name)):
+                return False, 'Output written outside the archive: ' + name
+        return True, ''
+
+
+@inside_glslc_testsuite('OptionFArchive')
+class TestArchiveOfInputFiles(ValidArchive):
+    """Tests that -c with several input files writes them into one archive."""
+    environment = Directory('.', [
+        File('a.vert', MINIMAL_SHADER),
+        File('b.frag', MINIMAL_SHADER)])
+    glslc_args = ['-c', 'a.vert', 'b.frag', '-farchive=shaders.shar']
+    archive_filename = 'shaders.shar'
+    expected_entry_names = ['a.vert.spv', 'b.frag.spv']
+
+
+@inside_glslc_testsuite('OptionFArchive')
+class TestArchiveOfBatchJobs(ValidArchive):
+    """Tests that batch jobs are archived under their output names."""
+    environment = Directory('.', [
+        File('a.vert', MINIMAL_SHADER),
+        File('manifest.json',
+             '{"jobs": [{"input": "a.vert", "output": "plain.spv"},\n'
+             '          {"input": "a.vert", "output": "variant.spv",'
+             ' "defines": ["VARIANT"]}]}')])
+    glslc_args = ['--batch=manifest.json', '-j', '2',
+                  '-farchive=shaders.shar']
+    archive_filename = 'shaders.shar'
+    expected_entry_names = ['plain.spv', 'variant.spv']
+
+
+@inside_glslc_testsuite('OptionFArchive')
+class TestArchiveDuplicateEntry(expect.ErrorMessageSubstr):
+    """Tests that two outputs with the same name are an error."""
+    environment = Directory('.', [
+        File('a.vert', MINIMAL_SHADER),
+        File('manifest.json',
+             '{"jobs": [{"input": "a.vert", "output": "same.spv"},\n'
+             '          {"input": "a.vert", "output": "same.spv"}]}')])
+    glslc_args = ['--batch=manifest.json', '-farchive=shaders.shar']
+    expected_error_substr = \
+        "glslc: error: more than one output named 'same.spv' in archive\n"
+
+
+@inside_glslc_testsuite('OptionFArchive')
+class TestArchiveRequiresBinaryOutput(expect.ErrorMessage):
+    """Tests that -farchive cannot be used with assembly output."""
+    environment = Directory('.', [File('a.vert', MINIMAL_SHADER)])
+    glslc_args = ['-S', 'a.vert', '-farchive=shaders.shar']
+    expected_error = [
+        'glslc: error: -farchive requires SPIR-V binary output\n']
+
+
+@inside_glslc_testsuite('OptionFArchive')
+class TestArchiveMissingFileName(expect.ErrorMessage):
+    """Tests that -farchive= needs a file name."""
+    environment = Directory('.', [File('a.vert', MINIMAL_SHADER)])
+    glslc_args = ['-c', 'a.vert', '-farchive=']
+    expected_error = [
+        "glslc: error: missing archive file name in '-farchive='\n"]
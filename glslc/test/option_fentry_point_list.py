@@ -0,0 +1,68 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+
+import expect
+from environment import File, Directory
+from glslc_test_framework import inside_glslc_testsuite
+
+MINIMAL_SHADER = '#version 140\nvoid main() {}'
+HLSL_SHADER = (
+    'float4 VSMain() : SV_POSITION { return float4(1.0, 1.0, 1.0, 1.0); }\n'
+    'float4 PSMain() : SV_Target0 { return float4(0.0, 0.0, 0.0, 1.0); }\n')
+
+
+@inside_glslc_testsuite('OptionFEntryPointList')
+class TestEntryPointListHlsl(expect.ValidNamedObjectFile):
+    """Tests that each entry point of an HLSL file gets its own object
+    file."""
+
+    uses_hlsl = True
+    environment = Directory('.', [File('a.hlsl', HLSL_SHADER)])
+    glslc_args = ['-c', '-fentry-point=VSMain:vert,PSMain:frag', 'a.hlsl']
+    expected_object_filenames = ('a.VSMain.spv', 'a.PSMain.spv')
+
+
+@inside_glslc_testsuite('OptionFEntryPointList')
+class TestEntryPointListWithOutputName(expect.ValidNamedObjectFile):
+    """Tests that -o names the base of the output file names."""
+
+    uses_hlsl = True
+    environment = Directory('.', [File('a.hlsl', HLSL_SHADER)])
+    glslc_args = ['-c', '-fentry-point=VSMain:vert,PSMain:frag', 'a.hlsl',
+                  '-o', 'out.spv']
+    expected_object_filenames = ('out.VSMain.spv', 'out.PSMain.spv')
+
+
+@inside_glslc_testsuite('OptionFEntryPointList')
+class TestEntryPointListUnknownStage(expect.ErrorMessage):
+    """Tests that every entry point in the list needs a known stage."""
+
+    environment = Directory('.', [File('a.glsl', MINIMAL_SHADER)])
+    glslc_args = ['-c', '-fentry-point=main:vert,main:pixel', 'a.glsl']
+    expected_error = [
+        "glslc: error: invalid entry point list 'main:vert,main:pixel' in "
+        "'-fentry-point=main:vert,main:pixel'\n"]
+
+
+@inside_glslc_testsuite('OptionFEntryPointList')
+class TestEntryPointListMissingStage(expect.ErrorMessage):
+    """Tests that every entry point in the list needs a stage."""
+
+    environment = Directory('.', [File('a.glsl', MINIMAL_SHADER)])
+    glslc_args = ['-c', '-fentry-point=main:vert,main', 'a.glsl']
+    expected_error = [
+        "glslc: error: invalid entry point list 'main:vert,main' in "
+        "'-fentry-point=main:vert,main'\n"]
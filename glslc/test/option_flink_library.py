@@ -0,0 +1,55 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import expect
+from environment import File, Directory
+from glslc_test_framework import inside_glslc_testsuite
+from placeholder import FileShader
+
+LIBRARY_SHADER = """#version 450
+float twice(float x) { return 2.0 * x; }
+"""
+
+
+@inside_glslc_testsuite('OptionFLinkLibrary')
+class TestFCompileForLinkingExportsFunctions(
+        expect.ValidAssemblyFileWithSubstr):
+    """Tests that -fcompile-for-linking exports the defined functions of a
+    source without an entry point."""
+
+    shader = FileShader(LIBRARY_SHADER, '.frag')
+    glslc_args = ['-S', '-fcompile-for-linking', shader]
+    expected_assembly_substrings = ['OpCapability Linkage',
+                                    'LinkageAttributes', 'Export']
+
+
+@inside_glslc_testsuite('OptionFLinkLibrary')
+class TestFLinkLibraryMissingFileName(expect.ErrorMessage):
+    """Tests that -flink-library needs a file name."""
+
+    shader = FileShader(LIBRARY_SHADER, '.frag')
+    glslc_args = ['-c', '-flink-library=', shader]
+    expected_error = ("glslc: error: missing library file name in "
+                      "'-flink-library='\n")
+
+
+@inside_glslc_testsuite('OptionFLinkLibrary')
+class TestFLinkLibraryNotSpirv(expect.ErrorMessage):
+    """Tests that the library file must hold a SPIR-V module."""
+
+    environment = Directory('.', [
+        File('a.frag', LIBRARY_SHADER),
+        File('lib.spv', 'not a module')])
+    glslc_args = ['-c', '-flink-library=lib.spv', 'a.frag']
+    expected_error = "glslc: error: 'lib.spv' is not a SPIR-V module\n"
@@ -0,0 +1,115 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import expect
+import json
+import os
+from glslc_test_framework import inside_glslc_testsuite
+from placeholder import FileShader
+
+MACRO_SHADER = """#version 450
+layout(local_size_x = 1) in;
+layout(std430, binding = 0) buffer B { int tile_size; float scale; };
+void main() {
+  tile_size = TILE_SIZE;
+  scale = SCALE;
+}
+"""
+
+
+class ValidMacroSpecMap(expect.SuccessfulReturn):
+    """Mixin class to check the JSON file written by -fmacro-spec-map.
+    To mix in this class, subclasses need to provide expected_map as a dict
+    of SpecIds by macro name."""
+
+    def check_macro_spec_map(self, status):
+        path = os.path.join(status.directory, 'map.json')
+        if not os.path.isfile(path):
+            return False, 'Cannot find map file: ' + path
+        with open(path) as f:
+            try:
+                spec_map = json.load(f)
+            except ValueError as e:
+                return False, 'Map is not valid JSON: ' + str(e)
+        if spec_map != self.expected_map:
+            return False, 'Unexpected map: ' + str(spec_map)
+        return True, ''
+
+
+@inside_glslc_testsuite('OptionFMacroSpecConstant')
+class TestFMacroSpecConstantDeclaresTheConstant(
+        expect.ValidAssemblyFileWithSubstr):
+    """Tests that the macro becomes a spec constant with the given SpecId."""
+
+    shader = FileShader(MACRO_SHADER, '.comp')
+    glslc_args = ['-S', '-DTILE_SIZE=8', '-DSCALE=0.5',
+                  '-fmacro-spec-constant=TILE_SIZE=3', shader]
+    expected_assembly_substr = 'OpDecorate %TILE_SIZE SpecId 3'
+
+
+@inside_glslc_testsuite('OptionFMacroSpecConstant')
+class TestFMacroSpecConstantHasTheMacroValue(
+        expect.ValidAssemblyFileWithSubstr):
+    """Tests that the spec constant defaults to the value of the macro."""
+
+    shader = FileShader(MACRO_SHADER, '.comp')
+    glslc_args = ['-S', '-DTILE_SIZE=8', '-DSCALE=0.5',
+                  '-fmacro-spec-constant=SCALE=3', shader]
+    expected_assembly_substr = '%SCALE = OpSpecConstant %float 0.5'
+
+
+@inside_glslc_testsuite('OptionFMacroSpecConstant')
+class TestFMacroSpecConstantNextSpecId(expect.ValidAssemblyFileWithSubstr):
+    """Tests that a macro without a SpecId gets the one after the previous
+    macro's."""
+
+    shader = FileShader(MACRO_SHADER, '.comp')
+    glslc_args = ['-S', '-DTILE_SIZE=8', '-DSCALE=0.5',
+                  '-fmacro-spec-constant=TILE_SIZE=3',
+                  '-fmacro-spec-constant=SCALE', shader]
+    expected_assembly_substr = 'OpDecorate %SCALE SpecId 4'
+
+
+@inside_glslc_testsuite('OptionFMacroSpecConstant')
+class TestFMacroSpecMap(ValidMacroSpecMap):
+    """Tests that -fmacro-spec-map writes the SpecId of each macro."""
+
+    shader = FileShader(MACRO_SHADER, '.comp')
+    glslc_args = ['-c', '-DTILE_SIZE=8', '-DSCALE=0.5',
+                  '-fmacro-spec-constant=TILE_SIZE',
+                  '-fmacro-spec-constant=SCALE=7',
+                  '-fmacro-spec-map=map.json', shader]
+    expected_map = {'TILE_SIZE': 0, 'SCALE': 7}
+
+
+@inside_glslc_testsuite('OptionFMacroSpecConstant')
+class TestFMacroSpecConstantUndefinedMacro(expect.ErrorMessage):
+    """Tests that a macro that is not defined is an error."""
+
+    shader = FileShader(MACRO_SHADER, '.comp')
+    glslc_args = ['-c', '-DSCALE=0.5', '-fmacro-spec-constant=TILE_SIZE',
+                  shader]
+    expected_error = [
+        shader, ": error: macro 'TILE_SIZE' is not defined, so it cannot be "
+        'a specialization constant\n', '1 error generated.\n']
+
+
+@inside_glslc_testsuite('OptionFMacroSpecConstant')
+class TestFMacroSpecConstantInvalidSpecId(expect.ErrorMessage):
+    """Tests that the SpecId must be a number."""
+
+    shader = FileShader(MACRO_SHADER, '.comp')
+    glslc_args = ['-c', '-fmacro-spec-constant=TILE_SIZE=x', shader]
+    expected_error = ("glslc: error: invalid value 'TILE_SIZE=x' in "
+                      "'-fmacro-spec-constant=TILE_SIZE=x'\n")
@@ -0,0 +1,103 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+
+import expect
+from glslc_test_framework import inside_glslc_testsuite
+from placeholder import FileShader
+from environment import File, Directory
+
+
+@inside_glslc_testsuite('OptionFPreprocessed')
+class TestFPreprocessedCompiles(expect.ValidObjectFile):
+    """Tests that preprocessed input compiles to an object file."""
+
+    shader = FileShader('#version 140\nvoid main() { }\n', '.vert')
+    glslc_args = ['-c', '-fpreprocessed', shader]
+
+
+@inside_glslc_testsuite('OptionFPreprocessed')
+class TestFPreprocessedStageFromPragma(expect.ValidObjectFile):
+    """Tests that the stage of preprocessed input may come from a #pragma."""
+
+    shader = FileShader(
+        '#version 140\n#pragma shader_stage(vertex)\nvoid main() { }\n',
+        '.glsl')
+    glslc_args = ['-c', '-fpreprocessed', shader]
+
+
+@inside_glslc_testsuite('OptionFPreprocessed')
+class TestFPreprocessedWithDashCapE(expect.StdoutMatch):
+    """Tests that -E passes preprocessed input through unchanged."""
+
+    shader = FileShader('#version 140\nvoid main(){ int a = X; }', '.vert')
+    expected_stdout = '#version 140\nvoid main(){ int a = X; }'
+    glslc_args = ['-DX=4', '-E', '-fpreprocessed', shader]
+
+
+@inside_glslc_testsuite('OptionFPreprocessed')
+class TestFPreprocessedIgnoresDefines(expect.ErrorMessageSubstr):
+    """Tests that -D definitions do not apply to preprocessed input."""
+
+    shader = FileShader('#version 140\nvoid main(){ int a = X; }', '.vert')
+    expected_error_substr = "'X' : undeclared identifier"
+    glslc_args = ['-c', '-DX=4', '-fpreprocessed', shader]
+
+
+@inside_glslc_testsuite('OptionFPreprocessed')
+class TestFPreprocessedRejectsInclude(expect.ErrorMessageSubstr):
+    """Tests that preprocessed input may not include other files."""
+
+    shader = FileShader(
+        '#version 140\n#extension GL_GOOGLE_include_directive : enable\n'
+        '#include "a.glsl"\nvoid main() { }\n', '.vert')
+    expected_error_substr = 'error:'
+    glslc_args = ['-c', '-fpreprocessed', shader]
+
+
+# The output of glslc -E for a shader that #includes a sibling file, which
+# carries the #extension and #line directives that -E injects.
+PREPROCESSED_INCLUDE = \
+"""#version 140
+#extension GL_GOOGLE_include_directive : enable
+#line 0 "a.vert"
+
+void foo() { }
+#line 0 "b"
+ void main() { foo(); }
+#line 3 "a.vert"
+
+"""
+
+
+@inside_glslc_testsuite('OptionFPreprocessed')
+class TestFPreprocessedIncludeInputMatchesDashCapE(expect.StdoutMatch):
+    """Tests that PREPROCESSED_INCLUDE is what -E emits for its source."""
+
+    environment = Directory('.', [
+        File('a.vert', '#version 140\nvoid foo() { }\n#include "b"\n'),
+        File('b', 'void main() { foo(); }\n')])
+    expected_stdout = PREPROCESSED_INCLUDE
+    glslc_args = ['-E', 'a.vert']
+
+
+@inside_glslc_testsuite('OptionFPreprocessed')
+class TestFPreprocessedCompilesDashCapEOutputWithInclude(
+        expect.ValidObjectFile):
+    """Tests that -E output with injected #extension and #line directives
+    compiles as preprocessed input."""
+
+    environment = Directory('.', [File('a.vert', PREPROCESSED_INCLUDE)])
+    glslc_args = ['-c', '-fpreprocessed', 'a.vert']
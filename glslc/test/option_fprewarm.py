@@ -0,0 +1,80 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import expect
+from environment import File, Directory
+from glslc_test_framework import inside_glslc_testsuite
+
+MINIMAL_SHADER = '#version 140\nvoid main() {}'
+ES_SHADER = '#version 310 es\nvoid main() {}'
+
+
+@inside_glslc_testsuite('OptionFPrewarm')
+class TestPrewarmBatch(expect.ValidNamedObjectFile):
+    """Tests that --batch compiles as usual after prewarming."""
+    environment = Directory('.', [
+        File('a.vert', MINIMAL_SHADER),
+        File('b.frag', MINIMAL_SHADER),
+        File('manifest.json',
+             '{"jobs": [{"input": "a.vert"}, {"input": "b.frag"}]}')])
+    glslc_args = ['--batch=manifest.json', '-j', '2', '-fprewarm']
+    expected_object_filenames = ('a.vert.spv', 'b.frag.spv')
+
+
+@inside_glslc_testsuite('OptionFPrewarm')
+class TestPrewarmVersions(expect.ValidNamedObjectFile):
+    """Tests that -fprewarm takes a list of versions, including es ones."""
+    environment = Directory('.', [
+        File('a.vert', MINIMAL_SHADER),
+        File('b.comp', ES_SHADER)])
+    glslc_args = ['-c', '-j', '2', 'a.vert', 'b.comp',
+                  '-fprewarm=140,310,450']
+    expected_object_filenames = ('a.vert.spv', 'b.comp.spv')
+
+
+@inside_glslc_testsuite('OptionFPrewarm')
+class TestPrewarmSkipsStagesFromSource(expect.ValidObjectFile):
+    """Tests that files whose stage comes from a #pragma are compiled as
+    usual."""
+    environment = Directory('.', [
+        File('a.glsl', '#version 140\n#pragma shader_stage(vertex)\n'
+                       'void main() {}')])
+    glslc_args = ['-c', 'a.glsl', '-fprewarm']
+
+
+@inside_glslc_testsuite('OptionFPrewarm')
+class TestPrewarmWithForcedVersion(expect.ValidObjectFile):
+    """Tests that -fprewarm works with the version given by -std."""
+    environment = Directory('.', [File('a.frag', ES_SHADER)])
+    glslc_args = ['-c', 'a.frag', '-std=310es', '-fprewarm']
+
+
+@inside_glslc_testsuite('OptionFPrewarm')
+class TestPrewarmInvalidVersion(expect.ErrorMessage):
+    """Tests that -fprewarm= rejects unknown GLSL versions."""
+    environment = Directory('.', [File('a.vert', MINIMAL_SHADER)])
+    glslc_args = ['-c', 'a.vert', '-fprewarm=450,451']
+    expected_error = [
+        "glslc: error: invalid GLSL versions '450,451' in "
+        "'-fprewarm=450,451'\n"]
+
+
+@inside_glslc_testsuite('OptionFPrewarm')
+class TestPrewarmEmptyVersions(expect.ErrorMessage):
+    """Tests that -fprewarm= needs at least one version."""
+    environment = Directory('.', [File('a.vert', MINIMAL_SHADER)])
+    glslc_args = ['-c', 'a.vert', '-fprewarm=']
+    expected_error = [
+        "glslc: error: invalid GLSL versions '' in '-fprewarm='\n"]
@@ -0,0 +1,47 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import expect
+from glslc_test_framework import inside_glslc_testsuite
+from placeholder import FileShader
+
+MINIMAL_SHADER = '#version 140\nvoid main() { }\n'
+
+
+@inside_glslc_testsuite('OptionFRawId')
+class TestFRawIdWritesNumberedIds(expect.ValidAssemblyFileWithoutSubstr):
+    """Tests that -fraw-id does not name ids after the names in the
+    module."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-S', '-fraw-id', shader]
+    unexpected_assembly_substr = '%main = OpFunction'
+
+
+@inside_glslc_testsuite('OptionFRawId')
+class TestFRawIdKeepsNames(expect.ValidAssemblyFileWithSubstr):
+    """Tests that -fraw-id keeps the OpName instructions of the module."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-S', '-fraw-id', shader]
+    expected_assembly_substr = 'OpName %4 "main"'
+
+
+@inside_glslc_testsuite('OptionFRawId')
+class TestNoFRawIdWritesFriendlyNames(expect.ValidAssemblyFileWithSubstr):
+    """Tests that ids are named after the names in the module by default."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-S', shader]
+    expected_assembly_substr = '%main = OpFunction'
@@ -0,0 +1,154 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import expect
+import json
+import os
+from environment import File, Directory
+from glslc_test_framework import inside_glslc_testsuite
+
+VERTEX_SHADER = """#version 450
+layout(location = 1) in vec3 position;
+layout(location = 0) out vec2 uv;
+void main() {
+  gl_Position = vec4(position, 1.0);
+  uv = position.xy;
+}
+"""
+
+COMPUTE_SHADER = """#version 450
+layout(local_size_x = 8, local_size_y = 8) in;
+void main() {}
+"""
+
+FRAGMENT_SHADER = """#version 450
+layout(set = 1, binding = 2) uniform sampler2D tex;
+layout(location = 0) out vec4 color;
+void main() { color = texture(tex, vec2(0.5)); }
+"""
+
+
+class ValidReflection(expect.SuccessfulReturn):
+    """Mixin class to check the JSON file written by -freflect.
+    To mix in this class, subclasses need to provide expected_reflection as a
+    dict from output file name to the expected members of its reflection."""
+
+    def check_reflection(self, status):
+        path = os.path.join(status.directory, 'reflect.json')
+        if not os.path.isfile(path):
+            return False, 'Cannot find reflection file: ' + path
+        with open(path) as f:
+            try:
+                reflection = json.load(f)
+            except ValueError as e:
+                return False, 'Reflection is not valid JSON: ' + str(e)
+        if sorted(reflection) != sorted(self.expected_reflection):
+            return False, 'Unexpected outputs: ' + str(sorted(reflection))
+        for output, members in self.expected_reflection.items():
+            for name, value in members.items():
+                if reflection[output].get(name) != value:
+                    return False, 'Unexpected {} of {}: {}'.format(
+                        name, output, reflection[output].get(name))
+        return True, ''
+
+
+@inside_glslc_testsuite('OptionFReflect')
+class TestFReflectStageVariablesAndWorkgroupSize(ValidReflection):
+    """Tests that -freflect describes each output, with the stage variables
+    that are not built-in, and the workgroup size of compute shaders."""
+
+    environment = Directory('.', [
+        File('a.vert', VERTEX_SHADER),
+        File('b.comp', COMPUTE_SHADER)])
+    glslc_args = ['-c', 'a.vert', 'b.comp', '-freflect=reflect.json']
+    expected_reflection = {
+        'a.vert.spv': {
+            'inputs': [{'name': 'position', 'type': 'vec3',
+                        'array_size': 1, 'location': 1}],
+            'outputs': [{'name': 'uv', 'type': 'vec2', 'array_size': 1,
+                         'location': 0}],
+            'resources': [],
+            'push_constants': [],
+        },
+        'b.comp.spv': {
+            'workgroup_size': [8, 8, 1],
+            'resources': [],
+        },
+    }
+
+
+@inside_glslc_testsuite('OptionFReflect')
+class TestFReflectDescriptor(ValidReflection):
+    """Tests that -freflect describes the set and binding of a descriptor."""
+
+    environment = Directory('.', [File('c.frag', FRAGMENT_SHADER)])
+    glslc_args = ['-c', 'c.frag', '-freflect=reflect.json']
+    expected_reflection = {
+        'c.frag.spv': {
+            'resources': [{'name': 'tex', 'type': 'sampler2D',
+                           'array_size': 1,
+                           'kind': 'combined_image_sampler', 'set': 1,
+                           'binding': 2}],
+        },
+    }
+
+
+@inside_glslc_testsuite('OptionFReflect')
+class TestFReflectLinkedProgram(ValidReflection):
+    """Tests that -freflect describes each stage of linked input files on its
+    own."""
+
+    environment = Directory('.', [
+        File('a.vert', VERTEX_SHADER),
+        File('a.frag', """#version 450
+layout(location = 0) in vec2 uv;
+layout(location = 0) out vec4 color;
+void main() { color = vec4(uv, 0.0, 1.0); }
+""")])
+    glslc_args = ['a.vert', 'a.frag', '-freflect=reflect.json']
+    expected_reflection = {
+        'a.vert.spv': {
+            'inputs': [{'name': 'position', 'type': 'vec3',
+                        'array_size': 1, 'location': 1}],
+            'outputs': [{'name': 'uv', 'type': 'vec2', 'array_size': 1,
+                         'location': 0}],
+        },
+        'a.frag.spv': {
+            'inputs': [{'name': 'uv', 'type': 'vec2', 'array_size': 1,
+                        'location': 0}],
+            'outputs': [{'name': 'color', 'type': 'vec4', 'array_size': 1,
+                         'location': 0}],
+        },
+    }
+
+
+@inside_glslc_testsuite('OptionFReflect')
+class TestFReflectWithSyntaxOnly(ValidReflection):
+    """Tests that -freflect also describes shaders that are only checked."""
+
+    environment = Directory('.', [File('b.comp', COMPUTE_SHADER)])
+    glslc_args = ['-fsyntax-only', 'b.comp', '-freflect=reflect.json']
+    # Without -c, the output would be named after the input file.
+    expected_reflection = {'b.comp': {'workgroup_size': [8, 8, 1]}}
+
+
+@inside_glslc_testsuite('OptionFReflect')
+class TestFReflectMissingFileName(expect.ErrorMessage):
+    """Tests that -freflect needs a file name."""
+
+    environment = Directory('.', [File('b.comp', COMPUTE_SHADER)])
+    glslc_args = ['-c', 'b.comp', '-freflect=']
+    expected_error = ("glslc: error: missing reflection file name in "
+                      "'-freflect='\n")
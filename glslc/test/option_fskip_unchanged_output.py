@@ -0,0 +1,120 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import expect
+import os
+from environment import File, Directory
+from glslc_test_framework import inside_glslc_testsuite
+
+MINIMAL_SHADER = '#version 140\nvoid main() {}'
+# The modification time given to existing output files, in seconds since the
+# epoch.  Any rewrite of such a file moves its modification time to now.
+OLD_MTIME = 1000000000
+
+
+class OldFile(File):
+    """Specifies a file whose modification time is OLD_MTIME."""
+
+    def write(self, directory):
+        File.write(self, directory)
+        path = os.path.join(directory, self.name)
+        os.utime(path, (OLD_MTIME, OLD_MTIME))
+
+
+class OutputModificationTime(expect.GlslCTest):
+    """Mixin class to check whether the output file was rewritten.
+    To mix in this class, subclasses need to provide target_filename and
+    expect_rewritten."""
+
+    def check_output_modification_time(self, status):
+        path = os.path.join(status.directory, self.target_filename)
+        rewritten = os.path.getmtime(path) != OLD_MTIME
+        if rewritten != self.expect_rewritten:
+            return False, ('Output file was {}rewritten'.format(
+                '' if rewritten else 'not '))
+        leftovers = [name for name in os.listdir(status.directory)
+                     if '.tmp' in name]
+        if leftovers:
+            return False, 'Temporary files left behind: ' + str(leftovers)
+        return True, ''
+
+
+@inside_glslc_testsuite('OptionFSkipUnchangedOutput')
+class TestUnchangedOutputIsNotRewritten(expect.SuccessfulReturn,
+                                        expect.ValidFileContents,
+                                        OutputModificationTime):
+    """Tests that an output file holding the same contents is left alone."""
+    environment = Directory('.', [
+        File('shader.vert', MINIMAL_SHADER),
+        OldFile('dep_info', 'shader.vert.spv: shader.vert\n')])
+    glslc_args = ['-M', 'shader.vert', '-o', 'dep_info',
+                  '-fskip-unchanged-output']
+    target_filename = 'dep_info'
+    expected_file_contents = 'shader.vert.spv: shader.vert\n'
+    expect_rewritten = False
+
+
+@inside_glslc_testsuite('OptionFSkipUnchangedOutput')
+class TestChangedOutputIsRewritten(expect.SuccessfulReturn,
+                                   expect.ValidFileContents,
+                                   OutputModificationTime):
+    """Tests that an output file with other contents is replaced."""
+    environment = Directory('.', [
+        File('shader.vert', MINIMAL_SHADER),
+        OldFile('dep_info', 'shader.vert.spv: shader.vert old.h\n')])
+    glslc_args = ['-M', 'shader.vert', '-o', 'dep_info',
+                  '-fskip-unchanged-output']
+    target_filename = 'dep_info'
+    expected_file_contents = 'shader.vert.spv: shader.vert\n'
+    expect_rewritten = True
+
+
+@inside_glslc_testsuite('OptionFSkipUnchangedOutput')
+class TestSameSizeOutputIsRewritten(expect.SuccessfulReturn,
+                                    expect.ValidFileContents,
+                                    OutputModificationTime):
+    """Tests that an output file of the same size but other contents is
+    replaced."""
+    environment = Directory('.', [
+        File('shader.vert', MINIMAL_SHADER),
+        OldFile('dep_info', 'shader.vert.spv: shader.frag\n')])
+    glslc_args = ['-M', 'shader.vert', '-o', 'dep_info',
+                  '-fskip-unchanged-output']
+    target_filename = 'dep_info'
+    expected_file_contents = 'shader.vert.spv: shader.vert\n'
+    expect_rewritten = True
+
+
+@inside_glslc_testsuite('OptionFSkipUnchangedOutput')
+class TestCompiledOutputReplacesOldFile(expect.ValidNamedObjectFile,
+                                        OutputModificationTime):
+    """Tests that a compiled output file replaces a stale one."""
+    environment = Directory('.', [
+        File('shader.vert', MINIMAL_SHADER),
+        OldFile('out.spv', 'stale')])
+    glslc_args = ['-c', 'shader.vert', '-o', 'out.spv',
+                  '-fskip-unchanged-output']
+    expected_object_filenames = ('out.spv',)
+    target_filename = 'out.spv'
+    expect_rewritten = True
+
+
+@inside_glslc_testsuite('OptionFSkipUnchangedOutput')
+class TestStdoutIsUnaffected(expect.ReturnCodeIsZero,
+                             expect.StdoutMatch):
+    """Tests that output to standard output is still written."""
+    environment = Directory('.', [File('shader.vert', MINIMAL_SHADER)])
+    glslc_args = ['-M', 'shader.vert', '-fskip-unchanged-output']
+    expected_stdout = 'shader.vert.spv: shader.vert\n'
@@ -0,0 +1,83 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import expect
+from glslc_test_framework import inside_glslc_testsuite
+from placeholder import FileShader
+
+SPEC_CONSTANT_SHADER = """#version 450
+layout(constant_id = 3) const int N = 4;
+layout(local_size_x = 1) in;
+layout(std430, binding = 0) buffer B { int v[]; };
+void main() { v[0] = N; }
+"""
+
+
+@inside_glslc_testsuite('OptionFSpecConstant')
+class TestFSpecConstantFreezesTheConstant(expect.ValidAssemblyFileWithSubstr):
+    """Tests that -fspec-constant turns the spec constant into a regular
+    constant with the given value."""
+
+    shader = FileShader(SPEC_CONSTANT_SHADER, '.comp')
+    glslc_args = ['-S', '-O0', '-fspec-constant=3=8', shader]
+    expected_assembly_substr = '%N = OpConstant %int 8'
+
+
+@inside_glslc_testsuite('OptionFSpecConstant')
+class TestFSpecConstantRemovesTheSpecId(expect.ValidAssemblyFileWithoutSubstr):
+    """Tests that a frozen constant loses its SpecId decoration."""
+
+    shader = FileShader(SPEC_CONSTANT_SHADER, '.comp')
+    glslc_args = ['-S', '-O0', '-fspec-constant=3=8', shader]
+    unexpected_assembly_substr = 'SpecId'
+
+
+@inside_glslc_testsuite('OptionFSpecConstant')
+class TestFSpecConstantLastValueWins(expect.ValidAssemblyFileWithSubstr):
+    """Tests that the last value given for a SpecId is used."""
+
+    shader = FileShader(SPEC_CONSTANT_SHADER, '.comp')
+    glslc_args = ['-S', '-O0', '-fspec-constant=3=8', '-fspec-constant=3=0x10',
+                  shader]
+    expected_assembly_substr = '%N = OpConstant %int 16'
+
+
+@inside_glslc_testsuite('OptionFSpecConstant')
+class TestFSpecConstantOfOtherSpecId(expect.ValidAssemblyFileWithSubstr):
+    """Tests that spec constants with other SpecIds are left alone."""
+
+    shader = FileShader(SPEC_CONSTANT_SHADER, '.comp')
+    glslc_args = ['-S', '-O0', '-fspec-constant=4=8', shader]
+    expected_assembly_substr = '%N = OpSpecConstant %int 4'
+
+
+@inside_glslc_testsuite('OptionFSpecConstant')
+class TestFSpecConstantInvalidValue(expect.ErrorMessage):
+    """Tests that a value that does not fit the constant is an error."""
+
+    shader = FileShader(SPEC_CONSTANT_SHADER, '.comp')
+    glslc_args = ['-c', '-fspec-constant=3=eight', shader]
+    expected_error = [
+        shader, ': error: invalid value \'eight\' for 32-bit signed integer '
+        'specialization constant 3\n', '1 error generated.\n']
+
+
+@inside_glslc_testsuite('OptionFSpecConstant')
+class TestFSpecConstantMissingValue(expect.ErrorMessage):
+    """Tests that -fspec-constant needs both a SpecId and a value."""
+
+    shader = FileShader(SPEC_CONSTANT_SHADER, '.comp')
+    glslc_args = ['-c', '-fspec-constant=3', shader]
+    expected_error = ("glslc: error: invalid value '3' in "
+                      "'-fspec-constant=3'\n")
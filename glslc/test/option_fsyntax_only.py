@@ -0,0 +1,113 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+
+import expect
+from glslc_test_framework import inside_glslc_testsuite
+from placeholder import FileShader
+
+MINIMAL_SHADER = '#version 140\nvoid main() { }\n'
+ERROR_SHADER = '#version 140\nvoid main() { float a = b; }\n'
+# The vec4 follows the float directly, which only the scalar layout allows.
+SCALAR_LAYOUT_SHADER = """#version 450
+#extension GL_EXT_scalar_block_layout : require
+layout(local_size_x = 1) in;
+layout(scalar, binding = 0) buffer B { float x; vec4 v; };
+void main() { v = vec4(x); }
+"""
+
+
+@inside_glslc_testsuite('OptionFSyntaxOnly')
+class TestFSyntaxOnlyWritesNoOutput(expect.SuccessfulReturn,
+                                    expect.NoGeneratedFiles):
+    """Tests that -fsyntax-only writes no output file on success."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-fsyntax-only', shader]
+
+
+@inside_glslc_testsuite('OptionFSyntaxOnly')
+class TestFSyntaxOnlyManyFiles(expect.SuccessfulReturn,
+                               expect.NoGeneratedFiles):
+    """Tests that -fsyntax-only checks several files without -c, in
+    parallel."""
+
+    shader1 = FileShader(MINIMAL_SHADER, '.vert')
+    shader2 = FileShader(MINIMAL_SHADER, '.frag')
+    shader3 = FileShader(MINIMAL_SHADER, '.comp')
+    glslc_args = ['-fsyntax-only', '-j', '2', shader1, shader2, shader3]
+
+
+@inside_glslc_testsuite('OptionFSyntaxOnly')
+class TestFSyntaxOnlyWithDashS(expect.SuccessfulReturn,
+                               expect.NoGeneratedFiles):
+    """Tests that -fsyntax-only writes no assembly file either."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-S', '-fsyntax-only', shader]
+
+
+@inside_glslc_testsuite('OptionFSyntaxOnly')
+class TestFSyntaxOnlyValidate(expect.SuccessfulReturn,
+                              expect.NoGeneratedFiles):
+    """Tests that -fsyntax-only=validate writes no output file on success."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-fsyntax-only=validate', shader]
+
+
+@inside_glslc_testsuite('OptionFSyntaxOnly')
+class TestFSyntaxOnlyValidateScalarLayout(expect.SuccessfulReturn,
+                                          expect.NoGeneratedFiles):
+    """Tests that -fsyntax-only=validate accepts blocks in the scalar
+    layout."""
+
+    shader = FileShader(SCALAR_LAYOUT_SHADER, '.comp')
+    glslc_args = ['-fsyntax-only=validate', shader]
+
+
+@inside_glslc_testsuite('OptionFSyntaxOnly')
+class TestFSyntaxOnlyValidateHlslOffsets(expect.SuccessfulReturn,
+                                         expect.NoGeneratedFiles):
+    """Tests that -fsyntax-only=validate accepts the relaxed block layout
+    that -fhlsl-offsets gives."""
+
+    shader = FileShader(
+        '#version 450\n'
+        'layout(binding = 0) buffer B { float x; vec3 v; };\n'
+        'void main() { v = vec3(x); }\n', '.vert')
+    glslc_args = ['-fsyntax-only=validate', '-fhlsl-offsets', shader]
+
+
+@inside_glslc_testsuite('OptionFSyntaxOnly')
+class TestFSyntaxOnlyReportsErrors(expect.ErrorMessage):
+    """Tests that -fsyntax-only reports the errors in the source."""
+
+    shader = FileShader(ERROR_SHADER, '.vert')
+    glslc_args = ['-fsyntax-only', shader]
+    expected_error = [
+        shader, ":2: error: 'b' : undeclared identifier\n",
+        '1 error generated.\n']
+
+
+@inside_glslc_testsuite('OptionFSyntaxOnly')
+class TestFSyntaxOnlyInvalidValue(expect.ErrorMessage):
+    """Tests that -fsyntax-only= only accepts validate."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-fsyntax-only=everything', shader]
+    expected_error = [
+        "glslc: error: invalid value 'everything' in "
+        "'-fsyntax-only=everything'\n"]
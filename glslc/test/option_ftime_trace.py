@@ -0,0 +1,105 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import expect
+import json
+import os
+from environment import File, Directory
+from glslc_test_framework import inside_glslc_testsuite
+
+MINIMAL_SHADER = '#version 140\nvoid main() {}'
+
+
+class ValidTimeTrace(expect.SuccessfulReturn):
+    """Mixin class to check the spans of a Chrome trace file.
+    To mix in this class, subclasses need to provide expected_spans as a list
+    of (name, detail) pairs, where a detail of None matches any detail, and
+    expected_lane_names as a list of the thread names of the trace."""
+
+    def check_time_trace(self, status):
+        path = os.path.join(status.directory, 'trace.json')
+        if not os.path.isfile(path):
+            return False, 'Cannot find trace file: ' + path
+        with open(path) as f:
+            try:
+                trace = json.load(f)
+            except ValueError as e:
+                return False, 'Trace is not valid JSON: ' + str(e)
+        events = trace['traceEvents']
+        spans = [e for e in events if e['ph'] == 'X']
+        for span in spans:
+            if span['dur'] < 0 or span['ts'] < 0:
+                return False, 'Span has a negative time: ' + str(span)
+        for name, detail in self.expected_spans:
+            if not any(s['name'] == name and
+                       (detail is None or
+                        s.get('args', {}).get('detail') == detail)
+                       for s in spans):
+                return False, 'Missing span {} for {}: {}'.format(
+                    name, detail, spans)
+        lane_names = sorted(e['args']['name'] for e in events
+                            if e['ph'] == 'M')
+        if lane_names != sorted(self.expected_lane_names):
+            return False, 'Unexpected lanes: ' + str(lane_names)
+        return True, ''
+
+
+@inside_glslc_testsuite('OptionFTimeTrace')
+class TestTimeTraceCompilePhases(ValidTimeTrace):
+    """Tests that the phases of a compilation are traced."""
+    environment = Directory('.', [
+        File('a.vert', '#version 140\n#include "inc.glsl"\nvoid main() {}'),
+        File('inc.glsl', '\n')])
+    glslc_args = ['-c', 'a.vert', '-O', '-ftime-trace=trace.json']
+    expected_spans = [('Compile', 'a.vert'), ('ReadFile', 'a.vert'),
+                      ('ReadInclude', None), ('Parse', 'a.vert'),
+                      ('Link', 'a.vert'), ('GlslangToSpv', 'a.vert'),
+                      ('Optimize', 'a.vert'),
+                      ('Optimize: performance', None),
+                      ('WriteOutput', 'a.vert.spv')]
+    expected_lane_names = ['main']
+
+
+@inside_glslc_testsuite('OptionFTimeTrace')
+class TestTimeTracePreprocessAndDisassemble(ValidTimeTrace):
+    """Tests that preprocessing and disassembly are traced."""
+    environment = Directory('.', [
+        File('a.glsl', '#version 140\n#pragma shader_stage(vertex)\n'
+                       'void main() {}')])
+    glslc_args = ['-S', 'a.glsl', '-ftime-trace=trace.json']
+    expected_spans = [('Preprocess', 'a.glsl'), ('Disassemble', 'a.glsl'),
+                      ('WriteOutput', 'a.spvasm')]
+    expected_lane_names = ['main']
+
+
+@inside_glslc_testsuite('OptionFTimeTrace')
+class TestTimeTraceWorkerLanes(ValidTimeTrace):
+    """Tests that each worker thread gets its own lane."""
+    environment = Directory('.', [
+        File('a.vert', MINIMAL_SHADER),
+        File('b.frag', MINIMAL_SHADER)])
+    glslc_args = ['-c', '-j', '2', 'a.vert', 'b.frag',
+                  '-ftime-trace=trace.json']
+    expected_spans = [('Compile', 'a.vert'), ('Compile', 'b.frag')]
+    expected_lane_names = ['main', 'worker 1']
+
+
+@inside_glslc_testsuite('OptionFTimeTrace')
+class TestTimeTraceMissingFileName(expect.ErrorMessage):
+    """Tests that -ftime-trace= needs a file name."""
+    environment = Directory('.', [File('a.vert', MINIMAL_SHADER)])
+    glslc_args = ['-c', 'a.vert', '-ftime-trace=']
+    expected_error = [
+        "glslc: error: missing trace file name in '-ftime-trace='\n"]
@@ -0,0 +1,61 @@
+# Copyright 2026 The Shaderc Authors. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import expect
+from glslc_test_framework import inside_glslc_testsuite
+from placeholder import FileShader
+
+MINIMAL_SHADER = '#version 140\nvoid main() { }\n'
+
+
+@inside_glslc_testsuite('OptionFValidate')
+class TestFValidateNever(expect.ValidObjectFile):
+    """Tests that -fvalidate=never still compiles."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-c', '-O', '-fvalidate=never', shader]
+
+
+@inside_glslc_testsuite('OptionFValidate')
+class TestFValidateBeforeOpt(expect.ValidObjectFile):
+    """Tests that -fvalidate=before-opt compiles without optimization."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-c', '-fvalidate=before-opt', shader]
+
+
+@inside_glslc_testsuite('OptionFValidate')
+class TestFValidateAfterOpt(expect.ValidObjectFile):
+    """Tests that -fvalidate=after-opt compiles with optimization."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-c', '-O', '-fvalidate=after-opt', shader]
+
+
+@inside_glslc_testsuite('OptionFValidate')
+class TestFValidateAlways(expect.ValidAssemblyFile):
+    """Tests that -fvalidate=always compiles to assembly."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-S', '-Os', '-fvalidate=always', shader]
+
+
+@inside_glslc_testsuite('OptionFValidate')
+class TestFValidateInvalidValue(expect.ErrorMessage):
+    """Tests that -fvalidate= rejects unknown policies."""
+
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = ['-fvalidate=sometimes', shader]
+    expected_error = [
+        "glslc: error: invalid value 'sometimes' in '-fvalidate=sometimes'\n"]
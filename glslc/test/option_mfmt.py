@@ -13,6 +13,7 @@
 # limitations under the License.
 
 import expect
+import os
 import re
 from glslc_test_framework import inside_glslc_testsuite
 from placeholder import FileShader
@@ -24,6 +25,76 @@ MINIMAL_SHADER = '#version 140\nvoid main() {}'
 MINIMAL_SHADER_NUM_FORMAT_PATTERN = "^0x07230203.*[0-9a-f]$"
 MINIMAL_SHADER_C_FORMAT_PATTERN = "^\\{0x07230203.*[0-9a-f]\\}"
 ERROR_SHADER = '#version 140\n#error\nvoid main() {}'
+SPIRV_MAGIC = 0x07230203
+PACKED_MAGIC = b'SPVP'
+
+
+def unpack_spirv(packed):
+    """Returns the words of the given packed SPIR-V, as described in
+    libshaderc_util/packed_spirv.h, or an error message string."""
+    if packed[:4] != PACKED_MAGIC:
+        return 'not packed SPIR-V'
+    pos = [4]
+
+    def varint():
+        value, shift = 0, 0
+        while True:
+            byte = packed[pos[0]]
+            pos[0] += 1
+            value |= (byte & 0x7f) << shift
+            shift += 7
+            if byte < 0x80:
+                return value
+
+    def delta():
+        value = varint()
+        return (value >> 1) ^ -(value & 1)
+
+    if varint() != 1:
+        return 'unsupported version'
+    num_words = varint()
+    words = [SPIRV_MAGIC] + [varint() for _ in range(4)]
+    result_type, result = 0, 0
+    while pos[0] < len(packed):
+        opcode = varint()
+        info = varint()
+        flags, num_operands = info & 7, info >> 3
+        instruction = [opcode]
+        if flags & 1:
+            result_type = (result_type + delta()) & 0xffffffff
+            instruction.append(result_type)
+        if flags & 2:
+            result = (result + 1 + delta()) & 0xffffffff
+            instruction.append(result)
+        for _ in range(num_operands):
+            if flags & 4:
+                instruction.append((result - delta()) & 0xffffffff)
+            else:
+                instruction.append(varint())
+        instruction[0] |= len(instruction) << 16
+        words.extend(instruction)
+    if len(words) != num_words:
+        return 'wrong word count'
+    return words
+
+
+class ValidPackedFile(expect.SuccessfulReturn):
+    """Mixin class to check that a file holds packed SPIR-V that unpacks to a
+    module, and is smaller than the module.  To mix in this class, subclasses
+    need to provide target_filename."""
+
+    def check_packed_file(self, status):
+        path = os.path.join(status.directory, self.target_filename)
+        if not os.path.isfile(path):
+            return False, 'Cannot find file: ' + path
+        with open(path, 'rb') as f:
+            packed = f.read()
+        words = unpack_spirv(packed)
+        if isinstance(words, str):
+            return False, words
+        if len(packed) >= 4 * len(words):
+            return False, 'Packed SPIR-V is not smaller than the module'
+        return True, ''
 
 
 @inside_glslc_testsuite('OptionMfmt')
@@ -58,6 +129,27 @@ class TestFmtBinWorksWithDashC(expect.ValidObjectFile):
     glslc_args = [shader, '-c', '-mfmt=bin']
 
 
+@inside_glslc_testsuite('OptionMfmt')
+class TestFmtPackedWorksWithDashC(ValidPackedFile):
+    """Tests that -mfmt=packed works with -c for single input file. SPIR-V
+    binary code should be emitted as packed SPIR-V in the output file.
+    """
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = [shader, '-c', '-mfmt=packed', '-o', 'output_file']
+    target_filename = 'output_file'
+
+
+@inside_glslc_testsuite('OptionMfmt')
+class TestFmtPackedWithOptimization(ValidPackedFile):
+    """Tests that -mfmt=packed packs optimized SPIR-V binary code."""
+    shader = FileShader(
+        '#version 450\nlayout(location=0) out vec4 c;\n'
+        'layout(location=0) in vec4 a;\nvoid main() { c = a * 2.0 + a; }',
+        '.frag')
+    glslc_args = [shader, '-c', '-O', '-mfmt=packed', '-o', 'output_file']
+    target_filename = 'output_file'
+
+
 @inside_glslc_testsuite('OptionMfmt')
 class TestFmtCWithLinking(expect.ValidFileContents):
     """Tests that -mfmt=c works when linkding is enabled (no -c specified).
@@ -116,6 +208,17 @@ class TestFmtBinErrorWhenOutputDisasembly(expect.ErrorMessage):
                       "when only preprocessing the source\n")
 
 
+@inside_glslc_testsuite('OptionMfmt')
+class TestFmtPackedErrorWhenOutputDisasembly(expect.ErrorMessage):
+    """Tests that specifying '-mfmt=packed' when the compiler is set to
+    disassembly mode should trigger an error.
+    """
+    shader = FileShader(MINIMAL_SHADER, '.vert')
+    glslc_args = [shader, '-mfmt=packed', '-S', '-o', 'output_file']
+    expected_error = ("glslc: error: cannot emit output as a packed binary "
+                      "when only preprocessing the source\n")
+
+
 @inside_glslc_testsuite('OptionMfmt')
 class TestFmtNumErrorWhenOutputPreprocess(expect.ErrorMessage):
     """Tests that specifying '-mfmt=num' when the compiler is set to
@@ -53,10 +53,19 @@ Usage: glslc [options] file...
 An input file of - represents standard input.
 
 Options:
+  --batch=<manifest>
+                    Compile the jobs described by the given JSON manifest,
+                    instead of input files, in parallel.  Each job may set its
+                    own input, output, stage, entry point, language, macros,
+                    include directories and dependency file, and otherwise
+                    uses the other options.  Implies -c.
   -c                Only run preprocess, compile, and assemble steps.
   -Dmacro[=defn]    Add an implicit macro definition.
   -E                Outputs only the results of the preprocessing step.
                     Output defaults to standard output.
+  -farchive=<file>  Write all compiled SPIR-V modules into a single indexed
+                    shader archive file, as entries named by their output
+                    file names, instead of into files of their own.
   -fauto-bind-uniforms
                     Automatically assign bindings to uniform variables that
                     don't have an explicit 'binding' layout in the shader
@@ -68,9 +77,24 @@ Options:
   -fauto-combined-image-sampler
                     Removes sampler variables and converts existing textures
                     to combined image-samplers.
+  -fcompile-for-linking
+                    Compile into SPIR-V modules to be linked with others, such
+                    as libraries for -flink-library: defined functions are
+                    exported, functions that are only declared are imported,
+                    and no entry point is needed.  Such modules are not
+                    validated.
+  -fdeps-scan       With -M or -MM, find dependencies by scanning only the
+                    preprocessor directives instead of fully preprocessing
+                    the source. Both branches of a conditional are followed
+                    unless its condition can be evaluated.
   -fentry-point=<name>
                     Specify the entry point name for HLSL compilation, for
                     all subsequent source files.  Default is "main".
+  -fentry-point=<name>:<stage>[,<name>:<stage>...]
+                    Compile each of the given entry points of all subsequent
+                    source files, as the given stage, into an output file of
+                    its own.  Each source file is preprocessed once, and its
+                    entry points are compiled in parallel.
   -fhlsl-16bit-types
                     Enable 16-bit type support for HLSL.
   -fhlsl_functionality1, -fhlsl-functionality1
@@ -87,13 +111,45 @@ Options:
                     several times, only the last setting takes effect.
   -flimit-file <file>
                     Set limits as specified in the given file.
+  -flink-library=<file>
+                    Link each compiled shader with the SPIR-V library in the
+                    given file, compiled with -fcompile-for-linking, so that
+                    the functions the shader declares are taken from it.  The
+                    library functions that the shader does not call are then
+                    removed.  May be given several times.
+  -fmacro-spec-constant=<macro>[=<id>]
+                    Make the -D macro <macro> a specialization constant with
+                    SpecId <id>, or by default with the SpecId after that of
+                    the previous such macro, starting at 0.  The macro expands
+                    to the constant wherever it is used as a value, so that
+                    one module serves every value of the macro.  Using it in
+                    #if expressions or layout qualifiers is an error.
+  -fmacro-spec-map=<file>
+                    Write the SpecIds of the macros given to
+                    -fmacro-spec-constant to the given file, as a JSON object.
   -fnan-clamp       Generate code for max and min builtins so that, when given
                     a NaN operand, the other operand is returned. Similarly,
                     the clamp builtin will favour the non-NaN operands, as if
                     clamp were implemented as a composition of max and min.
+  -fpreprocessed    Treat the input as the output of -E: do not run the
+                    preprocessor over it again, do not apply -D definitions,
+                    and reject #include directives.
   -fpreserve-bindings
                     Preserve all binding declarations, even if those bindings
                     are not used.
+  -fprewarm[=<version>,...]
+                    Before compiling, build the built-in symbol tables for
+                    the stages of all input files at the given GLSL versions,
+                    so that concurrent compilations with --batch or -j do not
+                    wait on each other to build them.  The default version is
+                    the one given by -std, or else 450.
+  -fraw-id          With -S, write ids as numbers, such as %4, instead of
+                    naming them after the names in the module, which is
+                    faster for large modules.
+  -freflect=<file>  Write the interface of each compiled shader to the given
+                    JSON file, by output file name: its descriptor sets and
+                    bindings, push constants, input and output locations and
+                    workgroup size.
   -fresource-set-binding [stage] <reg0> <set0> <binding0>
                         [<reg1> <set1> <binding1>...]
                     Explicitly sets the descriptor set and binding for
@@ -135,25 +191,55 @@ Options:
                     Treat subsequent input files as having stage <stage>.
                     Valid stages are vertex, vert, fragment, frag, tesscontrol,
                     tesc, tesseval, tese, geometry, geom, compute, and comp.
+  -fskip-unchanged-output
+                    Do not rewrite output files whose contents would not
+                    change, so that their timestamps are preserved.  Changed
+                    output files are replaced atomically.
+  -fspec-constant=<id>=<value>
+                    Freeze the specialization constant with SpecId <id> to
+                    <value> before optimization, so that the optimizer folds
+                    it like a regular constant.  May be given several times.
+  -fsyntax-only[=validate]
+                    Only check the input files for errors, and write no
+                    output files.  Compilation stops after parsing and
+                    linking, or with =validate, after the generated SPIR-V
+                    is validated.  No optimization is done.
+  -ftime-trace=<file>
+                    Write a Chrome Trace Event JSON file with the time spent
+                    in each phase of each compilation, including file reads
+                    and writes, with one lane per thread.
+  -fvalidate=<policy>
+                    When to check the SPIR-V with the SPIR-V validator:
+                    never, before-opt, after-opt, or always.  By default,
+                    only optimized SPIR-V is validated, before optimization.
   -g                Generate source-level debug information.
   -h                Display available options.
   --help            Display available options.
   -I <value>        Add directory to include search path.
+  -j <N>            Compile up to N input files or --batch jobs at the same
+                    time.  The default for --batch is the number of
+                    hardware threads, and 1 otherwise.
   -mfmt=<format>    Output SPIR-V binary code using the selected format. This
                     option may be specified only when the compilation output is
                     in SPIR-V binary code form. Available options are:
                       bin   - SPIR-V binary words.  This is the default.
                       c     - Binary words as C initializer list of 32-bit ints
                       num   - List of comma-separated 32-bit hex integers
+                      packed - SPIR-V binary in a compact, lossless encoding
   -M                Generate make dependencies. Implies -E and -w.
   -MM               An alias for -M.
   -MD               Generate make dependencies and compile.
   -MF <file>        Write dependency output to the given file.
+  -MJ <file>        Also write the dependency info of all input files to the
+                    given file as a JSON database.
   -MT <target>      Specify the target of the rule emitted by dependency
                     generation.
   -O                Optimize the generated SPIR-V code for better performance.
   -Os               Optimize the generated SPIR-V code for smaller size.
   -O0               Disable optimization.
+  -Oconfig=<file>   Run the optimization passes listed in <file>, as
+                    spirv-opt flags separated by whitespace, instead of
+                    those of the optimization level.
   -o <file>         Write output to <file>.
                     A file name of '-' represents standard output.
   -std=<value>      Version and profile for GLSL input files. Possible values
@@ -239,18 +325,6 @@ class FileNotFound(expect.ErrorMessage):
         "': No such file or directory\n"]
 
 
-@inside_glslc_testsuite('Unsupported')
-class LinkingNotSupported(expect.ErrorMessage):
-    """Tests the error message generated by linking not supported yet."""
-
-    shader1 = FileShader('#version 140\nvoid main() {}', '.vert')
-    shader2 = FileShader('#version 140\nvoid main() {}', '.frag')
-    glslc_args = [shader1, shader2]
-    expected_error = [
-        'glslc: error: linking multiple files is not supported yet. ',
-        'Use -c to compile files individually.\n']
-
-
 @inside_glslc_testsuite('Unsupported')
 class MultipleStdinUnsupported(expect.ErrorMessage):
     """Tests the error message generated by having more than one - input."""
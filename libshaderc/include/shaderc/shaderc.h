@@ -104,6 +104,22 @@ typedef enum {
   shaderc_optimization_level_performance,  // optimize towards performance
 } shaderc_optimization_level;
 
+// How far a compilation goes when it only checks its source.
+typedef enum {
+  shaderc_syntax_only_off,       // compile as usual
+  shaderc_syntax_only_parse,     // stop after parsing and linking
+  shaderc_syntax_only_validate,  // also generate SPIR-V, and validate it
+} shaderc_syntax_only_mode;
+
+// When the SPIR-V of a compilation is checked by the SPIR-V validator.
+typedef enum {
+  shaderc_validation_policy_default,  // only by the optimizer, before it runs
+  shaderc_validation_policy_never,    // not at all
+  shaderc_validation_policy_before_optimization,  // once generated
+  shaderc_validation_policy_after_optimization,   // once final
+  shaderc_validation_policy_always,  // both before and after optimization
+} shaderc_validation_policy;
+
 // Resource limits.
 typedef enum {
   shaderc_limit_max_lights,
@@ -311,6 +327,22 @@ SHADERC_EXPORT void shaderc_compile_options_add_macro_definition(
     shaderc_compile_options_t options, const char* name, size_t name_length,
     const char* value, size_t value_length);
 
+// Makes the predefined macro of the given name a specialization constant with
+// the given SpecId, so that one module serves every value of the macro instead
+// of one module per value.  The constant is declared with the value of the
+// macro as its default, which must be a boolean, integer or floating-point
+// literal, and its type follows from that literal.  Wherever the macro is used
+// as a value, it expands to the constant.  The macro stays defined for #ifdef,
+// but using it where a literal is required, such as in #if expressions or
+// layout qualifiers, fails the compilation.  So does a macro that is not
+// defined, or that has another kind of value.  Preprocessing-only
+// compilations, and input set as preprocessed, are unaffected.  Adding a
+// macro again replaces its SpecId.  The name is passed in as for
+// shaderc_compile_options_add_macro_definition.
+SHADERC_EXPORT void shaderc_compile_options_add_macro_spec_constant(
+    shaderc_compile_options_t options, const char* name, size_t name_length,
+    uint32_t spec_id);
+
 // Sets the source language.  The default is GLSL.
 SHADERC_EXPORT void shaderc_compile_options_set_source_language(
     shaderc_compile_options_t options, shaderc_source_language lang);
@@ -324,6 +356,58 @@ SHADERC_EXPORT void shaderc_compile_options_set_generate_debug_info(
 SHADERC_EXPORT void shaderc_compile_options_set_optimization_level(
     shaderc_compile_options_t options, shaderc_optimization_level level);
 
+// Sets the optimization passes to run instead of those of the optimization
+// level, as num_passes spirv-opt flags such as "--loop-unroll" or
+// "--scalar-replacement=100", in the order given.  The leading "--" may be left
+// out.  The passes are run by one optimizer, straight on the generated SPIR-V.
+// Only the last call of this function and
+// shaderc_compile_options_set_optimization_level() takes effect, and zero
+// passes restore the passes of the optimization level.  Returns false if
+// SPIRV-Tools does not know one of the passes, in which case compilations with
+// these options fail with an error naming the pass, until a later call of this
+// function or of shaderc_compile_options_set_optimization_level().
+SHADERC_EXPORT bool shaderc_compile_options_set_optimization_passes(
+    shaderc_compile_options_t options, const char** passes,
+    size_t num_passes);
+
+// An opaque handle to a cache of optimized SPIR-V modules, which compilations
+// share to skip the optimizer when their unoptimized SPIR-V, optimization
+// passes, target environment and optimizer options are the same as those of
+// an earlier compilation.  Variants of a shader that only differ in ways that
+// do not change the generated code, such as unused macros, then only pay for
+// optimization once.  The modules are kept in memory.  A cache may be used by
+// any number of options, compilers and threads at the same time.
+typedef struct shaderc_optimizer_cache* shaderc_optimizer_cache_t;
+
+// Returns a new empty cache, which keeps up to capacity_bytes bytes of modules
+// and drops the least recently used ones beyond that.  A return of NULL
+// indicates that the cache could not be created.
+SHADERC_EXPORT shaderc_optimizer_cache_t
+shaderc_optimizer_cache_create(size_t capacity_bytes);
+
+// Releases the cache.  Compilations that use it must be done, and it must not
+// be used by options again.  It is safe to pass NULL to this function.
+SHADERC_EXPORT void shaderc_optimizer_cache_release(
+    shaderc_optimizer_cache_t cache);
+
+// Drops all modules kept by the cache.
+SHADERC_EXPORT void shaderc_optimizer_cache_clear(
+    shaderc_optimizer_cache_t cache);
+
+// Returns the number of compilations that found their optimized SPIR-V in the
+// cache, and the number of those that did not and ran the optimizer.
+SHADERC_EXPORT size_t
+shaderc_optimizer_cache_get_num_hits(const shaderc_optimizer_cache_t cache);
+SHADERC_EXPORT size_t
+shaderc_optimizer_cache_get_num_misses(const shaderc_optimizer_cache_t cache);
+
+// Sets the cache that compilations with these options look up their optimized
+// SPIR-V in, and add it to, or NULL for none, which is the default.  The cache
+// is not owned by the options, and must outlive the compilations that use it.
+// Clones of the options share the cache.
+SHADERC_EXPORT void shaderc_compile_options_set_optimizer_cache(
+    shaderc_compile_options_t options, shaderc_optimizer_cache_t cache);
+
 // Forces the GLSL language version and profile to a given pair. The version
 // number is the same as would appear in the #version annotation in the source.
 // Version and profile specified here overrides the #version annotation in the
@@ -509,6 +593,139 @@ SHADERC_EXPORT void shaderc_compile_options_set_invert_y(
 SHADERC_EXPORT void shaderc_compile_options_set_nan_clamp(
     shaderc_compile_options_t options, bool enable);
 
+// Sets whether the source to compile is already preprocessed, as by
+// shaderc_compile_into_preprocessed_text, so that it has no #include
+// directives left and does not depend on predefined macros.  Such source is
+// parsed directly: the separate preprocessing pass is skipped, macro
+// definitions from the options are ignored, and #include directives are
+// errors.  The shader stage may still come from a #pragma shader_stage.
+SHADERC_EXPORT void shaderc_compile_options_set_input_preprocessed(
+    shaderc_compile_options_t options, bool preprocessed);
+
+// Sets how far compilations go when they only check their source, such as
+// for linting.  Unless the mode is shaderc_syntax_only_off, compilations to
+// SPIR-V or its assembly stop once the source is known to be correct, and
+// successful results have no output; only their diagnostics matter.  No
+// optimization is done.  With shaderc_syntax_only_validate, the SPIR-V is
+// also generated and checked by the SPIR-V validator, whose findings are
+// reported as errors.  Preprocessing-only compilations are not affected.
+SHADERC_EXPORT void shaderc_compile_options_set_syntax_only(
+    shaderc_compile_options_t options, shaderc_syntax_only_mode mode);
+
+// Sets when the SPIR-V of compilations is checked by the SPIR-V validator.
+// By default, only the SPIR-V that the optimizer runs on is validated, so
+// unoptimized compilations are not.  With
+// shaderc_validation_policy_before_optimization, the generated SPIR-V is
+// always validated, and with shaderc_validation_policy_after_optimization,
+// the SPIR-V that is output is, whether or not it was optimized.
+// shaderc_validation_policy_always does both, but validates only once if
+// there is no optimization.  shaderc_validation_policy_never skips
+// validation, for trusted builds.  Findings of the validator fail the
+// compilation with an error.  Syntax-only compilations with
+// shaderc_syntax_only_validate are validated whatever the policy.
+SHADERC_EXPORT void shaderc_compile_options_set_validation_policy(
+    shaderc_compile_options_t options, shaderc_validation_policy policy);
+
+// Sets whether SPIR-V assembly output names ids after the names in the module,
+// such as %main, which is the default, or by number, such as %4.  Numbered
+// ids skip the computation of the names, which is faster for large modules.
+// Applies to compilations to SPIR-V assembly and to shaderc_disassemble_spv.
+SHADERC_EXPORT void shaderc_compile_options_set_disassembly_friendly_names(
+    shaderc_compile_options_t options, bool friendly_names);
+
+// Sets whether compilations describe the interface of the shader, for
+// shaderc_result_get_reflection(): its descriptor sets and bindings, push
+// constants, stage inputs and outputs and workgroup size.  The description
+// comes from glslang's reflection of the shader after it is linked and its
+// bindings and locations are mapped, so it is of the shader as written,
+// before optimization.  Disabled by default.  Each stage of a program is
+// described on its own, as linked with the others, and the targets of a
+// compilation for several targets are described alike.  Preprocessing-only
+// compilations are not described.
+SHADERC_EXPORT void shaderc_compile_options_set_generate_reflection(
+    shaderc_compile_options_t options, bool enable);
+
+// Sets the value of the specialization constant with the given SpecId, as
+// given by layout(constant_id = spec_id), in the SPIR-V of compilations with
+// the given options.  The constant is frozen to that value before the
+// optimizer runs, so that the optimizer can fold it and unroll or remove the
+// code that depends on it, as if it were a regular constant.  Folding of spec
+// constant operations happens even at shaderc_optimization_level_zero.  The
+// value is read by the type of the constant: "true" or "false" for booleans,
+// decimal, "0x"-prefixed hexadecimal or "0"-prefixed octal numbers for
+// integers, and decimal numbers for floats.  As in GLSL, a hexadecimal or
+// octal value may set every bit of a signed integer, so "0xFFFFFFFF" is -1
+// for an int.  A value that does not fit the type fails the compilation with
+// an error.  Modules without a spec constant of that SpecId are unaffected.
+// Setting a SpecId again replaces its value.
+SHADERC_EXPORT void shaderc_compile_options_set_specialization_constant(
+    shaderc_compile_options_t options, uint32_t spec_id, const char* value);
+
+// Sets whether compilations with the given options produce SPIR-V modules to
+// be linked with others, such as libraries of functions, rather than shaders.
+// The functions that the source defines are exported, the functions that it
+// only declares are imported, and it needs no entry point.  Such modules keep
+// the Linkage capability, which Vulkan does not allow, so they are not
+// validated.  Default is false.
+SHADERC_EXPORT void shaderc_compile_options_set_compile_for_linking(
+    shaderc_compile_options_t options, bool enable);
+
+// Adds a SPIR-V library, compiled with
+// shaderc_compile_options_set_compile_for_linking(), to link the SPIR-V of
+// compilations with the given options with.  The words parameter points at
+// num_words words of the library, which are copied.  Shaders are compiled
+// for linking while there are libraries, and their imported functions are
+// resolved by the functions that the libraries export, before validation and
+// optimization.  The functions that the entry points of a shader do not call
+// are then removed, so that a shader only carries the library functions that
+// it uses.  A function that no library exports fails the compilation with an
+// error.  Libraries are not validated themselves, so a library can be
+// compiled once and linked with many shaders.
+SHADERC_EXPORT void shaderc_compile_options_add_link_library(
+    shaderc_compile_options_t options, const uint32_t* words,
+    size_t num_words);
+
+// Builds the built-in symbol tables that glslang needs for each of the given
+// shader stages at each of the given GLSL versions, as seen through the
+// target environment and source language of the given options (which may be
+// NULL), so that no later compilation has to pay for building them.
+// The stages parameter points at num_stages shader kinds.  A default shader
+// kind stands for its stage; shaderc_glsl_infer_from_source and
+// shaderc_spirv_assembly are not valid here.
+// The versions parameter points at num_versions GLSL versions, such as 450.
+// Versions 100, 300, 310 and 320 use the es profile.  If num_versions is 0,
+// the version forced by the options is used, or else the default version.
+// The tables are shared by all compilers in the process, and are kept until
+// the last compiler is released.
+// Returns false if a stage is not valid, or the options select an invalid
+// target environment.
+SHADERC_EXPORT bool shaderc_compiler_prewarm(
+    const shaderc_compiler_t compiler,
+    const shaderc_compile_options_t additional_options,
+    const shaderc_shader_kind* stages, size_t num_stages, const int* versions,
+    size_t num_versions);
+
+// How much shaderc_compiler_trim() releases.
+typedef enum {
+  // The compile contexts pooled by the compiler, with the optimizers and the
+  // SPIRV-Tools contexts they keep, and anything else the compiler caches.
+  shaderc_trim_level_caches,
+  // The above, and also the built-in symbol tables that glslang shares across
+  // all compilers in the process, such as those built by
+  // shaderc_compiler_prewarm().  They are built again when next needed.
+  shaderc_trim_level_all,
+} shaderc_trim_level;
+
+// Releases memory that the compiler keeps to speed up later compilations, as
+// selected by level, without releasing the compiler itself.
+// May be called from any thread.  With shaderc_trim_level_all, waits for the
+// compilations in progress in the process to finish, and holds off new ones
+// until it is done.
+// Returns the number of bytes by which the heap of the process shrank, or 0 if
+// the platform offers no way to tell.
+SHADERC_EXPORT size_t shaderc_compiler_trim(const shaderc_compiler_t compiler,
+                                            shaderc_trim_level level);
+
 // An opaque handle to the results of a call to any shaderc_compile_into_*()
 // function.
 typedef struct shaderc_compilation_result* shaderc_compilation_result_t;
@@ -555,12 +772,168 @@ SHADERC_EXPORT shaderc_compilation_result_t shaderc_compile_into_preprocessed_te
     const char* input_file_name, const char* entry_point_name,
     const shaderc_compile_options_t additional_options);
 
+// A piece of shader source, for the shaderc_compile_chunks_into_*()
+// functions.
+typedef struct {
+  // The text of the piece, which need not be null-terminated.
+  const char* text;
+  // The length of the text, in bytes.
+  size_t text_size;
+  // The null-terminated name that diagnostics in this piece are reported by.
+  const char* name;
+} shaderc_source_chunk;
+
+// Like shaderc_compile_into_spv, but the source is made of num_chunks pieces,
+// which are given to the compiler as separate strings, in order, without being
+// concatenated.  A #version directive may only be in the first piece, as it
+// must come first in the source.  Diagnostics in a piece are reported with the
+// name of that piece, and others with the name of the first piece.  The
+// chunks need only live until this returns.
+SHADERC_EXPORT shaderc_compilation_result_t shaderc_compile_chunks_into_spv(
+    const shaderc_compiler_t compiler, const shaderc_source_chunk* chunks,
+    size_t num_chunks, shaderc_shader_kind shader_kind,
+    const char* entry_point_name,
+    const shaderc_compile_options_t additional_options);
+
+// Like shaderc_compile_chunks_into_spv, but the result contains SPIR-V
+// assembly text instead of a SPIR-V binary module.
+SHADERC_EXPORT shaderc_compilation_result_t
+shaderc_compile_chunks_into_spv_assembly(
+    const shaderc_compiler_t compiler, const shaderc_source_chunk* chunks,
+    size_t num_chunks, shaderc_shader_kind shader_kind,
+    const char* entry_point_name,
+    const shaderc_compile_options_t additional_options);
+
+// Like shaderc_compile_chunks_into_spv, but the result contains preprocessed
+// source code instead of a SPIR-V binary module.
+SHADERC_EXPORT shaderc_compilation_result_t
+shaderc_compile_chunks_into_preprocessed_text(
+    const shaderc_compiler_t compiler, const shaderc_source_chunk* chunks,
+    size_t num_chunks, shaderc_shader_kind shader_kind,
+    const char* entry_point_name,
+    const shaderc_compile_options_t additional_options);
+
+// An entry point to compile, for the shaderc_compile_entry_points_into_*()
+// functions.
+typedef struct {
+  // The null-terminated name of the entry point function.
+  const char* name;
+  // The kind of shader the entry point is compiled as.
+  shaderc_shader_kind kind;
+} shaderc_entry_point;
+
+// Compiles each of the num_entry_points given entry points of the given source
+// into its own SPIR-V module, as if by a shaderc_compile_into_spv() call for
+// each, and stores the results in results[0] to results[num_entry_points - 1].
+// The source is preprocessed only once, with its #include directives resolved
+// once, and the entry points are then compiled in parallel, on at most as many
+// threads as the hardware runs at once.  The warnings of preprocessing are in
+// every result, and if preprocessing fails, every result reports its errors.
+// Each result must be released with shaderc_result_release(), and may be null
+// if it could not be allocated.
+SHADERC_EXPORT void shaderc_compile_entry_points_into_spv(
+    const shaderc_compiler_t compiler, const char* source_text,
+    size_t source_text_size, const char* input_file_name,
+    const shaderc_entry_point* entry_points, size_t num_entry_points,
+    const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results);
+
+// Like shaderc_compile_entry_points_into_spv, but the results contain SPIR-V
+// assembly text instead of SPIR-V binary modules.
+SHADERC_EXPORT void shaderc_compile_entry_points_into_spv_assembly(
+    const shaderc_compiler_t compiler, const char* source_text,
+    size_t source_text_size, const char* input_file_name,
+    const shaderc_entry_point* entry_points, size_t num_entry_points,
+    const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results);
+
+// A target environment and SPIR-V version, for the
+// shaderc_compile_into_*_for_targets() functions.
+typedef struct {
+  shaderc_target_env env;
+  // The version of env, as for shaderc_compile_options_set_target_env.
+  uint32_t env_version;
+  // The shaderc_spirv_version to generate, or 0 for the default of env.
+  uint32_t spirv_version;
+} shaderc_compile_target;
+
+// Compiles the given source as shaderc_compile_into_spv() does, once for each
+// of the num_targets given targets, which take the place of the target
+// environment and SPIR-V version of additional_options.  Stores the result for
+// targets[i] in results[i].  The targets for the same client API, Vulkan or
+// OpenGL, share one run of preprocessing, parsing and linking, for the one of
+// them with the lowest SPIR-V version.  SPIR-V is then generated for each of
+// them, and optimized and validated in parallel.  Since the warnings of the
+// frontend may depend on the version, targets of another SPIR-V or client
+// version are parsed again when a shared run warns.  When a target could not
+// use the first run of the frontend, and its source was parsed again,
+// shaderc_result_get_frontend_rerun() returns true for its result.  Each
+// result must be released with shaderc_result_release(), and may be null if it
+// could not be allocated.
+SHADERC_EXPORT void shaderc_compile_into_spv_for_targets(
+    const shaderc_compiler_t compiler, const char* source_text,
+    size_t source_text_size, shaderc_shader_kind shader_kind,
+    const char* input_file_name, const char* entry_point_name,
+    const shaderc_compile_target* targets, size_t num_targets,
+    const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results);
+
+// Like shaderc_compile_into_spv_for_targets, but the results contain SPIR-V
+// assembly text instead of SPIR-V binary modules.
+SHADERC_EXPORT void shaderc_compile_into_spv_assembly_for_targets(
+    const shaderc_compiler_t compiler, const char* source_text,
+    size_t source_text_size, shaderc_shader_kind shader_kind,
+    const char* input_file_name, const char* entry_point_name,
+    const shaderc_compile_target* targets, size_t num_targets,
+    const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results);
+
+// One shader of a program, for the shaderc_compile_program_into_*()
+// functions.
+typedef struct {
+  // The source text of the shader, which need not be null-terminated.
+  const char* text;
+  size_t text_size;
+  // The null-terminated name of the input file, used in diagnostics.
+  const char* name;
+  // The kind of the shader.  It must name a stage; the default kinds stand for
+  // their stage, and shaderc_glsl_infer_from_source is not allowed.
+  shaderc_shader_kind kind;
+  // The null-terminated name of the entry point, for HLSL.
+  const char* entry_point_name;
+} shaderc_program_stage;
+
+// Compiles the num_stages given shaders, at most one per stage, and links them
+// as one program, so that locations and bindings are assigned consistently
+// across the stages.  When the program only has vertex, tessellation, geometry
+// and fragment shaders, the outputs of each stage that the next stage does not
+// read are removed, with the code that only computes them, and so are the
+// inputs that a stage declares but does not read from its interface.  Stores
+// the SPIR-V module of stages[i] in results[i].  Every result has the status
+// of the whole program, and fails if any stage fails to compile or the program
+// fails to link.  The messages of all of the stages, and their counts, are in
+// results[0] only.  Each result must be released with
+// shaderc_result_release(), and may be null if it could not be allocated.
+SHADERC_EXPORT void shaderc_compile_program_into_spv(
+    const shaderc_compiler_t compiler, const shaderc_program_stage* stages,
+    size_t num_stages, const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results);
+
+// Like shaderc_compile_program_into_spv, but the results contain SPIR-V
+// assembly text instead of SPIR-V binary modules.
+SHADERC_EXPORT void shaderc_compile_program_into_spv_assembly(
+    const shaderc_compiler_t compiler, const shaderc_program_stage* stages,
+    size_t num_stages, const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results);
+
 // Takes an assembly string of the format defined in the SPIRV-Tools project
 // (https://github.com/KhronosGroup/SPIRV-Tools/blob/master/syntax.md),
 // assembles it into SPIR-V binary and a shaderc_compilation_result will be
 // returned to hold the results.
 // The assembling will pick options suitable for assembling specified in the
 // additional_options parameter.
+// The SPIRV-Tools context of each target environment, with its grammar
+// tables, is set up once per compiler, and reused by later calls.
 // May be safely called from multiple threads without explicit synchronization.
 // If there was failure in allocating the compiler object, null will be
 // returned.
@@ -569,6 +942,46 @@ SHADERC_EXPORT shaderc_compilation_result_t shaderc_assemble_into_spv(
     size_t source_assembly_size,
     const shaderc_compile_options_t additional_options);
 
+// Checks the given SPIR-V binary module, of binary_word_count words, with the
+// SPIR-V validator, for the target environment of additional_options, or the
+// default one if it is NULL.  Blocks may use the relaxed, scalar and std430
+// uniform buffer layouts, as in the SPIR-V that shaderc generates, since
+// they depend on device features.  The result has no output.  Its status is
+// shaderc_compilation_status_success if the module is valid, and otherwise
+// shaderc_compilation_status_validation_error, with the findings of the
+// validator as its error messages.  The validator of each target environment
+// is set up once per compiler, and reused by later calls.
+// May be safely called from multiple threads without explicit synchronization.
+// If there was failure in allocating the result object, null will be
+// returned.
+SHADERC_EXPORT shaderc_compilation_result_t shaderc_validate_spv(
+    const shaderc_compiler_t compiler, const uint32_t* binary,
+    size_t binary_word_count,
+    const shaderc_compile_options_t additional_options);
+
+// A sink for output text, such as a file.  Takes size bytes of data, and
+// returns false if it could not.
+typedef bool (*shaderc_output_writer_fn)(void* user_data, const char* data,
+                                         size_t size);
+
+// Disassembles the given SPIR-V binary module, of binary_word_count words,
+// into SPIR-V assembly text, for the target environment of
+// additional_options, or the default one if it is NULL.  If writer is not
+// NULL, the text is passed to it, with user_data, straight from the buffer
+// that SPIRV-Tools renders it into, and the result has no output.  Otherwise
+// the text is the output of the result.  The status of the result is
+// shaderc_compilation_status_validation_error if the module cannot be
+// disassembled, with the reason as its error message, and
+// shaderc_compilation_status_internal_error if writer returns false.
+// May be safely called from multiple threads without explicit synchronization.
+// If there was failure in allocating the result object, null will be
+// returned.
+SHADERC_EXPORT shaderc_compilation_result_t shaderc_disassemble_spv(
+    const shaderc_compiler_t compiler, const uint32_t* binary,
+    size_t binary_word_count,
+    const shaderc_compile_options_t additional_options,
+    shaderc_output_writer_fn writer, void* user_data);
+
 // The following functions, operating on shaderc_compilation_result_t objects,
 // offer only the basic thread-safety guarantee.
 
@@ -593,6 +1006,37 @@ SHADERC_EXPORT size_t shaderc_result_get_num_errors(const shaderc_compilation_re
 SHADERC_EXPORT shaderc_compilation_status shaderc_result_get_compilation_status(
     const shaderc_compilation_result_t);
 
+// Returns true if the result is for one of several targets, and the source
+// was parsed again for it, instead of sharing the parse of another target.
+// See shaderc_compile_into_spv_for_targets.
+SHADERC_EXPORT bool shaderc_result_get_frontend_rerun(
+    const shaderc_compilation_result_t result);
+
+// Returns the JSON description of the interface of the compiled shader, if
+// it was requested with shaderc_compile_options_set_generate_reflection().
+// It is an object with these members:
+//  - "resources": an array of the descriptors, each with its "name", "kind",
+//    "set", "binding", "type" and "array_size", and the "size" in bytes of
+//    the block of a buffer.  The kind is one of "uniform_buffer",
+//    "storage_buffer", "combined_image_sampler", "sampled_image",
+//    "storage_image", "sampler", "uniform_texel_buffer",
+//    "storage_texel_buffer", "input_attachment", "acceleration_structure" or
+//    "uniform".
+//  - "push_constants": an array of the push constant blocks, each with its
+//    "name", "size" and "members", which have a "name", "type", "offset" and
+//    "array_size".
+//  - "inputs" and "outputs": arrays of the user-defined stage variables, each
+//    with its "name", "type", "location" and "array_size".
+//  - "workgroup_size": the local size as an array of three numbers, for
+//    compute, task and mesh shaders.
+// The "array_size" is 1 for a variable that is not an array, and 0 for a
+// runtime array.  A "set", "binding" or "location" that is not assigned is
+// left out.  Returns an empty string if no description was requested, or the
+// compilation failed before it was made.  The string lives as long as the
+// result.
+SHADERC_EXPORT const char* shaderc_result_get_reflection(
+    const shaderc_compilation_result_t result);
+
 // Returns a pointer to the start of the compilation output data bytes, either
 // SPIR-V binary or char string. When the source string is compiled into SPIR-V
 // binary, this is guaranteed to be castable to a uint32_t*. If the result
@@ -16,6 +16,7 @@
 #define SHADERC_SHADERC_HPP_
 
 #include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -81,6 +82,24 @@ class CompilationResult {
     return shaderc_result_get_compilation_status(compilation_result_);
   }
 
+  // Returns true if the result is for one of several targets, and the source
+  // was parsed again for it.  See shaderc_result_get_frontend_rerun.
+  bool GetFrontendRerun() const {
+    if (!compilation_result_) {
+      return false;
+    }
+    return shaderc_result_get_frontend_rerun(compilation_result_);
+  }
+
+  // Returns the JSON description of the interface of the compiled shader, or
+  // an empty string if there is none.  See shaderc_result_get_reflection.
+  std::string GetReflection() const {
+    if (!compilation_result_) {
+      return "";
+    }
+    return shaderc_result_get_reflection(compilation_result_);
+  }
+
   // Returns a random access (contiguous) iterator pointing to the start
   // of the compilation output.  It is valid for the lifetime of this object.
   // If there is no compilation result, then returns nullptr.
@@ -136,6 +155,36 @@ using AssemblyCompilationResult = CompilationResult<char>;
 // Preprocessed source text.
 using PreprocessedSourceCompilationResult = CompilationResult<char>;
 
+// A cache of optimized SPIR-V modules that compilations share.  See
+// shaderc_optimizer_cache_t.
+class OptimizerCache {
+ public:
+  explicit OptimizerCache(size_t capacity_bytes)
+      : cache_(shaderc_optimizer_cache_create(capacity_bytes)) {}
+  ~OptimizerCache() { shaderc_optimizer_cache_release(cache_); }
+
+  OptimizerCache(const OptimizerCache&) = delete;
+  OptimizerCache& operator=(const OptimizerCache&) = delete;
+
+  bool IsValid() const { return cache_ != nullptr; }
+
+  // Drops all modules kept by the cache.
+  void Clear() { shaderc_optimizer_cache_clear(cache_); }
+
+  // Returns the number of compilations that found their optimized SPIR-V in
+  // the cache, and of those that ran the optimizer.
+  size_t GetNumHits() const {
+    return shaderc_optimizer_cache_get_num_hits(cache_);
+  }
+  size_t GetNumMisses() const {
+    return shaderc_optimizer_cache_get_num_misses(cache_);
+  }
+
+ private:
+  shaderc_optimizer_cache_t cache_;
+  friend class CompileOptions;
+};
+
 // Contains any options that can have default values for a compilation.
 class CompileOptions {
  public:
@@ -167,6 +216,14 @@ class CompileOptions {
     AddMacroDefinition(name.c_str(), name.size(), value.c_str(), value.size());
   }
 
+  // Makes a predefined macro a specialization constant with the given SpecId.
+  // It behaves the same as shaderc_compile_options_add_macro_spec_constant in
+  // shaderc.h.
+  void AddMacroSpecConstant(const std::string& name, uint32_t spec_id) {
+    shaderc_compile_options_add_macro_spec_constant(options_, name.c_str(),
+                                                    name.size(), spec_id);
+  }
+
   // Sets the compiler mode to generate debug information in the output.
   void SetGenerateDebugInfo() {
     shaderc_compile_options_set_generate_debug_info(options_);
@@ -178,6 +235,27 @@ class CompileOptions {
     shaderc_compile_options_set_optimization_level(options_, level);
   }
 
+  // Sets the cache that compilations look up their optimized SPIR-V in, or
+  // null for none.  The cache must outlive the compilations that use it.
+  void SetOptimizerCache(OptimizerCache* cache) {
+    shaderc_compile_options_set_optimizer_cache(
+        options_, cache ? cache->cache_ : nullptr);
+  }
+
+  // Sets the optimization passes to run instead of those of the optimization
+  // level, as spirv-opt flags.  Returns false if one of them is unknown, in
+  // which case compilations with these options fail.  See
+  // shaderc_compile_options_set_optimization_passes.
+  bool SetOptimizationPasses(const std::vector<std::string>& passes) {
+    std::vector<const char*> pass_pointers;
+    pass_pointers.reserve(passes.size());
+    for (const std::string& pass : passes) {
+      pass_pointers.push_back(pass.c_str());
+    }
+    return shaderc_compile_options_set_optimization_passes(
+        options_, pass_pointers.data(), pass_pointers.size());
+  }
+
   // A C++ version of the libshaderc includer interface.
   class IncluderInterface {
    public:
@@ -377,6 +455,62 @@ class CompileOptions {
     shaderc_compile_options_set_nan_clamp(options_, enable);
   }
 
+  // Sets whether the source to compile is already preprocessed, so that the
+  // preprocessing pass can be skipped.  See
+  // shaderc_compile_options_set_input_preprocessed.
+  void SetInputPreprocessed(bool preprocessed) {
+    shaderc_compile_options_set_input_preprocessed(options_, preprocessed);
+  }
+
+  // Sets how far compilations go when they only check their source.  See
+  // shaderc_compile_options_set_syntax_only.
+  void SetSyntaxOnly(shaderc_syntax_only_mode mode) {
+    shaderc_compile_options_set_syntax_only(options_, mode);
+  }
+
+  // Sets whether SPIR-V assembly output names ids after the names in the
+  // module, which is the default, or by number.  See
+  // shaderc_compile_options_set_disassembly_friendly_names.
+  void SetDisassemblyFriendlyNames(bool friendly_names) {
+    shaderc_compile_options_set_disassembly_friendly_names(options_,
+                                                           friendly_names);
+  }
+
+  // Sets whether compilations describe the interface of the shader, for
+  // CompilationResult::GetReflection.  See
+  // shaderc_compile_options_set_generate_reflection.
+  void SetGenerateReflection(bool enable) {
+    shaderc_compile_options_set_generate_reflection(options_, enable);
+  }
+
+  // Sets the value of the specialization constant with the given SpecId,
+  // which is frozen to it before optimization.  See
+  // shaderc_compile_options_set_specialization_constant.
+  void SetSpecializationConstant(uint32_t spec_id, const std::string& value) {
+    shaderc_compile_options_set_specialization_constant(options_, spec_id,
+                                                        value.c_str());
+  }
+
+  // Sets whether compilations produce SPIR-V modules to be linked with
+  // others, with exported and imported functions, rather than shaders.  See
+  // shaderc_compile_options_set_compile_for_linking.
+  void SetCompileForLinking(bool enable) {
+    shaderc_compile_options_set_compile_for_linking(options_, enable);
+  }
+
+  // Adds a SPIR-V library, compiled for linking, to link compiled shaders
+  // with.  See shaderc_compile_options_add_link_library.
+  void AddLinkLibrary(const std::vector<uint32_t>& library) {
+    shaderc_compile_options_add_link_library(options_, library.data(),
+                                             library.size());
+  }
+
+  // Sets when the SPIR-V of compilations is checked by the SPIR-V validator.
+  // See shaderc_compile_options_set_validation_policy.
+  void SetValidationPolicy(shaderc_validation_policy policy) {
+    shaderc_compile_options_set_validation_policy(options_, policy);
+  }
+
  private:
   CompileOptions& operator=(const CompileOptions& other) = delete;
   shaderc_compile_options_t options_;
@@ -398,6 +532,22 @@ class Compiler {
 
   bool IsValid() const { return compiler_ != nullptr; }
 
+  // Builds the built-in symbol tables for the given stages at the given GLSL
+  // versions up front.  See shaderc_compiler_prewarm.
+  bool Prewarm(const CompileOptions& options,
+               const std::vector<shaderc_shader_kind>& stages,
+               const std::vector<int>& versions) const {
+    return shaderc_compiler_prewarm(compiler_, options.options_, stages.data(),
+                                    stages.size(), versions.data(),
+                                    versions.size());
+  }
+
+  // Releases memory kept to speed up later compilations, and returns the
+  // number of bytes released.  See shaderc_compiler_trim.
+  size_t Trim(shaderc_trim_level level) const {
+    return shaderc_compiler_trim(compiler_, level);
+  }
+
   // Compiles the given source GLSL and returns a SPIR-V binary module
   // compilation result.
   // The source_text parameter must be a valid pointer.
@@ -541,6 +691,50 @@ class Compiler {
         compiler_, source_assembly.data(), source_assembly.size(), nullptr));
   }
 
+  // Checks the given SPIR-V binary module with the SPIR-V validator, for the
+  // target environment of the options.  The result has no output.  See
+  // shaderc_validate_spv.
+  SpvCompilationResult ValidateSpv(const uint32_t* binary,
+                                   size_t binary_word_count,
+                                   const CompileOptions& options) const {
+    return SpvCompilationResult(shaderc_validate_spv(
+        compiler_, binary, binary_word_count, options.options_));
+  }
+
+  // Like the first ValidateSpv method but uses the default compiler options.
+  SpvCompilationResult ValidateSpv(const uint32_t* binary,
+                                   size_t binary_word_count) const {
+    return SpvCompilationResult(
+        shaderc_validate_spv(compiler_, binary, binary_word_count, nullptr));
+  }
+
+  // Disassembles the given SPIR-V binary module into SPIR-V assembly text, for
+  // the target environment of the options, and returns the text as the output
+  // of the result.  See shaderc_disassemble_spv.
+  AssemblyCompilationResult DisassembleSpv(
+      const uint32_t* binary, size_t binary_word_count,
+      const CompileOptions& options) const {
+    return AssemblyCompilationResult(
+        shaderc_disassemble_spv(compiler_, binary, binary_word_count,
+                                options.options_, nullptr, nullptr));
+  }
+
+  // Like the first DisassembleSpv method, but writes the text straight to the
+  // given stream, and the result has no output.
+  AssemblyCompilationResult DisassembleSpv(const uint32_t* binary,
+                                           size_t binary_word_count,
+                                           const CompileOptions& options,
+                                           std::ostream* out) const {
+    return AssemblyCompilationResult(shaderc_disassemble_spv(
+        compiler_, binary, binary_word_count, options.options_,
+        [](void* user_data, const char* data, size_t size) {
+          std::ostream* stream = static_cast<std::ostream*>(user_data);
+          stream->write(data, size);
+          return !stream->fail();
+        },
+        out));
+  }
+
   // Compiles the given source GLSL and returns the SPIR-V assembly text
   // compilation result.
   // Options are similar to the first CompileToSpv method.
@@ -613,6 +807,149 @@ class Compiler {
                           input_file_name, options);
   }
 
+  // Compiles the source made of the given chunks, without concatenating
+  // them.  See shaderc_compile_chunks_into_spv.
+  SpvCompilationResult CompileGlslChunksToSpv(
+      const std::vector<shaderc_source_chunk>& chunks,
+      shaderc_shader_kind shader_kind, const char* entry_point_name,
+      const CompileOptions& options) const {
+    return SpvCompilationResult(shaderc_compile_chunks_into_spv(
+        compiler_, chunks.data(), chunks.size(), shader_kind, entry_point_name,
+        options.options_));
+  }
+
+  // Like CompileGlslChunksToSpv, but the result holds SPIR-V assembly text.
+  AssemblyCompilationResult CompileGlslChunksToSpvAssembly(
+      const std::vector<shaderc_source_chunk>& chunks,
+      shaderc_shader_kind shader_kind, const char* entry_point_name,
+      const CompileOptions& options) const {
+    return AssemblyCompilationResult(shaderc_compile_chunks_into_spv_assembly(
+        compiler_, chunks.data(), chunks.size(), shader_kind, entry_point_name,
+        options.options_));
+  }
+
+  // Compiles each of the given entry points of the source into its own SPIR-V
+  // module, preprocessing the source only once.  The results are in the order
+  // of the entry points.  See shaderc_compile_entry_points_into_spv.
+  std::vector<SpvCompilationResult> CompileGlslEntryPointsToSpv(
+      const std::string& source_text,
+      const std::vector<shaderc_entry_point>& entry_points,
+      const char* input_file_name, const CompileOptions& options) const {
+    std::vector<shaderc_compilation_result_t> raw_results(entry_points.size());
+    shaderc_compile_entry_points_into_spv(
+        compiler_, source_text.data(), source_text.size(), input_file_name,
+        entry_points.data(), entry_points.size(), options.options_,
+        raw_results.data());
+    std::vector<SpvCompilationResult> results;
+    results.reserve(raw_results.size());
+    for (shaderc_compilation_result_t raw_result : raw_results) {
+      results.emplace_back(raw_result);
+    }
+    return results;
+  }
+
+  // Like CompileGlslEntryPointsToSpv, but the results hold SPIR-V assembly
+  // text.
+  std::vector<AssemblyCompilationResult> CompileGlslEntryPointsToSpvAssembly(
+      const std::string& source_text,
+      const std::vector<shaderc_entry_point>& entry_points,
+      const char* input_file_name, const CompileOptions& options) const {
+    std::vector<shaderc_compilation_result_t> raw_results(entry_points.size());
+    shaderc_compile_entry_points_into_spv_assembly(
+        compiler_, source_text.data(), source_text.size(), input_file_name,
+        entry_points.data(), entry_points.size(), options.options_,
+        raw_results.data());
+    std::vector<AssemblyCompilationResult> results;
+    results.reserve(raw_results.size());
+    for (shaderc_compilation_result_t raw_result : raw_results) {
+      results.emplace_back(raw_result);
+    }
+    return results;
+  }
+
+  // Compiles the given source for each of the given targets, sharing the
+  // frontend between targets where it can.  The results are in the order of
+  // the targets.  See shaderc_compile_into_spv_for_targets.
+  std::vector<SpvCompilationResult> CompileGlslToSpvForTargets(
+      const std::string& source_text, shaderc_shader_kind shader_kind,
+      const char* input_file_name, const char* entry_point_name,
+      const std::vector<shaderc_compile_target>& targets,
+      const CompileOptions& options) const {
+    std::vector<shaderc_compilation_result_t> raw_results(targets.size());
+    shaderc_compile_into_spv_for_targets(
+        compiler_, source_text.data(), source_text.size(), shader_kind,
+        input_file_name, entry_point_name, targets.data(), targets.size(),
+        options.options_, raw_results.data());
+    std::vector<SpvCompilationResult> results;
+    results.reserve(raw_results.size());
+    for (shaderc_compilation_result_t raw_result : raw_results) {
+      results.emplace_back(raw_result);
+    }
+    return results;
+  }
+
+  // Like CompileGlslToSpvForTargets, but the results hold SPIR-V assembly
+  // text.
+  std::vector<AssemblyCompilationResult> CompileGlslToSpvAssemblyForTargets(
+      const std::string& source_text, shaderc_shader_kind shader_kind,
+      const char* input_file_name, const char* entry_point_name,
+      const std::vector<shaderc_compile_target>& targets,
+      const CompileOptions& options) const {
+    std::vector<shaderc_compilation_result_t> raw_results(targets.size());
+    shaderc_compile_into_spv_assembly_for_targets(
+        compiler_, source_text.data(), source_text.size(), shader_kind,
+        input_file_name, entry_point_name, targets.data(), targets.size(),
+        options.options_, raw_results.data());
+    std::vector<AssemblyCompilationResult> results;
+    results.reserve(raw_results.size());
+    for (shaderc_compilation_result_t raw_result : raw_results) {
+      results.emplace_back(raw_result);
+    }
+    return results;
+  }
+
+  // Compiles the given shaders and links them as one program.  The results
+  // are in the order of the stages.  See shaderc_compile_program_into_spv.
+  std::vector<SpvCompilationResult> CompileProgramToSpv(
+      const std::vector<shaderc_program_stage>& stages,
+      const CompileOptions& options) const {
+    std::vector<shaderc_compilation_result_t> raw_results(stages.size());
+    shaderc_compile_program_into_spv(compiler_, stages.data(), stages.size(),
+                                     options.options_, raw_results.data());
+    std::vector<SpvCompilationResult> results;
+    results.reserve(raw_results.size());
+    for (shaderc_compilation_result_t raw_result : raw_results) {
+      results.emplace_back(raw_result);
+    }
+    return results;
+  }
+
+  // Like CompileProgramToSpv, but the results hold SPIR-V assembly text.
+  std::vector<AssemblyCompilationResult> CompileProgramToSpvAssembly(
+      const std::vector<shaderc_program_stage>& stages,
+      const CompileOptions& options) const {
+    std::vector<shaderc_compilation_result_t> raw_results(stages.size());
+    shaderc_compile_program_into_spv_assembly(
+        compiler_, stages.data(), stages.size(), options.options_,
+        raw_results.data());
+    std::vector<AssemblyCompilationResult> results;
+    results.reserve(raw_results.size());
+    for (shaderc_compilation_result_t raw_result : raw_results) {
+      results.emplace_back(raw_result);
+    }
+    return results;
+  }
+
+  // Like CompileGlslChunksToSpv, but the result holds preprocessed source.
+  PreprocessedSourceCompilationResult PreprocessGlslChunks(
+      const std::vector<shaderc_source_chunk>& chunks,
+      shaderc_shader_kind shader_kind, const CompileOptions& options) const {
+    return PreprocessedSourceCompilationResult(
+        shaderc_compile_chunks_into_preprocessed_text(
+            compiler_, chunks.data(), chunks.size(), shader_kind, "main",
+            options.options_));
+  }
+
  private:
   Compiler(const Compiler&) = delete;
   Compiler& operator=(const Compiler& other) = delete;
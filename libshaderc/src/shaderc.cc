@@ -18,11 +18,14 @@
 #include <cassert>
 #include <cstdint>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <vector>
 
 #include "libshaderc_util/compiler.h"
 #include "libshaderc_util/counting_includer.h"
+#include "libshaderc_util/heap_usage.h"
+#include "libshaderc_util/parallel.h"
 #include "libshaderc_util/resources.h"
 #include "libshaderc_util/spirv_tools_wrapper.h"
 #include "libshaderc_util/version_profile.h"
@@ -385,6 +388,8 @@ shaderc_util::Compiler::Stage GetStage(shaderc_shader_kind kind) {
 struct shaderc_compile_options {
   shaderc_target_env target_env = shaderc_target_env_default;
   uint32_t target_env_version = 0;
+  bool disassembly_friendly_names = true;
+  bool generate_reflection = false;
   shaderc_util::Compiler compiler;
   shaderc_include_resolve_fn include_resolver = nullptr;
   shaderc_include_result_release_fn include_result_releaser = nullptr;
@@ -413,6 +418,13 @@ void shaderc_compile_options_add_macro_definition(
   options->compiler.AddMacroDefinition(name, name_length, value, value_length);
 }
 
+void shaderc_compile_options_add_macro_spec_constant(
+    shaderc_compile_options_t options, const char* name, size_t name_length,
+    uint32_t spec_id) {
+  options->compiler.AddMacroSpecConstant(std::string(name, name_length),
+                                         spec_id);
+}
+
 void shaderc_compile_options_set_source_language(
     shaderc_compile_options_t options, shaderc_source_language set_lang) {
   auto lang = shaderc_util::Compiler::SourceLanguage::GLSL;
@@ -443,6 +455,43 @@ void shaderc_compile_options_set_optimization_level(
   options->compiler.SetOptimizationLevel(opt_level);
 }
 
+shaderc_optimizer_cache_t shaderc_optimizer_cache_create(
+    size_t capacity_bytes) {
+  return new (std::nothrow) shaderc_optimizer_cache(capacity_bytes);
+}
+
+void shaderc_optimizer_cache_release(shaderc_optimizer_cache_t cache) {
+  delete cache;
+}
+
+void shaderc_optimizer_cache_clear(shaderc_optimizer_cache_t cache) {
+  cache->cache.Clear();
+}
+
+size_t shaderc_optimizer_cache_get_num_hits(
+    const shaderc_optimizer_cache_t cache) {
+  return cache->cache.num_hits();
+}
+
+size_t shaderc_optimizer_cache_get_num_misses(
+    const shaderc_optimizer_cache_t cache) {
+  return cache->cache.num_misses();
+}
+
+void shaderc_compile_options_set_optimizer_cache(
+    shaderc_compile_options_t options, shaderc_optimizer_cache_t cache) {
+  options->compiler.SetOptimizerCache(cache ? &cache->cache : nullptr);
+}
+
+bool shaderc_compile_options_set_optimization_passes(
+    shaderc_compile_options_t options, const char** passes,
+    size_t num_passes) {
+  std::vector<std::string> pass_list(passes, passes + num_passes);
+  // The compiler keeps the error, and compilations fail with it.
+  std::string errors;
+  return options->compiler.SetOptimizationPasses(pass_list, &errors);
+}
+
 void shaderc_compile_options_set_forced_version_profile(
     shaderc_compile_options_t options, int version, shaderc_profile profile) {
   // Transfer the profile parameter from public enum type to glslang internal
@@ -588,6 +637,78 @@ void shaderc_compile_options_set_nan_clamp(shaderc_compile_options_t options,
   options->compiler.SetNanClamp(enable);
 }
 
+void shaderc_compile_options_set_input_preprocessed(
+    shaderc_compile_options_t options, bool preprocessed) {
+  options->compiler.SetInputPreprocessed(preprocessed);
+}
+
+void shaderc_compile_options_set_syntax_only(
+    shaderc_compile_options_t options, shaderc_syntax_only_mode mode) {
+  auto syntax_only = shaderc_util::Compiler::SyntaxOnlyMode::Off;
+  switch (mode) {
+    case shaderc_syntax_only_parse:
+      syntax_only = shaderc_util::Compiler::SyntaxOnlyMode::ParseAndLink;
+      break;
+    case shaderc_syntax_only_validate:
+      syntax_only = shaderc_util::Compiler::SyntaxOnlyMode::Validate;
+      break;
+    default:
+      break;
+  }
+  options->compiler.SetSyntaxOnly(syntax_only);
+}
+
+void shaderc_compile_options_set_validation_policy(
+    shaderc_compile_options_t options, shaderc_validation_policy policy) {
+  using ValidationPolicy = shaderc_util::Compiler::ValidationPolicy;
+  auto validation_policy = ValidationPolicy::Default;
+  switch (policy) {
+    case shaderc_validation_policy_never:
+      validation_policy = ValidationPolicy::Never;
+      break;
+    case shaderc_validation_policy_before_optimization:
+      validation_policy = ValidationPolicy::BeforeOptimization;
+      break;
+    case shaderc_validation_policy_after_optimization:
+      validation_policy = ValidationPolicy::AfterOptimization;
+      break;
+    case shaderc_validation_policy_always:
+      validation_policy = ValidationPolicy::Always;
+      break;
+    default:
+      break;
+  }
+  options->compiler.SetValidationPolicy(validation_policy);
+}
+
+void shaderc_compile_options_set_disassembly_friendly_names(
+    shaderc_compile_options_t options, bool friendly_names) {
+  options->disassembly_friendly_names = friendly_names;
+  options->compiler.SetDisassemblyFriendlyNames(friendly_names);
+}
+
+void shaderc_compile_options_set_generate_reflection(
+    shaderc_compile_options_t options, bool enable) {
+  options->generate_reflection = enable;
+}
+
+void shaderc_compile_options_set_specialization_constant(
+    shaderc_compile_options_t options, uint32_t spec_id, const char* value) {
+  options->compiler.SetSpecializationConstant(spec_id, value);
+}
+
+void shaderc_compile_options_set_compile_for_linking(
+    shaderc_compile_options_t options, bool enable) {
+  options->compiler.SetCompileForLinking(enable);
+}
+
+void shaderc_compile_options_add_link_library(
+    shaderc_compile_options_t options, const uint32_t* words,
+    size_t num_words) {
+  options->compiler.AddLinkLibrary(
+      std::make_shared<const std::vector<uint32_t>>(words, words + num_words));
+}
+
 shaderc_compiler_t shaderc_compiler_initialize() {
   shaderc_compiler_t compiler = new (std::nothrow) shaderc_compiler;
   if (compiler) {
@@ -598,22 +719,122 @@ shaderc_compiler_t shaderc_compiler_initialize() {
 
 void shaderc_compiler_release(shaderc_compiler_t compiler) { delete compiler; }
 
+bool shaderc_compiler_prewarm(
+    const shaderc_compiler_t compiler,
+    const shaderc_compile_options_t additional_options,
+    const shaderc_shader_kind* stages, size_t num_stages, const int* versions,
+    size_t num_versions) {
+  if (!compiler || !compiler->initializer) return false;
+  std::vector<EShLanguage> languages;
+  for (size_t i = 0; i < num_stages; ++i) {
+    // Default shader kinds stand for their stage here.
+    StageDeducer default_stage(stages[i]);
+    EShLanguage stage = GetForcedStage(stages[i]);
+    if (stage == EShLangCount) stage = default_stage(nullptr, "");
+    if (stage == EShLangCount) return false;
+    languages.push_back(stage);
+  }
+  const int kDefaultVersion = 0;
+  if (num_versions == 0) {
+    versions = &kDefaultVersion;
+    num_versions = 1;
+  }
+
+  bool success = true;
+  TRY_IF_EXCEPTIONS_ENABLED {
+    const shaderc_util::Compiler default_compiler;
+    const shaderc_util::Compiler& util_compiler =
+        additional_options ? additional_options->compiler : default_compiler;
+    // glslang builds every built-in symbol table under one process-wide lock,
+    // so building them from several threads would only take turns.
+    for (EShLanguage stage : languages) {
+      for (size_t i = 0; i < num_versions; ++i) {
+        success &= util_compiler.PrewarmBuiltins(stage, versions[i]);
+      }
+    }
+  }
+  CATCH_IF_EXCEPTIONS_ENABLED(...) { success = false; }
+  return success;
+}
+
+size_t shaderc_compiler_trim(const shaderc_compiler_t compiler,
+                             shaderc_trim_level level) {
+  if (!compiler || !compiler->initializer) return 0;
+  const size_t heap_before = shaderc_util::HeapBytesInUse();
+  {
+    // Contexts in use are not in the pool, and come back to it when their
+    // compilations finish.
+    std::vector<std::unique_ptr<shaderc_util::CompileContext>> contexts;
+    std::lock_guard<std::mutex> lock(compiler->contexts_mutex);
+    contexts.swap(compiler->contexts);
+  }
+  if (level == shaderc_trim_level_all) {
+    compiler->initializer->ResetProcessState();
+  }
+  const size_t heap_after = shaderc_util::HeapBytesInUse();
+  return heap_before > heap_after ? heap_before - heap_after : 0;
+}
+
 namespace {
+// Holds a compile context taken from the pool of a compiler, and gives it back
+// on destruction.
+class PooledCompileContext {
+ public:
+  explicit PooledCompileContext(shaderc_compiler_t compiler)
+      : compiler_(compiler) {
+    {
+      std::lock_guard<std::mutex> lock(compiler_->contexts_mutex);
+      if (!compiler_->contexts.empty()) {
+        context_ = std::move(compiler_->contexts.back());
+        compiler_->contexts.pop_back();
+      }
+    }
+    if (!context_) context_.reset(new shaderc_util::CompileContext);
+  }
+
+  ~PooledCompileContext() {
+    std::lock_guard<std::mutex> lock(compiler_->contexts_mutex);
+    compiler_->contexts.push_back(std::move(context_));
+  }
+
+  shaderc_util::CompileContext* get() { return context_.get(); }
+
+ private:
+  shaderc_compiler_t compiler_;
+  std::unique_ptr<shaderc_util::CompileContext> context_;
+};
+
+// Compiles the source made of the given chunks.  Errors not in any chunk are
+// reported as if the file name were the name of the first chunk.
 shaderc_compilation_result_t CompileToSpecifiedOutputType(
-    const shaderc_compiler_t compiler, const char* source_text,
-    size_t source_text_size, shaderc_shader_kind shader_kind,
-    const char* input_file_name, const char* entry_point_name,
+    const shaderc_compiler_t compiler, const shaderc_source_chunk* chunks,
+    size_t num_chunks, shaderc_shader_kind shader_kind,
+    const char* entry_point_name,
     const shaderc_compile_options_t additional_options,
     shaderc_util::Compiler::OutputType output_type) {
   auto* result = new (std::nothrow) shaderc_compilation_result_vector;
   if (!result) return nullptr;
 
-  if (!input_file_name) {
-    result->messages = "Input file name string was null.";
+  if (num_chunks == 0) {
+    result->messages = "No source chunks were given.";
     result->num_errors = 1;
     result->compilation_status = shaderc_compilation_status_compilation_error;
     return result;
   }
+  std::vector<shaderc_util::SourceChunk> source_chunks;
+  for (size_t i = 0; i < num_chunks; ++i) {
+    if (!chunks[i].name) {
+      result->messages = "Input file name string was null.";
+      result->num_errors = 1;
+      result->compilation_status = shaderc_compilation_status_compilation_error;
+      return result;
+    }
+    source_chunks.push_back(shaderc_util::SourceChunk{
+        shaderc_util::string_piece(chunks[i].text,
+                                   chunks[i].text + chunks[i].text_size),
+        chunks[i].name});
+  }
+  const char* input_file_name = chunks[0].name;
   result->compilation_status = shaderc_compilation_status_invalid_stage;
   bool compilation_succeeded = false;  // In case we exit early.
   std::vector<uint32_t> compilation_output_data;
@@ -625,9 +846,8 @@ shaderc_compilation_result_t CompileToSpecifiedOutputType(
     size_t total_errors = 0;
     std::string input_file_name_str(input_file_name);
     EShLanguage forced_stage = GetForcedStage(shader_kind);
-    shaderc_util::string_piece source_string =
-        shaderc_util::string_piece(source_text, source_text + source_text_size);
     StageDeducer stage_deducer(shader_kind);
+    PooledCompileContext context(compiler);
     if (additional_options) {
       InternalFileIncluder includer(additional_options->include_resolver,
                                     additional_options->include_result_releaser,
@@ -636,22 +856,24 @@ shaderc_compilation_result_t CompileToSpecifiedOutputType(
       std::tie(compilation_succeeded, compilation_output_data,
                compilation_output_data_size_in_bytes) =
           additional_options->compiler.Compile(
-              source_string, forced_stage, input_file_name_str,
+              source_chunks, forced_stage, input_file_name_str,
               entry_point_name,
               // stage_deducer has a flag: error_, which we need to check later.
               // We need to make this a reference wrapper, so that std::function
               // won't make a copy for this callable object.
               std::ref(stage_deducer), includer, output_type, &errors,
-              &total_warnings, &total_errors);
+              &total_warnings, &total_errors, context.get(),
+              additional_options->generate_reflection ? &result->reflection
+                                                      : nullptr);
     } else {
       // Compile with default options.
       InternalFileIncluder includer;
       std::tie(compilation_succeeded, compilation_output_data,
                compilation_output_data_size_in_bytes) =
           shaderc_util::Compiler().Compile(
-              source_string, forced_stage, input_file_name_str,
+              source_chunks, forced_stage, input_file_name_str,
               entry_point_name, std::ref(stage_deducer), includer, output_type,
-              &errors, &total_warnings, &total_errors);
+              &errors, &total_warnings, &total_errors, context.get());
     }
 
     result->messages = errors.str();
@@ -675,6 +897,312 @@ shaderc_compilation_result_t CompileToSpecifiedOutputType(
   }
   return result;
 }
+
+// Returns the diagnostics in the given compiler messages.  Each diagnostic
+// is a line naming its file, line and text, with the lines that continue it.
+std::vector<std::string> SplitDiagnostics(const std::string& messages) {
+  std::vector<std::string> diagnostics;
+  for (size_t begin = 0; begin < messages.size();) {
+    const size_t end =
+        std::min(messages.find('\n', begin), messages.size() - 1) + 1;
+    const std::string line = messages.substr(begin, end - begin);
+    const bool starts_diagnostic =
+        line.find(": warning: ") != std::string::npos ||
+        line.find(": error: ") != std::string::npos;
+    if (starts_diagnostic || diagnostics.empty()) {
+      diagnostics.push_back(line);
+    } else {
+      diagnostics.back() += line;
+    }
+    begin = end;
+  }
+  return diagnostics;
+}
+
+// Compiles each of the given entry points of the given source, which is read
+// and preprocessed only once.  The entry points are compiled in parallel, on
+// at most as many threads as the hardware runs at once, each into its own
+// result.  The warnings of preprocessing come first in every result.
+void CompileEntryPointsToSpecifiedOutputType(
+    const shaderc_compiler_t compiler, const char* source_text,
+    size_t source_text_size, const char* input_file_name,
+    const shaderc_entry_point* entry_points, size_t num_entry_points,
+    const shaderc_compile_options_t additional_options,
+    shaderc_util::Compiler::OutputType output_type,
+    shaderc_compilation_result_t* results) {
+  if (num_entry_points == 0) return;
+
+  shaderc_compilation_status status =
+      shaderc_compilation_status_compilation_error;
+  std::string messages;
+  size_t num_warnings = 0;
+  size_t num_errors = 0;
+  std::string preprocessed_text;
+  if (!input_file_name) {
+    messages = "Input file name string was null.";
+    num_errors = 1;
+  } else if (!compiler->initializer) {
+    status = shaderc_compilation_status_invalid_stage;
+  } else {
+    TRY_IF_EXCEPTIONS_ENABLED {
+      std::stringstream errors;
+      const shaderc_util::Compiler default_compiler;
+      const shaderc_util::Compiler& source_compiler =
+          additional_options ? additional_options->compiler : default_compiler;
+      InternalFileIncluder includer(
+          additional_options ? additional_options->include_resolver : nullptr,
+          additional_options ? additional_options->include_result_releaser
+                             : nullptr,
+          additional_options ? additional_options->include_user_data
+                             : nullptr);
+      if (source_compiler.PreprocessForCompilation(
+              {shaderc_util::SourceChunk{
+                  shaderc_util::string_piece(source_text,
+                                             source_text + source_text_size),
+                  input_file_name}},
+              input_file_name, includer, &preprocessed_text, &errors,
+              &num_warnings, &num_errors)) {
+        status = shaderc_compilation_status_success;
+      }
+      messages = errors.str();
+    }
+    CATCH_IF_EXCEPTIONS_ENABLED(...) {
+      status = shaderc_compilation_status_internal_error;
+    }
+  }
+
+  if (status != shaderc_compilation_status_success) {
+    // Every entry point fails the same way.
+    for (size_t i = 0; i < num_entry_points; ++i) {
+      auto* result = new (std::nothrow) shaderc_compilation_result_vector;
+      if (result) {
+        result->messages = messages;
+        result->num_warnings = num_warnings;
+        result->num_errors = num_errors;
+        result->compilation_status = status;
+      }
+      results[i] = result;
+    }
+    return;
+  }
+
+  const shaderc_source_chunk preprocessed_chunk = {
+      preprocessed_text.data(), preprocessed_text.size(), input_file_name};
+  shaderc_compile_options preprocessed_options;
+  if (additional_options) preprocessed_options = *additional_options;
+  preprocessed_options.compiler.SetInputPreprocessed(true);
+
+  shaderc_util::RunInParallel(num_entry_points, [&](size_t i, unsigned) {
+    results[i] = CompileToSpecifiedOutputType(
+        compiler, &preprocessed_chunk, 1, entry_points[i].kind,
+        entry_points[i].name, &preprocessed_options, output_type);
+    if (results[i]) {
+      // The compilation of the preprocessed text repeats the warnings of the
+      // directives it keeps, such as #version and #extension, so a warning
+      // of preprocessing is added only if the compilation did not report the
+      // same diagnostic, at the same file and line.  Each diagnostic the
+      // compilation reported matches at most one warning.
+      std::multiset<std::string> repeated;
+      for (const std::string& diagnostic :
+           SplitDiagnostics(results[i]->messages)) {
+        repeated.insert(diagnostic);
+      }
+      std::string warnings;
+      size_t num_added_warnings = 0;
+      for (const std::string& diagnostic : SplitDiagnostics(messages)) {
+        const auto match = repeated.find(diagnostic);
+        if (match != repeated.end()) {
+          repeated.erase(match);
+        } else {
+          warnings += diagnostic;
+          ++num_added_warnings;
+        }
+      }
+      results[i]->messages = warnings + results[i]->messages;
+      results[i]->num_warnings += num_added_warnings;
+    }
+  });
+}
+
+// Compiles the given source for each of the given targets, into its own
+// result.
+void CompileForTargetsToSpecifiedOutputType(
+    const shaderc_compiler_t compiler, const char* source_text,
+    size_t source_text_size, shaderc_shader_kind shader_kind,
+    const char* input_file_name, const char* entry_point_name,
+    const shaderc_compile_target* targets, size_t num_targets,
+    const shaderc_compile_options_t additional_options,
+    shaderc_util::Compiler::OutputType output_type,
+    shaderc_compilation_result_t* results) {
+  if (num_targets == 0) return;
+
+  std::vector<shaderc_util::Compiler::Target> compiler_targets;
+  for (size_t i = 0; i < num_targets; ++i) {
+    // We made the SPIR-V version values match, so we can get away with a
+    // static cast.
+    compiler_targets.push_back(
+        {GetCompilerTargetEnv(targets[i].env),
+         GetCompilerTargetEnvVersion(targets[i].env_version),
+         static_cast<shaderc_util::Compiler::SpirvVersion>(
+             targets[i].spirv_version),
+         targets[i].spirv_version != 0});
+  }
+
+  shaderc_compilation_status status = shaderc_compilation_status_invalid_stage;
+  std::string messages;
+  std::vector<shaderc_util::Compiler::TargetOutput> outputs;
+  StageDeducer stage_deducer(shader_kind);
+  if (!input_file_name) {
+    messages = "Input file name string was null.";
+    status = shaderc_compilation_status_compilation_error;
+  } else if (compiler->initializer) {
+    TRY_IF_EXCEPTIONS_ENABLED {
+      const shaderc_util::Compiler default_compiler;
+      const shaderc_util::Compiler& target_compiler =
+          additional_options ? additional_options->compiler : default_compiler;
+      InternalFileIncluder includer(
+          additional_options ? additional_options->include_resolver : nullptr,
+          additional_options ? additional_options->include_result_releaser
+                             : nullptr,
+          additional_options ? additional_options->include_user_data
+                             : nullptr);
+      // One context for each worker that compiles targets in parallel.
+      std::vector<std::unique_ptr<PooledCompileContext>> pooled_contexts;
+      std::vector<shaderc_util::CompileContext*> contexts;
+      for (unsigned i = 0; i < shaderc_util::GetNumWorkers(num_targets); ++i) {
+        pooled_contexts.emplace_back(new PooledCompileContext(compiler));
+        contexts.push_back(pooled_contexts.back()->get());
+      }
+      outputs = target_compiler.CompileForTargets(
+          {shaderc_util::SourceChunk{
+              shaderc_util::string_piece(source_text,
+                                         source_text + source_text_size),
+              input_file_name}},
+          GetForcedStage(shader_kind), input_file_name, entry_point_name,
+          std::ref(stage_deducer), includer, output_type, compiler_targets,
+          contexts,
+          additional_options && additional_options->generate_reflection);
+    }
+    CATCH_IF_EXCEPTIONS_ENABLED(...) {
+      status = shaderc_compilation_status_internal_error;
+    }
+  }
+
+  for (size_t i = 0; i < num_targets; ++i) {
+    auto* result = new (std::nothrow) shaderc_compilation_result_vector;
+    results[i] = result;
+    if (!result) continue;
+    if (i >= outputs.size()) {
+      result->messages = messages;
+      result->num_errors = messages.empty() ? 0 : 1;
+      result->compilation_status = status;
+      continue;
+    }
+    auto& output = outputs[i];
+    result->messages = std::move(output.messages);
+    result->SetOutputData(std::move(output.output));
+    result->output_data_size = output.output_size;
+    result->num_warnings = output.num_warnings;
+    result->num_errors = output.num_errors;
+    result->frontend_rerun = output.frontend_rerun;
+    result->reflection = std::move(output.reflection);
+    if (output.succeeded) {
+      result->compilation_status = shaderc_compilation_status_success;
+    } else {
+      result->compilation_status =
+          stage_deducer.error() ? shaderc_compilation_status_invalid_stage
+                                : shaderc_compilation_status_compilation_error;
+    }
+  }
+}
+
+// Compiles the given stages as one program.  Every result gets the status of
+// the whole program and the output of its own stage.  The first result also
+// gets the messages.
+void CompileProgramToSpecifiedOutputType(
+    const shaderc_compiler_t compiler, const shaderc_program_stage* stages,
+    size_t num_stages, const shaderc_compile_options_t additional_options,
+    shaderc_util::Compiler::OutputType output_type,
+    shaderc_compilation_result_t* results) {
+  if (num_stages == 0) return;
+
+  shaderc_compilation_status status = shaderc_compilation_status_invalid_stage;
+  std::string messages;
+  size_t total_warnings = 0;
+  size_t total_errors = 0;
+  std::vector<shaderc_util::ProgramStage> program;
+  for (size_t i = 0; i < num_stages; ++i) {
+    if (!stages[i].name) {
+      messages = "Input file name string was null.";
+      total_errors = 1;
+      status = shaderc_compilation_status_compilation_error;
+      break;
+    }
+    // Default shader kinds stand for their stage here.
+    StageDeducer default_stage(stages[i].kind);
+    EShLanguage stage = GetForcedStage(stages[i].kind);
+    if (stage == EShLangCount) stage = default_stage(nullptr, "");
+    if (stage == EShLangCount) {
+      messages = std::string(stages[i].name) +
+                 ": error: the kind of a shader in a program must name its "
+                 "stage\n";
+      total_errors = 1;
+      break;
+    }
+    program.push_back(
+        {{shaderc_util::SourceChunk{
+             shaderc_util::string_piece(
+                 stages[i].text, stages[i].text + stages[i].text_size),
+             stages[i].name}},
+         stage,
+         stages[i].name,
+         stages[i].entry_point_name ? stages[i].entry_point_name : "main"});
+  }
+
+  std::vector<shaderc_util::ProgramStageOutput> outputs;
+  if (program.size() == num_stages && compiler->initializer) {
+    TRY_IF_EXCEPTIONS_ENABLED {
+      std::stringstream errors;
+      PooledCompileContext context(compiler);
+      const shaderc_util::Compiler default_compiler;
+      const shaderc_util::Compiler& program_compiler =
+          additional_options ? additional_options->compiler : default_compiler;
+      InternalFileIncluder includer(
+          additional_options ? additional_options->include_resolver : nullptr,
+          additional_options ? additional_options->include_result_releaser
+                             : nullptr,
+          additional_options ? additional_options->include_user_data
+                             : nullptr);
+      const bool succeeded = program_compiler.CompileProgram(
+          program, includer, output_type, &errors, &total_warnings,
+          &total_errors, &outputs, context.get(),
+          additional_options && additional_options->generate_reflection);
+      messages = errors.str();
+      status = succeeded ? shaderc_compilation_status_success
+                         : shaderc_compilation_status_compilation_error;
+    }
+    CATCH_IF_EXCEPTIONS_ENABLED(...) {
+      status = shaderc_compilation_status_internal_error;
+    }
+  }
+
+  for (size_t i = 0; i < num_stages; ++i) {
+    auto* result = new (std::nothrow) shaderc_compilation_result_vector;
+    results[i] = result;
+    if (!result) continue;
+    if (i == 0) {
+      result->messages = messages;
+      result->num_warnings = total_warnings;
+      result->num_errors = total_errors;
+    }
+    result->compilation_status = status;
+    if (i < outputs.size()) {
+      result->SetOutputData(std::move(outputs[i].output));
+      result->output_data_size = outputs[i].output_size;
+      result->reflection = std::move(outputs[i].reflection);
+    }
+  }
+}
 }  // anonymous namespace
 
 shaderc_compilation_result_t shaderc_compile_into_spv(
@@ -682,9 +1210,10 @@ shaderc_compilation_result_t shaderc_compile_into_spv(
     size_t source_text_size, shaderc_shader_kind shader_kind,
     const char* input_file_name, const char* entry_point_name,
     const shaderc_compile_options_t additional_options) {
+  const shaderc_source_chunk chunk = {source_text, source_text_size,
+                                      input_file_name};
   return CompileToSpecifiedOutputType(
-      compiler, source_text, source_text_size, shader_kind, input_file_name,
-      entry_point_name, additional_options,
+      compiler, &chunk, 1, shader_kind, entry_point_name, additional_options,
       shaderc_util::Compiler::OutputType::SpirvBinary);
 }
 
@@ -693,9 +1222,10 @@ shaderc_compilation_result_t shaderc_compile_into_spv_assembly(
     size_t source_text_size, shaderc_shader_kind shader_kind,
     const char* input_file_name, const char* entry_point_name,
     const shaderc_compile_options_t additional_options) {
+  const shaderc_source_chunk chunk = {source_text, source_text_size,
+                                      input_file_name};
   return CompileToSpecifiedOutputType(
-      compiler, source_text, source_text_size, shader_kind, input_file_name,
-      entry_point_name, additional_options,
+      compiler, &chunk, 1, shader_kind, entry_point_name, additional_options,
       shaderc_util::Compiler::OutputType::SpirvAssemblyText);
 }
 
@@ -704,12 +1234,112 @@ shaderc_compilation_result_t shaderc_compile_into_preprocessed_text(
     size_t source_text_size, shaderc_shader_kind shader_kind,
     const char* input_file_name, const char* entry_point_name,
     const shaderc_compile_options_t additional_options) {
+  const shaderc_source_chunk chunk = {source_text, source_text_size,
+                                      input_file_name};
   return CompileToSpecifiedOutputType(
-      compiler, source_text, source_text_size, shader_kind, input_file_name,
-      entry_point_name, additional_options,
+      compiler, &chunk, 1, shader_kind, entry_point_name, additional_options,
       shaderc_util::Compiler::OutputType::PreprocessedText);
 }
 
+shaderc_compilation_result_t shaderc_compile_chunks_into_spv(
+    const shaderc_compiler_t compiler, const shaderc_source_chunk* chunks,
+    size_t num_chunks, shaderc_shader_kind shader_kind,
+    const char* entry_point_name,
+    const shaderc_compile_options_t additional_options) {
+  return CompileToSpecifiedOutputType(
+      compiler, chunks, num_chunks, shader_kind, entry_point_name,
+      additional_options, shaderc_util::Compiler::OutputType::SpirvBinary);
+}
+
+shaderc_compilation_result_t shaderc_compile_chunks_into_spv_assembly(
+    const shaderc_compiler_t compiler, const shaderc_source_chunk* chunks,
+    size_t num_chunks, shaderc_shader_kind shader_kind,
+    const char* entry_point_name,
+    const shaderc_compile_options_t additional_options) {
+  return CompileToSpecifiedOutputType(
+      compiler, chunks, num_chunks, shader_kind, entry_point_name,
+      additional_options,
+      shaderc_util::Compiler::OutputType::SpirvAssemblyText);
+}
+
+shaderc_compilation_result_t shaderc_compile_chunks_into_preprocessed_text(
+    const shaderc_compiler_t compiler, const shaderc_source_chunk* chunks,
+    size_t num_chunks, shaderc_shader_kind shader_kind,
+    const char* entry_point_name,
+    const shaderc_compile_options_t additional_options) {
+  return CompileToSpecifiedOutputType(
+      compiler, chunks, num_chunks, shader_kind, entry_point_name,
+      additional_options, shaderc_util::Compiler::OutputType::PreprocessedText);
+}
+
+void shaderc_compile_entry_points_into_spv(
+    const shaderc_compiler_t compiler, const char* source_text,
+    size_t source_text_size, const char* input_file_name,
+    const shaderc_entry_point* entry_points, size_t num_entry_points,
+    const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results) {
+  CompileEntryPointsToSpecifiedOutputType(
+      compiler, source_text, source_text_size, input_file_name, entry_points,
+      num_entry_points, additional_options,
+      shaderc_util::Compiler::OutputType::SpirvBinary, results);
+}
+
+void shaderc_compile_entry_points_into_spv_assembly(
+    const shaderc_compiler_t compiler, const char* source_text,
+    size_t source_text_size, const char* input_file_name,
+    const shaderc_entry_point* entry_points, size_t num_entry_points,
+    const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results) {
+  CompileEntryPointsToSpecifiedOutputType(
+      compiler, source_text, source_text_size, input_file_name, entry_points,
+      num_entry_points, additional_options,
+      shaderc_util::Compiler::OutputType::SpirvAssemblyText, results);
+}
+
+void shaderc_compile_into_spv_for_targets(
+    const shaderc_compiler_t compiler, const char* source_text,
+    size_t source_text_size, shaderc_shader_kind shader_kind,
+    const char* input_file_name, const char* entry_point_name,
+    const shaderc_compile_target* targets, size_t num_targets,
+    const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results) {
+  CompileForTargetsToSpecifiedOutputType(
+      compiler, source_text, source_text_size, shader_kind, input_file_name,
+      entry_point_name, targets, num_targets, additional_options,
+      shaderc_util::Compiler::OutputType::SpirvBinary, results);
+}
+
+void shaderc_compile_into_spv_assembly_for_targets(
+    const shaderc_compiler_t compiler, const char* source_text,
+    size_t source_text_size, shaderc_shader_kind shader_kind,
+    const char* input_file_name, const char* entry_point_name,
+    const shaderc_compile_target* targets, size_t num_targets,
+    const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results) {
+  CompileForTargetsToSpecifiedOutputType(
+      compiler, source_text, source_text_size, shader_kind, input_file_name,
+      entry_point_name, targets, num_targets, additional_options,
+      shaderc_util::Compiler::OutputType::SpirvAssemblyText, results);
+}
+
+void shaderc_compile_program_into_spv(
+    const shaderc_compiler_t compiler, const shaderc_program_stage* stages,
+    size_t num_stages, const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results) {
+  CompileProgramToSpecifiedOutputType(
+      compiler, stages, num_stages, additional_options,
+      shaderc_util::Compiler::OutputType::SpirvBinary, results);
+}
+
+void shaderc_compile_program_into_spv_assembly(
+    const shaderc_compiler_t compiler, const shaderc_program_stage* stages,
+    size_t num_stages, const shaderc_compile_options_t additional_options,
+    shaderc_compilation_result_t* results) {
+  CompileProgramToSpecifiedOutputType(
+      compiler, stages, num_stages, additional_options,
+      shaderc_util::Compiler::OutputType::SpirvAssemblyText, results);
+}
+
 shaderc_compilation_result_t shaderc_assemble_into_spv(
     const shaderc_compiler_t compiler, const char* source_assembly,
     size_t source_assembly_size,
@@ -727,11 +1357,12 @@ shaderc_compilation_result_t shaderc_assemble_into_spv(
                                                : shaderc_target_env_default;
     const uint32_t target_env_version =
         additional_options ? additional_options->target_env_version : 0;
+    PooledCompileContext context(compiler);
     const bool assembling_succeeded = shaderc_util::SpirvToolsAssemble(
         GetCompilerTargetEnv(target_env),
         GetCompilerTargetEnvVersion(target_env_version),
         {source_assembly, source_assembly + source_assembly_size},
-        &assembling_output_data, &errors);
+        &assembling_output_data, &errors, context.get());
     result->num_errors = !assembling_succeeded;
     if (assembling_succeeded) {
       result->SetOutputData(assembling_output_data);
@@ -750,6 +1381,101 @@ shaderc_compilation_result_t shaderc_assemble_into_spv(
   return result;
 }
 
+shaderc_compilation_result_t shaderc_validate_spv(
+    const shaderc_compiler_t compiler, const uint32_t* binary,
+    size_t binary_word_count,
+    const shaderc_compile_options_t additional_options) {
+  auto* result = new (std::nothrow) shaderc_compilation_result_vector;
+  if (!result) return nullptr;
+  result->compilation_status = shaderc_compilation_status_validation_error;
+  result->num_errors = 1;
+  if (!compiler->initializer) return result;
+  if (binary == nullptr) return result;
+
+  TRY_IF_EXCEPTIONS_ENABLED {
+    const auto target_env = additional_options ? additional_options->target_env
+                                               : shaderc_target_env_default;
+    const uint32_t target_env_version =
+        additional_options ? additional_options->target_env_version : 0;
+    PooledCompileContext context(compiler);
+    std::string errors;
+    const bool valid = shaderc_util::SpirvToolsValidate(
+        GetCompilerTargetEnv(target_env),
+        GetCompilerTargetEnvVersion(target_env_version),
+        {binary, binary + binary_word_count},
+        shaderc_util::GetSpirvToolsValidatorOptions(
+            /* skip_block_layout = */ false,
+            /* before_hlsl_legalization = */ false),
+        &errors, context.get());
+    if (valid) {
+      result->num_errors = 0;
+      result->compilation_status = shaderc_compilation_status_success;
+    } else {
+      result->messages = std::move(errors);
+    }
+  }
+  CATCH_IF_EXCEPTIONS_ENABLED(...) {
+    result->compilation_status = shaderc_compilation_status_internal_error;
+  }
+
+  return result;
+}
+
+shaderc_compilation_result_t shaderc_disassemble_spv(
+    const shaderc_compiler_t compiler, const uint32_t* binary,
+    size_t binary_word_count,
+    const shaderc_compile_options_t additional_options,
+    shaderc_output_writer_fn writer, void* user_data) {
+  auto* result = new (std::nothrow) shaderc_compilation_result_vector;
+  if (!result) return nullptr;
+  result->compilation_status = shaderc_compilation_status_validation_error;
+  result->num_errors = 1;
+  if (!compiler->initializer) return result;
+  if (binary == nullptr) return result;
+
+  TRY_IF_EXCEPTIONS_ENABLED {
+    const auto target_env = additional_options ? additional_options->target_env
+                                               : shaderc_target_env_default;
+    const uint32_t target_env_version =
+        additional_options ? additional_options->target_env_version : 0;
+    const bool friendly_names =
+        additional_options ? additional_options->disassembly_friendly_names
+                           : true;
+    PooledCompileContext context(compiler);
+    bool written = true;
+    std::string errors;
+    const bool disassembled = shaderc_util::SpirvToolsDisassemble(
+        GetCompilerTargetEnv(target_env),
+        GetCompilerTargetEnvVersion(target_env_version), binary,
+        binary_word_count, friendly_names,
+        [result, writer, user_data,
+         &written](shaderc_util::string_piece text) {
+          if (writer) {
+            written = writer(user_data, text.data(), text.size());
+          } else {
+            result->SetOutputData(shaderc_util::ConvertStringToVector(text));
+            result->output_data_size = text.size();
+          }
+          return written;
+        },
+        &errors, context.get());
+    if (disassembled) {
+      result->num_errors = 0;
+      result->compilation_status = shaderc_compilation_status_success;
+    } else if (!written) {
+      result->messages = "shaderc: error: failed to write the disassembly\n";
+      result->compilation_status = shaderc_compilation_status_internal_error;
+    } else {
+      result->messages = std::move(errors);
+    }
+  }
+  CATCH_IF_EXCEPTIONS_ENABLED(...) {
+    result->compilation_status = shaderc_compilation_status_internal_error;
+  }
+
+  return result;
+}
+
 size_t shaderc_result_get_length(const shaderc_compilation_result_t result) {
   return result->output_data_size;
 }
@@ -778,6 +1504,16 @@ const char* shaderc_result_get_error_message(
   return result->messages.c_str();
 }
 
+const char* shaderc_result_get_reflection(
+    const shaderc_compilation_result_t result) {
+  return result->reflection.c_str();
+}
+
+bool shaderc_result_get_frontend_rerun(
+    const shaderc_compilation_result_t result) {
+  return result->frontend_rerun;
+}
+
 shaderc_compilation_status shaderc_result_get_compilation_status(
     const shaderc_compilation_result_t result) {
   return result->compilation_status;
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <sstream>
 #include <thread>
 #include <unordered_map>
 
@@ -28,6 +29,7 @@ namespace {
 
 using shaderc::AssemblyCompilationResult;
 using shaderc::CompileOptions;
+using shaderc::OptimizerCache;
 using shaderc::PreprocessedSourceCompilationResult;
 using shaderc::SpvCompilationResult;
 using testing::Each;
@@ -272,6 +274,81 @@ TEST_F(CppInterface, BasicOptions) {
                                  shaderc_glsl_fragment_shader, options_));
 }
 
+TEST_F(CppInterface, PrewarmThenCompile) {
+  EXPECT_TRUE(compiler_.Prewarm(
+      options_, {shaderc_glsl_vertex_shader, shaderc_glsl_fragment_shader},
+      {450}));
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_vertex_shader, options_));
+  EXPECT_FALSE(
+      compiler_.Prewarm(options_, {shaderc_glsl_infer_from_source}, {450}));
+}
+
+TEST_F(CppInterface, CompilesAfterTrim) {
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_vertex_shader, options_));
+  compiler_.Trim(shaderc_trim_level_all);
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_vertex_shader, options_));
+}
+
+TEST_F(CppInterface, CompilesChunks) {
+  const std::string version = "#version 450\n";
+  const std::string body = "void main() {}\n";
+  const std::vector<shaderc_source_chunk> chunks = {
+      {version.data(), version.size(), "version.glsl"},
+      {body.data(), body.size(), "body.glsl"}};
+  EXPECT_TRUE(IsValidSpv(compiler_.CompileGlslChunksToSpv(
+      chunks, shaderc_glsl_fragment_shader, "main", options_)));
+  const auto assembly = compiler_.CompileGlslChunksToSpvAssembly(
+      chunks, shaderc_glsl_fragment_shader, "main", options_);
+  EXPECT_TRUE(CompilationResultIsSuccess(assembly));
+}
+
+TEST_F(CppInterface, CompilesEachEntryPoint) {
+  const auto results = compiler_.CompileGlslEntryPointsToSpv(
+      kMinimalShader,
+      {{"main", shaderc_glsl_vertex_shader},
+       {"main", shaderc_glsl_fragment_shader}},
+      "shader", options_);
+  ASSERT_EQ(2u, results.size());
+  EXPECT_TRUE(IsValidSpv(results[0]));
+  EXPECT_TRUE(IsValidSpv(results[1]));
+}
+
+TEST_F(CppInterface, CompilesProgramStages) {
+  const auto results = compiler_.CompileProgramToSpv(
+      {{kMinimalShader, strlen(kMinimalShader), "a.vert",
+        shaderc_glsl_vertex_shader, "main"},
+       {kMinimalShader, strlen(kMinimalShader), "a.frag",
+        shaderc_glsl_fragment_shader, "main"}},
+      options_);
+  ASSERT_EQ(2u, results.size());
+  EXPECT_TRUE(IsValidSpv(results[0]));
+  EXPECT_TRUE(IsValidSpv(results[1]));
+}
+
+TEST_F(CppInterface, CompilesForTargets) {
+  const auto results = compiler_.CompileGlslToSpvForTargets(
+      kMinimalShader, shaderc_glsl_vertex_shader, "shader", "main",
+      {{shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_0, 0},
+       {shaderc_target_env_opengl, shaderc_env_version_opengl_4_5, 0}},
+      options_);
+  ASSERT_EQ(2u, results.size());
+  EXPECT_TRUE(IsValidSpv(results[0]));
+  EXPECT_TRUE(IsValidSpv(results[1]));
+  EXPECT_FALSE(results[0].GetFrontendRerun());
+  EXPECT_TRUE(results[1].GetFrontendRerun());
+}
+
+TEST_F(CppInterface, SyntaxOnlyCompilesToNothing) {
+  options_.SetSyntaxOnly(shaderc_syntax_only_parse);
+  const auto result = compiler_.CompileGlslToSpv(
+      kMinimalShader, shaderc_glsl_vertex_shader, "shader", options_);
+  EXPECT_TRUE(CompilationResultIsSuccess(result));
+  EXPECT_EQ(result.cbegin(), result.cend());
+}
+
 TEST_F(CppInterface, CopiedOptions) {
   EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
                                  shaderc_glsl_vertex_shader, options_));
@@ -532,6 +609,129 @@ TEST_F(CppInterface, CompileAndOptimizeWithLevelSize) {
   EXPECT_THAT(disassembly_text, Not(HasSubstr("OpSource")));
 }
 
+TEST_F(CppInterface, OptimizerCacheIsUsedByCopiedOptions) {
+  OptimizerCache cache(1 << 20);
+  ASSERT_TRUE(cache.IsValid());
+  options_.SetOptimizationLevel(shaderc_optimization_level_size);
+  options_.SetOptimizerCache(&cache);
+  const CompileOptions copied_options(options_);
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_vertex_shader, options_));
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_vertex_shader, copied_options));
+  EXPECT_EQ(1u, cache.GetNumHits());
+  EXPECT_EQ(1u, cache.GetNumMisses());
+}
+
+TEST_F(CppInterface, ValidateSpvOfCompiledModule) {
+  options_.SetValidationPolicy(shaderc_validation_policy_always);
+  const SpvCompilationResult compiled = compiler_.CompileGlslToSpv(
+      kMinimalShader, shaderc_glsl_vertex_shader, "shader", options_);
+  ASSERT_TRUE(CompilationResultIsSuccess(compiled));
+  const std::vector<uint32_t> binary(compiled.cbegin(), compiled.cend());
+  EXPECT_TRUE(CompilationResultIsSuccess(
+      compiler_.ValidateSpv(binary.data(), binary.size(), options_)));
+  const SpvCompilationResult truncated =
+      compiler_.ValidateSpv(binary.data(), binary.size() / 2);
+  EXPECT_EQ(shaderc_compilation_status_validation_error,
+            truncated.GetCompilationStatus());
+  EXPECT_FALSE(truncated.GetErrorMessage().empty());
+}
+
+TEST_F(CppInterface, DisassembleSpvToStream) {
+  const SpvCompilationResult compiled = compiler_.CompileGlslToSpv(
+      kMinimalShader, shaderc_glsl_vertex_shader, "shader", options_);
+  ASSERT_TRUE(CompilationResultIsSuccess(compiled));
+  const std::vector<uint32_t> binary(compiled.cbegin(), compiled.cend());
+  const AssemblyCompilationResult disassembled =
+      compiler_.DisassembleSpv(binary.data(), binary.size(), options_);
+  ASSERT_TRUE(CompilationResultIsSuccess(disassembled));
+  std::ostringstream stream;
+  EXPECT_TRUE(CompilationResultIsSuccess(compiler_.DisassembleSpv(
+      binary.data(), binary.size(), options_, &stream)));
+  EXPECT_EQ(std::string(disassembled.cbegin(), disassembled.cend()),
+            stream.str());
+  EXPECT_THAT(stream.str(), HasSubstr("%main = OpFunction"));
+}
+
+TEST_F(CppInterface, CompileWithSpecializationConstant) {
+  const std::string shader =
+      "#version 450\n"
+      "layout(local_size_x = 1) in;\n"
+      "layout(constant_id = 3) const int N = 4;\n"
+      "layout(std430, binding = 0) buffer B { int v[]; };\n"
+      "void main() { v[0] = N; }\n";
+  options_.SetSpecializationConstant(3, "0x10");
+  const std::string disassembly =
+      AssemblyOutput(shader, shaderc_glsl_compute_shader, options_);
+  EXPECT_THAT(disassembly, HasSubstr("OpConstant %int 16"));
+  EXPECT_THAT(disassembly, Not(HasSubstr("SpecId")));
+}
+
+TEST_F(CppInterface, CompileWithMacroSpecConstant) {
+  const std::string shader =
+      "#version 450\n"
+      "layout(local_size_x = 1) in;\n"
+      "layout(std430, binding = 0) buffer B { int v[]; };\n"
+      "void main() { v[0] = TILE_SIZE; }\n";
+  options_.AddMacroDefinition("TILE_SIZE", "16");
+  options_.AddMacroSpecConstant("TILE_SIZE", 2);
+  const std::string disassembly =
+      AssemblyOutput(shader, shaderc_glsl_compute_shader, options_);
+  EXPECT_THAT(disassembly, HasSubstr("OpDecorate %TILE_SIZE SpecId 2"));
+  EXPECT_THAT(disassembly, HasSubstr("%TILE_SIZE = OpSpecConstant %int 16"));
+}
+
+TEST_F(CppInterface, CompileWithReflection) {
+  const std::string shader =
+      "#version 450\n"
+      "layout(location = 3) in vec4 color;\n"
+      "layout(location = 0) out vec4 frag_color;\n"
+      "void main() { frag_color = color; }\n";
+  options_.SetGenerateReflection(true);
+  const SpvCompilationResult result = compiler_.CompileGlslToSpv(
+      shader, shaderc_glsl_fragment_shader, "shader", options_);
+  ASSERT_EQ(shaderc_compilation_status_success,
+            result.GetCompilationStatus());
+  EXPECT_THAT(result.GetReflection(),
+              HasSubstr("\"inputs\": [{\"name\": \"color\", "
+                        "\"type\": \"vec4\", \"array_size\": 1, "
+                        "\"location\": 3}]"));
+}
+
+TEST_F(CppInterface, CompileWithLinkLibrary) {
+  CompileOptions library_options;
+  library_options.SetCompileForLinking(true);
+  const SpvCompilationResult library = compiler_.CompileGlslToSpv(
+      "#version 450\n"
+      "float twice(float x) { return 2.0 * x; }\n"
+      "float unused_helper(float x) { return x + 1.0; }\n",
+      shaderc_glsl_fragment_shader, "library", library_options);
+  ASSERT_EQ(shaderc_compilation_status_success,
+            library.GetCompilationStatus());
+  options_.AddLinkLibrary({library.cbegin(), library.cend()});
+  const std::string disassembly_text = AssemblyOutput(
+      "#version 450\n"
+      "layout(location = 0) out vec4 frag_color;\n"
+      "float twice(float x);\n"
+      "void main() { frag_color = vec4(twice(0.5)); }\n",
+      shaderc_glsl_fragment_shader, options_);
+  EXPECT_THAT(disassembly_text, HasSubstr("OpFunctionCall"));
+  EXPECT_THAT(disassembly_text, Not(HasSubstr("Linkage")));
+  EXPECT_THAT(disassembly_text, Not(HasSubstr("unused_helper")));
+}
+
+TEST_F(CppInterface, CompileWithOptimizationPasses) {
+  EXPECT_FALSE(options_.SetOptimizationPasses({"no-such-pass"}));
+  ASSERT_TRUE(options_.SetOptimizationPasses(
+      {"inline-entry-points-exhaustive", "eliminate-dead-functions"}));
+  const std::string disassembly_text = AssemblyOutput(
+      kGlslMultipleFnShader, shaderc_glsl_fragment_shader, options_);
+  EXPECT_THAT(disassembly_text, Not(HasSubstr("OpFunctionCall")));
+  // Without the level's passes, the debug instructions stay.
+  EXPECT_THAT(disassembly_text, HasSubstr("OpName"));
+}
+
 #if SHADERC_ENABLE_HLSL
 TEST_F(CppInterface, CompileAndOptimizeForVulkan10Failure) {
   options_.SetSourceLanguage(shaderc_source_language_hlsl);
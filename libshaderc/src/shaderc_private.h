@@ -17,12 +17,16 @@
 
 #include <cassert>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "shaderc/shaderc.h"
 
+#include "libshaderc_util/compile_context.h"
 #include "libshaderc_util/compiler.h"
+#include "libshaderc_util/optimizer_cache.h"
 #include "spirv-tools/libspirv.h"
 
 // Described in shaderc.h.
@@ -43,6 +47,11 @@ struct shaderc_compilation_result {
   // Compilation status.
   shaderc_compilation_status compilation_status =
       shaderc_compilation_status_null_result_object;
+  // Whether the source was parsed again for this result, when compiling for
+  // several targets.
+  bool frontend_rerun = false;
+  // The JSON description of the shader's interface, if it was requested.
+  std::string reflection;
 };
 
 // Compilation result class using a vector for holding the compilation
@@ -89,8 +98,22 @@ namespace shaderc_util {
 class GlslangInitializer;
 }
 
+// Described in shaderc.h.
+struct shaderc_optimizer_cache {
+  explicit shaderc_optimizer_cache(size_t capacity_bytes)
+      : cache(capacity_bytes) {}
+
+  shaderc_util::OptimizerCache cache;
+};
+
 struct shaderc_compiler {
   std::unique_ptr<shaderc_util::GlslangInitializer> initializer;
+
+  // Scratch contexts kept across compilations.  A compilation takes a context
+  // from the pool, or creates one if the pool is empty, and gives it back when
+  // done, so that concurrent compilations never share a context.
+  std::mutex contexts_mutex;
+  std::vector<std::unique_ptr<shaderc_util::CompileContext>> contexts;
 };
 
 // Converts a shader stage from shaderc_shader_kind into a shaderc_util::Compiler::Stage.
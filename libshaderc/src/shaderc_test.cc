@@ -376,12 +376,495 @@ TEST_F(AssembleStringTest, MinimalShader) {
   EXPECT_TRUE(AssemblingValid(kMinimalShaderAssembly));
 }
 
+#ifndef SHADERC_DISABLE_THREADED_TESTS
+TEST_F(AssembleStringTest, MultipleThreadsCalling) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  bool results[10];
+  std::vector<std::thread> threads;
+  for (auto& r : results) {
+    threads.emplace_back([&r, this]() {
+      r = true;
+      // Later calls of each thread reuse the pooled SPIRV-Tools contexts.
+      for (int i = 0; i < 3; ++i) {
+        r &= AssemblingValid(kMinimalShaderAssembly);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_THAT(results, Each(true));
+}
+#endif
+
 TEST_F(CompileStringTest, WorksWithCompileOptions) {
   ASSERT_NE(nullptr, compiler_.get_compiler_handle());
   EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
                                  shaderc_glsl_vertex_shader, options_.get()));
 }
 
+TEST_F(CompileStringTest, PrewarmThenCompile) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const shaderc_shader_kind stages[] = {shaderc_glsl_vertex_shader,
+                                        shaderc_glsl_default_fragment_shader};
+  const int versions[] = {140, 450, 310};
+  EXPECT_TRUE(shaderc_compiler_prewarm(compiler_.get_compiler_handle(),
+                                       options_.get(), stages, 2, versions,
+                                       3));
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_vertex_shader, options_.get()));
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_fragment_shader,
+                                 options_.get()));
+}
+
+TEST_F(CompileStringTest, PrewarmWithDefaultVersionAndOptions) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const shaderc_shader_kind stage = shaderc_glsl_compute_shader;
+  EXPECT_TRUE(shaderc_compiler_prewarm(compiler_.get_compiler_handle(),
+                                       nullptr, &stage, 1, nullptr, 0));
+}
+
+TEST_F(CompileStringTest, PrewarmRejectsStagelessKinds) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const shaderc_shader_kind stages[] = {shaderc_glsl_infer_from_source,
+                                        shaderc_spirv_assembly};
+  const int version = 450;
+  EXPECT_FALSE(shaderc_compiler_prewarm(compiler_.get_compiler_handle(),
+                                        nullptr, &stages[0], 1, &version, 1));
+  EXPECT_FALSE(shaderc_compiler_prewarm(compiler_.get_compiler_handle(),
+                                        nullptr, &stages[1], 1, &version, 1));
+}
+
+TEST_F(CompileStringTest, CompilesAfterTrim) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const shaderc_shader_kind stage = shaderc_glsl_vertex_shader;
+  const int version = 450;
+  ASSERT_TRUE(shaderc_compiler_prewarm(compiler_.get_compiler_handle(),
+                                       nullptr, &stage, 1, &version, 1));
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_vertex_shader));
+  shaderc_compiler_trim(compiler_.get_compiler_handle(),
+                        shaderc_trim_level_caches);
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_vertex_shader));
+  shaderc_compiler_trim(compiler_.get_compiler_handle(),
+                        shaderc_trim_level_all);
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_vertex_shader));
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_fragment_shader));
+}
+
+TEST_F(CompileStringTest, TrimNullCompilerReleasesNothing) {
+  EXPECT_EQ(0u, shaderc_compiler_trim(nullptr, shaderc_trim_level_all));
+}
+
+#ifndef SHADERC_DISABLE_THREADED_TESTS
+TEST_F(CompileStringTest, TrimWhileCompiling) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  bool compiled = true;
+  std::thread compiling([this, &compiled]() {
+    for (int i = 0; i < 20; ++i) {
+      compiled &= CompilesToValidSpv(compiler_, kMinimalShader,
+                                     shaderc_glsl_fragment_shader);
+    }
+  });
+  for (int i = 0; i < 20; ++i) {
+    shaderc_compiler_trim(compiler_.get_compiler_handle(),
+                          shaderc_trim_level_all);
+  }
+  compiling.join();
+  EXPECT_TRUE(compiled);
+}
+#endif
+
+TEST_F(CompileStringTest, CompilesChunks) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string version = "#version 450\n";
+  const std::string body = "void main() {}\n";
+  const shaderc_source_chunk chunks[] = {
+      {version.data(), version.size(), "version.glsl"},
+      {body.data(), body.size(), "body.glsl"}};
+  shaderc_compilation_result_t result = shaderc_compile_chunks_into_spv(
+      compiler_.get_compiler_handle(), chunks, 2, shaderc_glsl_vertex_shader,
+      "main", options_.get());
+  EXPECT_TRUE(ResultContainsValidSpv(result));
+  shaderc_result_release(result);
+}
+
+TEST_F(CompileStringTest, ChunkDiagnosticsNameTheirChunk) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string version = "#version 450\n";
+  const std::string body = "void main() {\n  int x = undeclared;\n}\n";
+  const shaderc_source_chunk chunks[] = {
+      {version.data(), version.size(), "version.glsl"},
+      {body.data(), body.size(), "body.glsl"}};
+  shaderc_compilation_result_t result = shaderc_compile_chunks_into_spv(
+      compiler_.get_compiler_handle(), chunks, 2, shaderc_glsl_vertex_shader,
+      "main", options_.get());
+  EXPECT_EQ(shaderc_compilation_status_compilation_error,
+            shaderc_result_get_compilation_status(result));
+  EXPECT_THAT(shaderc_result_get_error_message(result),
+              HasSubstr("body.glsl:2: error:"));
+  shaderc_result_release(result);
+}
+
+TEST_F(CompileStringTest, PreprocessesChunksInOrder) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string first = "#version 450\n#define VALUE 42\n";
+  const std::string second = "int x = VALUE;\n";
+  const shaderc_source_chunk chunks[] = {
+      {first.data(), first.size(), "first.glsl"},
+      {second.data(), second.size(), "second.glsl"}};
+  shaderc_compilation_result_t result =
+      shaderc_compile_chunks_into_preprocessed_text(
+          compiler_.get_compiler_handle(), chunks, 2,
+          shaderc_glsl_vertex_shader, "main", options_.get());
+  ASSERT_EQ(shaderc_compilation_status_success,
+            shaderc_result_get_compilation_status(result));
+  const std::string text(shaderc_result_get_bytes(result),
+                         shaderc_result_get_length(result));
+  EXPECT_THAT(text, HasSubstr("int x = 42;"));
+  shaderc_result_release(result);
+}
+
+TEST_F(CompileStringTest, NoChunksIsAnError) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  shaderc_compilation_result_t result = shaderc_compile_chunks_into_spv(
+      compiler_.get_compiler_handle(), nullptr, 0, shaderc_glsl_vertex_shader,
+      "main", options_.get());
+  EXPECT_EQ(shaderc_compilation_status_compilation_error,
+            shaderc_result_get_compilation_status(result));
+  EXPECT_EQ(1u, shaderc_result_get_num_errors(result));
+  shaderc_result_release(result);
+}
+
+TEST_F(CompileStringTest, CompilesEachEntryPoint) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const shaderc_entry_point entry_points[] = {
+      {"main", shaderc_glsl_vertex_shader},
+      {"main", shaderc_glsl_fragment_shader}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_entry_points_into_spv_assembly(
+      compiler_.get_compiler_handle(), kMinimalShader, strlen(kMinimalShader),
+      "shader", entry_points, 2, options_.get(), results);
+  ASSERT_TRUE(CompilationResultIsSuccess(results[0]));
+  ASSERT_TRUE(CompilationResultIsSuccess(results[1]));
+  EXPECT_THAT(shaderc_result_get_bytes(results[0]),
+              HasSubstr("OpEntryPoint Vertex %main"));
+  EXPECT_THAT(shaderc_result_get_bytes(results[1]),
+              HasSubstr("OpEntryPoint Fragment %main"));
+  shaderc_result_release(results[0]);
+  shaderc_result_release(results[1]);
+}
+
+TEST_F(CompileStringTest, EntryPointsShareMacroDefinitions) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string source = "#version 140\nvoid E(){}";
+  shaderc_compile_options_add_macro_definition(options_.get(), "E", 1u, "main",
+                                               4u);
+  const shaderc_entry_point entry_points[] = {
+      {"main", shaderc_glsl_vertex_shader},
+      {"main", shaderc_glsl_compute_shader}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_entry_points_into_spv(
+      compiler_.get_compiler_handle(), source.data(), source.size(), "shader",
+      entry_points, 2, options_.get(), results);
+  EXPECT_TRUE(ResultContainsValidSpv(results[0]));
+  EXPECT_TRUE(ResultContainsValidSpv(results[1]));
+  shaderc_result_release(results[0]);
+  shaderc_result_release(results[1]);
+}
+
+TEST_F(CompileStringTest, EntryPointsKeepMacroSpecConstants) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string source =
+      "#version 450\n"
+      "layout(location=0) out vec4 color;\n"
+      "void main() { color = vec4(SCALE); }";
+  shaderc_compile_options_add_macro_definition(options_.get(), "SCALE", 5u,
+                                               "0.5", 3u);
+  shaderc_compile_options_add_macro_spec_constant(options_.get(), "SCALE", 5u,
+                                                  7);
+  const shaderc_entry_point entry_points[] = {
+      {"main", shaderc_glsl_vertex_shader},
+      {"main", shaderc_glsl_fragment_shader}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_entry_points_into_spv_assembly(
+      compiler_.get_compiler_handle(), source.data(), source.size(), "shader",
+      entry_points, 2, options_.get(), results);
+  for (shaderc_compilation_result_t result : results) {
+    ASSERT_TRUE(CompilationResultIsSuccess(result));
+    EXPECT_THAT(shaderc_result_get_bytes(result),
+                HasSubstr("OpDecorate %SCALE SpecId 7"));
+    EXPECT_THAT(shaderc_result_get_bytes(result),
+                HasSubstr("%SCALE = OpSpecConstant %float 0.5"));
+    shaderc_result_release(result);
+  }
+}
+
+TEST_F(CompileStringTest, EntryPointsReportPreprocessingWarnings) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string source = "#version 140\n#define A__B\nvoid main(){}";
+  const shaderc_entry_point entry_points[] = {
+      {"main", shaderc_glsl_vertex_shader},
+      {"main", shaderc_glsl_fragment_shader}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_entry_points_into_spv(
+      compiler_.get_compiler_handle(), source.data(), source.size(), "shader",
+      entry_points, 2, options_.get(), results);
+  for (shaderc_compilation_result_t result : results) {
+    ASSERT_TRUE(CompilationResultIsSuccess(result));
+    EXPECT_THAT(shaderc_result_get_error_message(result),
+                HasSubstr("shader:2: warning: '#define' : names containing "
+                          "consecutive underscores are reserved"));
+    EXPECT_EQ(1u, shaderc_result_get_num_warnings(result));
+    shaderc_result_release(result);
+  }
+}
+
+TEST_F(CompileStringTest, EntryPointsReportEachPreprocessingWarningOnce) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  // The #extension directive is kept in the preprocessed text, so its warning
+  // may be reported by both preprocessing and compilation; the #define is not.
+  const std::string source =
+      "#version 140\n"
+      "#extension GL_EXT_no_such_extension : warn\n"
+      "#define A__B\n"
+      "void main(){}";
+  const shaderc_entry_point entry_points[] = {
+      {"main", shaderc_glsl_vertex_shader},
+      {"main", shaderc_glsl_fragment_shader}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_entry_points_into_spv(
+      compiler_.get_compiler_handle(), source.data(), source.size(), "shader",
+      entry_points, 2, options_.get(), results);
+  for (shaderc_compilation_result_t result : results) {
+    ASSERT_TRUE(CompilationResultIsSuccess(result));
+    const std::string messages = shaderc_result_get_error_message(result);
+    for (const std::string location : {"shader:2: warning:",
+                                       "shader:3: warning:"}) {
+      const size_t first = messages.find(location);
+      EXPECT_NE(std::string::npos, first) << messages;
+      EXPECT_EQ(std::string::npos, messages.find(location, first + 1))
+          << messages;
+    }
+    EXPECT_EQ(2u, shaderc_result_get_num_warnings(result));
+    shaderc_result_release(result);
+  }
+}
+
+TEST_F(CompileStringTest, PreprocessingErrorFailsEveryEntryPoint) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string source = "#version 140\n#error stop\nvoid main(){}";
+  const shaderc_entry_point entry_points[] = {
+      {"main", shaderc_glsl_vertex_shader},
+      {"main", shaderc_glsl_fragment_shader}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_entry_points_into_spv(
+      compiler_.get_compiler_handle(), source.data(), source.size(), "shader",
+      entry_points, 2, options_.get(), results);
+  for (shaderc_compilation_result_t result : results) {
+    EXPECT_EQ(shaderc_compilation_status_compilation_error,
+              shaderc_result_get_compilation_status(result));
+    EXPECT_THAT(shaderc_result_get_error_message(result),
+                HasSubstr("shader:2: error: '#error' : stop"));
+    shaderc_result_release(result);
+  }
+}
+
+TEST_F(CompileStringTest, CompilesProgramStages) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string vertex =
+      "#version 450\n"
+      "layout(location=0) out vec4 color;\n"
+      "layout(location=1) out vec4 unused_varying;\n"
+      "void main() { color = vec4(1); unused_varying = vec4(2); }";
+  const std::string fragment =
+      "#version 450\n"
+      "layout(location=0) in vec4 color;\n"
+      "layout(location=1) in vec4 unused_varying;\n"
+      "layout(location=0) out vec4 frag_color;\n"
+      "void main() { frag_color = color; }";
+  shaderc_compile_options_set_validation_policy(
+      options_.get(), shaderc_validation_policy_always);
+  const shaderc_program_stage stages[] = {
+      {vertex.data(), vertex.size(), "a.vert", shaderc_glsl_vertex_shader,
+       "main"},
+      {fragment.data(), fragment.size(), "a.frag",
+       shaderc_glsl_fragment_shader, "main"}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_program_into_spv_assembly(compiler_.get_compiler_handle(),
+                                            stages, 2, options_.get(),
+                                            results);
+  ASSERT_TRUE(CompilationResultIsSuccess(results[0]));
+  ASSERT_TRUE(CompilationResultIsSuccess(results[1]));
+  const std::string vertex_assembly(shaderc_result_get_bytes(results[0]),
+                                    shaderc_result_get_length(results[0]));
+  EXPECT_THAT(vertex_assembly, HasSubstr("OpEntryPoint Vertex %main"));
+  EXPECT_THAT(vertex_assembly, Not(HasSubstr("unused_varying")));
+  // The fragment input that is declared but not read is not left in the
+  // interface without the vertex output that fed it.
+  const std::string fragment_assembly(shaderc_result_get_bytes(results[1]),
+                                      shaderc_result_get_length(results[1]));
+  const size_t entry_point =
+      fragment_assembly.find("OpEntryPoint Fragment %main");
+  ASSERT_NE(std::string::npos, entry_point);
+  EXPECT_THAT(fragment_assembly.substr(
+                  entry_point,
+                  fragment_assembly.find('\n', entry_point) - entry_point),
+              Not(HasSubstr("%unused_varying")));
+  shaderc_result_release(results[0]);
+  shaderc_result_release(results[1]);
+}
+
+TEST_F(CompileStringTest, ErrorInOneStageFailsTheProgram) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string bad_fragment = "#version 450\nvoid main() { float a = b; }";
+  const shaderc_program_stage stages[] = {
+      {kMinimalShader, strlen(kMinimalShader), "a.vert",
+       shaderc_glsl_vertex_shader, "main"},
+      {bad_fragment.data(), bad_fragment.size(), "a.frag",
+       shaderc_glsl_fragment_shader, "main"}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_program_into_spv(compiler_.get_compiler_handle(), stages, 2,
+                                   options_.get(), results);
+  EXPECT_THAT(shaderc_result_get_error_message(results[0]),
+              HasSubstr("a.frag:2: error: 'b' : undeclared identifier"));
+  EXPECT_EQ(1u, shaderc_result_get_num_errors(results[0]));
+  EXPECT_EQ(0u, shaderc_result_get_num_errors(results[1]));
+  for (shaderc_compilation_result_t result : results) {
+    EXPECT_EQ(shaderc_compilation_status_compilation_error,
+              shaderc_result_get_compilation_status(result));
+    EXPECT_EQ(0u, shaderc_result_get_length(result));
+    shaderc_result_release(result);
+  }
+}
+
+TEST_F(CompileStringTest, ProgramStagesAreReflectedWhenRequested) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string vertex =
+      "#version 450\n"
+      "layout(location=0) out vec4 color;\n"
+      "void main() { color = vec4(1); }";
+  const std::string fragment =
+      "#version 450\n"
+      "layout(set=1, binding=2) uniform sampler2D tex;\n"
+      "layout(location=0) in vec4 color;\n"
+      "layout(location=0) out vec4 frag_color;\n"
+      "void main() { frag_color = color * texture(tex, vec2(0.5)); }";
+  const shaderc_program_stage stages[] = {
+      {vertex.data(), vertex.size(), "a.vert", shaderc_glsl_vertex_shader,
+       "main"},
+      {fragment.data(), fragment.size(), "a.frag",
+       shaderc_glsl_fragment_shader, "main"}};
+  shaderc_compile_options_set_generate_reflection(options_.get(), true);
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_program_into_spv(compiler_.get_compiler_handle(), stages, 2,
+                                   options_.get(), results);
+  ASSERT_TRUE(CompilationResultIsSuccess(results[0]));
+  ASSERT_TRUE(CompilationResultIsSuccess(results[1]));
+  EXPECT_THAT(shaderc_result_get_reflection(results[0]),
+              HasSubstr("\"outputs\": [{\"name\": \"color\""));
+  EXPECT_THAT(shaderc_result_get_reflection(results[1]),
+              HasSubstr("\"inputs\": [{\"name\": \"color\""));
+  EXPECT_THAT(shaderc_result_get_reflection(results[1]),
+              HasSubstr("\"set\": 1, \"binding\": 2}"));
+  shaderc_result_release(results[0]);
+  shaderc_result_release(results[1]);
+}
+
+TEST_F(CompileStringTest, ProgramStageKindMustNameAStage) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const shaderc_program_stage stages[] = {
+      {kMinimalShader, strlen(kMinimalShader), "a.glsl",
+       shaderc_glsl_infer_from_source, "main"}};
+  shaderc_compilation_result_t result = nullptr;
+  shaderc_compile_program_into_spv(compiler_.get_compiler_handle(), stages, 1,
+                                   options_.get(), &result);
+  EXPECT_EQ(shaderc_compilation_status_invalid_stage,
+            shaderc_result_get_compilation_status(result));
+  shaderc_result_release(result);
+}
+
+TEST_F(CompileStringTest, CompilesForEachTarget) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const shaderc_compile_target targets[] = {
+      {shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_0,
+       shaderc_spirv_version_1_0},
+      {shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_1,
+       shaderc_spirv_version_1_3}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_into_spv_for_targets(
+      compiler_.get_compiler_handle(), kMinimalShader, strlen(kMinimalShader),
+      shaderc_glsl_vertex_shader, "shader", "main", targets, 2,
+      options_.get(), results);
+  ASSERT_TRUE(ResultContainsValidSpv(results[0]));
+  ASSERT_TRUE(ResultContainsValidSpv(results[1]));
+  // Word 1 of a module is its SPIR-V version.
+  const auto* words0 =
+      reinterpret_cast<const uint32_t*>(shaderc_result_get_bytes(results[0]));
+  const auto* words1 =
+      reinterpret_cast<const uint32_t*>(shaderc_result_get_bytes(results[1]));
+  EXPECT_EQ(0x00010000u, words0[1]);
+  EXPECT_EQ(0x00010300u, words1[1]);
+  EXPECT_FALSE(shaderc_result_get_frontend_rerun(results[0]));
+  EXPECT_FALSE(shaderc_result_get_frontend_rerun(results[1]));
+  shaderc_result_release(results[0]);
+  shaderc_result_release(results[1]);
+}
+
+TEST_F(CompileStringTest, TargetsAreReflectedWhenRequested) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string shader =
+      "#version 450\n"
+      "layout(local_size_x = 16) in;\n"
+      "layout(set = 2, binding = 3) buffer B { int v[]; };\n"
+      "void main() { v[0] = 1; }\n";
+  const shaderc_compile_target targets[] = {
+      {shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_0,
+       shaderc_spirv_version_1_0},
+      {shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_1,
+       shaderc_spirv_version_1_3}};
+  shaderc_compile_options_set_generate_reflection(options_.get(), true);
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_into_spv_for_targets(
+      compiler_.get_compiler_handle(), shader.data(), shader.size(),
+      shaderc_glsl_compute_shader, "shader", "main", targets, 2,
+      options_.get(), results);
+  for (shaderc_compilation_result_t result : results) {
+    ASSERT_TRUE(CompilationResultIsSuccess(result));
+    EXPECT_THAT(shaderc_result_get_reflection(result),
+                HasSubstr("\"kind\": \"storage_buffer\", "
+                          "\"set\": 2, \"binding\": 3"));
+    EXPECT_THAT(shaderc_result_get_reflection(result),
+                HasSubstr("\"workgroup_size\": [16, 1, 1]"));
+    shaderc_result_release(result);
+  }
+}
+
+TEST_F(CompileStringTest, ErrorFailsEveryTarget) {
+  ASSERT_NE(nullptr, compiler_.get_compiler_handle());
+  const std::string bad_shader = "#version 450\nvoid main() { float a = b; }";
+  const shaderc_compile_target targets[] = {
+      {shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_0, 0},
+      {shaderc_target_env_opengl, shaderc_env_version_opengl_4_5, 0}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_into_spv_for_targets(
+      compiler_.get_compiler_handle(), bad_shader.data(), bad_shader.size(),
+      shaderc_glsl_vertex_shader, "shader", "main", targets, 2,
+      options_.get(), results);
+  for (shaderc_compilation_result_t result : results) {
+    EXPECT_EQ(shaderc_compilation_status_compilation_error,
+              shaderc_result_get_compilation_status(result));
+    EXPECT_THAT(shaderc_result_get_error_message(result),
+                HasSubstr("shader:2: error: 'b' : undeclared identifier"));
+    EXPECT_EQ(0u, shaderc_result_get_length(result));
+    shaderc_result_release(result);
+  }
+}
+
 TEST_F(CompileStringTest, GetNumErrors) {
   Compilation comp(compiler_.get_compiler_handle(), kTwoErrorsShader,
                    shaderc_glsl_vertex_shader, "shader", "main");
@@ -685,6 +1168,329 @@ TEST_F(CompileStringWithOptionsTest, CompileAndOptimizeWithLevelSize) {
   EXPECT_THAT(disassembly_text, Not(HasSubstr("OpSource")));
 }
 
+TEST_F(CompileStringWithOptionsTest, CompileWithOptimizationPasses) {
+  const char* passes[] = {"--inline-entry-points-exhaustive", "strip-debug"};
+  ASSERT_TRUE(shaderc_compile_options_set_optimization_passes(options_.get(),
+                                                              passes, 2));
+  const std::string disassembly_text =
+      CompilationOutput(kGlslMultipleFnShader, shaderc_glsl_fragment_shader,
+                        options_.get(), OutputType::SpirvAssemblyText);
+  EXPECT_THAT(disassembly_text, Not(HasSubstr("OpFunctionCall")));
+  EXPECT_THAT(disassembly_text, Not(HasSubstr("OpName")));
+}
+
+TEST_F(CompileStringWithOptionsTest, OptimizationPassesReplaceTheLevel) {
+  shaderc_compile_options_set_optimization_level(
+      options_.get(), shaderc_optimization_level_size);
+  const char* passes[] = {"--eliminate-dead-functions"};
+  ASSERT_TRUE(shaderc_compile_options_set_optimization_passes(options_.get(),
+                                                              passes, 1));
+  // The size passes would strip the debug instructions.
+  EXPECT_THAT(CompilationOutput(kMinimalShader, shaderc_glsl_vertex_shader,
+                                options_.get(), OutputType::SpirvAssemblyText),
+              HasSubstr("OpName"));
+}
+
+TEST_F(CompileStringWithOptionsTest, OptimizerCacheIsSharedByVariants) {
+  shaderc_optimizer_cache_t cache = shaderc_optimizer_cache_create(1 << 20);
+  ASSERT_NE(nullptr, cache);
+  shaderc_compile_options_set_optimization_level(
+      options_.get(), shaderc_optimization_level_performance);
+  shaderc_compile_options_set_optimizer_cache(options_.get(), cache);
+  const std::string plain = CompilationOutput(
+      kGlslMultipleFnShader, shaderc_glsl_fragment_shader, options_.get());
+  // An unused macro does not change the generated SPIR-V.
+  compile_options_ptr variant_options(
+      shaderc_compile_options_clone(options_.get()));
+  shaderc_compile_options_add_macro_definition(variant_options.get(),
+                                               "UNUSED", 6, "1", 1);
+  const std::string variant =
+      CompilationOutput(kGlslMultipleFnShader, shaderc_glsl_fragment_shader,
+                        variant_options.get());
+  EXPECT_EQ(plain, variant);
+  EXPECT_EQ(1u, shaderc_optimizer_cache_get_num_hits(cache));
+  EXPECT_EQ(1u, shaderc_optimizer_cache_get_num_misses(cache));
+  shaderc_optimizer_cache_clear(cache);
+  CompilationOutput(kGlslMultipleFnShader, shaderc_glsl_fragment_shader,
+                    options_.get());
+  EXPECT_EQ(2u, shaderc_optimizer_cache_get_num_misses(cache));
+  variant_options.reset();
+  options_.reset();
+  shaderc_optimizer_cache_release(cache);
+}
+
+TEST_F(CompileStringWithOptionsTest, ValidationPoliciesCompileValidShaders) {
+  for (const auto policy : {shaderc_validation_policy_never,
+                            shaderc_validation_policy_before_optimization,
+                            shaderc_validation_policy_after_optimization,
+                            shaderc_validation_policy_always}) {
+    shaderc_compile_options_set_validation_policy(options_.get(), policy);
+    for (const auto level : {shaderc_optimization_level_zero,
+                             shaderc_optimization_level_performance}) {
+      shaderc_compile_options_set_optimization_level(options_.get(), level);
+      EXPECT_TRUE(CompilationSuccess(kGlslMultipleFnShader,
+                                     shaderc_glsl_fragment_shader,
+                                     options_.get()))
+          << policy << " " << level;
+    }
+  }
+}
+
+TEST_F(CompileStringWithOptionsTest, ValidateSpvAcceptsCompiledModule) {
+  const std::string binary = CompilationOutput(
+      kMinimalShader, shaderc_glsl_vertex_shader, options_.get());
+  ASSERT_EQ(0u, binary.size() % sizeof(uint32_t));
+  shaderc_compilation_result_t result = shaderc_validate_spv(
+      compiler_.get_compiler_handle(),
+      reinterpret_cast<const uint32_t*>(binary.data()),
+      binary.size() / sizeof(uint32_t), options_.get());
+  ASSERT_NE(nullptr, result);
+  EXPECT_EQ(shaderc_compilation_status_success,
+            shaderc_result_get_compilation_status(result));
+  EXPECT_EQ(0u, shaderc_result_get_length(result));
+  EXPECT_EQ(0u, shaderc_result_get_num_errors(result));
+  shaderc_result_release(result);
+}
+
+TEST_F(CompileStringWithOptionsTest, ValidateSpvAcceptsScalarBlockLayout) {
+  // The vec4 follows the float directly, which only the scalar layout allows.
+  const std::string binary = CompilationOutput(
+      "#version 450\n"
+      "#extension GL_EXT_scalar_block_layout : require\n"
+      "layout(local_size_x = 1) in;\n"
+      "layout(scalar, binding = 0) buffer B { float x; vec4 v; };\n"
+      "void main() { v = vec4(x); }\n",
+      shaderc_glsl_compute_shader, options_.get());
+  ASSERT_EQ(0u, binary.size() % sizeof(uint32_t));
+  shaderc_compilation_result_t result = shaderc_validate_spv(
+      compiler_.get_compiler_handle(),
+      reinterpret_cast<const uint32_t*>(binary.data()),
+      binary.size() / sizeof(uint32_t), options_.get());
+  ASSERT_NE(nullptr, result);
+  EXPECT_EQ(shaderc_compilation_status_success,
+            shaderc_result_get_compilation_status(result))
+      << shaderc_result_get_error_message(result);
+  shaderc_result_release(result);
+}
+
+TEST_F(CompileStringWithOptionsTest, ValidateSpvRejectsInvalidModule) {
+  const uint32_t not_spirv[] = {0xdeadbeef, 0x00010000, 0, 1, 0};
+  for (int i = 0; i < 2; ++i) {
+    // The second call reuses the validator of the first.
+    shaderc_compilation_result_t result =
+        shaderc_validate_spv(compiler_.get_compiler_handle(), not_spirv, 5,
+                             i ? nullptr : options_.get());
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(shaderc_compilation_status_validation_error,
+              shaderc_result_get_compilation_status(result));
+    EXPECT_EQ(1u, shaderc_result_get_num_errors(result));
+    EXPECT_STRNE("", shaderc_result_get_error_message(result));
+    shaderc_result_release(result);
+  }
+}
+
+// Appends the given data to the std::string that user_data points to.
+bool AppendToString(void* user_data, const char* data, size_t size) {
+  static_cast<std::string*>(user_data)->append(data, size);
+  return true;
+}
+
+TEST_F(CompileStringWithOptionsTest, DisassembleSpvWritesToTheWriter) {
+  const std::string binary = CompilationOutput(
+      kMinimalShader, shaderc_glsl_vertex_shader, options_.get());
+  std::string text;
+  shaderc_compilation_result_t result = shaderc_disassemble_spv(
+      compiler_.get_compiler_handle(),
+      reinterpret_cast<const uint32_t*>(binary.data()),
+      binary.size() / sizeof(uint32_t), options_.get(), AppendToString, &text);
+  ASSERT_NE(nullptr, result);
+  EXPECT_EQ(shaderc_compilation_status_success,
+            shaderc_result_get_compilation_status(result));
+  EXPECT_EQ(0u, shaderc_result_get_length(result));
+  shaderc_result_release(result);
+  EXPECT_EQ(CompilationOutput(kMinimalShader, shaderc_glsl_vertex_shader,
+                              options_.get(), OutputType::SpirvAssemblyText),
+            text);
+}
+
+TEST_F(CompileStringWithOptionsTest, DisassembleSpvWithoutFriendlyNames) {
+  const std::string binary = CompilationOutput(
+      kMinimalShader, shaderc_glsl_vertex_shader, options_.get());
+  shaderc_compile_options_set_disassembly_friendly_names(options_.get(),
+                                                         false);
+  shaderc_compilation_result_t result = shaderc_disassemble_spv(
+      compiler_.get_compiler_handle(),
+      reinterpret_cast<const uint32_t*>(binary.data()),
+      binary.size() / sizeof(uint32_t), options_.get(), nullptr, nullptr);
+  ASSERT_NE(nullptr, result);
+  ASSERT_EQ(shaderc_compilation_status_success,
+            shaderc_result_get_compilation_status(result));
+  const std::string text(shaderc_result_get_bytes(result),
+                         shaderc_result_get_length(result));
+  shaderc_result_release(result);
+  EXPECT_THAT(text, HasSubstr("OpName %4 \"main\""));
+  EXPECT_THAT(text, Not(HasSubstr("%main")));
+  // Compilations to assembly follow the options too.
+  EXPECT_THAT(CompilationOutput(kMinimalShader, shaderc_glsl_vertex_shader,
+                                options_.get(), OutputType::SpirvAssemblyText),
+              Not(HasSubstr("%main")));
+}
+
+TEST_F(CompileStringWithOptionsTest, DisassembleSpvRejectsInvalidModule) {
+  const uint32_t not_spirv[] = {0xdeadbeef, 0x00010000, 0, 1, 0};
+  std::string text;
+  shaderc_compilation_result_t result =
+      shaderc_disassemble_spv(compiler_.get_compiler_handle(), not_spirv, 5,
+                              options_.get(), AppendToString, &text);
+  ASSERT_NE(nullptr, result);
+  EXPECT_EQ(shaderc_compilation_status_validation_error,
+            shaderc_result_get_compilation_status(result));
+  EXPECT_STRNE("", shaderc_result_get_error_message(result));
+  EXPECT_EQ("", text);
+  shaderc_result_release(result);
+}
+
+TEST_F(CompileStringWithOptionsTest, SpecializationConstantIsFrozen) {
+  const std::string shader =
+      "#version 450\n"
+      "layout(local_size_x = 1) in;\n"
+      "layout(constant_id = 3) const int N = 4;\n"
+      "layout(std430, binding = 0) buffer B { int v[]; };\n"
+      "void main() { v[0] = N; }\n";
+  shaderc_compile_options_set_specialization_constant(options_.get(), 3, "8");
+  const std::string disassembly =
+      CompilationOutput(shader, shaderc_glsl_compute_shader, options_.get(),
+                        OutputType::SpirvAssemblyText);
+  EXPECT_THAT(disassembly, HasSubstr("OpConstant %int 8"));
+  EXPECT_THAT(disassembly, Not(HasSubstr("SpecId")));
+
+  shaderc_compile_options_set_specialization_constant(options_.get(), 3,
+                                                      "eight");
+  EXPECT_THAT(
+      CompilationErrors(shader, shaderc_glsl_compute_shader, options_.get()),
+      HasSubstr("shader: error: invalid value 'eight' for 32-bit signed "
+                "integer specialization constant 3"));
+}
+
+TEST_F(CompileStringWithOptionsTest, MacroSpecConstant) {
+  const std::string shader =
+      "#version 450\n"
+      "layout(local_size_x = 1) in;\n"
+      "layout(std430, binding = 0) buffer B { float v[]; };\n"
+      "void main() { v[0] = SCALE; }\n";
+  shaderc_compile_options_add_macro_definition(options_.get(), "SCALE", 5u,
+                                               "0.5", 3u);
+  shaderc_compile_options_add_macro_spec_constant(options_.get(), "SCALE", 5u,
+                                                  7);
+  const std::string disassembly =
+      CompilationOutput(shader, shaderc_glsl_compute_shader, options_.get(),
+                        OutputType::SpirvAssemblyText);
+  EXPECT_THAT(disassembly, HasSubstr("OpDecorate %SCALE SpecId 7"));
+  EXPECT_THAT(disassembly, HasSubstr("%SCALE = OpSpecConstant %float 0.5"));
+
+  shaderc_compile_options_add_macro_definition(options_.get(), "SCALE", 5u,
+                                               "1 / 2", 5u);
+  EXPECT_THAT(
+      CompilationErrors(shader, shaderc_glsl_compute_shader, options_.get()),
+      HasSubstr("shader: error: macro 'SCALE' has no boolean or numeric "
+                "literal value"));
+}
+
+TEST_F(CompileStringWithOptionsTest, ReflectionIsGeneratedWhenRequested) {
+  const std::string shader =
+      "#version 450\n"
+      "layout(local_size_x = 16) in;\n"
+      "layout(set = 2, binding = 3) buffer B { int v[]; };\n"
+      "void main() { v[0] = 1; }\n";
+  {
+    const Compilation comp(compiler_.get_compiler_handle(), shader,
+                           shaderc_glsl_compute_shader, "shader", "main",
+                           options_.get());
+    EXPECT_EQ(shaderc_compilation_status_success,
+              shaderc_result_get_compilation_status(comp.result()));
+    EXPECT_STREQ("", shaderc_result_get_reflection(comp.result()));
+  }
+  shaderc_compile_options_set_generate_reflection(options_.get(), true);
+  const Compilation comp(compiler_.get_compiler_handle(), shader,
+                         shaderc_glsl_compute_shader, "shader", "main",
+                         options_.get());
+  ASSERT_EQ(shaderc_compilation_status_success,
+            shaderc_result_get_compilation_status(comp.result()));
+  const std::string reflection = shaderc_result_get_reflection(comp.result());
+  EXPECT_THAT(reflection, HasSubstr("\"kind\": \"storage_buffer\", "
+                                    "\"set\": 2, \"binding\": 3"));
+  EXPECT_THAT(reflection, HasSubstr("\"workgroup_size\": [16, 1, 1]"));
+}
+
+TEST_F(CompileStringWithOptionsTest, LinkLibraryResolvesImportedFunctions) {
+  const std::string library =
+      "#version 450\n"
+      "float twice(float x) { return 2.0 * x; }\n";
+  const std::string shader =
+      "#version 450\n"
+      "layout(local_size_x = 1) in;\n"
+      "layout(std430, binding = 0) buffer B { float v[]; };\n"
+      "float twice(float x);\n"
+      "void main() { v[0] = twice(v[1]); }\n";
+  std::vector<uint32_t> library_words;
+  {
+    compile_options_ptr library_options(shaderc_compile_options_initialize());
+    shaderc_compile_options_set_compile_for_linking(library_options.get(),
+                                                    true);
+    const Compilation comp(compiler_.get_compiler_handle(), library,
+                           shaderc_glsl_compute_shader, "library", "main",
+                           library_options.get());
+    ASSERT_EQ(shaderc_compilation_status_success,
+              shaderc_result_get_compilation_status(comp.result()));
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(
+        shaderc_result_get_bytes(comp.result()));
+    library_words.assign(
+        words, words + shaderc_result_get_length(comp.result()) / 4);
+  }
+  {
+    // Without the library, the function is not defined.
+    const Compilation comp(compiler_.get_compiler_handle(), shader,
+                           shaderc_glsl_compute_shader, "shader", "main",
+                           options_.get());
+    EXPECT_NE(shaderc_compilation_status_success,
+              shaderc_result_get_compilation_status(comp.result()));
+  }
+  shaderc_compile_options_add_link_library(
+      options_.get(), library_words.data(), library_words.size());
+  const Compilation comp(compiler_.get_compiler_handle(), shader,
+                         shaderc_glsl_compute_shader, "shader", "main",
+                         options_.get());
+  EXPECT_EQ(shaderc_compilation_status_success,
+            shaderc_result_get_compilation_status(comp.result()))
+      << shaderc_result_get_error_message(comp.result());
+}
+
+TEST_F(CompileStringWithOptionsTest, UnknownOptimizationPassFailsCompilation) {
+  const char* passes[] = {"--strip-debug", "--no-such-pass"};
+  EXPECT_FALSE(shaderc_compile_options_set_optimization_passes(options_.get(),
+                                                               passes, 2));
+  EXPECT_EQ("shader: error: unknown optimization pass: '--no-such-pass'\n",
+            CompilationErrors(kMinimalShader, shaderc_glsl_vertex_shader,
+                              options_.get()));
+  // The last call wins, and zero passes restore the optimization level.
+  EXPECT_TRUE(shaderc_compile_options_set_optimization_passes(options_.get(),
+                                                              nullptr, 0));
+  EXPECT_THAT(CompilationOutput(kMinimalShader, shaderc_glsl_vertex_shader,
+                                options_.get(), OutputType::SpirvAssemblyText),
+              HasSubstr("OpName"));
+}
+
+TEST_F(CompileStringWithOptionsTest, EmptyOptimizationPassesClearEarlierOnes) {
+  const char* passes[] = {"--strip-debug"};
+  ASSERT_TRUE(shaderc_compile_options_set_optimization_passes(options_.get(),
+                                                              passes, 1));
+  ASSERT_TRUE(shaderc_compile_options_set_optimization_passes(options_.get(),
+                                                              nullptr, 0));
+  EXPECT_THAT(CompilationOutput(kMinimalShader, shaderc_glsl_vertex_shader,
+                                options_.get(), OutputType::SpirvAssemblyText),
+              HasSubstr("OpName"));
+}
+
 #if SHADERC_ENABLE_HLSL
 TEST_F(CompileStringWithOptionsTest, CompileAndOptimizeForVulkan10Failure) {
   shaderc_compile_options_set_source_language(options_.get(),
@@ -1862,6 +2668,28 @@ TEST_F(CompileStringWithOptionsTest, HlslOffsetsOptionEnableRespected) {
   EXPECT_THAT(disassembly_text, HasSubstr("OpMemberDecorate %B 1 Offset 4"));
 }
 
+TEST_F(CompileStringWithOptionsTest, CompilesEachHlslEntryPoint) {
+  shaderc_compile_options_set_source_language(options_.get(),
+                                              shaderc_source_language_hlsl);
+  const std::string source =
+      "float4 VSMain() : SV_POSITION { return float4(1.0, 1.0, 1.0, 1.0); }\n"
+      "float4 PSMain() : SV_Target0 { return float4(0.0, 0.0, 0.0, 1.0); }\n";
+  const shaderc_entry_point entry_points[] = {
+      {"VSMain", shaderc_vertex_shader}, {"PSMain", shaderc_fragment_shader}};
+  shaderc_compilation_result_t results[2] = {};
+  shaderc_compile_entry_points_into_spv_assembly(
+      compiler_.get_compiler_handle(), source.data(), source.size(), "shader",
+      entry_points, 2, options_.get(), results);
+  ASSERT_TRUE(CompilationResultIsSuccess(results[0]));
+  ASSERT_TRUE(CompilationResultIsSuccess(results[1]));
+  EXPECT_THAT(shaderc_result_get_bytes(results[0]),
+              HasSubstr("OpEntryPoint Vertex %VSMain"));
+  EXPECT_THAT(shaderc_result_get_bytes(results[1]),
+              HasSubstr("OpEntryPoint Fragment %PSMain"));
+  shaderc_result_release(results[0]);
+  shaderc_result_release(results[1]);
+}
+
 TEST_F(CompileStringWithOptionsTest, HlslFunctionality1OffByDefault) {
   shaderc_compile_options_set_source_language(options_.get(),
                                               shaderc_source_language_hlsl);
@@ -1938,4 +2766,66 @@ TEST_F(CompileStringWithOptionsTest, NanClampSurvivesCloning) {
   EXPECT_THAT(disassembly_text, HasSubstr("OpExtInst %v4float %1 NClamp"));
 }
 
+TEST_F(CompileStringWithOptionsTest, PreprocessedInputCompiles) {
+  shaderc_compile_options_set_input_preprocessed(options_.get(), true);
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalShader,
+                                 shaderc_glsl_vertex_shader, options_.get()));
+}
+
+TEST_F(CompileStringWithOptionsTest, PreprocessedInputSkipsMacroDefinitions) {
+  shaderc_compile_options_add_macro_definition(options_.get(), "E", 1u, "main",
+                                               4u);
+  const std::string kMinimalExpandedShader = "#version 140\nvoid E(){}";
+  EXPECT_TRUE(CompilesToValidSpv(compiler_, kMinimalExpandedShader,
+                                 shaderc_glsl_vertex_shader, options_.get()));
+  shaderc_compile_options_set_input_preprocessed(options_.get(), true);
+  EXPECT_FALSE(CompilesToValidSpv(compiler_, kMinimalExpandedShader,
+                                  shaderc_glsl_vertex_shader, options_.get()));
+}
+
+TEST_F(CompileStringWithOptionsTest, PreprocessedInputSurvivesCloning) {
+  shaderc_compile_options_set_input_preprocessed(options_.get(), true);
+  compile_options_ptr cloned_options(
+      shaderc_compile_options_clone(options_.get()));
+  const std::string preprocessed_text = CompilationOutput(
+      kMinimalShader, shaderc_glsl_vertex_shader, cloned_options.get(),
+      OutputType::PreprocessedText);
+  EXPECT_EQ(kMinimalShader, preprocessed_text);
+}
+
+TEST_F(CompileStringWithOptionsTest, SyntaxOnlyHasNoOutput) {
+  shaderc_compile_options_set_syntax_only(options_.get(),
+                                          shaderc_syntax_only_parse);
+  EXPECT_EQ("", CompilationOutput(kMinimalShader, shaderc_glsl_vertex_shader,
+                                  options_.get()));
+  EXPECT_EQ("", CompilationOutput(kMinimalShader, shaderc_glsl_vertex_shader,
+                                  options_.get(),
+                                  OutputType::SpirvAssemblyText));
+}
+
+TEST_F(CompileStringWithOptionsTest, SyntaxOnlyReportsErrors) {
+  shaderc_compile_options_set_syntax_only(options_.get(),
+                                          shaderc_syntax_only_parse);
+  EXPECT_THAT(CompilationErrors("#version 140\nvoid main() { float a = b; }",
+                                shaderc_glsl_vertex_shader, options_.get()),
+              HasSubstr("shader:2: error: 'b' : undeclared identifier"));
+}
+
+TEST_F(CompileStringWithOptionsTest, SyntaxOnlyValidateHasNoOutput) {
+  shaderc_compile_options_set_syntax_only(options_.get(),
+                                          shaderc_syntax_only_validate);
+  shaderc_compile_options_set_optimization_level(
+      options_.get(), shaderc_optimization_level_performance);
+  EXPECT_EQ("", CompilationOutput(kMinimalShader, shaderc_glsl_vertex_shader,
+                                  options_.get()));
+}
+
+TEST_F(CompileStringWithOptionsTest, SyntaxOnlyLeavesPreprocessingAlone) {
+  shaderc_compile_options_set_syntax_only(options_.get(),
+                                          shaderc_syntax_only_parse);
+  EXPECT_THAT(CompilationOutput(kMinimalShader, shaderc_glsl_vertex_shader,
+                                options_.get(), OutputType::PreprocessedText),
+              HasSubstr("void main"));
+}
+
 }  // anonymous namespace
@@ -25,14 +25,24 @@ else
 endif
 LOCAL_EXPORT_C_INCLUDES:=$(LOCAL_PATH)/include
 LOCAL_SRC_FILES:=src/args.cc \
+		src/compile_context.cc \
                 src/compiler.cc \
 		src/file_finder.cc \
+		src/heap_usage.cc \
 		src/io_shaderc.cc \
+		src/json.cc \
 		src/message.cc \
+		src/optimizer_cache.cc \
+		src/packed_spirv.cc \
+		src/parallel.cc \
+		src/reflection.cc \
 		src/resources.cc \
+		src/shader_archive.cc \
 		src/shader_stage.cc \
+		src/spec_constants.cc \
 		src/spirv_tools_wrapper.cc \
+		src/trace.cc \
 		src/version_profile.cc
-LOCAL_STATIC_LIBRARIES:=SPIRV SPIRV-Tools-opt glslang
-LOCAL_C_INCLUDES:=$(LOCAL_PATH)/include
+LOCAL_STATIC_LIBRARIES:=SPIRV SPIRV-Tools-opt SPIRV-Tools-link glslang
+LOCAL_C_INCLUDES:=$(LOCAL_PATH)/include $(SPVHEADERS_LOCAL_PATH)/include
 include $(BUILD_STATIC_LIBRARY)
@@ -0,0 +1,122 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSHADERC_UTIL_COMPILE_CONTEXT_H_
+#define LIBSHADERC_UTIL_COMPILE_CONTEXT_H_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "libshaderc_util/compiler.h"
+
+namespace spvtools {
+class Context;
+class Optimizer;
+class SpirvTools;
+}
+
+namespace shaderc_util {
+
+// Scratch state that Compiler::Compile() keeps across compilations, so that
+// it is set up once instead of for each compilation.  This holds optimizers
+// with their passes already registered, and SPIRV-Tools contexts, with their
+// grammar tables, for validation, assembly and disassembly.  The frontend
+// state of glslang, such as its pool allocators and symbol tables, belongs to
+// the glslang::TShader and glslang::TProgram of each compilation, and cannot
+// be reused.
+//
+// Optimizers are kept for each target environment and list of passes, which
+// callers may choose freely, so only the max_optimizers most recently used
+// ones are kept.
+//
+// A context must only be used by one compilation at a time.
+class CompileContext {
+ public:
+  // The number of optimizers that a context keeps by default, enough for the
+  // optimization levels of a few target environments.
+  static constexpr size_t kDefaultMaxOptimizers = 16;
+
+  explicit CompileContext(size_t max_optimizers = kDefaultMaxOptimizers);
+  ~CompileContext();
+
+  CompileContext(const CompileContext&) = delete;
+  CompileContext& operator=(const CompileContext&) = delete;
+
+  // Returns an optimizer for the given target environment, with the given
+  // passes and spirv-opt pass flags registered, creating it on first use.  Its
+  // messages are written to optimizer_messages().  Creating one may drop the
+  // least recently used optimizer, so the optimizer returned is only valid
+  // until the next call.
+  spvtools::Optimizer* GetOptimizer(
+      Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+      const std::vector<PassId>& passes,
+      const std::vector<std::string>& pass_flags = {});
+
+  // Returns the stream that the messages of optimizers are written to.
+  std::ostringstream* optimizer_messages() { return &optimizer_messages_; }
+
+  // Returns the number of optimizers kept.
+  size_t num_optimizers() const { return optimizers_.size(); }
+
+  // Returns the SPIRV-Tools context for the given target environment,
+  // creating it on first use.  Its messages are written to
+  // spirv_tools_messages().
+  spvtools::SpirvTools* GetSpirvTools(Compiler::TargetEnv env,
+                                      Compiler::TargetEnvVersion version);
+
+  // Returns the stream that the messages of SPIRV-Tools contexts are written
+  // to.
+  std::ostringstream* spirv_tools_messages() { return &spirv_tools_messages_; }
+
+  // Returns the number of SPIRV-Tools contexts kept.
+  size_t num_spirv_tools() const { return spirv_tools_.size(); }
+
+  // Returns the SPIRV-Tools context for the given target environment whose
+  // C context is used with the C API of SPIRV-Tools, such as for assembly,
+  // creating it on first use.
+  spvtools::Context* GetSpvContext(Compiler::TargetEnv env,
+                                   Compiler::TargetEnvVersion version);
+
+ private:
+  using OptimizerKey = std::tuple<Compiler::TargetEnv,
+                                  Compiler::TargetEnvVersion,
+                                  std::vector<PassId>,
+                                  std::vector<std::string>>;
+  struct OptimizerEntry {
+    OptimizerKey key;
+    std::unique_ptr<spvtools::Optimizer> optimizer;
+  };
+  const size_t max_optimizers_;
+  // The optimizers, most recently used first.
+  std::list<OptimizerEntry> optimizers_;
+  std::map<OptimizerKey, std::list<OptimizerEntry>::iterator> optimizer_index_;
+  std::ostringstream optimizer_messages_;
+  std::map<std::pair<Compiler::TargetEnv, Compiler::TargetEnvVersion>,
+           std::unique_ptr<spvtools::SpirvTools>>
+      spirv_tools_;
+  std::ostringstream spirv_tools_messages_;
+  std::map<std::pair<Compiler::TargetEnv, Compiler::TargetEnvVersion>,
+           std::unique_ptr<spvtools::Context>>
+      spv_contexts_;
+};
+
+}  // namespace shaderc_util
+
+#endif  // LIBSHADERC_UTIL_COMPILE_CONTEXT_H_
@@ -18,8 +18,11 @@
 #include <array>
 #include <cassert>
 #include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <ostream>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -40,6 +43,10 @@ namespace shaderc_util {
 // spirv_tools_wrapper.h, so cannot include spirv_tools_wrapper.h here.
 enum class PassId;
 
+class CompileContext;
+class OptimizerCache;
+struct GlslangClientInfo;
+
 // Initializes glslang on creation, and destroys it on completion.
 // Used to tie gslang process operations to object lifetimes.
 // Additionally initialization/finalization of glslang is not thread safe, so
@@ -49,6 +56,16 @@ class GlslangInitializer {
   GlslangInitializer();
   ~GlslangInitializer();
 
+  // Frees the process-wide state of glslang, including the built-in symbol
+  // tables shared by all compilations, and sets it up again empty.  Waits for
+  // the compilations in progress to finish, and holds off new ones until it is
+  // done.
+  void ResetProcessState();
+
+  // Held in shared mode by each compilation, and in exclusive mode by
+  // ResetProcessState().
+  static std::shared_mutex& state_mutex();
+
  private:
   static unsigned int initialize_count_;
 
@@ -57,6 +74,35 @@ class GlslangInitializer {
   static std::mutex* glslang_mutex_;
 };
 
+// One piece of the source of a shader.  The pieces of a shader are given to
+// glslang as its separate strings, in order, without being concatenated, and
+// diagnostics in each piece name that piece.
+struct SourceChunk {
+  string_piece text;
+  // The null-terminated name of the piece.
+  const char* name;
+};
+
+// One stage of a program given to Compiler::CompileProgram().
+struct ProgramStage {
+  std::vector<SourceChunk> source_chunks;
+  EShLanguage stage;
+  // The name to use for errors about this stage that are not in any chunk.
+  std::string error_tag;
+  // The entry point, for HLSL.  Ignored for GLSL.
+  std::string entry_point_name;
+};
+
+// The output for one stage of a program compiled by
+// Compiler::CompileProgram().  As for Compiler::Compile(), output_size is the
+// number of bytes of valid data in output.
+struct ProgramStageOutput {
+  std::vector<uint32_t> output;
+  size_t output_size = 0;
+  // The JSON description of the stage's interface, if it was requested.
+  std::string reflection;
+};
+
 // Maps macro names to their definitions.  Stores string_pieces, so the
 // underlying strings must outlive it.
 using MacroDictionary = std::unordered_map<std::string, std::string>;
@@ -101,12 +147,46 @@ class Compiler {
     v1_6 = 0x010600u,
   };
 
+  // A target environment and SPIR-V version, for CompileForTargets().
+  struct Target {
+    TargetEnv env;
+    TargetEnvVersion env_version;
+    // The SPIR-V version, if spirv_version_is_forced.  Otherwise the default
+    // version of the target environment is used.
+    SpirvVersion spirv_version;
+    bool spirv_version_is_forced;
+  };
+
+  // The output for one target of CompileForTargets().  As for Compile(),
+  // output_size is the number of bytes of valid data in output.
+  struct TargetOutput {
+    bool succeeded = false;
+    std::vector<uint32_t> output;
+    size_t output_size = 0;
+    std::string messages;
+    size_t num_warnings = 0;
+    size_t num_errors = 0;
+    // True if this target did not share the first run of the frontend, and
+    // its source was parsed again.
+    bool frontend_rerun = false;
+    // The JSON description of the shader's interface, if it was requested.
+    std::string reflection;
+  };
+
   enum class OutputType {
     SpirvBinary,  // A binary module, as defined by the SPIR-V specification.
     SpirvAssemblyText,  // Assembly syntax defined by the SPIRV-Tools project.
     PreprocessedText,   // Preprocessed source code.
   };
 
+  // How far a syntax-only compilation goes before it stops.  A syntax-only
+  // compilation produces diagnostics, but no output.
+  enum class SyntaxOnlyMode {
+    Off,           // Compile as usual.
+    ParseAndLink,  // Stop after glslang's parse and link.
+    Validate,      // Also generate SPIR-V, and validate it.
+  };
+
   // Supported optimization levels.
   enum class OptimizationLevel {
     Zero,         // No optimization.
@@ -114,6 +194,15 @@ class Compiler {
     Performance,  // Optimization towards better performance.
   };
 
+  // When the SPIR-V of a compilation is validated.
+  enum class ValidationPolicy {
+    Default,             // Only by the optimizer, before it runs.
+    Never,               // Not at all.
+    BeforeOptimization,  // Once generated, before any optimization.
+    AfterOptimization,   // Once final, after any optimization.
+    Always,              // Both before and after any optimization.
+  };
+
   // Resource limits.  These map to the "max*" fields in
   // glslang::TBuiltInResource.
   enum class Limit {
@@ -196,6 +285,8 @@ class Compiler {
         suppress_warnings_(false),
         generate_debug_info_(false),
         enabled_opt_passes_(),
+        opt_pass_flags_(),
+        opt_pass_flags_error_(),
         target_env_(TargetEnv::Vulkan),
         target_env_version_(TargetEnvVersion::Default),
         target_spirv_version_(SpirvVersion::v1_0),
@@ -224,6 +315,17 @@ class Compiler {
   // effect if multiple calls of this method exist.
   void SetOptimizationLevel(OptimizationLevel level);
 
+  // Sets the optimization passes to run instead of those of the optimization
+  // level, as spirv-opt flags such as "--loop-unroll", in order.  The leading
+  // "--" may be left out.  Only the last call of this method and
+  // SetOptimizationLevel() takes effect, and an empty list of passes restores
+  // the passes of the optimization level.  Returns false and writes a message
+  // to *errors if SPIRV-Tools does not know one of the passes, in which case
+  // every compilation fails with that message until a later call of this
+  // method or of SetOptimizationLevel().
+  bool SetOptimizationPasses(const std::vector<std::string>& passes,
+                             std::string* errors);
+
   // Enables or disables HLSL legalization passes.
   void EnableHlslLegalization(bool hlsl_legalization_enabled);
 
@@ -253,6 +355,19 @@ class Compiler {
   // Any warning message generated is suppressed before it is output.
   void SetSuppressWarnings();
 
+  // Sets whether the source is the output of an earlier preprocessing, with
+  // no #include directives left and no dependence on predefined macros.  Such
+  // source goes straight to the parser: there is no separate preprocessing
+  // pass, no macro definitions or other preamble are added, and #include
+  // directives are errors.  Preprocessing-only output is the source itself.
+  void SetInputPreprocessed(bool preprocessed);
+
+  // Sets how far compilations go when they only check the source.  Unless
+  // the mode is SyntaxOnlyMode::Off, successful compilations to SPIR-V or its
+  // assembly produce no output, and no optimization or disassembly is done.
+  // Preprocessing-only compilations are not affected.
+  void SetSyntaxOnly(SyntaxOnlyMode mode);
+
   // Adds an implicit macro definition obeyed by subsequent CompileShader()
   // calls. The macro and definition should be passed in with their char*
   // pointer and their lengths. They can be modified or deleted after this
@@ -260,6 +375,19 @@ class Compiler {
   void AddMacroDefinition(const char* macro, size_t macro_length,
                           const char* definition, size_t definition_length);
 
+  // Makes the predefined macro of the given name a specialization constant
+  // with the given SpecId in subsequent compilations, so that one module
+  // serves every value of the macro.  The constant is declared with the value
+  // of the macro as its default, which must be a boolean, integer or
+  // floating-point literal, and the macro expands to the constant wherever it
+  // is used as a value.  The macro stays defined for #ifdef, but using it
+  // where a literal is required, such as in #if expressions or layout
+  // qualifiers, is an error.  Preprocessing-only compilations, and input
+  // that is already preprocessed, are unaffected.
+  void AddMacroSpecConstant(const std::string& macro, uint32_t spec_id) {
+    macro_spec_constants_[macro] = spec_id;
+  }
+
   // Sets the target environment, including version.  The version value should
   // be 0 or one of the values from TargetEnvVersion.  The default value maps
   // to Vulkan 1.0 if the target environment is Vulkan, and it maps to OpenGL
@@ -321,6 +449,51 @@ class Compiler {
 
   void SetMaxIdBound(uint32_t max_id_bound) { max_id_bound_ = max_id_bound; }
 
+  // Sets the cache of optimizer outputs to look up the optimized SPIR-V in,
+  // and to add it to, or null for none.  The cache is not owned, and may be
+  // shared by several compilers on several threads.
+  void SetOptimizerCache(OptimizerCache* cache) { optimizer_cache_ = cache; }
+
+  // Sets whether SPIR-V assembly output names ids after the names in the
+  // module, which is the default, or by number, which is faster.
+  void SetDisassemblyFriendlyNames(bool friendly_names) {
+    disassembly_friendly_names_ = friendly_names;
+  }
+
+  // Sets the value of the specialization constant with the given SpecId in
+  // the SPIR-V of subsequent compilations.  The constant is frozen to that
+  // value before the optimizer runs, which folds it, and the operations on it,
+  // as regular constants, even at OptimizationLevel::Zero.  The value is read
+  // by the type of the constant: "true" or "false" for booleans, decimal or
+  // "0x"-prefixed hexadecimal numbers for integers, and decimal numbers for
+  // floats.  Modules without a spec constant of that SpecId are unaffected.
+  void SetSpecializationConstant(uint32_t spec_id, const std::string& value) {
+    specialization_constants_[spec_id] = value;
+  }
+
+  // Sets whether subsequent compilations produce SPIR-V modules to be linked
+  // with others rather than shaders: their defined functions are exported,
+  // functions that are only declared are imported, and no entry point is
+  // needed.  Such modules keep the Linkage capability, so they are not
+  // validated, as Vulkan does not allow it.
+  void SetCompileForLinking(bool enable) { compile_for_linking_ = enable; }
+
+  // Adds a SPIR-V module, compiled for linking, whose exported functions
+  // resolve the functions that subsequent compilations import.  The SPIR-V
+  // of a shader is linked with all the libraries before it is validated and
+  // optimized, and the functions that its entry points do not call are then
+  // removed.  Shaders are compiled for linking while there are libraries.
+  void AddLinkLibrary(std::shared_ptr<const std::vector<uint32_t>> library) {
+    link_libraries_.push_back(std::move(library));
+  }
+
+  // Sets when the SPIR-V of subsequent compilations is validated.  Invalid
+  // SPIR-V fails the compilation with an error.  Syntax-only compilations in
+  // SyntaxOnlyMode::Validate are validated whatever the policy.
+  void SetValidationPolicy(ValidationPolicy policy) {
+    validation_policy_ = policy;
+  }
+
   // Sets whether the compiler automatically assigns locations to
   // uniform variables that don't have explicit locations.
   void SetAutoMapLocations(bool auto_map) { auto_map_locations_ = auto_map; }
@@ -355,7 +528,22 @@ class Compiler {
     hlsl_explicit_bindings_[static_cast<int>(stage)].push_back(binding);
   }
 
-  // Compiles the shader source in the input_source_string parameter.
+  // Compiles the shader source in the input_source_string parameter.  Same as
+  // the Compile() that takes source chunks, with error_tag naming the one
+  // chunk.
+  std::tuple<bool, std::vector<uint32_t>, size_t> Compile(
+      const string_piece& input_source_string, EShLanguage forced_shader_stage,
+      const std::string& error_tag, const char* entry_point_name,
+      const std::function<EShLanguage(std::ostream* error_stream,
+                                      const string_piece& error_tag)>&
+          stage_callback,
+      CountingIncluder& includer, OutputType output_type,
+      std::ostream* error_stream, size_t* total_warnings,
+      size_t* total_errors, CompileContext* context = nullptr,
+      std::string* reflection = nullptr) const;
+
+  // Compiles the shader source made of the given chunks, which must not be
+  // empty.
   //
   // If the forced_shader stage parameter is not EShLangCount then
   // the shader is assumed to be of the given stage.
@@ -376,11 +564,20 @@ class Compiler {
   // The output_type parameter determines what kind of output should be
   // produced.
   //
-  // Any error messages are written as if the file name were error_tag.
+  // Diagnostics in a chunk are written as if the file name were the name of
+  // the chunk, and other error messages as if it were error_tag.
   // Any errors are written to the error_stream parameter.
   // total_warnings and total_errors are incremented once for every
   // warning or error encountered respectively.
   //
+  // If context is not null, its scratch state is reused instead of being set
+  // up for this compilation only.
+  //
+  // If reflection is not null and the source is compiled, the JSON
+  // description of the shader's interface from GetReflectionJson() is written
+  // to *reflection.  It describes the shader as linked, before SPIR-V is
+  // generated and optimized.
+  //
   // Returns a tuple consisting of three fields. 1) a boolean which is true when
   // the compilation succeeded, and false otherwise; 2) a vector of 32-bit words
   // which contains the compilation output data, either compiled SPIR-V binary
@@ -389,14 +586,95 @@ class Compiler {
   // binary code, the size is the number of bytes of valid data in the vector.
   // If the output is a text string, the size equals the length of that string.
   std::tuple<bool, std::vector<uint32_t>, size_t> Compile(
-      const string_piece& input_source_string, EShLanguage forced_shader_stage,
-      const std::string& error_tag, const char* entry_point_name,
+      const std::vector<SourceChunk>& source_chunks,
+      EShLanguage forced_shader_stage, const std::string& error_tag,
+      const char* entry_point_name,
       const std::function<EShLanguage(std::ostream* error_stream,
                                       const string_piece& error_tag)>&
           stage_callback,
       CountingIncluder& includer, OutputType output_type,
       std::ostream* error_stream, size_t* total_warnings,
-      size_t* total_errors) const;
+      size_t* total_errors, CompileContext* context = nullptr,
+      std::string* reflection = nullptr) const;
+
+  // Compiles the given stages, each made of its own source chunks, and links
+  // them as one program, so that locations and bindings are mapped
+  // consistently across the stages.  The stages must be known, and distinct.
+  // The output_type must not be OutputType::PreprocessedText.  When the
+  // stages are all from the vertex, tessellation, geometry and fragment
+  // pipeline, the outputs of a stage that the next stage does not read are
+  // removed, together with the code that only computes them.  The results are
+  // written to *outputs, one per stage, in the order of the stages.  Errors
+  // and warnings for all of the stages are written to error_stream and counted
+  // as for Compile().  If generate_reflection is true, each output gets the
+  // description of its stage from GetReflectionJson(), as linked with the
+  // other stages, before the unused outputs are removed.  Returns true if
+  // every stage compiled, and the program linked.
+  bool CompileProgram(const std::vector<ProgramStage>& stages,
+                      CountingIncluder& includer, OutputType output_type,
+                      std::ostream* error_stream, size_t* total_warnings,
+                      size_t* total_errors,
+                      std::vector<ProgramStageOutput>* outputs,
+                      CompileContext* context = nullptr,
+                      bool generate_reflection = false) const;
+
+  // Compiles the given source as Compile() does, once for each of the given
+  // targets, instead of for the target of this compiler.  The targets for the
+  // same client API, Vulkan or OpenGL, share one run of the frontend: the
+  // source is preprocessed, parsed and linked once, for the one of them with
+  // the lowest SPIR-V version, and only GlslangToSpv runs for each of them.
+  // This relies on glslang building the same AST for any SPIR-V version, and
+  // leaving what depends on it to GlslangToSpv, which holds except for the
+  // diagnostics: if a shared run of the frontend warns, the targets with
+  // another SPIR-V or client version are compiled on their own.  If a shared
+  // run of the frontend fails, the other targets that would have shared it are
+  // compiled on their own too, since the source may only be invalid for the
+  // lower version.  A target whose output does not come from the first run of
+  // the frontend has frontend_rerun set.  The optimizer and the disassembler
+  // run for the shared targets in parallel, on GetNumWorkers(targets.size())
+  // workers at most; if contexts is not empty, it holds at least that many
+  // contexts, and each worker uses the one at its index.  If
+  // generate_reflection is true, each output gets the description of the
+  // shader from GetReflectionJson(), which the targets of a shared run of the
+  // frontend share too.  The output_type must not be
+  // OutputType::PreprocessedText.  Returns the outputs in the order of the
+  // targets.
+  std::vector<TargetOutput> CompileForTargets(
+      const std::vector<SourceChunk>& source_chunks,
+      EShLanguage forced_shader_stage, const std::string& error_tag,
+      const char* entry_point_name,
+      const std::function<EShLanguage(std::ostream* error_stream,
+                                      const string_piece& error_tag)>&
+          stage_callback,
+      CountingIncluder& includer, OutputType output_type,
+      const std::vector<Target>& targets,
+      const std::vector<CompileContext*>& contexts = {},
+      bool generate_reflection = false) const;
+
+  // Preprocesses the given source as Compile() does before parsing it, for
+  // several compilations of the same source.  Compiling the result with
+  // SetInputPreprocessed(true) and otherwise the same settings gives the same
+  // output as compiling the source.  In particular, the result declares the
+  // macros that are specialization constants, which preprocessed text output
+  // expands instead.  Errors and warnings are written and counted as for
+  // Compile(), and are not repeated by the compilations of the result.
+  // Returns true and writes the result to *preprocessed_source on success.
+  bool PreprocessForCompilation(const std::vector<SourceChunk>& source_chunks,
+                                const std::string& error_tag,
+                                CountingIncluder& includer,
+                                std::string* preprocessed_source,
+                                std::ostream* error_stream,
+                                size_t* total_warnings,
+                                size_t* total_errors) const;
+
+  // Builds the glslang built-in symbol tables for the given stage at the given
+  // GLSL version, as seen by this compiler's target environment and source
+  // language, so that later compilations find them ready.  Versions 100, 300,
+  // 310 and 320 select the es profile.  A version of 0 means the forced
+  // version and profile, if any, or else the default.  The tables are shared
+  // by the whole process, and live until glslang is finalized.  Returns false
+  // if the target environment is not valid.
+  bool PrewarmBuiltins(EShLanguage stage, int version) const;
 
   static EShMessages GetDefaultRules() {
     return static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules |
@@ -404,13 +682,183 @@ class Compiler {
   }
 
  protected:
-  // Preprocesses a shader whose filename is filename and content is
-  // shader_source. If preprocessing is successful, returns true, the
-  // preprocessed shader, and any warning message as a tuple. Otherwise,
-  // returns false, an empty string, and error messages as a tuple.
+  // Parses and links the given shader source as the given stage, then writes
+  // its SPIR-V to *spirv.  The glslang shader and program, with the AST and
+  // symbol tables, are freed before this returns.  The preamble is prepended
+  // to the source, as in PreprocessShader().  If reflection is not null, the
+  // description of the linked program is written to it, as for Compile().
+  // Errors and warnings are written and counted as for Compile().  Returns
+  // true on success.
+  bool GenerateSpirv(const std::vector<SourceChunk>& source_chunks,
+                     EShLanguage stage, const std::string& error_tag,
+                     const char* entry_point_name, const std::string& preamble,
+                     const GlslangClientInfo& target_client_info,
+                     glslang::TShader::Includer& includer,
+                     std::ostream* error_stream,
+                     size_t* total_warnings, size_t* total_errors,
+                     std::vector<uint32_t>* spirv,
+                     std::string* reflection = nullptr) const;
+
+  // Sets up the given shader for the given stage and entry point with this
+  // compiler's options.  The preamble must outlive the shader.
+  void ConfigureShader(EShLanguage stage, const char* entry_point_name,
+                       const std::string& preamble,
+                       const GlslangClientInfo& target_client_info,
+                       glslang::TShader* shader) const;
+
+  // Parses the given shader, which has its strings set and is configured.
+  // Errors and warnings are written and counted as for Compile().  Returns
+  // true on success.
+  bool ParseShader(glslang::TShader* shader, const std::string& error_tag,
+                   glslang::TShader::Includer& includer,
+                   std::ostream* error_stream, size_t* total_warnings,
+                   size_t* total_errors) const;
+
+  // Links the given program, which has its shaders added, and maps its
+  // inputs, outputs and resources.  Errors and warnings are written and
+  // counted as for Compile().  Returns true on success.
+  bool LinkProgram(glslang::TProgram* program, const std::string& error_tag,
+                   std::ostream* error_stream, size_t* total_warnings,
+                   size_t* total_errors) const;
+
+  // Gets what glslang parses for the given source: *parse_chunks with
+  // *preamble before them.  That is source_chunks with the #define directives
+  // of the predefined macros and pound_extension, or no preamble for input
+  // that is already preprocessed.  If some macros are specialization
+  // constants, the source is instead preprocessed, with those macros defined
+  // as the constants, and the declarations of the constants are inserted after
+  // its #version and #extension directives.  The result is written to
+  // *parse_source, which *parse_chunks then refer to, and has no preamble.
+  // Errors and warnings are written and counted as for Compile().  Returns
+  // true on success.
+  bool GetParseInput(const std::vector<SourceChunk>& source_chunks,
+                     const std::string& error_tag,
+                     const std::string& pound_extension,
+                     CountingIncluder& includer, std::string* preamble,
+                     std::string* parse_source,
+                     std::vector<SourceChunk>* parse_chunks,
+                     std::ostream* error_stream, size_t* total_warnings,
+                     size_t* total_errors) const;
+
+  // Preprocesses the given source as Compile() does for preprocessed text
+  // output, with the given preamble, and writes the result to
+  // *preprocessed_shader.  Input that is already preprocessed is only
+  // concatenated.  Errors, and warnings unless suppress_warnings, are written
+  // and counted as for Compile().  Returns true on success.
+  bool GetPreprocessedShader(const std::vector<SourceChunk>& source_chunks,
+                             const std::string& error_tag,
+                             const std::string& preamble,
+                             const std::string& pound_extension,
+                             CountingIncluder& includer,
+                             bool suppress_warnings,
+                             std::ostream* error_stream,
+                             size_t* total_warnings, size_t* total_errors,
+                             std::string* preprocessed_shader) const;
+
+  // Returns the stage named by the #pragma shader_stage of the given
+  // preprocessed shader, or else the one returned by stage_callback.  Returns
+  // EShLangCount if the stage is unknown, after writing any errors to
+  // error_stream.
+  EShLanguage DeduceShaderStage(
+      const std::string& error_tag, const std::string& preprocessed_shader,
+      const std::function<EShLanguage(std::ostream* error_stream,
+                                      const string_piece& error_tag)>&
+          stage_callback,
+      std::ostream* error_stream) const;
+
+  // Takes the SPIR-V generated for a shader through the rest of Compile():
+  // validation in syntax-only mode, or else optimization and conversion to
+  // the given output type.  Works in place, and sets *output_size to the size
+  // of the output in bytes.  Returns true on success.
+  bool CompleteSpirv(const std::string& error_tag, OutputType output_type,
+                     CompileContext* context, std::vector<uint32_t>* spirv,
+                     size_t* output_size, std::ostream* error_stream,
+                     size_t* total_errors) const;
+
+  // Returns true if OptimizeSpirv() runs any passes.
+  bool RunsOptimizer() const;
+
+  // Freezes the specialization constants given values by
+  // SetSpecializationConstant() in the given SPIR-V, in place.  On failure,
+  // writes an error naming error_tag to error_stream, counts it in
+  // *total_errors, and returns false.
+  bool SpecializeSpirv(const std::string& error_tag,
+                       std::vector<uint32_t>* spirv,
+                       std::ostream* error_stream, size_t* total_errors) const;
+
+  // Returns true if compilations produce SPIR-V with linkage, because of
+  // SetCompileForLinking() or AddLinkLibrary().
+  bool CompilesForLinking() const {
+    return compile_for_linking_ || !link_libraries_.empty();
+  }
+
+  // Links the given SPIR-V with the libraries added by AddLinkLibrary(), in
+  // place, if there are any.  On failure, writes an error naming error_tag to
+  // error_stream, counts it in *total_errors, and returns false.
+  bool LinkSpirv(const std::string& error_tag, std::vector<uint32_t>* spirv,
+                 std::ostream* error_stream, size_t* total_errors) const;
+
+  // Validates the SPIR-V generated for a shader, before optimization, if the
+  // validation policy asks for it and the optimizer does not validate its
+  // input itself.  On failure, writes an error naming error_tag to
+  // error_stream, counts it in *total_errors, and returns false.
+  bool ValidateGeneratedSpirv(const std::string& error_tag,
+                              CompileContext* context,
+                              const std::vector<uint32_t>& spirv,
+                              std::ostream* error_stream,
+                              size_t* total_errors) const;
+
+  // Like ValidateGeneratedSpirv(), but for the final SPIR-V, after any
+  // optimization.  The changed parameter says whether anything has been run
+  // on the SPIR-V since it was generated.
+  bool ValidateOptimizedSpirv(const std::string& error_tag,
+                              CompileContext* context,
+                              const std::vector<uint32_t>& spirv,
+                              bool changed, std::ostream* error_stream,
+                              size_t* total_errors) const;
+
+  // Runs the legalization passes, if they apply, and the enabled
+  // optimization passes on the given SPIR-V, in place.  Uses the optimizers
+  // kept by context, if it is not null.  On failure, writes an error to
+  // error_stream and returns false.
+  bool OptimizeSpirv(const std::string& error_tag, CompileContext* context,
+                     std::vector<uint32_t>* spirv,
+                     std::ostream* error_stream) const;
+
+  // Turns the given SPIR-V into the output of the given type, in place, and
+  // sets *output_size to its size in bytes.  On failure, writes an error to
+  // error_stream and returns false.  Uses the SPIRV-Tools contexts kept by
+  // context, if it is not null.
+  bool FinishOutput(const std::string& error_tag, OutputType output_type,
+                    CompileContext* context, std::vector<uint32_t>* spirv,
+                    size_t* output_size, std::ostream* error_stream) const;
+
+  // Validates the given SPIR-V for the target environment, after legalizing
+  // it first if it comes from HLSL and legalization is enabled.  On failure,
+  // writes an error naming error_tag to error_stream, counts it in
+  // *total_errors, and returns false.  Uses the optimizers kept by context,
+  // if it is not null.
+  bool ValidateSpirv(const std::string& error_tag, CompileContext* context,
+                     std::vector<uint32_t>* spirv, std::ostream* error_stream,
+                     size_t* total_errors) const;
+
+  // Validates the given SPIR-V for the target environment, as it is, with
+  // the block layouts that shaderc generates, and the relaxed rules of HLSL
+  // that has not been legalized unless the legalized parameter says it has.
+  // On failure, writes an error naming error_tag to error_stream, counts it
+  // in *total_errors, and returns false.  Uses the SPIRV-Tools context kept
+  // by context, if it is not null.
+  bool CheckSpirv(const std::string& error_tag, CompileContext* context,
+                  const std::vector<uint32_t>& spirv, bool legalized,
+                  std::ostream* error_stream, size_t* total_errors) const;
+
+  // Preprocesses a shader whose content is made of source_chunks. If
+  // preprocessing is successful, returns true, the preprocessed shader, and
+  // any warning message as a tuple. Otherwise, returns false, an empty
+  // string, and error messages as a tuple.
   //
-  // The error_tag parameter is the name to use for outputting errors.
-  // The shader_source parameter is the input shader's source text.
+  // The error_tag parameter is the name to use for outputting errors that
+  // are not in any chunk.
   // The shader_preamble parameter is a context-specific preamble internally
   // prepended to shader_text without affecting the validity of its #version
   // position.
@@ -421,7 +869,8 @@ class Compiler {
   // to be default_version_/default_profile_ regardless of the #version
   // directive in the source code.
   std::tuple<bool, std::string, std::string> PreprocessShader(
-      const std::string& error_tag, const string_piece& shader_source,
+      const std::string& error_tag,
+      const std::vector<SourceChunk>& source_chunks,
       const string_piece& shader_preamble, CountingIncluder& includer) const;
 
   // Cleans up the preamble in a given preprocessed shader.
@@ -479,6 +928,13 @@ class Compiler {
 
   // Macro definitions that must be available to reference in the shader source.
   MacroDictionary predefined_macros_;
+  // The #define directives for predefined_macros_, which go into the preamble
+  // of each compilation.  Kept up to date by AddMacroDefinition(), so that
+  // they are not formatted again for each compilation.
+  std::string macro_definitions_;
+  // The SpecIds of the predefined macros that are specialization constants,
+  // by macro name.
+  std::map<std::string, uint32_t> macro_spec_constants_;
 
   // When true, treat warnings as errors.
   bool warnings_as_errors_;
@@ -492,6 +948,15 @@ class Compiler {
   // Optimization passes to be applied.
   std::vector<PassId> enabled_opt_passes_;
 
+  // The spirv-opt flags of the optimization passes to apply instead of
+  // enabled_opt_passes_, if any.
+  std::vector<std::string> opt_pass_flags_;
+
+  // The error of the last SetOptimizationPasses() call, if it failed and no
+  // later call of it or of SetOptimizationLevel() succeeded.  Compilations
+  // fail with it.
+  std::string opt_pass_flags_error_;
+
   // The target environment to compile with. This controls the glslang
   // EshMessages bitmask, which determines which dialect of GLSL and which
   // SPIR-V codegen semantics are used. This impacts the warning & error
@@ -538,6 +1003,24 @@ class Compiler {
 
   uint32_t max_id_bound_ = 0x3FFFFF;
 
+  // The cache of optimizer outputs, if any.
+  OptimizerCache* optimizer_cache_ = nullptr;
+
+  // When the SPIR-V of a compilation is validated.
+  ValidationPolicy validation_policy_ = ValidationPolicy::Default;
+
+  // True if SPIR-V assembly output names ids after the names in the module.
+  bool disassembly_friendly_names_ = true;
+
+  // The values to freeze specialization constants to, by SpecId.
+  std::map<uint32_t, std::string> specialization_constants_;
+
+  // True if compilations produce SPIR-V modules to be linked with others.
+  bool compile_for_linking_ = false;
+
+  // The SPIR-V modules to link compiled shaders with.
+  std::vector<std::shared_ptr<const std::vector<uint32_t>>> link_libraries_;
+
   // True if the compiler should use HLSL IO mapping rules when compiling HLSL.
   bool hlsl_iomap_;
 
@@ -569,6 +1052,12 @@ class Compiler {
   // as a composition of max and min.
   bool nan_clamp_;
 
+  // True if the source is already preprocessed.
+  bool input_preprocessed_ = false;
+
+  // How far compilations go when they only check the source.
+  SyntaxOnlyMode syntax_only_ = SyntaxOnlyMode::Off;
+
   // A sequence of triples, each triple representing a specific HLSL register
   // name, and the set and binding numbers it should be mapped to, but in
   // the form of strings.  This is how Glslang wants to consume the data.
@@ -578,7 +1067,7 @@ class Compiler {
 // Converts a string to a vector of uint32_t by copying the content of a given
 // string to the vector and returns it. Appends '\0' at the end if extra bytes
 // are required to complete the last element.
-std::vector<uint32_t> ConvertStringToVector(const std::string& str);
+std::vector<uint32_t> ConvertStringToVector(const string_piece& str);
 
 // Converts a valid Glslang shader stage value to a Compiler::Stage value.
 inline Compiler::Stage ConvertToStage(EShLanguage stage) {
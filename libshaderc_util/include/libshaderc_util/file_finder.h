@@ -47,6 +47,7 @@ class FileFinder {
 
   // Search path for Find().  Users may add/remove elements as desired.
   std::vector<std::string>& search_path() { return search_path_; }
+  const std::vector<std::string>& search_path() const { return search_path_; }
 
  private:
   std::vector<std::string> search_path_;
@@ -0,0 +1,30 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSHADERC_UTIL_INC_HEAP_USAGE_H_
+#define LIBSHADERC_UTIL_INC_HEAP_USAGE_H_
+
+#include <cstddef>
+
+namespace shaderc_util {
+
+// Returns the number of bytes the C heap of the process has handed out and
+// not yet taken back, or 0 if the platform offers no cheap way to find out.
+// This is the whole process, so it is only meaningful as a difference
+// between two calls with no other thread allocating in between.
+size_t HeapBytesInUse();
+
+}  // namespace shaderc_util
+
+#endif  // LIBSHADERC_UTIL_INC_HEAP_USAGE_H_
@@ -58,6 +58,19 @@ std::ostream* GetOutputStream(const string_piece& output_filename,
 // is "-", writes to std::cout.
 bool WriteFile(std::ostream* output_stream, const string_piece& output_data);
 
+// Returns true if the named file can be read and its contents are exactly
+// data.  Files of a different size are rejected without reading them.
+bool FileContentsEqual(const std::string& file_name, const string_piece& data);
+
+// Writes data to the named file, unless the file already holds exactly that
+// data, in which case it is not touched and keeps its modification time.
+// Otherwise the data is first written to a temporary file in the same
+// directory, which then replaces the named file, so that readers never see a
+// partially written file.  Returns true on success.  Otherwise emits an error
+// message to err and returns false.
+bool WriteFileIfChanged(const std::string& file_name, const string_piece& data,
+                        std::ostream* err);
+
 // Flush the standard output stream and set it to binary mode.  Subsequent
 // output will not translate newlines to carriage-return newline pairs.
 void FlushAndSetBinaryModeOnStdout();
@@ -0,0 +1,84 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSHADERC_UTIL_JSON_H_
+#define LIBSHADERC_UTIL_JSON_H_
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "string_piece.h"
+
+namespace shaderc_util {
+
+// Returns str escaped for use inside a JSON string literal.  The surrounding
+// quotes are not added.  Control characters are written as \uXXXX escapes,
+// and bytes outside the ASCII range are passed through unchanged.
+std::string EscapeJsonString(const string_piece& str);
+
+// Writes str to out as a quoted JSON string literal.
+void WriteJsonString(std::ostream* out, const string_piece& str);
+
+// A parsed JSON value.  Object members keep their order from the source text.
+class JsonValue {
+ public:
+  enum class Type { Null, Bool, Number, String, Array, Object };
+
+  JsonValue() : type_(Type::Null), bool_value_(false), number_value_(0) {}
+
+  Type type() const { return type_; }
+  bool is_null() const { return type_ == Type::Null; }
+  bool is_bool() const { return type_ == Type::Bool; }
+  bool is_number() const { return type_ == Type::Number; }
+  bool is_string() const { return type_ == Type::String; }
+  bool is_array() const { return type_ == Type::Array; }
+  bool is_object() const { return type_ == Type::Object; }
+
+  // Accessors for the value of each type.  Their results are only meaningful
+  // when type() matches.
+  bool bool_value() const { return bool_value_; }
+  double number_value() const { return number_value_; }
+  const std::string& string_value() const { return string_value_; }
+  const std::vector<JsonValue>& elements() const { return elements_; }
+  const std::vector<std::pair<std::string, JsonValue>>& members() const {
+    return members_;
+  }
+
+  // Returns the value of the first member with the given name, or nullptr if
+  // this is not an object or has no such member.
+  const JsonValue* Find(const string_piece& name) const;
+
+ private:
+  friend class JsonParser;
+
+  Type type_;
+  bool bool_value_;
+  double number_value_;
+  std::string string_value_;
+  std::vector<JsonValue> elements_;
+  std::vector<std::pair<std::string, JsonValue>> members_;
+};
+
+// Parses text as a single JSON value into *value.  Returns true on success.
+// Otherwise returns false and writes a message of the form
+// "<line>:<column>: <reason>" to *error_message.  \uXXXX escapes are decoded
+// to UTF-8.
+bool ParseJson(const string_piece& text, JsonValue* value,
+               std::string* error_message);
+
+}  // namespace shaderc_util
+
+#endif  // LIBSHADERC_UTIL_JSON_H_
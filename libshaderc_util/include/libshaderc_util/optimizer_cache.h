@@ -0,0 +1,101 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSHADERC_UTIL_OPTIMIZER_CACHE_H_
+#define LIBSHADERC_UTIL_OPTIMIZER_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace shaderc_util {
+
+// Remembers the output of the SPIR-V optimizer for given inputs, so that
+// compilations whose unoptimized SPIR-V is the same as that of an earlier one
+// skip the optimizer.  An entry is found by the 64-bit hash of its input
+// module and of its configuration, a string that describes everything else
+// that the output depends on, such as the passes and the target environment.
+// The input and configuration are kept with the output, and compared on
+// lookup, so that a hash collision is a miss rather than a wrong module.
+//
+// When the modules kept take more than the capacity, the least recently used
+// ones are dropped.  All methods may be called from any thread.
+class OptimizerCache {
+ public:
+  // Creates a cache that keeps up to capacity_bytes bytes of modules.
+  explicit OptimizerCache(size_t capacity_bytes)
+      : capacity_bytes_(capacity_bytes),
+        size_bytes_(0),
+        num_hits_(0),
+        num_misses_(0) {}
+
+  OptimizerCache(const OptimizerCache&) = delete;
+  OptimizerCache& operator=(const OptimizerCache&) = delete;
+
+  // Looks up the output for the given configuration and input.  Returns true
+  // and writes it to *output if found.
+  bool Lookup(const std::string& config, const std::vector<uint32_t>& input,
+              std::vector<uint32_t>* output);
+
+  // Remembers output as the output for the given configuration and input.
+  // Does nothing if the entry alone would be larger than the capacity.
+  void Insert(const std::string& config, const std::vector<uint32_t>& input,
+              const std::vector<uint32_t>& output);
+
+  // Drops all entries.  The hit and miss counts are kept.
+  void Clear();
+
+  // Returns the number of bytes of modules kept.
+  size_t size_bytes() const;
+
+  // Returns the number of entries.
+  size_t num_entries() const;
+
+  // Returns the number of lookups that found an entry, and of those that did
+  // not.
+  size_t num_hits() const;
+  size_t num_misses() const;
+
+ private:
+  struct Entry {
+    uint64_t key;
+    std::string config;
+    std::vector<uint32_t> input;
+    std::vector<uint32_t> output;
+  };
+
+  // Returns the number of bytes an entry accounts for.
+  static size_t EntryBytes(const Entry& entry);
+
+  // Removes the least recently used entries until the modules kept take no
+  // more than capacity_bytes_ - reserve bytes.  mutex_ must be held.
+  void Evict(size_t reserve);
+
+  const size_t capacity_bytes_;
+  mutable std::mutex mutex_;
+  // The entries, most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+  size_t size_bytes_;
+  size_t num_hits_;
+  size_t num_misses_;
+};
+
+}  // namespace shaderc_util
+
+#endif  // LIBSHADERC_UTIL_OPTIMIZER_CACHE_H_
@@ -0,0 +1,79 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSHADERC_UTIL_PACKED_SPIRV_H_
+#define LIBSHADERC_UTIL_PACKED_SPIRV_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "string_piece.h"
+
+// Packed SPIR-V is a compact, lossless encoding of a SPIR-V module, in the
+// spirit of SMOL-V.  Unpacking gives back exactly the words that were packed.
+// All numbers are unsigned LEB128 varints, and signed ones are zigzag-encoded
+// first:
+//
+//   Header:        magic ("SPVP", 4 bytes), format version, module word
+//                  count, then the SPIR-V version, generator, id bound and
+//                  schema words
+//   Instructions:  one after the other, until the end of the data:
+//                  opcode, (operand count << 3 | flags), then
+//                  the result type id, as a signed delta from the previous
+//                  one, if flags has kPackedHasResultType,
+//                  the result id, as a signed delta from one past the
+//                  previous one, if flags has kPackedHasResult,
+//                  the remaining operands, each as a signed delta from the
+//                  previous result id if flags has kPackedIdOperands, and
+//                  as is otherwise
+//
+// Since consecutive instructions mostly define consecutive ids and refer to
+// recently defined ones, most ids pack into a single byte.  Whether an
+// instruction is modelled this way is recorded in its flags, so a module
+// always unpacks the same way, whatever the SPIR-V grammar the packer knew.
+
+namespace shaderc_util {
+
+// The first four bytes of packed SPIR-V, as a little-endian word.
+const uint32_t kPackedSpirvMagic = 0x50565053;
+// The version of the packed SPIR-V format.
+const uint32_t kPackedSpirvVersion = 1;
+
+// Flags of a packed instruction.
+enum PackedInstructionFlags : uint32_t {
+  kPackedHasResultType = 1,
+  kPackedHasResult = 2,
+  kPackedIdOperands = 4,
+};
+
+// Returns true if the given data starts like packed SPIR-V.
+bool IsPackedSpirv(const string_piece& data);
+
+// Packs the given SPIR-V module, appending it to packed.  Returns true on
+// success.  Otherwise writes the reason to error, which happens when the
+// words are not a sequence of well-formed instructions after a SPIR-V header.
+bool PackSpirv(const uint32_t* words, size_t num_words, std::string* packed,
+               std::string* error);
+
+// Unpacks the given packed SPIR-V, replacing the contents of words.  Returns
+// true on success.  Otherwise writes the reason to error, and words is
+// unspecified.
+bool UnpackSpirv(const string_piece& packed, std::vector<uint32_t>* words,
+                 std::string* error);
+
+}  // namespace shaderc_util
+
+#endif  // LIBSHADERC_UTIL_PACKED_SPIRV_H_
@@ -0,0 +1,38 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSHADERC_UTIL_PARALLEL_H_
+#define LIBSHADERC_UTIL_PARALLEL_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace shaderc_util {
+
+// Returns the number of workers that RunInParallel() runs num_jobs jobs on:
+// one per job, but no more than the threads the hardware runs at once, and at
+// least one.
+unsigned GetNumWorkers(size_t num_jobs);
+
+// Calls job(i, worker) for each i below num_jobs, on GetNumWorkers(num_jobs)
+// workers.  Worker 0 is the calling thread, and the others are threads started
+// for the call.  Each worker takes the next job that no worker has taken yet,
+// so the jobs start in order, and state indexed by worker is only used by one
+// job at a time.  Returns when all jobs are done.
+void RunInParallel(size_t num_jobs,
+                   const std::function<void(size_t job, unsigned worker)>& job);
+
+}  // namespace shaderc_util
+
+#endif  // LIBSHADERC_UTIL_PARALLEL_H_
@@ -0,0 +1,49 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSHADERC_UTIL_REFLECTION_H_
+#define LIBSHADERC_UTIL_REFLECTION_H_
+
+#include <string>
+
+namespace glslang {
+class TIntermediate;
+}  // namespace glslang
+
+namespace shaderc_util {
+
+// Writes a JSON description of the interface of the stage of the given
+// intermediate of a linked program to *json.  Only that stage is described,
+// with its own inputs and outputs, even when the program has other stages.
+// The description is an object with these members:
+//  - "resources": the descriptors, each with its "name", "kind" (such as
+//    "uniform_buffer", "storage_buffer", "combined_image_sampler" or
+//    "storage_image"), "set", "binding", "type", "array_size" and, for
+//    buffers, the "size" of the block in bytes.
+//  - "push_constants": the push constant blocks, each with its "name", "size"
+//    and "members", which have a "name", "type", "offset" and "array_size".
+//  - "inputs" and "outputs": the user-defined stage variables, each with its
+//    "name", "type", "location" and "array_size".
+//  - "workgroup_size": the local size as [x, y, z], for compute, task and
+//    mesh shaders only.
+// An "array_size" is 1 for a variable that is not an array, and 0 for a
+// runtime array.  A "set", "binding" or "location" that has not been
+// assigned is left out.  Returns true on success.  Otherwise writes the
+// reason to *errors.
+bool GetReflectionJson(const glslang::TIntermediate& intermediate,
+                       std::string* json, std::string* errors);
+
+}  // namespace shaderc_util
+
+#endif  // LIBSHADERC_UTIL_REFLECTION_H_
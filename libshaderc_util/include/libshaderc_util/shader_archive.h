@@ -0,0 +1,107 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSHADERC_UTIL_SHADER_ARCHIVE_H_
+#define LIBSHADERC_UTIL_SHADER_ARCHIVE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "string_piece.h"
+
+// A shader archive holds many named blobs, usually SPIR-V modules, in a single
+// file, so that they can be written and loaded without the cost of one file
+// per shader.  All fields are 32-bit little-endian words:
+//
+//   Header:    magic ("SHAR"), version, entry count, names offset, names size
+//   Contents:  one record per entry, sorted by key and then by name:
+//              key (low word, high word), name offset, name size,
+//              data offset, data size
+//   Names:     the entry names, back to back, padded to a multiple of 4 bytes
+//   Data:      the entry data, each starting at a multiple of 4 bytes
+//
+// Offsets are in bytes from the start of the archive, and sizes are in bytes.
+// The key of an entry is the 64-bit FNV-1a hash of its name.  Since data is
+// aligned, an archive that is mapped into memory can be used in place.
+
+namespace shaderc_util {
+
+// The first word of a shader archive.
+const uint32_t kShaderArchiveMagic = 0x52414853;
+// The version of the shader archive format.
+const uint32_t kShaderArchiveVersion = 1;
+
+// Returns the key of an archive entry with the given name.
+uint64_t ShaderArchiveKey(const string_piece& name);
+
+// Collects named entries and serializes them as a shader archive.
+class ShaderArchiveWriter {
+ public:
+  // Adds an entry with a copy of the given data. Returns false, and does not
+  // add anything, if there is already an entry with that name.
+  bool Add(const std::string& name, const string_piece& data);
+
+  // Returns the number of entries.
+  size_t size() const { return entries_.size(); }
+
+  // Returns the archive holding all entries added so far.
+  std::string Serialize() const;
+
+ private:
+  std::map<std::string, std::string> entries_;
+};
+
+// Reads a shader archive in place.  The archive data is not copied, so it must
+// outlive the reader, and the data of entries is returned as pieces of it.
+class ShaderArchiveReader {
+ public:
+  struct Entry {
+    string_piece name;
+    string_piece data;
+  };
+
+  ShaderArchiveReader() : archive_(), num_entries_(0) {}
+
+  // Checks that the given data is a well-formed shader archive, and reads
+  // entries from it from now on. Returns true on success.  Otherwise writes
+  // the reason to error, and the reader has no entries.  For the entry data to
+  // be usable as 32-bit words, the archive must be 4-byte aligned in memory.
+  bool Open(const string_piece& archive, std::string* error);
+
+  // Returns the number of entries.
+  size_t size() const { return num_entries_; }
+
+  // Returns the entry at the given index of the table of contents, which must
+  // be less than size().
+  Entry GetEntry(size_t index) const;
+
+  // Looks up the entry with the given name.  Returns true and sets data if it
+  // exists.  Otherwise returns false.
+  bool Find(const string_piece& name, string_piece* data) const;
+
+ private:
+  // Returns the given word of the given entry's record.
+  uint32_t EntryWord(size_t index, size_t word) const;
+  // Returns the key of the given entry.
+  uint64_t EntryKey(size_t index) const;
+
+  string_piece archive_;
+  size_t num_entries_;
+};
+
+}  // namespace shaderc_util
+
+#endif  // LIBSHADERC_UTIL_SHADER_ARCHIVE_H_
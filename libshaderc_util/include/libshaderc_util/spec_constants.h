@@ -0,0 +1,47 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSHADERC_UTIL_SPEC_CONSTANTS_H_
+#define LIBSHADERC_UTIL_SPEC_CONSTANTS_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace shaderc_util {
+
+// Freezes the specialization constants of the given SPIR-V module that have
+// the given SpecIds: each one becomes a regular constant with the given value
+// and loses its SpecId decoration.  Values are read by the type of their
+// constant: "true" or "false" for booleans, decimal or "0x"-prefixed
+// hexadecimal numbers for integers, and decimal numbers for floats, which are
+// rounded to the nearest value of their width.  SpecIds that the module does
+// not use are ignored.  Spec constant operations and composites are left as
+// they are, for the optimizer to fold.  Returns true on success.  Otherwise
+// writes the reason to *errors, and the module is left unchanged.
+bool FreezeSpecConstants(const std::map<uint32_t, std::string>& values,
+                         std::vector<uint32_t>* spirv, std::string* errors);
+
+// Returns the GLSL type of the given literal: "bool" for true and false,
+// "int" or, with a u or U suffix, "uint" for decimal, octal and hexadecimal
+// integers, and "float" or, with an lf or LF suffix, "double" for
+// floating-point numbers, which have a decimal point or an exponent.  Numbers
+// may have a leading minus sign.  Returns an empty string if text is not such
+// a literal.
+std::string GetLiteralType(const std::string& text);
+
+}  // namespace shaderc_util
+
+#endif  // LIBSHADERC_UTIL_SPEC_CONSTANTS_H_
@@ -15,10 +15,14 @@
 #ifndef LIBSHADERC_UTIL_INC_SPIRV_TOOLS_WRAPPER_H
 #define LIBSHADERC_UTIL_INC_SPIRV_TOOLS_WRAPPER_H
 
+#include <functional>
+#include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 
 #include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/optimizer.hpp"
 
 #include "libshaderc_util/compiler.h"
 #include "libshaderc_util/string_piece.h"
@@ -26,19 +30,60 @@
 namespace shaderc_util {
 // Assembles the given assembly. On success, returns true, writes the assembled
 // binary to *binary, and clears *errors. Otherwise, writes the error message
-// into *errors.
+// into *errors.  If context is not null, the SPIRV-Tools context it keeps for
+// the target environment is reused.
 bool SpirvToolsAssemble(Compiler::TargetEnv env,
                         Compiler::TargetEnvVersion version,
                         const string_piece assembly, spv_binary* binary,
-                        std::string* errors);
+                        std::string* errors,
+                        CompileContext* context = nullptr);
 
 // Disassembles the given binary. Returns true and writes the disassembled text
 // to *text_or_error if successful. Otherwise, writes the error message to
-// *text_or_error.
+// *text_or_error.  If context is not null, the SPIRV-Tools context it keeps
+// for the target environment is reused.
 bool SpirvToolsDisassemble(Compiler::TargetEnv env,
                            Compiler::TargetEnvVersion version,
                            const std::vector<uint32_t>& binary,
-                           std::string* text_or_error);
+                           std::string* text_or_error,
+                           CompileContext* context = nullptr);
+
+// Disassembles the given binary of binary_word_count words.  The ids are named
+// after the names in the module if friendly_names is true, and by number
+// otherwise, which is faster.  On success, passes the text to write straight
+// from the buffer SPIRV-Tools renders it into, and returns what write returns.
+// Otherwise, writes the error message to *errors and returns false.  If
+// context is not null, the SPIRV-Tools context it keeps for the target
+// environment is reused.
+bool SpirvToolsDisassemble(Compiler::TargetEnv env,
+                           Compiler::TargetEnvVersion version,
+                           const uint32_t* binary, size_t binary_word_count,
+                           bool friendly_names,
+                           const std::function<bool(string_piece)>& write,
+                           std::string* errors,
+                           CompileContext* context = nullptr);
+
+// Returns the validator options for SPIR-V that shaderc generates.  Blocks
+// may use the relaxed, scalar and std430 uniform buffer layouts, which
+// depend on device features that the compiler does not know; glslang has
+// already laid them out by the rules their source asked for.  If
+// skip_block_layout is true, block layouts are not checked at all, as for
+// HLSL packing rules.  If before_hlsl_legalization is true, the relaxed
+// rules for pointers and resources of HLSL that has not been legalized yet
+// apply.
+spvtools::ValidatorOptions GetSpirvToolsValidatorOptions(
+    bool skip_block_layout, bool before_hlsl_legalization);
+
+// Validates the given binary for the target environment, with the given
+// validator options.  Returns true if it is valid.  Otherwise writes the
+// validator's messages to *errors.  If context is not null, the SPIRV-Tools
+// context it keeps for the target environment is reused.
+bool SpirvToolsValidate(Compiler::TargetEnv env,
+                        Compiler::TargetEnvVersion version,
+                        const std::vector<uint32_t>& binary,
+                        const spvtools::ValidatorOptions& options,
+                        std::string* errors,
+                        CompileContext* context = nullptr);
 
 // The ids of a list of supported optimization passes.
 enum class PassId {
@@ -51,17 +96,80 @@ enum class PassId {
   kNullPass,
   kStripDebugInfo,
   kCompactIds,
+  // Folds spec constant operations and composites of regular constants.
+  kFoldSpecConstants,
 };
 
+// Checks the given spirv-opt pass flags, such as "--loop-unroll" or
+// "--scalar-replacement=100".  A flag given without its leading "--" gets it.
+// Returns true and writes the flags to *flags if SPIRV-Tools knows all of
+// them.  Otherwise writes a message naming the first bad one to *errors.
+bool ParseSpirvToolsPassFlags(const std::vector<std::string>& passes,
+                              std::vector<std::string>* flags,
+                              std::string* errors);
+
 // Optimizes the given binary. Passes are registered in the exact order as shown
-// in enabled_passes, without de-duplication. Returns true and writes the
-// optimized binary back to *binary if successful. Otherwise, writes errors to
-// *errors and the content of binary may be in an invalid state.
+// in enabled_passes, without de-duplication, followed by the passes of the
+// given spirv-opt flags, which must have been checked by
+// ParseSpirvToolsPassFlags(). If validate_input is true, the binary is
+// validated first, with the relaxed rules that SPIR-V for HLSL needs before
+// legalization. Returns true and writes the optimized binary back to *binary
+// if successful. Otherwise, writes errors to *errors and the content of
+// binary may be in an invalid state.  If context is not null, the optimizers
+// it keeps are reused.
 bool SpirvToolsOptimize(Compiler::TargetEnv env,
                         Compiler::TargetEnvVersion version,
                         const std::vector<PassId>& enabled_passes,
+                        const std::vector<std::string>& pass_flags,
                         spvtools::OptimizerOptions& optimizer_options,
-                        std::vector<uint32_t>* binary, std::string* errors);
+                        bool validate_input, std::vector<uint32_t>* binary,
+                        std::string* errors,
+                        CompileContext* context = nullptr);
+
+// Removes the inter-stage outputs that the next stage does not read, and the
+// code that only computes them, from the given modules of one linked program.
+// The inputs that a stage declares but does not read are removed from its
+// entry point interface, so that every input left has an output to match.
+// The modules must be in pipeline order, each one feeding the next, and are
+// optimized in place from the last one to the first.  Returns true on success.
+// Otherwise writes the optimizer's messages to *errors.
+bool SpirvToolsPruneInterStageVaryings(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+    const std::vector<std::vector<uint32_t>*>& modules, std::string* errors);
+
+// Links the given module with the given library modules, so that the
+// functions it imports are resolved by the functions that the libraries
+// export, then removes the functions that its entry points do not call, such
+// as the library functions that it does not use.  Returns true and writes the
+// linked module back to *binary on success.  Otherwise writes the messages of
+// SPIRV-Tools to *errors, and *binary is left unchanged.
+bool SpirvToolsLink(Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+                    const std::vector<const std::vector<uint32_t>*>& libraries,
+                    std::vector<uint32_t>* binary, std::string* errors);
+
+// Returns true if the given module declares the Linkage capability, which
+// modules keep until they are linked.
+bool HasLinkageCapability(const std::vector<uint32_t>& binary);
+
+// Returns a new optimizer for the given target environment, with the given
+// passes registered in order, followed by those of the given spirv-opt flags.
+// Its messages are written to messages, which must outlive it.
+std::unique_ptr<spvtools::Optimizer> CreateSpirvToolsOptimizer(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+    const std::vector<PassId>& passes,
+    const std::vector<std::string>& pass_flags, std::ostream* messages);
+
+// Returns a new SPIRV-Tools context for the given target environment.  Its
+// messages are written to messages, each prefixed with the word index it is
+// about, and messages must outlive it.
+std::unique_ptr<spvtools::SpirvTools> CreateSpirvTools(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+    std::ostream* messages);
+
+// Returns a new SPIRV-Tools context for the given target environment, for
+// the C API of SPIRV-Tools.
+std::unique_ptr<spvtools::Context> CreateSpvContext(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version);
 
 }  // namespace shaderc_util
 
@@ -0,0 +1,70 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSHADERC_UTIL_TRACE_H_
+#define LIBSHADERC_UTIL_TRACE_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "string_piece.h"
+
+// A process-wide recorder of timed spans, such as compilation phases, for
+// export in the Chrome Trace Event format, which chrome://tracing and Perfetto
+// can display.  Each thread that records spans gets a lane of its own.
+// Recording is off by default, and then a TraceScope costs one atomic load.
+
+namespace shaderc_util {
+
+// Starts recording spans.  Timestamps are relative to the first call.
+void EnableTrace();
+
+// Returns true if spans are being recorded.
+bool TraceEnabled();
+
+// Stops recording spans, and discards those recorded so far and all lane
+// names.
+void ResetTrace();
+
+// Names the lane of the calling thread, if spans are being recorded.
+void SetTraceThreadName(const std::string& name);
+
+// Writes the spans recorded so far as a Chrome Trace Event JSON object.
+void WriteTrace(std::ostream* out);
+
+// Records a span named name, lasting from the construction to the destruction
+// of the scope, on the lane of the calling thread.  The detail, such as the
+// file being worked on, is shown with the span.  Nothing is recorded if
+// recording is off when the scope is constructed.
+class TraceScope {
+ public:
+  // The name must outlive the recorded span, so it is usually a literal.
+  explicit TraceScope(const char* name,
+                      const string_piece& detail = string_piece());
+  ~TraceScope();
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  // The span name, or nullptr if recording was off.
+  const char* name_;
+  std::string detail_;
+  int64_t start_;
+};
+
+}  // namespace shaderc_util
+
+#endif  // LIBSHADERC_UTIL_TRACE_H_
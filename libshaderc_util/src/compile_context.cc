@@ -0,0 +1,67 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/compile_context.h"
+
+#include "libshaderc_util/spirv_tools_wrapper.h"
+#include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/optimizer.hpp"
+
+namespace shaderc_util {
+
+CompileContext::CompileContext(size_t max_optimizers)
+    : max_optimizers_(max_optimizers < 1 ? 1 : max_optimizers) {}
+
+CompileContext::~CompileContext() = default;
+
+spvtools::Optimizer* CompileContext::GetOptimizer(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+    const std::vector<PassId>& passes,
+    const std::vector<std::string>& pass_flags) {
+  OptimizerKey key(env, version, passes, pass_flags);
+  const auto found = optimizer_index_.find(key);
+  if (found != optimizer_index_.end()) {
+    optimizers_.splice(optimizers_.begin(), optimizers_, found->second);
+    return found->second->optimizer.get();
+  }
+  if (optimizers_.size() >= max_optimizers_) {
+    optimizer_index_.erase(optimizers_.back().key);
+    optimizers_.pop_back();
+  }
+  optimizers_.push_front(
+      {key, CreateSpirvToolsOptimizer(env, version, passes, pass_flags,
+                                      &optimizer_messages_)});
+  optimizer_index_.emplace(std::move(key), optimizers_.begin());
+  return optimizers_.front().optimizer.get();
+}
+
+spvtools::SpirvTools* CompileContext::GetSpirvTools(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version) {
+  std::unique_ptr<spvtools::SpirvTools>& tools =
+      spirv_tools_[std::make_pair(env, version)];
+  if (!tools) {
+    tools = CreateSpirvTools(env, version, &spirv_tools_messages_);
+  }
+  return tools.get();
+}
+
+spvtools::Context* CompileContext::GetSpvContext(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version) {
+  std::unique_ptr<spvtools::Context>& spv_context =
+      spv_contexts_[std::make_pair(env, version)];
+  if (!spv_context) spv_context = CreateSpvContext(env, version);
+  return spv_context.get();
+}
+
+}  // namespace shaderc_util
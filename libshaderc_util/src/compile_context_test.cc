@@ -0,0 +1,147 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/compile_context.h"
+
+#include <gmock/gmock.h>
+
+#include "libshaderc_util/spirv_tools_wrapper.h"
+
+namespace {
+
+using shaderc_util::CompileContext;
+using shaderc_util::Compiler;
+using shaderc_util::PassId;
+
+TEST(CompileContext, ReusesOptimizers) {
+  CompileContext context;
+  EXPECT_EQ(0u, context.num_optimizers());
+  auto* optimizer = context.GetOptimizer(
+      Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0,
+      {PassId::kPerformancePasses});
+  ASSERT_NE(nullptr, optimizer);
+  EXPECT_EQ(optimizer, context.GetOptimizer(
+                           Compiler::TargetEnv::Vulkan,
+                           Compiler::TargetEnvVersion::Vulkan_1_0,
+                           {PassId::kPerformancePasses}));
+  EXPECT_EQ(1u, context.num_optimizers());
+}
+
+TEST(CompileContext, KeepsAnOptimizerPerEnvironmentAndPasses) {
+  CompileContext context;
+  auto* performance = context.GetOptimizer(
+      Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0,
+      {PassId::kPerformancePasses});
+  auto* size = context.GetOptimizer(Compiler::TargetEnv::Vulkan,
+                                    Compiler::TargetEnvVersion::Vulkan_1_0,
+                                    {PassId::kSizePasses});
+  auto* vulkan_1_1 = context.GetOptimizer(
+      Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_1,
+      {PassId::kPerformancePasses});
+  EXPECT_NE(performance, size);
+  EXPECT_NE(performance, vulkan_1_1);
+  EXPECT_EQ(3u, context.num_optimizers());
+}
+
+TEST(CompileContext, DropsTheLeastRecentlyUsedOptimizer) {
+  CompileContext context(2);
+  const auto get_optimizer = [&context](std::vector<std::string> flags) {
+    return context.GetOptimizer(Compiler::TargetEnv::Vulkan,
+                                Compiler::TargetEnvVersion::Vulkan_1_0, {},
+                                flags);
+  };
+  auto* unroll = get_optimizer({"--loop-unroll"});
+  get_optimizer({"--eliminate-dead-functions"});
+  // Using the first optimizer again makes the second one the oldest.
+  EXPECT_EQ(unroll, get_optimizer({"--loop-unroll"}));
+  get_optimizer({"--compact-ids"});
+  EXPECT_EQ(2u, context.num_optimizers());
+  EXPECT_EQ(unroll, get_optimizer({"--loop-unroll"}));
+  EXPECT_EQ(2u, context.num_optimizers());
+}
+
+TEST(CompileContext, KeepsABoundedNumberOfOptimizers) {
+  CompileContext context;
+  for (size_t i = 0; i < 2 * CompileContext::kDefaultMaxOptimizers; ++i) {
+    context.GetOptimizer(Compiler::TargetEnv::Vulkan,
+                         Compiler::TargetEnvVersion::Vulkan_1_0, {},
+                         {"--scalar-replacement=" + std::to_string(i + 1)});
+  }
+  EXPECT_EQ(CompileContext::kDefaultMaxOptimizers, context.num_optimizers());
+}
+
+TEST(CompileContext, KeepsSpirvToolsPerEnvironment) {
+  CompileContext context;
+  EXPECT_EQ(0u, context.num_spirv_tools());
+  auto* vulkan_1_0 = context.GetSpirvTools(
+      Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0);
+  ASSERT_NE(nullptr, vulkan_1_0);
+  EXPECT_EQ(vulkan_1_0,
+            context.GetSpirvTools(Compiler::TargetEnv::Vulkan,
+                                  Compiler::TargetEnvVersion::Vulkan_1_0));
+  EXPECT_NE(vulkan_1_0,
+            context.GetSpirvTools(Compiler::TargetEnv::OpenGL,
+                                  Compiler::TargetEnvVersion::OpenGL_4_5));
+  EXPECT_EQ(2u, context.num_spirv_tools());
+}
+
+TEST(CompileContext, ValidatesWithItsSpirvTools) {
+  CompileContext context;
+  std::string errors;
+  EXPECT_FALSE(shaderc_util::SpirvToolsValidate(
+      Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0,
+      {0xdeadbeef},
+      shaderc_util::GetSpirvToolsValidatorOptions(false, false), &errors,
+      &context));
+  EXPECT_FALSE(errors.empty());
+  EXPECT_EQ(1u, context.num_spirv_tools());
+}
+
+TEST(CompileContext, KeepsSpvContextsPerEnvironment) {
+  CompileContext context;
+  auto* vulkan_1_0 = context.GetSpvContext(
+      Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0);
+  ASSERT_NE(nullptr, vulkan_1_0);
+  EXPECT_EQ(vulkan_1_0,
+            context.GetSpvContext(Compiler::TargetEnv::Vulkan,
+                                  Compiler::TargetEnvVersion::Vulkan_1_0));
+  EXPECT_NE(vulkan_1_0,
+            context.GetSpvContext(Compiler::TargetEnv::Vulkan,
+                                  Compiler::TargetEnvVersion::Vulkan_1_1));
+}
+
+TEST(CompileContext, AssemblesAndDisassemblesWithItsContexts) {
+  CompileContext context;
+  for (int i = 0; i < 2; ++i) {
+    spv_binary binary = nullptr;
+    std::string errors;
+    ASSERT_TRUE(shaderc_util::SpirvToolsAssemble(
+        Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0,
+        "OpCapability Shader\nOpMemoryModel Logical GLSL450\n", &binary,
+        &errors, &context))
+        << errors;
+    const std::vector<uint32_t> words(binary->code,
+                                      binary->code + binary->wordCount);
+    spvBinaryDestroy(binary);
+    std::string text;
+    ASSERT_TRUE(shaderc_util::SpirvToolsDisassemble(
+        Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0,
+        words, &text, &context))
+        << text;
+    EXPECT_THAT(text, testing::HasSubstr("OpMemoryModel Logical GLSL450"));
+  }
+  EXPECT_EQ(1u, context.num_spirv_tools());
+}
+
+}  // anonymous namespace
@@ -14,24 +14,32 @@
 
 #include "libshaderc_util/compiler.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <iomanip>
+#include <memory>
 #include <sstream>
-#include <thread>
 #include <tuple>
 
 #include "SPIRV/GlslangToSpv.h"
+#include "glslang/MachineIndependent/localintermediate.h"
 #include "libshaderc_util/format.h"
 #include "libshaderc_util/io_shaderc.h"
 #include "libshaderc_util/message.h"
+#include "libshaderc_util/optimizer_cache.h"
+#include "libshaderc_util/parallel.h"
+#include "libshaderc_util/reflection.h"
 #include "libshaderc_util/resources.h"
 #include "libshaderc_util/shader_stage.h"
+#include "libshaderc_util/spec_constants.h"
 #include "libshaderc_util/spirv_tools_wrapper.h"
 #include "libshaderc_util/string_piece.h"
+#include "libshaderc_util/trace.h"
 #include "libshaderc_util/version_profile.h"
 #include "spirv-tools/libspirv.hpp"
 
 namespace {
+using shaderc_util::SourceChunk;
 using shaderc_util::string_piece;
 
 constexpr const char* kLineDirectivePrefixCstr = "#line ";
@@ -72,6 +80,54 @@ std::pair<int, string_piece> DecodeLineDirective(string_piece directive) {
   return std::make_pair(line, directive);
 }
 
+// Returns the preprocessed shader with the given declarations inserted at the
+// start of its first line that is neither blank nor a directive, which is
+// after its #version directive and the #extension directives that follow.
+// The declarations are on one line, so the other lines keep their numbers.
+std::string InsertDeclarations(const std::string& preprocessed_shader,
+                               const std::string& declarations) {
+  size_t line_start = 0;
+  while (line_start < preprocessed_shader.size()) {
+    const size_t first =
+        preprocessed_shader.find_first_not_of(" \t\r\n", line_start);
+    if (first == std::string::npos) break;
+    const size_t line_end = preprocessed_shader.find('\n', line_start);
+    if (first < line_end && preprocessed_shader[first] != '#') {
+      return preprocessed_shader.substr(0, line_start) + declarations +
+             preprocessed_shader.substr(line_start);
+    }
+    if (line_end == std::string::npos) break;
+    line_start = line_end + 1;
+  }
+  std::string result = preprocessed_shader;
+  if (!result.empty() && result.back() != '\n') result += '\n';
+  return result + declarations + "\n";
+}
+
+// The strings of a shader, in the parallel arrays that glslang takes them in.
+// glslang keeps pointers to the arrays, so this must outlive any parse or
+// preprocess of the shader.
+struct GlslangStrings {
+  explicit GlslangStrings(const std::vector<SourceChunk>& chunks) {
+    for (const auto& chunk : chunks) {
+      texts.push_back(chunk.text.data());
+      lengths.push_back(static_cast<int>(chunk.text.size()));
+      names.push_back(chunk.name);
+    }
+  }
+
+  // Sets these strings as those of the given shader.
+  void SetOn(glslang::TShader* shader) const {
+    shader->setStringsWithLengthsAndNames(texts.data(), lengths.data(),
+                                          names.data(),
+                                          static_cast<int>(texts.size()));
+  }
+
+  std::vector<const char*> texts;
+  std::vector<int> lengths;
+  std::vector<const char*> names;
+};
+
 // Returns the Glslang message rules for the given target environment,
 // source language, and whether we want HLSL offset rules.  We assume
 // only valid combinations are used.
@@ -109,6 +165,16 @@ EShMessages GetMessageRules(shaderc_util::Compiler::TargetEnv env,
   return result;
 }
 
+// Sets the tool field (the top 16-bits) in the generator word of the given
+// SPIR-V module to 'Shaderc over Glslang'.
+void SetGeneratorWord(std::vector<uint32_t>* spirv) {
+  const uint32_t shaderc_generator_word = 13;  // From SPIR-V XML Registry
+  const uint32_t generator_word_index = 2;     // SPIR-V 2.3: Physical layout
+  assert(spirv->size() > generator_word_index);
+  (*spirv)[generator_word_index] = ((*spirv)[generator_word_index] & 0xffff) |
+                                   (shaderc_generator_word << 16);
+}
+
 }  // anonymous namespace
 
 namespace shaderc_util {
@@ -137,6 +203,20 @@ GlslangInitializer::GlslangInitializer() {
   initialize_count_++;
 }
 
+void GlslangInitializer::ResetProcessState() {
+  const std::lock_guard<std::mutex> glslang_lock(*glslang_mutex_);
+  const std::unique_lock<std::shared_mutex> state_lock(state_mutex());
+  // glslang counts its clients, and only frees its state once the last one
+  // finalizes.  All live GlslangInitializers count as one client.
+  glslang::FinalizeProcess();
+  glslang::InitializeProcess();
+}
+
+std::shared_mutex& GlslangInitializer::state_mutex() {
+  static std::shared_mutex mutex;
+  return mutex;
+}
+
 GlslangInitializer::~GlslangInitializer() {
   const std::lock_guard<std::mutex> glslang_lock(*glslang_mutex_);
 
@@ -183,7 +263,28 @@ std::tuple<bool, std::vector<uint32_t>, size_t> Compiler::Compile(
         stage_callback,
     CountingIncluder& includer, OutputType output_type,
     std::ostream* error_stream, size_t* total_warnings,
-    size_t* total_errors) const {
+    size_t* total_errors, CompileContext* context,
+    std::string* reflection) const {
+  return Compile({SourceChunk{input_source_string, error_tag.c_str()}},
+                 forced_shader_stage, error_tag, entry_point_name,
+                 stage_callback, includer, output_type, error_stream,
+                 total_warnings, total_errors, context, reflection);
+}
+
+std::tuple<bool, std::vector<uint32_t>, size_t> Compiler::Compile(
+    const std::vector<SourceChunk>& source_chunks,
+    EShLanguage forced_shader_stage, const std::string& error_tag,
+    const char* entry_point_name,
+    const std::function<EShLanguage(std::ostream* error_stream,
+                                    const string_piece& error_tag)>&
+        stage_callback,
+    CountingIncluder& includer, OutputType output_type,
+    std::ostream* error_stream, size_t* total_warnings,
+    size_t* total_errors, CompileContext* context,
+    std::string* reflection) const {
+  assert(!source_chunks.empty());
+  const std::shared_lock<std::shared_mutex> state_lock(
+      GlslangInitializer::state_mutex());
   // Compilation results to be returned:
   // Initialize the result tuple as a failed compilation. In error cases, we
   // should return result_tuple directly without setting its members.
@@ -205,6 +306,12 @@ std::tuple<bool, std::vector<uint32_t>, size_t> Compiler::Compile(
     *total_errors = 1;
     return result_tuple;
   }
+  if (!opt_pass_flags_error_.empty()) {
+    *error_stream << error_tag << ": error: " << opt_pass_flags_error_ << "\n";
+    *total_warnings = 0;
+    *total_errors = 1;
+    return result_tuple;
+  }
 
 #if !SHADERC_ENABLE_HLSL
   if (source_language_ == SourceLanguage::HLSL) {
@@ -220,41 +327,32 @@ std::tuple<bool, std::vector<uint32_t>, size_t> Compiler::Compile(
 #endif
 
   EShLanguage used_shader_stage = forced_shader_stage;
-  const std::string macro_definitions =
-      shaderc_util::format(predefined_macros_, "#define ", " ", "\n");
   const std::string pound_extension =
       "#extension GL_GOOGLE_include_directive : enable\n";
-  const std::string preamble = macro_definitions + pound_extension;
-
-  std::string preprocessed_shader;
+  // Preprocessed input already has its macros expanded and its #include
+  // directives replaced, so it gets no preamble, and may not include files.
+  const std::string preamble = input_preprocessed_
+                                   ? std::string()
+                                   : macro_definitions_ + pound_extension;
+  glslang::TShader::ForbidIncluder forbid_includer;
+  glslang::TShader::Includer& parse_includer =
+      input_preprocessed_
+          ? static_cast<glslang::TShader::Includer&>(forbid_includer)
+          : includer;
 
   // If only preprocessing, we definitely need to preprocess. Otherwise, if
   // we don't know the stage until now, we need the preprocessed shader to
   // deduce the shader stage.
   if (output_type == OutputType::PreprocessedText ||
       used_shader_stage == EShLangCount) {
-    bool success;
-    std::string glslang_errors;
-    std::tie(success, preprocessed_shader, glslang_errors) =
-        PreprocessShader(error_tag, input_source_string, preamble, includer);
-
-    success &= PrintFilteredErrors(error_tag, error_stream, warnings_as_errors_,
-                                   /* suppress_warnings = */ true,
-                                   glslang_errors.c_str(), total_warnings,
-                                   total_errors);
-    if (!success) return result_tuple;
-    // Because of the behavior change of the #line directive, the #line
-    // directive introducing each file's content must use the syntax for the
-    // specified version. So we need to probe this shader's version and
-    // profile.
-    int version;
-    EProfile profile;
-    std::tie(version, profile) = DeduceVersionProfile(preprocessed_shader);
-    const bool is_for_next_line = LineDirectiveIsForNextLine(version, profile);
-
-    preprocessed_shader =
-        CleanupPreamble(preprocessed_shader, error_tag, pound_extension,
-                        includer.num_include_directives(), is_for_next_line);
+    std::string preprocessed_shader;
+    if (!GetPreprocessedShader(source_chunks, error_tag, preamble,
+                               pound_extension, includer,
+                               /* suppress_warnings = */ true, error_stream,
+                               total_warnings, total_errors,
+                               &preprocessed_shader)) {
+      return result_tuple;
+    }
 
     if (output_type == OutputType::PreprocessedText) {
       // Set the values of the result tuple.
@@ -263,58 +361,972 @@ std::tuple<bool, std::vector<uint32_t>, size_t> Compiler::Compile(
       compilation_output_data_size_in_bytes = preprocessed_shader.size();
       return result_tuple;
     } else if (used_shader_stage == EShLangCount) {
+      used_shader_stage = DeduceShaderStage(error_tag, preprocessed_shader,
+                                            stage_callback, error_stream);
+      if (used_shader_stage == EShLangCount) return result_tuple;
+    }
+  }
+
+  // The glslang objects hold the whole AST and its symbol tables.  They only
+  // live inside GenerateSpirv(), so that they are freed before the optimizer
+  // and the disassembler build their own IR of the module.
+  // 'spirv' is an alias for the compilation_output_data. This alias is added
+  // to serve as an input for the call to DissassemblyBinary.
+  std::vector<uint32_t>& spirv = compilation_output_data;
+  std::string parse_preamble;
+  std::string parse_source;
+  std::vector<SourceChunk> parse_chunks;
+  if (!GetParseInput(source_chunks, error_tag, pound_extension, includer,
+                     &parse_preamble, &parse_source, &parse_chunks,
+                     error_stream, total_warnings, total_errors) ||
+      !GenerateSpirv(parse_chunks, used_shader_stage, error_tag,
+                     entry_point_name, parse_preamble, target_client_info,
+                     parse_includer, error_stream, total_warnings,
+                     total_errors, &spirv, reflection)) {
+    return result_tuple;
+  }
+
+  succeeded = CompleteSpirv(error_tag, output_type, context, &spirv,
+                            &compilation_output_data_size_in_bytes,
+                            error_stream, total_errors);
+  return result_tuple;
+}
+
+bool Compiler::PreprocessForCompilation(
+    const std::vector<SourceChunk>& source_chunks,
+    const std::string& error_tag, CountingIncluder& includer,
+    std::string* preprocessed_source, std::ostream* error_stream,
+    size_t* total_warnings, size_t* total_errors) const {
+  assert(!source_chunks.empty());
+  const std::shared_lock<std::shared_mutex> state_lock(
+      GlslangInitializer::state_mutex());
+  const std::string pound_extension =
+      "#extension GL_GOOGLE_include_directive : enable\n";
+  std::string preamble;
+  std::vector<SourceChunk> parse_chunks;
+  if (!GetParseInput(source_chunks, error_tag, pound_extension, includer,
+                     &preamble, preprocessed_source, &parse_chunks,
+                     error_stream, total_warnings, total_errors)) {
+    return false;
+  }
+  // GetParseInput() already preprocessed the source if some macros are
+  // specialization constants.
+  if (!preprocessed_source->empty()) return true;
+  return GetPreprocessedShader(source_chunks, error_tag, preamble,
+                               pound_extension, includer, suppress_warnings_,
+                               error_stream, total_warnings, total_errors,
+                               preprocessed_source);
+}
+
+bool Compiler::GetParseInput(const std::vector<SourceChunk>& source_chunks,
+                             const std::string& error_tag,
+                             const std::string& pound_extension,
+                             CountingIncluder& includer, std::string* preamble,
+                             std::string* parse_source,
+                             std::vector<SourceChunk>* parse_chunks,
+                             std::ostream* error_stream,
+                             size_t* total_warnings,
+                             size_t* total_errors) const {
+  preamble->clear();
+  parse_source->clear();
+  *parse_chunks = source_chunks;
+  if (input_preprocessed_) return true;
+  if (macro_spec_constants_.empty()) {
+    *preamble = macro_definitions_ + pound_extension;
+    return true;
+  }
+
+  // Each macro is defined as a constructor call of a constant of its own
+  // name, so that its expansion names the constant.  The constructor call is
+  // an error in #if expressions instead of the silent zero that an undefined
+  // identifier evaluates to there.  The constants are declared after the
+  // source is preprocessed, so that the declarations follow its #version and
+  // #extension directives and are not expanded themselves.
+  MacroDictionary macros = predefined_macros_;
+  std::ostringstream declarations;
+  std::ostringstream definitions;
+  for (const auto& macro : macro_spec_constants_) {
+    const auto definition = macros.find(macro.first);
+    const std::string type = definition == macros.end()
+                                 ? std::string()
+                                 : GetLiteralType(definition->second);
+    if (type.empty()) {
+      *error_stream << error_tag << ": error: macro '" << macro.first << "' "
+                    << (definition == macros.end()
+                            ? "is not defined"
+                            : "has no boolean or numeric literal value")
+                    << ", so it cannot be a specialization constant\n";
+      ++*total_errors;
+      return false;
+    }
+    if (source_language_ == SourceLanguage::HLSL) {
+      declarations << "[[vk::constant_id(" << macro.second << ")]] ";
+    } else {
+      declarations << "layout(constant_id = " << macro.second << ") ";
+    }
+    declarations << "const " << type << " " << macro.first << " = "
+                 << definition->second << "; ";
+    definitions << "#define " << macro.first << " " << type << "("
+                << macro.first << ")\n";
+    macros.erase(definition);
+  }
+
+  std::string preprocessed_shader;
+  if (!GetPreprocessedShader(
+          source_chunks, error_tag,
+          shaderc_util::format(macros, "#define ", " ", "\n") +
+              definitions.str() + pound_extension,
+          pound_extension, includer, suppress_warnings_, error_stream,
+          total_warnings, total_errors, &preprocessed_shader)) {
+    return false;
+  }
+  *parse_source = InsertDeclarations(preprocessed_shader, declarations.str());
+  *parse_chunks = {SourceChunk{string_piece(*parse_source),
+                               source_chunks.front().name}};
+  return true;
+}
+
+bool Compiler::GetPreprocessedShader(
+    const std::vector<SourceChunk>& source_chunks,
+    const std::string& error_tag, const std::string& preamble,
+    const std::string& pound_extension, CountingIncluder& includer,
+    bool suppress_warnings, std::ostream* error_stream,
+    size_t* total_warnings, size_t* total_errors,
+    std::string* preprocessed_shader) const {
+  preprocessed_shader->clear();
+  if (input_preprocessed_) {
+    for (const auto& chunk : source_chunks) {
+      preprocessed_shader->append(chunk.text.data(), chunk.text.size());
+    }
+    return true;
+  }
+
+  bool success;
+  std::string glslang_errors;
+  {
+    TraceScope trace_scope("Preprocess", error_tag);
+    std::tie(success, *preprocessed_shader, glslang_errors) =
+        PreprocessShader(error_tag, source_chunks, preamble, includer);
+  }
+
+  success &= PrintFilteredErrors(error_tag, error_stream, warnings_as_errors_,
+                                 suppress_warnings, glslang_errors.c_str(),
+                                 total_warnings, total_errors);
+  if (!success) return false;
+  // Because of the behavior change of the #line directive, the #line
+  // directive introducing each file's content must use the syntax for the
+  // specified version. So we need to probe this shader's version and
+  // profile.
+  int version;
+  EProfile profile;
+  std::tie(version, profile) = DeduceVersionProfile(*preprocessed_shader);
+  const bool is_for_next_line = LineDirectiveIsForNextLine(version, profile);
+
+  *preprocessed_shader =
+      CleanupPreamble(*preprocessed_shader, error_tag, pound_extension,
+                      includer.num_include_directives(), is_for_next_line);
+  return true;
+}
+
+EShLanguage Compiler::DeduceShaderStage(
+    const std::string& error_tag, const std::string& preprocessed_shader,
+    const std::function<EShLanguage(std::ostream* error_stream,
+                                    const string_piece& error_tag)>&
+        stage_callback,
+    std::ostream* error_stream) const {
+  EShLanguage stage;
+  std::string errors;
+  std::tie(stage, errors) =
+      GetShaderStageFromSourceCode(error_tag, preprocessed_shader);
+  if (!errors.empty()) {
+    *error_stream << errors;
+    return EShLangCount;
+  }
+  if (stage == EShLangCount) stage = stage_callback(error_stream, error_tag);
+  return stage;
+}
+
+bool Compiler::CompleteSpirv(const std::string& error_tag,
+                             OutputType output_type, CompileContext* context,
+                             std::vector<uint32_t>* spirv, size_t* output_size,
+                             std::ostream* error_stream,
+                             size_t* total_errors) const {
+  if (syntax_only_ != SyntaxOnlyMode::Off) {
+    if (syntax_only_ == SyntaxOnlyMode::Validate &&
+        !ValidateSpirv(error_tag, context, spirv, error_stream,
+                       total_errors)) {
+      return false;
+    }
+    spirv->clear();
+    *output_size = 0;
+    return true;
+  }
+
+  if (!LinkSpirv(error_tag, spirv, error_stream, total_errors)) return false;
+  SetGeneratorWord(spirv);
+  if (!SpecializeSpirv(error_tag, spirv, error_stream, total_errors) ||
+      !ValidateGeneratedSpirv(error_tag, context, *spirv, error_stream,
+                              total_errors) ||
+      !OptimizeSpirv(error_tag, context, spirv, error_stream) ||
+      !ValidateOptimizedSpirv(error_tag, context, *spirv, RunsOptimizer(),
+                              error_stream, total_errors)) {
+    return false;
+  }
+  return FinishOutput(error_tag, output_type, context, spirv, output_size,
+                      error_stream);
+}
+
+bool Compiler::CompileProgram(const std::vector<ProgramStage>& stages,
+                              CountingIncluder& includer,
+                              OutputType output_type,
+                              std::ostream* error_stream,
+                              size_t* total_warnings, size_t* total_errors,
+                              std::vector<ProgramStageOutput>* outputs,
+                              CompileContext* context,
+                              bool generate_reflection) const {
+  assert(!stages.empty());
+  assert(output_type != OutputType::PreprocessedText);
+  outputs->clear();
+  const std::shared_lock<std::shared_mutex> state_lock(
+      GlslangInitializer::state_mutex());
+  // Errors about the program as a whole name its first stage.
+  const std::string& program_tag = stages.front().error_tag;
+
+  const auto target_client_info = GetGlslangClientInfo(
+      program_tag, target_env_, target_env_version_, target_spirv_version_,
+      target_spirv_version_is_forced_);
+  if (!target_client_info.error.empty()) {
+    *error_stream << target_client_info.error;
+    ++*total_errors;
+    return false;
+  }
+  if (!opt_pass_flags_error_.empty()) {
+    *error_stream << program_tag << ": error: " << opt_pass_flags_error_
+                  << "\n";
+    ++*total_errors;
+    return false;
+  }
+
+#if !SHADERC_ENABLE_HLSL
+  if (source_language_ == SourceLanguage::HLSL) {
+    *error_stream << "Shaderc was built without HLSL support. See "
+                     "https://github.com/KhronosGroup/glslang/issues/4210\n";
+    ++*total_errors;
+    return false;
+  }
+#endif
+
+  bool seen_stages[EShLangCount] = {};
+  bool is_graphics_pipeline = true;
+  for (const auto& stage : stages) {
+    if (stage.stage >= EShLangCount) {
+      *error_stream << stage.error_tag
+                    << ": error: the stage of a shader in a program must be "
+                       "known\n";
+      ++*total_errors;
+      return false;
+    }
+    if (seen_stages[stage.stage]) {
+      *error_stream << stage.error_tag
+                    << ": error: a program has more than one shader for the "
+                       "same stage\n";
+      ++*total_errors;
+      return false;
+    }
+    seen_stages[stage.stage] = true;
+    is_graphics_pipeline &= stage.stage <= EShLangFragment;
+  }
+
+  const std::string pound_extension =
+      "#extension GL_GOOGLE_include_directive : enable\n";
+  glslang::TShader::ForbidIncluder forbid_includer;
+  glslang::TShader::Includer& parse_includer =
+      input_preprocessed_
+          ? static_cast<glslang::TShader::Includer&>(forbid_includer)
+          : includer;
+
+  std::vector<std::vector<uint32_t>> spirv(stages.size());
+  std::vector<std::string> reflections(stages.size());
+  // Sets *outputs up for the stages on success, with their reflections.
+  auto resize_outputs = [&stages, &reflections, outputs]() {
+    outputs->resize(stages.size());
+    for (size_t i = 0; i < stages.size(); ++i) {
+      (*outputs)[i].reflection = std::move(reflections[i]);
+    }
+  };
+  {
+    // As in Compile(), the glslang objects are freed before the optimizer
+    // builds its own IR of the modules.
+    std::vector<GlslangStrings> shader_strings;
+    shader_strings.reserve(stages.size());
+    // Reserved up front, since the shader strings point into them.
+    std::vector<std::string> parse_sources;
+    parse_sources.reserve(stages.size());
+    std::vector<std::unique_ptr<glslang::TShader>> shaders;
+    bool success = true;
+    for (const auto& stage : stages) {
+      std::string preamble;
+      std::vector<SourceChunk> parse_chunks;
+      parse_sources.emplace_back();
+      if (!GetParseInput(stage.source_chunks, stage.error_tag,
+                         pound_extension, includer, &preamble,
+                         &parse_sources.back(), &parse_chunks, error_stream,
+                         total_warnings, total_errors)) {
+        success = false;
+        continue;
+      }
+      shaders.emplace_back(new glslang::TShader(stage.stage));
+      shader_strings.emplace_back(parse_chunks);
+      shader_strings.back().SetOn(shaders.back().get());
+      const char* entry_point_name = stage.entry_point_name.empty()
+                                         ? "main"
+                                         : stage.entry_point_name.c_str();
+      ConfigureShader(stage.stage, entry_point_name, preamble,
+                      target_client_info, shaders.back().get());
+      // Parse every stage, so that the errors of all of them are reported.
+      success &= ParseShader(shaders.back().get(), stage.error_tag,
+                             parse_includer, error_stream, total_warnings,
+                             total_errors);
+    }
+    if (!success) return false;
+
+    glslang::TProgram program;
+    for (const auto& shader : shaders) program.addShader(shader.get());
+    if (!LinkProgram(&program, program_tag, error_stream, total_warnings,
+                     total_errors)) {
+      return false;
+    }
+
+    for (size_t i = 0; generate_reflection && i < stages.size(); ++i) {
+      TraceScope trace_scope("Reflect", stages[i].error_tag);
       std::string errors;
-      std::tie(used_shader_stage, errors) =
-          GetShaderStageFromSourceCode(error_tag, preprocessed_shader);
-      if (!errors.empty()) {
-        *error_stream << errors;
-        return result_tuple;
+      if (!GetReflectionJson(*program.getIntermediate(stages[i].stage),
+                             &reflections[i], &errors)) {
+        *error_stream << stages[i].error_tag << ": error: " << errors << "\n";
+        ++*total_errors;
+        return false;
+      }
+    }
+
+    if (syntax_only_ == SyntaxOnlyMode::ParseAndLink) {
+      resize_outputs();
+      return true;
+    }
+
+    glslang::SpvOptions options;
+    options.generateDebugInfo = generate_debug_info_;
+    options.disableOptimizer = true;
+    options.optimizeSize = false;
+    options.compileOnly = CompilesForLinking();
+    for (size_t i = 0; i < stages.size(); ++i) {
+      TraceScope trace_scope("GlslangToSpv", stages[i].error_tag);
+      glslang::GlslangToSpv(*program.getIntermediate(stages[i].stage),
+                            spirv[i], &options);
+    }
+  }
+
+  if (syntax_only_ == SyntaxOnlyMode::Validate) {
+    bool success = true;
+    for (size_t i = 0; i < stages.size(); ++i) {
+      success &= ValidateSpirv(stages[i].error_tag, context, &spirv[i],
+                               error_stream, total_errors);
+    }
+    if (success) resize_outputs();
+    return success;
+  }
+
+  for (size_t i = 0; i < stages.size(); ++i) {
+    if (!LinkSpirv(stages[i].error_tag, &spirv[i], error_stream,
+                   total_errors)) {
+      return false;
+    }
+    SetGeneratorWord(&spirv[i]);
+    if (!SpecializeSpirv(stages[i].error_tag, &spirv[i], error_stream,
+                         total_errors) ||
+        !ValidateGeneratedSpirv(stages[i].error_tag, context, spirv[i],
+                                error_stream, total_errors) ||
+        !OptimizeSpirv(stages[i].error_tag, context, &spirv[i],
+                       error_stream)) {
+      return false;
+    }
+  }
+
+  const bool prunes_varyings = is_graphics_pipeline && stages.size() > 1;
+  if (prunes_varyings) {
+    // The stages in pipeline order.  The EShLanguage values of the vertex to
+    // fragment stages are in that order.
+    std::vector<size_t> order(stages.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&stages](size_t a, size_t b) {
+      return stages[a].stage < stages[b].stage;
+    });
+    std::vector<std::vector<uint32_t>*> pipeline;
+    for (const size_t i : order) pipeline.push_back(&spirv[i]);
+
+    TraceScope trace_scope("PruneVaryings", program_tag);
+    std::string errors;
+    if (!SpirvToolsPruneInterStageVaryings(target_env_, target_env_version_,
+                                           pipeline, &errors)) {
+      *error_stream << "shaderc: internal error: compilation succeeded but "
+                       "failed to remove unused varyings: "
+                    << errors << "\n";
+      return false;
+    }
+  }
+
+  const bool changed = prunes_varyings || RunsOptimizer();
+  for (size_t i = 0; i < stages.size(); ++i) {
+    if (!ValidateOptimizedSpirv(stages[i].error_tag, context, spirv[i],
+                                changed, error_stream, total_errors)) {
+      return false;
+    }
+  }
+
+  resize_outputs();
+  for (size_t i = 0; i < stages.size(); ++i) {
+    ProgramStageOutput& output = (*outputs)[i];
+    output.output = std::move(spirv[i]);
+    if (!FinishOutput(stages[i].error_tag, output_type, context,
+                      &output.output, &output.output_size, error_stream)) {
+      outputs->clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<Compiler::TargetOutput> Compiler::CompileForTargets(
+    const std::vector<SourceChunk>& source_chunks,
+    EShLanguage forced_shader_stage, const std::string& error_tag,
+    const char* entry_point_name,
+    const std::function<EShLanguage(std::ostream* error_stream,
+                                    const string_piece& error_tag)>&
+        stage_callback,
+    CountingIncluder& includer, OutputType output_type,
+    const std::vector<Target>& targets,
+    const std::vector<CompileContext*>& contexts,
+    bool generate_reflection) const {
+  assert(!source_chunks.empty());
+  assert(output_type != OutputType::PreprocessedText);
+  assert(contexts.empty() || contexts.size() >= GetNumWorkers(targets.size()));
+  std::vector<TargetOutput> outputs(targets.size());
+  if (targets.empty()) return outputs;
+  if (!opt_pass_flags_error_.empty()) {
+    for (auto& output : outputs) {
+      output.messages = error_tag + ": error: " + opt_pass_flags_error_ + "\n";
+      output.num_errors = 1;
+    }
+    return outputs;
+  }
+
+  // Each target is compiled by a copy of this compiler, set up for it.
+  std::vector<Compiler> target_compilers(targets.size(), *this);
+  std::vector<GlslangClientInfo> client_infos;
+  for (size_t i = 0; i < targets.size(); ++i) {
+    Compiler& target_compiler = target_compilers[i];
+    target_compiler.SetTargetEnv(targets[i].env, targets[i].env_version);
+    target_compiler.target_spirv_version_ = targets[i].spirv_version;
+    target_compiler.target_spirv_version_is_forced_ =
+        targets[i].spirv_version_is_forced;
+    client_infos.push_back(GetGlslangClientInfo(
+        error_tag, target_compiler.target_env_,
+        target_compiler.target_env_version_,
+        target_compiler.target_spirv_version_,
+        target_compiler.target_spirv_version_is_forced_));
+  }
+
+  const std::string pound_extension =
+      "#extension GL_GOOGLE_include_directive : enable\n";
+  const std::string preamble = input_preprocessed_
+                                   ? std::string()
+                                   : macro_definitions_ + pound_extension;
+  glslang::TShader::ForbidIncluder forbid_includer;
+  glslang::TShader::Includer& parse_includer =
+      input_preprocessed_
+          ? static_cast<glslang::TShader::Includer&>(forbid_includer)
+          : includer;
+
+  // The targets to compile on their own, as if by Compile().
+  std::vector<size_t> separate_targets;
+  // The targets whose SPIR-V came from a shared run of the frontend.
+  std::vector<size_t> shared_targets;
+  std::shared_lock<std::shared_mutex> state_lock(
+      GlslangInitializer::state_mutex());
+
+  // The stage does not depend on the target.
+  EShLanguage stage = forced_shader_stage;
+  if (stage == EShLangCount) {
+    std::ostringstream errors;
+    size_t total_warnings = 0;
+    size_t total_errors = 0;
+    std::string preprocessed_shader;
+    if (GetPreprocessedShader(source_chunks, error_tag, preamble,
+                              pound_extension, includer,
+                              /* suppress_warnings = */ true, &errors,
+                              &total_warnings, &total_errors,
+                              &preprocessed_shader)) {
+      stage = DeduceShaderStage(error_tag, preprocessed_shader,
+                                stage_callback, &errors);
+    }
+    if (stage == EShLangCount) {
+      for (auto& output : outputs) {
+        output.messages = errors.str();
+        output.num_warnings = total_warnings;
+        output.num_errors = total_errors;
+      }
+      return outputs;
+    }
+  }
+
+  // Any warnings of preprocessing the source are reported for every target
+  // whose SPIR-V comes from the shared run of the frontend.
+  std::string parse_preamble;
+  std::string parse_source;
+  std::vector<SourceChunk> parse_chunks;
+  std::string preprocessing_messages;
+  size_t preprocessing_warnings = 0;
+  {
+    std::ostringstream errors;
+    size_t total_errors = 0;
+    if (!GetParseInput(source_chunks, error_tag, pound_extension, includer,
+                       &parse_preamble, &parse_source, &parse_chunks,
+                       &errors, &preprocessing_warnings, &total_errors)) {
+      for (auto& output : outputs) {
+        output.messages = errors.str();
+        output.num_warnings = preprocessing_warnings;
+        output.num_errors = total_errors;
+      }
+      return outputs;
+    }
+    preprocessing_messages = errors.str();
+  }
+
+  bool shared_frontend_ran = false;
+  std::vector<bool> grouped(targets.size(), false);
+  for (size_t first = 0; first < targets.size(); ++first) {
+    if (grouped[first]) continue;
+    if (!client_infos[first].error.empty()) {
+      outputs[first].messages = client_infos[first].error;
+      outputs[first].num_errors = 1;
+      continue;
+    }
+#if !SHADERC_ENABLE_HLSL
+    if (source_language_ == SourceLanguage::HLSL) {
+      // Compile() reports the error.
+      separate_targets.push_back(first);
+      continue;
+    }
+#endif
+    // The targets for the same client as this one, and the one of them with
+    // the lowest SPIR-V version, which the frontend runs for.
+    std::vector<size_t> group;
+    size_t lowest = first;
+    for (size_t i = first; i < targets.size(); ++i) {
+      if (grouped[i] || !client_infos[i].error.empty() ||
+          client_infos[i].client != client_infos[first].client) {
+        continue;
+      }
+      grouped[i] = true;
+      group.push_back(i);
+      if (client_infos[i].target_language_version <
+          client_infos[lowest].target_language_version) {
+        lowest = i;
       }
-      if (used_shader_stage == EShLangCount) {
-        if ((used_shader_stage = stage_callback(error_stream, error_tag)) ==
-            EShLangCount) {
-          return result_tuple;
+    }
+    for (const size_t i : group) {
+      outputs[i].frontend_rerun = shared_frontend_ran;
+    }
+    shared_frontend_ran = true;
+
+    const Compiler& lowest_compiler = target_compilers[lowest];
+    std::ostringstream errors;
+    errors << preprocessing_messages;
+    size_t total_warnings = preprocessing_warnings;
+    size_t total_errors = 0;
+    glslang::TShader shader(stage);
+    const GlslangStrings shader_strings(parse_chunks);
+    shader_strings.SetOn(&shader);
+    lowest_compiler.ConfigureShader(stage, entry_point_name, parse_preamble,
+                                    client_infos[lowest], &shader);
+    glslang::TProgram program;
+    program.addShader(&shader);
+    const bool success =
+        lowest_compiler.ParseShader(&shader, error_tag, parse_includer,
+                                    &errors, &total_warnings,
+                                    &total_errors) &&
+        lowest_compiler.LinkProgram(&program, error_tag, &errors,
+                                    &total_warnings, &total_errors);
+    if (!success) {
+      outputs[lowest].messages = errors.str();
+      outputs[lowest].num_warnings = total_warnings;
+      outputs[lowest].num_errors = total_errors;
+      for (const size_t i : group) {
+        if (i == lowest) continue;
+        outputs[i].frontend_rerun = true;
+        separate_targets.push_back(i);
+      }
+      continue;
+    }
+
+    // The reflection does not depend on the target, so it is shared too.
+    std::string reflection;
+    if (generate_reflection) {
+      TraceScope trace_scope("Reflect", error_tag);
+      std::string reflection_errors;
+      if (!GetReflectionJson(*program.getIntermediate(stage), &reflection,
+                             &reflection_errors)) {
+        errors << error_tag << ": error: " << reflection_errors << "\n";
+        for (const size_t i : group) {
+          outputs[i].messages = errors.str();
+          outputs[i].num_warnings = total_warnings;
+          outputs[i].num_errors = total_errors + 1;
         }
+        continue;
+      }
+    }
+
+    // The warnings of the frontend may depend on the SPIR-V and client
+    // versions it ran for, so after a warning the targets of other versions
+    // are parsed on their own.
+    const bool frontend_warned = total_warnings > preprocessing_warnings;
+    glslang::TIntermediate* intermediate = program.getIntermediate(stage);
+    const glslang::SpvVersion frontend_version = intermediate->getSpv();
+    glslang::SpvOptions options;
+    options.generateDebugInfo = generate_debug_info_;
+    options.disableOptimizer = true;
+    options.optimizeSize = false;
+    options.compileOnly = CompilesForLinking();
+    for (const size_t i : group) {
+      const GlslangClientInfo& info = client_infos[i];
+      if (frontend_warned &&
+          (info.target_language_version !=
+               client_infos[lowest].target_language_version ||
+           info.client_version != client_infos[lowest].client_version)) {
+        outputs[i].frontend_rerun = true;
+        separate_targets.push_back(i);
+        continue;
+      }
+      outputs[i].messages = errors.str();
+      outputs[i].num_warnings = total_warnings;
+      outputs[i].num_errors = total_errors;
+      outputs[i].reflection = reflection;
+      shared_targets.push_back(i);
+      if (syntax_only_ == SyntaxOnlyMode::ParseAndLink) continue;
+      // GlslangToSpv takes the SPIR-V version to generate, and the client
+      // version, from the intermediate.  Since they are read from the shared
+      // intermediate, each target is generated in turn.
+      glslang::SpvVersion target_version = frontend_version;
+      target_version.spv = client_infos[i].target_language_version;
+      if (target_version.vulkan > 0) {
+        target_version.vulkan = client_infos[i].client_version;
+      }
+      intermediate->setSpv(target_version);
+      TraceScope trace_scope("GlslangToSpv", error_tag);
+      glslang::GlslangToSpv(*intermediate, outputs[i].output, &options);
+    }
+    intermediate->setSpv(frontend_version);
+  }
+  state_lock.unlock();
+
+  // The rest of the compilation of each shared target runs in parallel.  The
+  // separate targets are compiled afterwards on this thread, since they share
+  // the includer.
+  auto worker_context = [&contexts](unsigned worker) {
+    return contexts.empty() ? nullptr : contexts[worker];
+  };
+  RunInParallel(shared_targets.size(), [&](size_t job, unsigned worker) {
+    TargetOutput& output = outputs[shared_targets[job]];
+    std::ostringstream errors;
+    output.succeeded = target_compilers[shared_targets[job]].CompleteSpirv(
+        error_tag, output_type, worker_context(worker), &output.output,
+        &output.output_size, &errors, &output.num_errors);
+    output.messages += errors.str();
+  });
+  for (const size_t i : separate_targets) {
+    TargetOutput& output = outputs[i];
+    std::ostringstream errors;
+    std::tie(output.succeeded, output.output, output.output_size) =
+        target_compilers[i].Compile(source_chunks, stage, error_tag,
+                                    entry_point_name, stage_callback,
+                                    includer, output_type, &errors,
+                                    &output.num_warnings, &output.num_errors,
+                                    worker_context(0),
+                                    generate_reflection ? &output.reflection
+                                                        : nullptr);
+    output.messages = errors.str();
+  }
+  return outputs;
+}
+
+bool Compiler::RunsOptimizer() const {
+  if (hlsl_legalization_enabled_ && source_language_ == SourceLanguage::HLSL) {
+    return true;
+  }
+  return !opt_pass_flags_.empty() || !specialization_constants_.empty() ||
+         std::any_of(enabled_opt_passes_.cbegin(), enabled_opt_passes_.cend(),
+                     [](PassId pass) { return pass != PassId::kNullPass; });
+}
+
+bool Compiler::ValidateGeneratedSpirv(const std::string& error_tag,
+                                      CompileContext* context,
+                                      const std::vector<uint32_t>& spirv,
+                                      std::ostream* error_stream,
+                                      size_t* total_errors) const {
+  if (validation_policy_ != ValidationPolicy::BeforeOptimization &&
+      validation_policy_ != ValidationPolicy::Always) {
+    return true;
+  }
+  // The optimizer validates its input itself.
+  if (RunsOptimizer()) return true;
+  return CheckSpirv(error_tag, context, spirv, /* legalized = */ false,
+                    error_stream, total_errors);
+}
+
+bool Compiler::ValidateOptimizedSpirv(const std::string& error_tag,
+                                      CompileContext* context,
+                                      const std::vector<uint32_t>& spirv,
+                                      bool changed, std::ostream* error_stream,
+                                      size_t* total_errors) const {
+  switch (validation_policy_) {
+    case ValidationPolicy::AfterOptimization:
+      break;
+    case ValidationPolicy::Always:
+      // Unchanged SPIR-V was validated before optimization.
+      if (!changed) return true;
+      break;
+    default:
+      return true;
+  }
+  return CheckSpirv(error_tag, context, spirv,
+                    /* legalized = */ changed && hlsl_legalization_enabled_,
+                    error_stream, total_errors);
+}
+
+bool Compiler::SpecializeSpirv(const std::string& error_tag,
+                               std::vector<uint32_t>* spirv,
+                               std::ostream* error_stream,
+                               size_t* total_errors) const {
+  if (specialization_constants_.empty()) return true;
+  TraceScope trace_scope("FreezeSpecConstants", error_tag);
+  std::string errors;
+  if (!FreezeSpecConstants(specialization_constants_, spirv, &errors)) {
+    *error_stream << error_tag << ": error: " << errors << "\n";
+    ++*total_errors;
+    return false;
+  }
+  return true;
+}
+
+bool Compiler::LinkSpirv(const std::string& error_tag,
+                         std::vector<uint32_t>* spirv,
+                         std::ostream* error_stream,
+                         size_t* total_errors) const {
+  if (link_libraries_.empty()) return true;
+  TraceScope trace_scope("LinkSpirv", error_tag);
+  std::vector<const std::vector<uint32_t>*> libraries;
+  libraries.reserve(link_libraries_.size());
+  for (const auto& library : link_libraries_) {
+    libraries.push_back(library.get());
+  }
+  std::string errors;
+  if (!SpirvToolsLink(target_env_, target_env_version_, libraries, spirv,
+                      &errors)) {
+    *error_stream << error_tag
+                  << ": error: cannot link with the SPIR-V libraries: "
+                  << errors << "\n";
+    ++*total_errors;
+    return false;
+  }
+  return true;
+}
+
+bool Compiler::OptimizeSpirv(const std::string& error_tag,
+                             CompileContext* context,
+                             std::vector<uint32_t>* spirv,
+                             std::ostream* error_stream) const {
+  std::vector<PassId> opt_passes;
+
+  if (!specialization_constants_.empty()) {
+    // Fold what depends on the spec constants frozen by SpecializeSpirv().
+    opt_passes.push_back(PassId::kFoldSpecConstants);
+  }
+
+  if (hlsl_legalization_enabled_ && source_language_ == SourceLanguage::HLSL) {
+    // If from HLSL, run this passes to "legalize" the SPIR-V for Vulkan
+    // eg. forward and remove memory writes of opaque types.
+    opt_passes.push_back(PassId::kLegalizationPasses);
+  }
+
+  if (opt_pass_flags_.empty()) {
+    opt_passes.insert(opt_passes.end(), enabled_opt_passes_.begin(),
+                      enabled_opt_passes_.end());
+  }
+
+  if (!opt_passes.empty() || !opt_pass_flags_.empty()) {
+    TraceScope trace_scope("Optimize", error_tag);
+    // Modules compiled for linking keep the Linkage capability, which the
+    // validator rejects for Vulkan.
+    const bool validate_input =
+        (validation_policy_ == ValidationPolicy::Default ||
+         validation_policy_ == ValidationPolicy::BeforeOptimization ||
+         validation_policy_ == ValidationPolicy::Always) &&
+        !HasLinkageCapability(*spirv);
+    // Everything but the module that the optimizer output depends on.
+    std::string cache_config;
+    std::vector<uint32_t> unoptimized;
+    if (optimizer_cache_) {
+      std::ostringstream config;
+      config << static_cast<int>(target_env_) << ' '
+             << static_cast<uint32_t>(target_env_version_) << ' '
+             << preserve_bindings_ << ' ' << max_id_bound_ << ' '
+             << validate_input;
+      for (const PassId pass : opt_passes) {
+        config << ' ' << static_cast<int>(pass);
       }
+      for (const std::string& flag : opt_pass_flags_) config << ' ' << flag;
+      cache_config = config.str();
+      if (optimizer_cache_->Lookup(cache_config, *spirv, spirv)) return true;
+      unoptimized = *spirv;
+    }
+
+    spvtools::OptimizerOptions opt_options;
+    opt_options.set_preserve_bindings(preserve_bindings_);
+    opt_options.set_max_id_bound(max_id_bound_);
+
+    std::string opt_errors;
+    if (!SpirvToolsOptimize(target_env_, target_env_version_, opt_passes,
+                            opt_pass_flags_, opt_options, validate_input,
+                            spirv, &opt_errors, context)) {
+      *error_stream << "shaderc: internal error: compilation succeeded but "
+                       "failed to optimize: "
+                    << opt_errors << "\n";
+      return false;
+    }
+    if (optimizer_cache_) {
+      optimizer_cache_->Insert(cache_config, unoptimized, *spirv);
+    }
+  }
+  return true;
+}
+
+bool Compiler::FinishOutput(const std::string& error_tag,
+                            OutputType output_type, CompileContext* context,
+                            std::vector<uint32_t>* spirv, size_t* output_size,
+                            std::ostream* error_stream) const {
+  if (output_type == OutputType::SpirvAssemblyText) {
+    std::string errors;
+    TraceScope trace_scope("Disassemble", error_tag);
+    // The text goes from the disassembler's buffer straight into the output,
+    // which replaces the binary once the disassembler is done with it.
+    if (!SpirvToolsDisassemble(
+            target_env_, target_env_version_, spirv->data(), spirv->size(),
+            disassembly_friendly_names_,
+            [spirv, output_size](string_piece text) {
+              *spirv = ConvertStringToVector(text);
+              *output_size = text.size();
+              return true;
+            },
+            &errors, context)) {
+      *error_stream << "shaderc: internal error: compilation succeeded but "
+                       "failed to disassemble: "
+                    << errors << "\n";
+      return false;
     }
+  } else {
+    *output_size = spirv->size() * sizeof((*spirv)[0]);
   }
+  return true;
+}
 
+bool Compiler::GenerateSpirv(const std::vector<SourceChunk>& source_chunks,
+                             EShLanguage stage, const std::string& error_tag,
+                             const char* entry_point_name,
+                             const std::string& preamble,
+                             const GlslangClientInfo& target_client_info,
+                             glslang::TShader::Includer& includer,
+                             std::ostream* error_stream, size_t* total_warnings,
+                             size_t* total_errors,
+                             std::vector<uint32_t>* spirv,
+                             std::string* reflection) const {
   // Parsing requires its own Glslang symbol tables.
-  glslang::TShader shader(used_shader_stage);
-  const char* shader_strings = input_source_string.data();
-  const int shader_lengths = static_cast<int>(input_source_string.size());
-  const char* string_names = error_tag.c_str();
-  shader.setStringsWithLengthsAndNames(&shader_strings, &shader_lengths,
-                                       &string_names, 1);
-  shader.setPreamble(preamble.c_str());
-  shader.setEntryPoint(entry_point_name);
-  shader.setAutoMapBindings(auto_bind_uniforms_);
+  glslang::TShader shader(stage);
+  const GlslangStrings shader_strings(source_chunks);
+  shader_strings.SetOn(&shader);
+  ConfigureShader(stage, entry_point_name, preamble, target_client_info,
+                  &shader);
+  if (!ParseShader(&shader, error_tag, includer, error_stream, total_warnings,
+                   total_errors)) {
+    return false;
+  }
+
+  glslang::TProgram program;
+  program.addShader(&shader);
+  if (!LinkProgram(&program, error_tag, error_stream, total_warnings,
+                   total_errors)) {
+    return false;
+  }
+
+  if (reflection) {
+    TraceScope trace_scope("Reflect", error_tag);
+    std::string errors;
+    if (!GetReflectionJson(*program.getIntermediate(stage), reflection,
+                           &errors)) {
+      *error_stream << error_tag << ": error: " << errors << "\n";
+      ++*total_errors;
+      return false;
+    }
+  }
+
+  if (syntax_only_ == SyntaxOnlyMode::ParseAndLink) return true;
+
+  glslang::SpvOptions options;
+  options.generateDebugInfo = generate_debug_info_;
+  options.disableOptimizer = true;
+  options.optimizeSize = false;
+  options.compileOnly = CompilesForLinking();
+  {
+    TraceScope trace_scope("GlslangToSpv", error_tag);
+    glslang::GlslangToSpv(*program.getIntermediate(stage), *spirv,
+                          &options);
+  }
+  return true;
+}
+
+void Compiler::ConfigureShader(EShLanguage stage,
+                               const char* entry_point_name,
+                               const std::string& preamble,
+                               const GlslangClientInfo& target_client_info,
+                               glslang::TShader* shader) const {
+  shader->setPreamble(preamble.c_str());
+  shader->setEntryPoint(entry_point_name);
+  shader->setAutoMapBindings(auto_bind_uniforms_);
   if (auto_combined_image_sampler_) {
-    shader.setTextureSamplerTransformMode(
+    shader->setTextureSamplerTransformMode(
         EShTexSampTransUpgradeTextureRemoveSampler);
   }
-  shader.setAutoMapLocations(auto_map_locations_);
-  const auto& bases = auto_binding_base_[static_cast<int>(used_shader_stage)];
-  shader.setShiftImageBinding(bases[static_cast<int>(UniformKind::Image)]);
-  shader.setShiftSamplerBinding(bases[static_cast<int>(UniformKind::Sampler)]);
-  shader.setShiftTextureBinding(bases[static_cast<int>(UniformKind::Texture)]);
-  shader.setShiftUboBinding(bases[static_cast<int>(UniformKind::Buffer)]);
-  shader.setShiftSsboBinding(
+  shader->setAutoMapLocations(auto_map_locations_);
+  const auto& bases = auto_binding_base_[static_cast<int>(stage)];
+  shader->setShiftImageBinding(bases[static_cast<int>(UniformKind::Image)]);
+  shader->setShiftSamplerBinding(bases[static_cast<int>(UniformKind::Sampler)]);
+  shader->setShiftTextureBinding(bases[static_cast<int>(UniformKind::Texture)]);
+  shader->setShiftUboBinding(bases[static_cast<int>(UniformKind::Buffer)]);
+  shader->setShiftSsboBinding(
       bases[static_cast<int>(UniformKind::StorageBuffer)]);
-  shader.setShiftUavBinding(
+  shader->setShiftUavBinding(
       bases[static_cast<int>(UniformKind::UnorderedAccessView)]);
 #if SHADERC_ENABLE_HLSL
-  shader.setHlslIoMapping(hlsl_iomap_);
+  shader->setHlslIoMapping(hlsl_iomap_);
 #endif
-  shader.setResourceSetBinding(
-      hlsl_explicit_bindings_[static_cast<int>(used_shader_stage)]);
-  shader.setEnvClient(target_client_info.client,
-                      target_client_info.client_version);
-  shader.setEnvTarget(target_client_info.target_language,
-                      target_client_info.target_language_version);
+  shader->setResourceSetBinding(
+      hlsl_explicit_bindings_[static_cast<int>(stage)]);
+  shader->setEnvClient(target_client_info.client,
+                       target_client_info.client_version);
+  shader->setEnvTarget(target_client_info.target_language,
+                       target_client_info.target_language_version);
+  if (CompilesForLinking()) shader->setCompileOnly();
 #if SHADERC_ENABLE_HLSL
   if (hlsl_functionality1_enabled_) {
-    shader.setEnvTargetHlslFunctionality1();
+    shader->setEnvTargetHlslFunctionality1();
   }
 #endif
   if (vulkan_rules_relaxed_) {
@@ -330,98 +1342,151 @@ std::tuple<bool, std::vector<uint32_t>, size_t> Compiler::Compile(
     // This option will only be used if the Vulkan client is used.
     // If new versions of GL_KHR_vulkan_glsl come out, it would make sense to
     // let callers specify which version to use. For now, just use 100.
-    shader.setEnvInput(language, used_shader_stage, glslang::EShClientVulkan,
-                       100);
-    shader.setEnvInputVulkanRulesRelaxed();
+    shader->setEnvInput(language, stage, glslang::EShClientVulkan, 100);
+    shader->setEnvInputVulkanRulesRelaxed();
   }
-  shader.setInvertY(invert_y_enabled_);
-  shader.setNanMinMaxClamp(nan_clamp_);
+  shader->setInvertY(invert_y_enabled_);
+  shader->setNanMinMaxClamp(nan_clamp_);
+}
 
+bool Compiler::ParseShader(glslang::TShader* shader,
+                           const std::string& error_tag,
+                           glslang::TShader::Includer& includer,
+                           std::ostream* error_stream, size_t* total_warnings,
+                           size_t* total_errors) const {
   const EShMessages rules =
       GetMessageRules(target_env_, source_language_, hlsl_offsets_,
                       hlsl_16bit_types_enabled_, generate_debug_info_);
 
-  bool success = shader.parse(&limits_, default_version_, default_profile_,
-                              force_version_profile_, kNotForwardCompatible,
-                              rules, includer);
+  bool success;
+  {
+    TraceScope trace_scope("Parse", error_tag);
+    success = shader->parse(&limits_, default_version_, default_profile_,
+                            force_version_profile_, kNotForwardCompatible,
+                            rules, includer);
+  }
 
   success &= PrintFilteredErrors(error_tag, error_stream, warnings_as_errors_,
-                                 suppress_warnings_, shader.getInfoLog(),
+                                 suppress_warnings_, shader->getInfoLog(),
                                  total_warnings, total_errors);
-  if (!success) return result_tuple;
+  return success;
+}
 
-  glslang::TProgram program;
-  program.addShader(&shader);
-  success = program.link(EShMsgDefault) && program.mapIO();
+bool Compiler::LinkProgram(glslang::TProgram* program,
+                           const std::string& error_tag,
+                           std::ostream* error_stream, size_t* total_warnings,
+                           size_t* total_errors) const {
+  bool success;
+  {
+    TraceScope trace_scope("Link", error_tag);
+    success = program->link(EShMsgDefault) && program->mapIO();
+  }
   success &= PrintFilteredErrors(error_tag, error_stream, warnings_as_errors_,
-                                 suppress_warnings_, program.getInfoLog(),
+                                 suppress_warnings_, program->getInfoLog(),
                                  total_warnings, total_errors);
-  if (!success) return result_tuple;
-
-  // 'spirv' is an alias for the compilation_output_data. This alias is added
-  // to serve as an input for the call to DissassemblyBinary.
-  std::vector<uint32_t>& spirv = compilation_output_data;
-  glslang::SpvOptions options;
-  options.generateDebugInfo = generate_debug_info_;
-  options.disableOptimizer = true;
-  options.optimizeSize = false;
-  // Note the call to GlslangToSpv also populates compilation_output_data.
-  glslang::GlslangToSpv(*program.getIntermediate(used_shader_stage), spirv,
-                        &options);
-
-  // Set the tool field (the top 16-bits) in the generator word to
-  // 'Shaderc over Glslang'.
-  const uint32_t shaderc_generator_word = 13;  // From SPIR-V XML Registry
-  const uint32_t generator_word_index = 2;     // SPIR-V 2.3: Physical layout
-  assert(spirv.size() > generator_word_index);
-  spirv[generator_word_index] =
-      (spirv[generator_word_index] & 0xffff) | (shaderc_generator_word << 16);
-
-  std::vector<PassId> opt_passes;
+  return success;
+}
 
+bool Compiler::ValidateSpirv(const std::string& error_tag,
+                             CompileContext* context,
+                             std::vector<uint32_t>* spirv,
+                             std::ostream* error_stream,
+                             size_t* total_errors) const {
+  std::string errors;
   if (hlsl_legalization_enabled_ && source_language_ == SourceLanguage::HLSL) {
-    // If from HLSL, run this passes to "legalize" the SPIR-V for Vulkan
-    // eg. forward and remove memory writes of opaque types.
-    opt_passes.push_back(PassId::kLegalizationPasses);
-  }
-
-  opt_passes.insert(opt_passes.end(), enabled_opt_passes_.begin(),
-                    enabled_opt_passes_.end());
-
-  if (!opt_passes.empty()) {
+    // glslang's SPIR-V for HLSL is only valid for Vulkan once it has been
+    // legalized.
     spvtools::OptimizerOptions opt_options;
     opt_options.set_preserve_bindings(preserve_bindings_);
     opt_options.set_max_id_bound(max_id_bound_);
-
-    std::string opt_errors;
-    if (!SpirvToolsOptimize(target_env_, target_env_version_, opt_passes,
-                            opt_options, &spirv, &opt_errors)) {
+    TraceScope trace_scope("Optimize", error_tag);
+    if (!SpirvToolsOptimize(target_env_, target_env_version_,
+                            {PassId::kLegalizationPasses}, {}, opt_options,
+                            /* validate_input = */ true, spirv, &errors,
+                            context)) {
       *error_stream << "shaderc: internal error: compilation succeeded but "
-                       "failed to optimize: "
-                    << opt_errors << "\n";
-      return result_tuple;
+                       "failed to legalize: "
+                    << errors << "\n";
+      return false;
     }
   }
 
-  if (output_type == OutputType::SpirvAssemblyText) {
-    std::string text_or_error;
-    if (!SpirvToolsDisassemble(target_env_, target_env_version_, spirv,
-                               &text_or_error)) {
-      *error_stream << "shaderc: internal error: compilation succeeded but "
-                       "failed to disassemble: "
-                    << text_or_error << "\n";
-      return result_tuple;
-    }
-    succeeded = true;
-    compilation_output_data = ConvertStringToVector(text_or_error);
-    compilation_output_data_size_in_bytes = text_or_error.size();
-    return result_tuple;
+  return CheckSpirv(error_tag, context, *spirv,
+                    /* legalized = */ hlsl_legalization_enabled_,
+                    error_stream, total_errors);
+}
+
+bool Compiler::CheckSpirv(const std::string& error_tag,
+                          CompileContext* context,
+                          const std::vector<uint32_t>& spirv, bool legalized,
+                          std::ostream* error_stream,
+                          size_t* total_errors) const {
+  // See OptimizeSpirv() about modules compiled for linking.
+  if (HasLinkageCapability(spirv)) return true;
+  TraceScope trace_scope("Validate", error_tag);
+  const bool is_hlsl = source_language_ == SourceLanguage::HLSL;
+  std::string errors;
+  if (!SpirvToolsValidate(
+          target_env_, target_env_version_, spirv,
+          GetSpirvToolsValidatorOptions(is_hlsl, is_hlsl && !legalized),
+          &errors, context)) {
+    *error_stream << error_tag << ": error: generated SPIR-V is invalid: "
+                  << errors << "\n";
+    ++*total_errors;
+    return false;
+  }
+  return true;
+}
+
+bool Compiler::PrewarmBuiltins(EShLanguage stage, int version) const {
+  auto target_client_info = GetGlslangClientInfo(
+      "", target_env_, target_env_version_, target_spirv_version_,
+      target_spirv_version_is_forced_);
+  if (!target_client_info.error.empty()) return false;
+
+  const std::shared_lock<std::shared_mutex> state_lock(
+      GlslangInitializer::state_mutex());
+  EProfile profile = default_profile_;
+  if (version == 0) {
+    version = default_version_;
+  } else if (version == 100 || version == 300 || version == 310 ||
+             version == 320) {
+    profile = EEsProfile;
   } else {
-    succeeded = true;
-    // Note compilation_output_data is already populated in GlslangToSpv().
-    compilation_output_data_size_in_bytes = spirv.size() * sizeof(spirv[0]);
-    return result_tuple;
+    profile = version >= 150 ? ECoreProfile : ENoProfile;
+  }
+
+  TraceScope trace_scope("Prewarm");
+  // glslang sets up the built-in symbol tables for a version, profile, target
+  // and stage before it looks at the source, so parsing a trivial shader is
+  // enough.  Whether that shader is valid for the stage does not matter.
+  glslang::TShader shader(stage);
+  const char* shader_strings = "void main() {}\n";
+  shader.setStrings(&shader_strings, 1);
+  shader.setEntryPoint("main");
+  shader.setEnvClient(target_client_info.client,
+                      target_client_info.client_version);
+  shader.setEnvTarget(target_client_info.target_language,
+                      target_client_info.target_language_version);
+#if SHADERC_ENABLE_HLSL
+  if (hlsl_functionality1_enabled_) {
+    shader.setEnvTargetHlslFunctionality1();
   }
+#endif
+  if (vulkan_rules_relaxed_) {
+    shader.setEnvInput(source_language_ == SourceLanguage::HLSL
+                           ? glslang::EShSourceHlsl
+                           : glslang::EShSourceGlsl,
+                       stage, glslang::EShClientVulkan, 100);
+    shader.setEnvInputVulkanRulesRelaxed();
+  }
+  const EShMessages rules =
+      GetMessageRules(target_env_, source_language_, hlsl_offsets_,
+                      hlsl_16bit_types_enabled_, generate_debug_info_);
+  const bool force_version_profile = true;
+  shader.parse(&limits_, version, profile, force_version_profile,
+               kNotForwardCompatible, rules);
+  return true;
 }
 
 void Compiler::AddMacroDefinition(const char* macro, size_t macro_length,
@@ -429,6 +1494,8 @@ void Compiler::AddMacroDefinition(const char* macro, size_t macro_length,
                                   size_t definition_length) {
   predefined_macros_[std::string(macro, macro_length)] =
       definition ? std::string(definition, definition_length) : "";
+  macro_definitions_ =
+      shaderc_util::format(predefined_macros_, "#define ", " ", "\n");
 }
 
 void Compiler::SetTargetEnv(Compiler::TargetEnv env,
@@ -466,6 +1533,8 @@ void Compiler::SetGenerateDebugInfo() {
 void Compiler::SetOptimizationLevel(Compiler::OptimizationLevel level) {
   // Clear previous settings first.
   enabled_opt_passes_.clear();
+  opt_pass_flags_.clear();
+  opt_pass_flags_error_.clear();
 
   switch (level) {
     case OptimizationLevel::Size:
@@ -485,6 +1554,16 @@ void Compiler::SetOptimizationLevel(Compiler::OptimizationLevel level) {
   }
 }
 
+bool Compiler::SetOptimizationPasses(const std::vector<std::string>& passes,
+                                     std::string* errors) {
+  if (!ParseSpirvToolsPassFlags(passes, &opt_pass_flags_, errors)) {
+    opt_pass_flags_error_ = *errors;
+    return false;
+  }
+  opt_pass_flags_error_.clear();
+  return true;
+}
+
 void Compiler::EnableHlslLegalization(bool hlsl_legalization_enabled) {
   hlsl_legalization_enabled_ = hlsl_legalization_enabled;
 }
@@ -507,16 +1586,20 @@ void Compiler::SetNanClamp(bool enable) { nan_clamp_ = enable; }
 
 void Compiler::SetSuppressWarnings() { suppress_warnings_ = true; }
 
+void Compiler::SetInputPreprocessed(bool preprocessed) {
+  input_preprocessed_ = preprocessed;
+}
+
+void Compiler::SetSyntaxOnly(SyntaxOnlyMode mode) { syntax_only_ = mode; }
+
 std::tuple<bool, std::string, std::string> Compiler::PreprocessShader(
-    const std::string& error_tag, const string_piece& shader_source,
+    const std::string& error_tag,
+    const std::vector<SourceChunk>& source_chunks,
     const string_piece& shader_preamble, CountingIncluder& includer) const {
   // The stage does not matter for preprocessing.
   glslang::TShader shader(EShLangVertex);
-  const char* shader_strings = shader_source.data();
-  const int shader_lengths = static_cast<int>(shader_source.size());
-  const char* string_names = error_tag.c_str();
-  shader.setStringsWithLengthsAndNames(&shader_strings, &shader_lengths,
-                                       &string_names, 1);
+  const GlslangStrings shader_strings(source_chunks);
+  shader_strings.SetOn(&shader);
   shader.setPreamble(shader_preamble.data());
   auto target_client_info = GetGlslangClientInfo(
       error_tag, target_env_, target_env_version_, target_spirv_version_,
@@ -747,13 +1830,14 @@ std::pair<int, EProfile> Compiler::GetVersionProfileFromSourceCode(
 // Converts a string to a vector of uint32_t by copying the content of a given
 // string to a vector<uint32_t> and returns it. Appends '\0' at the end if extra
 // bytes are required to complete the last element.
-std::vector<uint32_t> ConvertStringToVector(const std::string& str) {
+std::vector<uint32_t> ConvertStringToVector(const string_piece& str) {
   size_t num_bytes_str = str.size() + 1u;
   size_t vector_length =
       (num_bytes_str + sizeof(uint32_t) - 1) / sizeof(uint32_t);
   std::vector<uint32_t> result_vec(vector_length, 0);
-  std::strncpy(reinterpret_cast<char*>(result_vec.data()), str.c_str(),
-               str.size());
+  if (!str.empty()) {
+    std::memcpy(result_vec.data(), str.data(), str.size());
+  }
   return result_vec;
 }
 
@@ -19,7 +19,10 @@
 #include <sstream>
 
 #include "death_test.h"
+#include "libshaderc_util/compile_context.h"
 #include "libshaderc_util/counting_includer.h"
+#include "libshaderc_util/optimizer_cache.h"
+#include "libshaderc_util/parallel.h"
 #include "libshaderc_util/spirv_tools_wrapper.h"
 
 namespace {
@@ -135,6 +138,15 @@ const char kGlslShaderWeirdPacking[] =
        buffer B { float x; vec3 foo; } my_ssbo;
        void main() { my_ssbo.x = 1.0; })";
 
+// A GLSL compute shader with a block in the scalar layout, where the vec4
+// follows the float directly, which the relaxed block layout does not allow.
+const char kScalarLayoutShader[] = R"(#version 450
+#extension GL_EXT_scalar_block_layout : require
+layout(local_size_x = 1) in;
+layout(scalar, binding = 0) buffer B { float x; vec4 v; };
+void main() { v = vec4(x); }
+)";
+
 #if SHADERC_ENABLE_HLSL
 const char kHlslShaderForLegalizationTest[] = R"(
 struct CombinedTextureSampler {
@@ -174,6 +186,91 @@ layout(location=0) out vec4 o;
 void main() { o = clamp(i, vec4(0.5), vec4(1.0)); }
 )";
 
+// A vertex and a fragment shader for one program.  The fragment shader
+// declares both outputs of the vertex shader as inputs, but only reads one.
+const char kProgramVertexShader[] = R"(#version 450
+layout(location=0) in vec4 position;
+layout(location=0) out vec4 color;
+layout(location=1) out vec4 unused_varying;
+void main() {
+  gl_Position = position;
+  color = position * 0.5;
+  unused_varying = sin(position);
+}
+)";
+
+const char kProgramFragmentShader[] = R"(#version 450
+layout(location=0) in vec4 color;
+layout(location=1) in vec4 unused_varying;
+layout(location=0) out vec4 frag_color;
+void main() { frag_color = color; }
+)";
+
+// A compute shader that uses the TILE_SIZE and SCALE macros as values.
+const char kMacroSpecConstantShader[] = R"(#version 450
+layout(local_size_x = 1) in;
+layout(std430, binding = 0) buffer B { int v[]; };
+void main() { v[0] = TILE_SIZE + int(SCALE * 4.0); }
+)";
+
+// A compute shader with a specialization constant, and a spec constant
+// operation that depends on it.
+const char kSpecConstantShader[] = R"(#version 450
+layout(local_size_x = 1) in;
+layout(constant_id = 3) const int N = 4;
+const int M = N * 2;
+layout(std430, binding = 0) buffer B { int v[]; };
+void main() { v[0] = M; }
+)";
+
+// A library of functions, one of which no shader calls.
+const char kLibraryShader[] = R"(#version 450
+float twice(float x) { return 2.0 * x; }
+float unused_helper(float x) { return x + 1.0; }
+)";
+
+// A compute shader that calls a function of kLibraryShader.
+const char kLibraryUserShader[] = R"(#version 450
+layout(local_size_x = 1) in;
+layout(std430, binding = 0) buffer B { float v[]; };
+float twice(float x);
+void main() { v[0] = twice(v[1]); }
+)";
+
+// A compute shader that calls a function that kLibraryShader does not have.
+const char kMissingLibraryFunctionShader[] = R"(#version 450
+layout(local_size_x = 1) in;
+layout(std430, binding = 0) buffer B { float v[]; };
+float thrice(float x);
+void main() { v[0] = thrice(v[1]); }
+)";
+
+// A compute shader with a uniform buffer, a storage buffer, an array of
+// samplers and push constants.
+const char kReflectedComputeShader[] = R"(#version 450
+layout(local_size_x = 8, local_size_y = 4) in;
+layout(set = 1, binding = 2) uniform Params { vec4 scale; } params;
+layout(set = 0, binding = 0) buffer Data { float values[]; } data;
+layout(set = 0, binding = 1) uniform sampler2D textures[4];
+layout(push_constant) uniform Push { uint count; mat4 transform; } push;
+void main() {
+  data.values[gl_GlobalInvocationID.x] =
+      params.scale.x * float(push.count) * push.transform[0][0] +
+      textureLod(textures[1], vec2(0.0), 0.0).x;
+}
+)";
+
+// A vertex shader with stage inputs and outputs.
+const char kReflectedVertexShader[] = R"(#version 450
+layout(location = 0) in vec3 position;
+layout(location = 2) in vec2 uv[2];
+layout(location = 1) out vec4 color;
+void main() {
+  gl_Position = vec4(position, 1.0);
+  color = vec4(uv[0], uv[1]);
+}
+)";
+
 // Returns the disassembly of the given SPIR-V binary, as a string.
 // Assumes the disassembly will be successful when targeting Vulkan.
 std::string Disassemble(const std::vector<uint32_t> binary) {
@@ -246,6 +343,50 @@ class CompilerTest : public testing::Test {
     return words;
   }
 
+  // Returns the reflection of a successful compilation of a shader.
+  std::string SimpleCompilationReflection(std::string source,
+                                          EShLanguage stage) {
+    shaderc_util::GlslangInitializer initializer;
+    std::stringstream errors;
+    size_t total_warnings = 0;
+    size_t total_errors = 0;
+    bool result = false;
+    DummyCountingIncluder dummy_includer;
+    std::string reflection;
+    std::tie(result, std::ignore, std::ignore) = compiler_.Compile(
+        source, stage, "shader", "main", dummy_stage_callback_, dummy_includer,
+        Compiler::OutputType::SpirvBinary, &errors, &total_warnings,
+        &total_errors, nullptr, &reflection);
+    errors_ = errors.str();
+    EXPECT_TRUE(result) << errors_;
+    return reflection;
+  }
+
+  // Compiles the given sources, each for its stage, as one program to the
+  // given output type.  Returns true on success, and writes the outputs to
+  // *outputs.
+  bool ProgramCompiles(
+      const std::vector<std::pair<std::string, EShLanguage>>& sources,
+      Compiler::OutputType output_type,
+      std::vector<shaderc_util::ProgramStageOutput>* outputs,
+      bool generate_reflection = false) {
+    shaderc_util::GlslangInitializer initializer;
+    std::vector<shaderc_util::ProgramStage> stages;
+    for (const auto& source : sources) {
+      stages.push_back(
+          {{{source.first, "shader"}}, source.second, "shader", "main"});
+    }
+    std::stringstream errors;
+    size_t total_warnings = 0;
+    size_t total_errors = 0;
+    DummyCountingIncluder dummy_includer;
+    const bool result = compiler_.CompileProgram(
+        stages, dummy_includer, output_type, &errors, &total_warnings,
+        &total_errors, outputs, nullptr, generate_reflection);
+    errors_ = errors.str();
+    return result;
+  }
+
  protected:
   Compiler compiler_;
   // The error string from the most recent compilation.
@@ -442,6 +583,558 @@ TEST_F(CompilerTest, AddMacroDefinitionNotNullTerminated) {
   EXPECT_TRUE(SimpleCompilationSucceeds(kMinimalExpandedShader, EShLangVertex));
 }
 
+TEST_F(CompilerTest, MacroSpecConstantIsDeclared) {
+  compiler_.AddMacroDefinition("TILE_SIZE", 9u, "8", 1u);
+  compiler_.AddMacroDefinition("SCALE", 5u, "0.5", 3u);
+  compiler_.AddMacroSpecConstant("TILE_SIZE", 5);
+  const std::string disassembly = Disassemble(
+      SimpleCompilationBinary(kMacroSpecConstantShader, EShLangCompute));
+  EXPECT_THAT(disassembly, HasSubstr("OpDecorate %TILE_SIZE SpecId 5"));
+  EXPECT_THAT(disassembly, HasSubstr("%TILE_SIZE = OpSpecConstant %int 8"));
+  // Other macros are expanded as usual.
+  EXPECT_THAT(disassembly, HasSubstr("OpConstant %int 2"));
+}
+
+TEST_F(CompilerTest, MacroSpecConstantStaysDefinedForIfdef) {
+  const std::string shader =
+      "#version 450\n"
+      "layout(local_size_x = 1) in;\n"
+      "layout(std430, binding = 0) buffer B { int v[]; };\n"
+      "#ifndef TILE_SIZE\n"
+      "#error TILE_SIZE is not defined\n"
+      "#endif\n"
+      "void main() { v[0] = TILE_SIZE * 2; }\n";
+  compiler_.AddMacroDefinition("TILE_SIZE", 9u, "8u", 2u);
+  compiler_.AddMacroSpecConstant("TILE_SIZE", 1);
+  EXPECT_THAT(
+      Disassemble(SimpleCompilationBinary(shader, EShLangCompute)),
+      HasSubstr("%TILE_SIZE = OpSpecConstant %uint 8"));
+}
+
+TEST_F(CompilerTest, MacroSpecConstantIsDeclaredAfterExtensions) {
+  const std::string shader =
+      "#version 450\n"
+      "#extension GL_EXT_scalar_block_layout : require\n"
+      "layout(local_size_x = 1) in;\n"
+      "layout(scalar, binding = 0) buffer B { int v[]; };\n"
+      "void main() { v[0] = TILE_SIZE; }\n";
+  compiler_.AddMacroDefinition("TILE_SIZE", 9u, "8", 1u);
+  compiler_.AddMacroSpecConstant("TILE_SIZE", 2);
+  EXPECT_THAT(Disassemble(SimpleCompilationBinary(shader, EShLangCompute)),
+              HasSubstr("%TILE_SIZE = OpSpecConstant %int 8"));
+}
+
+TEST_F(CompilerTest, MacroSpecConstantKeepsTheLineNumbersOfErrors) {
+  const std::string shader =
+      "#version 450\n"
+      "layout(local_size_x = 1) in;\n"
+      "\n"
+      "void main() {\n"
+      "  int x = TILE_SIZE + undeclared;\n"
+      "}\n";
+  compiler_.AddMacroDefinition("TILE_SIZE", 9u, "8", 1u);
+  compiler_.AddMacroSpecConstant("TILE_SIZE", 2);
+  EXPECT_FALSE(SimpleCompilationSucceeds(shader, EShLangCompute));
+  EXPECT_THAT(errors_, HasSubstr("shader:5: error: 'undeclared'"));
+}
+
+TEST_F(CompilerTest, MacroSpecConstantInIfExpressionIsAnError) {
+  const std::string shader =
+      "#version 450\n"
+      "layout(local_size_x = 1) in;\n"
+      "#if TILE_SIZE > 8\n"
+      "#endif\n"
+      "void main() {}\n";
+  compiler_.AddMacroDefinition("TILE_SIZE", 9u, "16", 2u);
+  compiler_.AddMacroSpecConstant("TILE_SIZE", 1);
+  EXPECT_FALSE(SimpleCompilationSucceeds(shader, EShLangCompute));
+}
+
+TEST_F(CompilerTest, MacroSpecConstantNeedsALiteralValue) {
+  compiler_.AddMacroSpecConstant("TILE_SIZE", 5);
+  EXPECT_FALSE(
+      SimpleCompilationSucceeds(kMacroSpecConstantShader, EShLangCompute));
+  EXPECT_THAT(errors_,
+              HasSubstr("shader: error: macro 'TILE_SIZE' is not defined, so "
+                        "it cannot be a specialization constant"));
+
+  compiler_.AddMacroDefinition("TILE_SIZE", 9u, "(4 + 4)", 7u);
+  EXPECT_FALSE(
+      SimpleCompilationSucceeds(kMacroSpecConstantShader, EShLangCompute));
+  EXPECT_THAT(errors_,
+              HasSubstr("shader: error: macro 'TILE_SIZE' has no boolean or "
+                        "numeric literal value, so it cannot be a "
+                        "specialization constant"));
+}
+
+TEST_F(CompilerTest, MacroSpecConstantIsExpandedWhenOnlyPreprocessing) {
+  compiler_.AddMacroDefinition("TILE_SIZE", 9u, "8", 1u);
+  compiler_.AddMacroDefinition("SCALE", 5u, "0.5", 3u);
+  compiler_.AddMacroSpecConstant("TILE_SIZE", 5);
+  shaderc_util::GlslangInitializer initializer;
+  std::stringstream errors;
+  size_t total_warnings = 0;
+  size_t total_errors = 0;
+  bool result = false;
+  DummyCountingIncluder dummy_includer;
+  std::vector<uint32_t> output;
+  size_t output_size = 0;
+  std::tie(result, output, output_size) = compiler_.Compile(
+      kMacroSpecConstantShader, EShLangCompute, "shader", "main",
+      dummy_stage_callback_, dummy_includer,
+      Compiler::OutputType::PreprocessedText, &errors, &total_warnings,
+      &total_errors);
+  ASSERT_TRUE(result) << errors.str();
+  const std::string text(reinterpret_cast<const char*>(output.data()),
+                         output_size);
+  EXPECT_THAT(text, HasSubstr("v[0] = 8 + int(0.5 * 4.0);"));
+  EXPECT_THAT(text, Not(HasSubstr("constant_id")));
+}
+
+TEST_F(CompilerTest, ReflectionDescribesResources) {
+  const std::string reflection =
+      SimpleCompilationReflection(kReflectedComputeShader, EShLangCompute);
+  EXPECT_THAT(reflection,
+              HasSubstr("\"type\": \"Params\", \"array_size\": 1, "
+                        "\"kind\": \"uniform_buffer\", \"set\": 1, "
+                        "\"binding\": 2, \"size\": 16}"));
+  EXPECT_THAT(reflection, HasSubstr("\"kind\": \"storage_buffer\", "
+                                    "\"set\": 0, \"binding\": 0"));
+  EXPECT_THAT(reflection,
+              HasSubstr("\"type\": \"sampler2D\", \"array_size\": 4, "
+                        "\"kind\": \"combined_image_sampler\", "
+                        "\"set\": 0, \"binding\": 1}"));
+  EXPECT_THAT(reflection, HasSubstr("\"workgroup_size\": [8, 4, 1]"));
+}
+
+TEST_F(CompilerTest, ReflectionDescribesPushConstants) {
+  const std::string reflection =
+      SimpleCompilationReflection(kReflectedComputeShader, EShLangCompute);
+  // The push constant block is not a descriptor.
+  EXPECT_THAT(reflection, Not(HasSubstr("\"type\": \"Push\"")));
+  EXPECT_THAT(reflection, HasSubstr("\"size\": 80, \"members\": ["));
+  EXPECT_THAT(reflection, HasSubstr("\"type\": \"uint\", "
+                                    "\"array_size\": 1, \"offset\": 0}"));
+  EXPECT_THAT(reflection, HasSubstr("\"type\": \"mat4\", "
+                                    "\"array_size\": 1, \"offset\": 16}"));
+}
+
+TEST_F(CompilerTest, ReflectionDescribesStageVariables) {
+  const std::string reflection =
+      SimpleCompilationReflection(kReflectedVertexShader, EShLangVertex);
+  EXPECT_THAT(reflection,
+              HasSubstr("{\"name\": \"position\", \"type\": \"vec3\", "
+                        "\"array_size\": 1, \"location\": 0}"));
+  EXPECT_THAT(reflection,
+              HasSubstr("{\"name\": \"uv\", \"type\": \"vec2\", "
+                        "\"array_size\": 2, \"location\": 2}"));
+  EXPECT_THAT(reflection,
+              HasSubstr("\"outputs\": [{\"name\": \"color\", "
+                        "\"type\": \"vec4\", \"array_size\": 1, "
+                        "\"location\": 1}]"));
+  // Built-in variables and the workgroup size are left out.
+  EXPECT_THAT(reflection, Not(HasSubstr("gl_")));
+  EXPECT_THAT(reflection, Not(HasSubstr("workgroup_size")));
+}
+
+TEST_F(CompilerTest, ReflectionIsMadeForSyntaxOnlyCompilations) {
+  compiler_.SetSyntaxOnly(Compiler::SyntaxOnlyMode::ParseAndLink);
+  EXPECT_THAT(
+      SimpleCompilationReflection(kReflectedComputeShader, EShLangCompute),
+      HasSubstr("\"workgroup_size\": [8, 4, 1]"));
+}
+
+TEST_F(CompilerTest, PreprocessedInputCompiles) {
+  compiler_.SetInputPreprocessed(true);
+  EXPECT_TRUE(SimpleCompilationSucceeds(kVertexShader, EShLangVertex))
+      << errors_;
+}
+
+TEST_F(CompilerTest, PreprocessedInputIgnoresMacroDefinitions) {
+  // The predefined macros are part of the preprocessing that the input has
+  // already been through, so they are not applied again.
+  const std::string kMinimalExpandedShader = "#version 140\nvoid E(){}";
+  compiler_.AddMacroDefinition("E", 1u, "main", 4u);
+  compiler_.SetInputPreprocessed(true);
+  EXPECT_FALSE(
+      SimpleCompilationSucceeds(kMinimalExpandedShader, EShLangVertex));
+}
+
+TEST_F(CompilerTest, PreprocessedInputRejectsIncludes) {
+  const std::string kShaderWithInclude =
+      "#version 450\n"
+      "#extension GL_GOOGLE_include_directive : enable\n"
+      "#include \"a.glsl\"\n"
+      "void main() {}\n";
+  compiler_.SetInputPreprocessed(true);
+  EXPECT_FALSE(SimpleCompilationSucceeds(kShaderWithInclude, EShLangVertex));
+}
+
+TEST_F(CompilerTest, SyntaxOnlyProducesNoOutput) {
+  compiler_.SetSyntaxOnly(Compiler::SyntaxOnlyMode::ParseAndLink);
+  EXPECT_TRUE(SimpleCompilationBinary(kVertexShader, EShLangVertex).empty());
+}
+
+TEST_F(CompilerTest, SyntaxOnlyReportsErrors) {
+  compiler_.SetSyntaxOnly(Compiler::SyntaxOnlyMode::ParseAndLink);
+  EXPECT_FALSE(SimpleCompilationSucceeds(
+      "#version 140\nvoid main() { float a = b; }", EShLangVertex));
+  EXPECT_THAT(errors_, HasSubstr("'b' : undeclared identifier"));
+}
+
+TEST_F(CompilerTest, SyntaxOnlyValidateProducesNoOutput) {
+  compiler_.SetSyntaxOnly(Compiler::SyntaxOnlyMode::Validate);
+  compiler_.SetOptimizationLevel(Compiler::OptimizationLevel::Performance);
+  EXPECT_TRUE(SimpleCompilationBinary(kVertexShader, EShLangVertex).empty());
+}
+
+TEST_F(CompilerTest, SyntaxOnlyValidateAcceptsScalarBlockLayout) {
+  compiler_.SetSyntaxOnly(Compiler::SyntaxOnlyMode::Validate);
+  EXPECT_TRUE(SimpleCompilationSucceeds(kScalarLayoutShader, EShLangCompute))
+      << errors_;
+}
+
+#if SHADERC_ENABLE_HLSL
+TEST_F(CompilerTest, SyntaxOnlyValidateAcceptsHlslOffsets) {
+  compiler_.SetSyntaxOnly(Compiler::SyntaxOnlyMode::Validate);
+  // The vec3 is at offset 4, which only the relaxed block layout allows.
+  compiler_.SetHlslOffsets(true);
+  EXPECT_TRUE(
+      SimpleCompilationSucceeds(kGlslShaderWeirdPacking, EShLangVertex))
+      << errors_;
+}
+#endif
+
+TEST_F(CompilerTest, ValidationPoliciesCompileValidShaders) {
+  for (const auto policy : {Compiler::ValidationPolicy::Never,
+                            Compiler::ValidationPolicy::BeforeOptimization,
+                            Compiler::ValidationPolicy::AfterOptimization,
+                            Compiler::ValidationPolicy::Always}) {
+    compiler_.SetValidationPolicy(policy);
+    compiler_.SetOptimizationLevel(Compiler::OptimizationLevel::Zero);
+    EXPECT_TRUE(SimpleCompilationSucceeds(kVertexShader, EShLangVertex))
+        << errors_;
+    compiler_.SetOptimizationLevel(Compiler::OptimizationLevel::Performance);
+    EXPECT_TRUE(SimpleCompilationSucceeds(kVertexShader, EShLangVertex))
+        << errors_;
+  }
+}
+
+TEST_F(CompilerTest, ValidationPoliciesAcceptScalarBlockLayout) {
+  for (const auto policy : {Compiler::ValidationPolicy::BeforeOptimization,
+                            Compiler::ValidationPolicy::AfterOptimization,
+                            Compiler::ValidationPolicy::Always}) {
+    compiler_.SetValidationPolicy(policy);
+    EXPECT_TRUE(SimpleCompilationSucceeds(kScalarLayoutShader, EShLangCompute))
+        << errors_;
+  }
+}
+
+TEST_F(CompilerTest, ValidationPolicyAppliesToPrograms) {
+  compiler_.SetValidationPolicy(Compiler::ValidationPolicy::Always);
+  std::vector<shaderc_util::ProgramStageOutput> outputs;
+  EXPECT_TRUE(ProgramCompiles({{kProgramVertexShader, EShLangVertex},
+                               {kProgramFragmentShader, EShLangFragment}},
+                              Compiler::OutputType::SpirvBinary, &outputs))
+      << errors_;
+}
+
+TEST_F(CompilerTest, SpecializationConstantsAreFrozenAndFolded) {
+  compiler_.SetOptimizationLevel(Compiler::OptimizationLevel::Zero);
+  EXPECT_THAT(Disassemble(SimpleCompilationBinary(kSpecConstantShader,
+                                                  EShLangCompute)),
+              HasSubstr("OpSpecConstantOp %int IMul"));
+  // Freezing N lets even an unoptimized compilation fold M into a constant.
+  compiler_.SetSpecializationConstant(3, "8");
+  const std::string disassembly = Disassemble(
+      SimpleCompilationBinary(kSpecConstantShader, EShLangCompute));
+  EXPECT_THAT(disassembly, HasSubstr("OpConstant %int 16"));
+  EXPECT_THAT(disassembly, Not(HasSubstr("OpSpecConstant")));
+  EXPECT_THAT(disassembly, Not(HasSubstr("SpecId")));
+}
+
+TEST_F(CompilerTest, SpecializationConstantsOfOtherSpecIdsAreKept) {
+  compiler_.SetSpecializationConstant(4, "8");
+  const std::string disassembly = Disassemble(
+      SimpleCompilationBinary(kSpecConstantShader, EShLangCompute));
+  EXPECT_THAT(disassembly, HasSubstr("OpDecorate %N SpecId 3"));
+  EXPECT_THAT(disassembly, HasSubstr("OpSpecConstant %int 4"));
+}
+
+TEST_F(CompilerTest, InvalidSpecializationConstantValueFailsCompilation) {
+  compiler_.SetSpecializationConstant(3, "true");
+  EXPECT_FALSE(SimpleCompilationSucceeds(kSpecConstantShader, EShLangCompute));
+  EXPECT_THAT(errors_,
+              HasSubstr("shader: error: invalid value 'true' for 32-bit "
+                        "signed integer specialization constant 3"));
+}
+
+TEST_F(CompilerTest, CompileForLinkingExportsFunctions) {
+  compiler_.SetCompileForLinking(true);
+  const std::string disassembly =
+      Disassemble(SimpleCompilationBinary(kLibraryShader, EShLangCompute));
+  EXPECT_THAT(disassembly, HasSubstr("OpCapability Linkage"));
+  EXPECT_THAT(disassembly, HasSubstr("LinkageAttributes"));
+  EXPECT_THAT(disassembly, HasSubstr("Export"));
+}
+
+TEST_F(CompilerTest, LinkLibraryResolvesImportsAndRemovesUnusedFunctions) {
+  compiler_.SetCompileForLinking(true);
+  auto library = std::make_shared<const std::vector<uint32_t>>(
+      SimpleCompilationBinary(kLibraryShader, EShLangCompute));
+  compiler_.SetCompileForLinking(false);
+  compiler_.AddLinkLibrary(library);
+  compiler_.SetValidationPolicy(Compiler::ValidationPolicy::Always);
+  const std::string disassembly =
+      Disassemble(SimpleCompilationBinary(kLibraryUserShader, EShLangCompute));
+  EXPECT_THAT(disassembly, HasSubstr("OpEntryPoint GLCompute"));
+  EXPECT_THAT(disassembly, Not(HasSubstr("Linkage")));
+  EXPECT_THAT(disassembly, Not(HasSubstr("unused_helper")));
+}
+
+TEST_F(CompilerTest, LinkLibraryWithoutAnImportedFunctionFailsCompilation) {
+  compiler_.SetCompileForLinking(true);
+  auto library = std::make_shared<const std::vector<uint32_t>>(
+      SimpleCompilationBinary(kLibraryShader, EShLangCompute));
+  compiler_.SetCompileForLinking(false);
+  compiler_.AddLinkLibrary(library);
+  EXPECT_FALSE(
+      SimpleCompilationSucceeds(kMissingLibraryFunctionShader, EShLangCompute));
+  EXPECT_THAT(errors_,
+              HasSubstr("shader: error: cannot link with the SPIR-V "
+                        "libraries: "));
+}
+
+TEST_F(CompilerTest, ProgramCompilesEachStage) {
+  std::vector<shaderc_util::ProgramStageOutput> outputs;
+  ASSERT_TRUE(ProgramCompiles({{kProgramVertexShader, EShLangVertex},
+                               {kProgramFragmentShader, EShLangFragment}},
+                              Compiler::OutputType::SpirvBinary, &outputs))
+      << errors_;
+  ASSERT_EQ(2u, outputs.size());
+  EXPECT_THAT(Disassemble(outputs[0].output), HasSubstr("OpEntryPoint Vertex"));
+  EXPECT_THAT(Disassemble(outputs[1].output),
+              HasSubstr("OpEntryPoint Fragment"));
+}
+
+TEST_F(CompilerTest, ProgramRemovesVaryingsTheNextStageDoesNotRead) {
+  compiler_.SetValidationPolicy(Compiler::ValidationPolicy::Always);
+  std::vector<shaderc_util::ProgramStageOutput> outputs;
+  // The stages are given out of pipeline order.
+  ASSERT_TRUE(ProgramCompiles({{kProgramFragmentShader, EShLangFragment},
+                               {kProgramVertexShader, EShLangVertex}},
+                              Compiler::OutputType::SpirvAssemblyText,
+                              &outputs))
+      << errors_;
+  ASSERT_EQ(2u, outputs.size());
+  const std::string fragment(reinterpret_cast<const char*>(
+                                 outputs[0].output.data()),
+                             outputs[0].output_size);
+  const std::string vertex(reinterpret_cast<const char*>(
+                               outputs[1].output.data()),
+                           outputs[1].output_size);
+  EXPECT_THAT(vertex, HasSubstr("OpName %color \"color\""));
+  EXPECT_THAT(vertex, HasSubstr("BuiltIn Position"));
+  EXPECT_THAT(vertex, Not(HasSubstr("unused_varying")));
+  EXPECT_THAT(vertex, Not(HasSubstr(" Sin %")));
+  // The input that the fragment shader declares but does not read leaves its
+  // interface along with the output that fed it.
+  const size_t entry_point = fragment.find("OpEntryPoint Fragment");
+  ASSERT_NE(std::string::npos, entry_point);
+  const std::string interface = fragment.substr(
+      entry_point, fragment.find('\n', entry_point) - entry_point);
+  EXPECT_THAT(interface, HasSubstr("%color"));
+  EXPECT_THAT(interface, Not(HasSubstr("%unused_varying")));
+}
+
+TEST_F(CompilerTest, DisassemblyWithoutFriendlyNamesNumbersIds) {
+  compiler_.SetDisassemblyFriendlyNames(false);
+  std::vector<shaderc_util::ProgramStageOutput> outputs;
+  ASSERT_TRUE(ProgramCompiles({{kProgramVertexShader, EShLangVertex},
+                               {kProgramFragmentShader, EShLangFragment}},
+                              Compiler::OutputType::SpirvAssemblyText,
+                              &outputs))
+      << errors_;
+  ASSERT_EQ(2u, outputs.size());
+  const std::string fragment(reinterpret_cast<const char*>(
+                                 outputs[1].output.data()),
+                             outputs[1].output_size);
+  EXPECT_THAT(fragment, HasSubstr("OpEntryPoint Fragment %4 \"main\""));
+  EXPECT_THAT(fragment, Not(HasSubstr("%main")));
+}
+
+TEST_F(CompilerTest, ProgramRejectsTwoShadersForOneStage) {
+  std::vector<shaderc_util::ProgramStageOutput> outputs;
+  EXPECT_FALSE(ProgramCompiles({{kProgramVertexShader, EShLangVertex},
+                                {kProgramVertexShader, EShLangVertex}},
+                               Compiler::OutputType::SpirvBinary, &outputs));
+  EXPECT_THAT(errors_, HasSubstr("more than one shader for the same stage"));
+  EXPECT_TRUE(outputs.empty());
+}
+
+TEST_F(CompilerTest, ProgramReportsErrorsOfEveryStage) {
+  std::vector<shaderc_util::ProgramStageOutput> outputs;
+  EXPECT_FALSE(ProgramCompiles(
+      {{"#version 450\nvoid main() { float a = b; }", EShLangVertex},
+       {"#version 450\nvoid main() { float a = c; }", EShLangFragment}},
+      Compiler::OutputType::SpirvBinary, &outputs));
+  EXPECT_THAT(errors_, HasSubstr("'b' : undeclared identifier"));
+  EXPECT_THAT(errors_, HasSubstr("'c' : undeclared identifier"));
+}
+
+TEST_F(CompilerTest, ProgramReflectionDescribesEachStage) {
+  std::vector<shaderc_util::ProgramStageOutput> outputs;
+  ASSERT_TRUE(ProgramCompiles(
+      {{"#version 450\n"
+        "layout(location=0) in vec3 position;\n"
+        "layout(location=0) out vec4 color;\n"
+        "void main() { color = vec4(position, 1); }",
+        EShLangVertex},
+       {"#version 450\n"
+        "layout(set=1, binding=2) uniform sampler2D tex;\n"
+        "layout(location=0) in vec4 color;\n"
+        "layout(location=0) out vec4 frag_color;\n"
+        "void main() { frag_color = color * texture(tex, vec2(0.5)); }",
+        EShLangFragment}},
+      Compiler::OutputType::SpirvBinary, &outputs, true))
+      << errors_;
+  ASSERT_EQ(2u, outputs.size());
+  EXPECT_THAT(outputs[0].reflection,
+              HasSubstr("\"inputs\": [{\"name\": \"position\""));
+  EXPECT_THAT(outputs[0].reflection,
+              HasSubstr("\"outputs\": [{\"name\": \"color\""));
+  EXPECT_THAT(outputs[0].reflection, Not(HasSubstr("tex")));
+  EXPECT_THAT(outputs[1].reflection,
+              HasSubstr("\"inputs\": [{\"name\": \"color\""));
+  EXPECT_THAT(outputs[1].reflection,
+              HasSubstr("\"outputs\": [{\"name\": \"frag_color\""));
+  EXPECT_THAT(outputs[1].reflection,
+              HasSubstr("\"kind\": \"combined_image_sampler\", "
+                        "\"set\": 1, \"binding\": 2}"));
+}
+
+TEST_F(CompilerTest, CompileForTargetsGeneratesEachSpirvVersion) {
+  shaderc_util::GlslangInitializer initializer;
+  DummyCountingIncluder dummy_includer;
+  const auto outputs = compiler_.CompileForTargets(
+      {{kVertexShader, "shader"}}, EShLangVertex, "shader", "main",
+      dummy_stage_callback_, dummy_includer, Compiler::OutputType::SpirvBinary,
+      {{Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_3,
+        Compiler::SpirvVersion::v1_3, true},
+       {Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0,
+        Compiler::SpirvVersion::v1_0, true}});
+  ASSERT_EQ(2u, outputs.size());
+  ASSERT_TRUE(outputs[0].succeeded) << outputs[0].messages;
+  ASSERT_TRUE(outputs[1].succeeded) << outputs[1].messages;
+  // Word 1 of a module is its SPIR-V version.
+  EXPECT_EQ(0x00010300u, outputs[0].output[1]);
+  EXPECT_EQ(0x00010000u, outputs[1].output[1]);
+  EXPECT_FALSE(outputs[0].frontend_rerun);
+  EXPECT_FALSE(outputs[1].frontend_rerun);
+}
+
+TEST_F(CompilerTest, CompileForTargetsMatchesCompilingEachTarget) {
+  // From SPIR-V 1.4 on, the entry point lists the uniform block too, so the
+  // outputs for SPIR-V 1.0 and 1.6 differ beyond their version.
+  const std::string source =
+      "#version 450\n"
+      "layout(binding = 0) uniform U { vec4 v; };\n"
+      "layout(location = 0) out vec4 color;\n"
+      "void main() { color = v; }";
+  const std::vector<Compiler::Target> targets = {
+      {Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0,
+       Compiler::SpirvVersion::v1_0, true},
+      {Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_3,
+       Compiler::SpirvVersion::v1_6, true}};
+  std::vector<shaderc_util::CompileContext> context_storage(
+      shaderc_util::GetNumWorkers(targets.size()));
+  std::vector<shaderc_util::CompileContext*> contexts;
+  for (auto& context : context_storage) contexts.push_back(&context);
+  std::vector<Compiler::TargetOutput> outputs;
+  {
+    shaderc_util::GlslangInitializer initializer;
+    DummyCountingIncluder dummy_includer;
+    outputs = compiler_.CompileForTargets(
+        {{source, "shader"}}, EShLangVertex, "shader", "main",
+        dummy_stage_callback_, dummy_includer,
+        Compiler::OutputType::SpirvBinary, targets, contexts);
+  }
+  ASSERT_EQ(2u, outputs.size());
+  EXPECT_NE(outputs[0].output, outputs[1].output);
+  for (size_t i = 0; i < targets.size(); ++i) {
+    ASSERT_TRUE(outputs[i].succeeded) << outputs[i].messages;
+    EXPECT_FALSE(outputs[i].frontend_rerun);
+    compiler_.SetTargetEnv(targets[i].env, targets[i].env_version);
+    compiler_.SetTargetSpirv(targets[i].spirv_version);
+    EXPECT_EQ(SimpleCompilationBinary(source, EShLangVertex),
+              outputs[i].output);
+  }
+}
+
+TEST_F(CompilerTest, CompileForTargetsReparsesOtherVersionsAfterAWarning) {
+  shaderc_util::GlslangInitializer initializer;
+  DummyCountingIncluder dummy_includer;
+  const auto outputs = compiler_.CompileForTargets(
+      {{"#version 450\n#extension GL_EXT_no_such_extension : warn\n"
+        "void main() {}",
+        "shader"}},
+      EShLangVertex, "shader", "main", dummy_stage_callback_, dummy_includer,
+      Compiler::OutputType::SpirvBinary,
+      {{Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0,
+        Compiler::SpirvVersion::v1_0, true},
+       {Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0,
+        Compiler::SpirvVersion::v1_0, true},
+       {Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_3,
+        Compiler::SpirvVersion::v1_6, true}});
+  ASSERT_EQ(3u, outputs.size());
+  for (const auto& output : outputs) {
+    EXPECT_TRUE(output.succeeded) << output.messages;
+    EXPECT_THAT(output.messages,
+                HasSubstr("shader:2: warning: '#extension' : extension not "
+                          "supported: GL_EXT_no_such_extension"));
+    EXPECT_EQ(1u, output.num_warnings);
+  }
+  EXPECT_FALSE(outputs[0].frontend_rerun);
+  EXPECT_FALSE(outputs[1].frontend_rerun);
+  EXPECT_TRUE(outputs[2].frontend_rerun);
+}
+
+TEST_F(CompilerTest, CompileForTargetsRerunsTheFrontendForAnotherClient) {
+  shaderc_util::GlslangInitializer initializer;
+  DummyCountingIncluder dummy_includer;
+  const auto outputs = compiler_.CompileForTargets(
+      {{kVertexShader, "shader"}}, EShLangVertex, "shader", "main",
+      dummy_stage_callback_, dummy_includer, Compiler::OutputType::SpirvBinary,
+      {{Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Default,
+        Compiler::SpirvVersion::v1_0, false},
+       {Compiler::TargetEnv::OpenGL, Compiler::TargetEnvVersion::Default,
+        Compiler::SpirvVersion::v1_0, false}});
+  ASSERT_EQ(2u, outputs.size());
+  EXPECT_TRUE(outputs[0].succeeded) << outputs[0].messages;
+  EXPECT_TRUE(outputs[1].succeeded) << outputs[1].messages;
+  EXPECT_FALSE(outputs[0].frontend_rerun);
+  EXPECT_TRUE(outputs[1].frontend_rerun);
+}
+
+TEST_F(CompilerTest, CompileForTargetsReportsErrorsForEveryTarget) {
+  shaderc_util::GlslangInitializer initializer;
+  DummyCountingIncluder dummy_includer;
+  const auto outputs = compiler_.CompileForTargets(
+      {{"#version 450\nvoid main() { float a = b; }", "shader"}},
+      EShLangVertex, "shader", "main", dummy_stage_callback_, dummy_includer,
+      Compiler::OutputType::SpirvBinary,
+      {{Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_1,
+        Compiler::SpirvVersion::v1_3, true},
+       {Compiler::TargetEnv::Vulkan, Compiler::TargetEnvVersion::Vulkan_1_0,
+        Compiler::SpirvVersion::v1_0, true}});
+  ASSERT_EQ(2u, outputs.size());
+  for (const auto& output : outputs) {
+    EXPECT_FALSE(output.succeeded);
+    EXPECT_THAT(output.messages, HasSubstr("'b' : undeclared identifier"));
+    EXPECT_EQ(0u, output.output_size);
+  }
+}
+
 // A convert-string-to-vector test case consists of 1) an input string; 2) an
 // expected vector after the conversion.
 struct ConvertStringToVectorTestCase {
@@ -846,6 +1539,103 @@ TEST_F(CompilerTest, RelaxedVulkanRulesEnabled) {
       << disassembly;
 }
 
+TEST_F(CompilerTest, OptimizationPassesRunInsteadOfTheLevel) {
+  std::string errors;
+  compiler_.SetOptimizationLevel(Compiler::OptimizationLevel::Size);
+  ASSERT_TRUE(compiler_.SetOptimizationPasses({"--eliminate-dead-functions"},
+                                              &errors))
+      << errors;
+  const auto disassembly =
+      Disassemble(SimpleCompilationBinary(kVertexShader, EShLangVertex));
+  EXPECT_THAT(disassembly, HasSubstr("OpName %main"));
+}
+
+TEST_F(CompilerTest, OptimizationPassesWithoutDashesAreAccepted) {
+  std::string errors;
+  ASSERT_TRUE(compiler_.SetOptimizationPasses({"strip-debug"}, &errors))
+      << errors;
+  const auto disassembly =
+      Disassemble(SimpleCompilationBinary(kVertexShader, EShLangVertex));
+  EXPECT_THAT(disassembly, Not(HasSubstr("OpName")));
+}
+
+TEST_F(CompilerTest, OptimizationLevelClearsOptimizationPasses) {
+  std::string errors;
+  ASSERT_TRUE(compiler_.SetOptimizationPasses({"strip-debug"}, &errors));
+  compiler_.SetOptimizationLevel(Compiler::OptimizationLevel::Zero);
+  const auto disassembly =
+      Disassemble(SimpleCompilationBinary(kVertexShader, EShLangVertex));
+  EXPECT_THAT(disassembly, HasSubstr("OpName %main"));
+}
+
+TEST_F(CompilerTest, UnknownOptimizationPassIsRejected) {
+  std::string errors;
+  EXPECT_FALSE(
+      compiler_.SetOptimizationPasses({"strip-debug", "bogus"}, &errors));
+  EXPECT_EQ("unknown optimization pass: 'bogus'", errors);
+  EXPECT_FALSE(compiler_.SetOptimizationPasses({""}, &errors));
+}
+
+TEST_F(CompilerTest, UnknownOptimizationPassFailsCompilation) {
+  std::string errors;
+  EXPECT_FALSE(compiler_.SetOptimizationPasses({"bogus"}, &errors));
+  EXPECT_FALSE(SimpleCompilationSucceeds(kVertexShader, EShLangVertex));
+  EXPECT_EQ("shader: error: unknown optimization pass: 'bogus'\n", errors_);
+  // A later list of passes that SPIRV-Tools knows replaces the error.
+  ASSERT_TRUE(compiler_.SetOptimizationPasses({"strip-debug"}, &errors));
+  EXPECT_TRUE(SimpleCompilationSucceeds(kVertexShader, EShLangVertex))
+      << errors_;
+}
+
+TEST_F(CompilerTest, OptimizationLevelClearsAnUnknownOptimizationPass) {
+  std::string errors;
+  EXPECT_FALSE(compiler_.SetOptimizationPasses({"bogus"}, &errors));
+  compiler_.SetOptimizationLevel(Compiler::OptimizationLevel::Zero);
+  EXPECT_TRUE(SimpleCompilationSucceeds(kVertexShader, EShLangVertex))
+      << errors_;
+}
+
+TEST_F(CompilerTest, EmptyOptimizationPassesClearEarlierOnes) {
+  std::string errors;
+  ASSERT_TRUE(compiler_.SetOptimizationPasses({"strip-debug"}, &errors));
+  ASSERT_TRUE(compiler_.SetOptimizationPasses({}, &errors));
+  const auto disassembly =
+      Disassemble(SimpleCompilationBinary(kVertexShader, EShLangVertex));
+  EXPECT_THAT(disassembly, HasSubstr("OpName %main"));
+}
+
+TEST_F(CompilerTest, OptimizerCacheSkipsTheOptimizerForTheSameSpirv) {
+  shaderc_util::OptimizerCache cache(1 << 20);
+  compiler_.SetOptimizationLevel(Compiler::OptimizationLevel::Performance);
+  compiler_.SetOptimizerCache(&cache);
+  const auto first = SimpleCompilationBinary(kVertexShader, EShLangVertex);
+  EXPECT_EQ(0u, cache.num_hits());
+  EXPECT_EQ(1u, cache.num_entries());
+  // A comment does not change the generated SPIR-V.
+  const auto second = SimpleCompilationBinary(
+      std::string(kVertexShader) + "// variant\n", EShLangVertex);
+  EXPECT_EQ(1u, cache.num_hits());
+  EXPECT_EQ(first, second);
+}
+
+TEST_F(CompilerTest, OptimizerCacheTellsOptimizationLevelsApart) {
+  shaderc_util::OptimizerCache cache(1 << 20);
+  compiler_.SetOptimizerCache(&cache);
+  compiler_.SetOptimizationLevel(Compiler::OptimizationLevel::Performance);
+  SimpleCompilationBinary(kVertexShader, EShLangVertex);
+  compiler_.SetOptimizationLevel(Compiler::OptimizationLevel::Size);
+  SimpleCompilationBinary(kVertexShader, EShLangVertex);
+  EXPECT_EQ(0u, cache.num_hits());
+  EXPECT_EQ(2u, cache.num_entries());
+}
+
+TEST_F(CompilerTest, OptimizerCacheIsNotUsedWithoutOptimization) {
+  shaderc_util::OptimizerCache cache(1 << 20);
+  compiler_.SetOptimizerCache(&cache);
+  SimpleCompilationBinary(kVertexShader, EShLangVertex);
+  EXPECT_EQ(0u, cache.num_hits() + cache.num_misses());
+}
+
 TEST_F(CompilerTest, ClampMapsToFClampByDefault) {
   const auto words =
       SimpleCompilationBinary(kGlslShaderWithClamp, EShLangFragment);
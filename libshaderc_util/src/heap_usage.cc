@@ -0,0 +1,42 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/heap_usage.h"
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__GLIBC__) || defined(__ANDROID__)
+#include <malloc.h>
+#endif
+
+namespace shaderc_util {
+
+size_t HeapBytesInUse() {
+#if defined(__APPLE__)
+  malloc_statistics_t statistics;
+  malloc_zone_statistics(nullptr, &statistics);
+  return statistics.size_in_use;
+#elif defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  const struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#elif defined(__GLIBC__) || defined(__ANDROID__)
+  const struct mallinfo info = mallinfo();
+  return static_cast<size_t>(info.uordblks) + static_cast<size_t>(info.hblkhd);
+#else
+  return 0;
+#endif
+}
+
+}  // namespace shaderc_util
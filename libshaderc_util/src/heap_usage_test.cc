@@ -0,0 +1,37 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/heap_usage.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace {
+
+using shaderc_util::HeapBytesInUse;
+
+TEST(HeapBytesInUse, FollowsAllocations) {
+  const size_t before = HeapBytesInUse();
+  if (before == 0) GTEST_SKIP() << "heap usage is not known here";
+  const size_t kSize = 4 << 20;
+  std::unique_ptr<char[]> block(new char[kSize]);
+  block[0] = 1;
+  const size_t during = HeapBytesInUse();
+  EXPECT_GE(during, before + kSize);
+  block.reset();
+  EXPECT_LT(HeapBytesInUse(), during);
+}
+
+}  // anonymous namespace
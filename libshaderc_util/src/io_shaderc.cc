@@ -19,16 +19,29 @@
 #if _WIN32
 // Need _fileno from stdio.h
 // Need _O_BINARY and _O_TEXT from fcntl.h
+// Need _getpid from process.h
+// Need MoveFileExA from windows.h
 #include <fcntl.h>
+#include <process.h>
 #include <stdio.h>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+// Need getpid from unistd.h
+#include <unistd.h>
 #endif
 
 #include <errno.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 namespace {
 
@@ -45,6 +58,29 @@ void OutputFileErrorMessage(int errno_value) {
 #endif
 }
 
+// Returns a file name, next to file_name, that is not used by another
+// thread or process writing the same file.
+std::string GetTemporaryFileName(const std::string& file_name) {
+  static std::atomic_uint counter(0);
+#if _WIN32
+  const int pid = _getpid();
+#else
+  const int pid = getpid();
+#endif
+  std::ostringstream name;
+  name << file_name << ".tmp" << pid << "-" << counter++;
+  return name.str();
+}
+
+// Replaces the file at to with the file at from.  Returns true on success.
+bool ReplaceFile(const std::string& from, const std::string& to) {
+#if _WIN32
+  return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
 }  // anonymous namespace
 
 namespace shaderc_util {
@@ -129,6 +165,53 @@ bool WriteFile(std::ostream* stream, const string_piece& output_data) {
   return true;
 }
 
+bool FileContentsEqual(const std::string& file_name,
+                       const string_piece& data) {
+  std::ifstream file(file_name, std::ios_base::binary | std::ios_base::ate);
+  if (!file) return false;
+  if (static_cast<std::streamoff>(file.tellg()) !=
+      static_cast<std::streamoff>(data.size())) {
+    return false;
+  }
+  file.seekg(0);
+  char buffer[16384];
+  size_t offset = 0;
+  while (offset < data.size()) {
+    const size_t chunk_size = std::min(sizeof(buffer), data.size() - offset);
+    if (!file.read(buffer, chunk_size) ||
+        std::memcmp(buffer, data.data() + offset, chunk_size) != 0) {
+      return false;
+    }
+    offset += chunk_size;
+  }
+  return true;
+}
+
+bool WriteFileIfChanged(const std::string& file_name, const string_piece& data,
+                        std::ostream* err) {
+  if (FileContentsEqual(file_name, data)) return true;
+
+  const std::string temporary_file_name = GetTemporaryFileName(file_name);
+  {
+    std::ofstream file;
+    std::ostream* stream = GetOutputStream(temporary_file_name, &file, err);
+    if (!stream) return false;
+    if (!WriteFile(stream, data) || (file.close(), file.fail())) {
+      *err << "glslc: error: error writing to output file: '"
+           << temporary_file_name << "'" << std::endl;
+      std::remove(temporary_file_name.c_str());
+      return false;
+    }
+  }
+  if (!ReplaceFile(temporary_file_name, file_name)) {
+    *err << "glslc: error: cannot replace output file: '" << file_name
+         << "'" << std::endl;
+    std::remove(temporary_file_name.c_str());
+    return false;
+  }
+  return true;
+}
+
 void FlushAndSetBinaryModeOnStdout() {
   std::fflush(stdout);
 #if _WIN32
@@ -16,15 +16,21 @@
 
 #include <gmock/gmock.h>
 
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
 #include <fstream>
+#include <sstream>
 
 namespace {
 
+using shaderc_util::FileContentsEqual;
 using shaderc_util::GetBaseFileName;
 using shaderc_util::GetOutputStream;
 using shaderc_util::IsAbsolutePath;
 using shaderc_util::ReadFile;
 using shaderc_util::WriteFile;
+using shaderc_util::WriteFileIfChanged;
 using testing::Eq;
 using testing::HasSubstr;
 
@@ -129,6 +135,53 @@ TEST(WriteFileTest, Roundtrip) {
   EXPECT_EQ(content, ToString(read_data));
 }
 
+TEST(FileContentsEqualTest, ComparesSizeAndContents) {
+  const std::string filename = "FileContentsEqualTestOutput.tmp";
+  std::ofstream(filename, std::ios_base::binary) << "abc";
+  EXPECT_TRUE(FileContentsEqual(filename, "abc"));
+  EXPECT_FALSE(FileContentsEqual(filename, "abd"));
+  EXPECT_FALSE(FileContentsEqual(filename, "abcd"));
+  EXPECT_FALSE(FileContentsEqual(filename, ""));
+  EXPECT_FALSE(FileContentsEqual("/this/file/should/not/exist/asdf", ""));
+}
+
+TEST(WriteFileIfChangedTest, WritesNewAndChangedFiles) {
+  const std::string filename = "WriteFileIfChangedTestOutput.tmp";
+  std::remove(filename.c_str());
+  std::ostringstream err;
+  ASSERT_TRUE(WriteFileIfChanged(filename, "first", &err));
+  std::vector<char> read_data;
+  ASSERT_TRUE(ReadFile(filename, &read_data));
+  EXPECT_EQ("first", ToString(read_data));
+
+  ASSERT_TRUE(WriteFileIfChanged(filename, "second version", &err));
+  ASSERT_TRUE(ReadFile(filename, &read_data));
+  EXPECT_EQ("second version", ToString(read_data));
+  EXPECT_THAT(err.str(), Eq(""));
+}
+
+TEST(WriteFileIfChangedTest, LeavesIdenticalFileUntouched) {
+  const std::string filename = "WriteFileIfChangedTestUntouched.tmp";
+  std::ostringstream err;
+  ASSERT_TRUE(WriteFileIfChanged(filename, "same", &err));
+  // Backdate the file so that any rewrite would be visible in its timestamp.
+  const auto old_time =
+      std::filesystem::last_write_time(filename) - std::chrono::hours(1);
+  std::filesystem::last_write_time(filename, old_time);
+  ASSERT_TRUE(WriteFileIfChanged(filename, "same", &err));
+  EXPECT_TRUE(std::filesystem::last_write_time(filename) == old_time);
+  ASSERT_TRUE(WriteFileIfChanged(filename, "different", &err));
+  EXPECT_FALSE(std::filesystem::last_write_time(filename) == old_time);
+  EXPECT_THAT(err.str(), Eq(""));
+}
+
+TEST(WriteFileIfChangedTest, UnwritableFile) {
+  std::ostringstream err;
+  EXPECT_FALSE(WriteFileIfChanged(
+      "/this/should/not/be/writable/asdfasdfasdfasdf", "data", &err));
+  EXPECT_THAT(err.str(), HasSubstr("cannot open output file"));
+}
+
 TEST(OutputStreamTest, Stdout) {
   std::ofstream fstream;
   std::ostringstream err;
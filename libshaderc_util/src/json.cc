@@ -0,0 +1,355 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/json.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+
+namespace shaderc_util {
+
+std::string EscapeJsonString(const string_piece& str) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '\b':
+        escaped += "\\b";
+        break;
+      case '\f':
+        escaped += "\\f";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      case '\r':
+        escaped += "\\r";
+        break;
+      case '\t':
+        escaped += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          escaped += "\\u00";
+          escaped += kHexDigits[(c >> 4) & 0xf];
+          escaped += kHexDigits[c & 0xf];
+        } else {
+          escaped += c;
+        }
+        break;
+    }
+  }
+  return escaped;
+}
+
+void WriteJsonString(std::ostream* out, const string_piece& str) {
+  *out << '"' << EscapeJsonString(str) << '"';
+}
+
+const JsonValue* JsonValue::Find(const string_piece& name) const {
+  for (const auto& member : members_) {
+    if (name == member.first) return &member.second;
+  }
+  return nullptr;
+}
+
+// A recursive descent parser for the JSON grammar of RFC 8259.
+class JsonParser {
+ public:
+  explicit JsonParser(const string_piece& text)
+      : text_(text), pos_(0), depth_(0) {}
+
+  bool Parse(JsonValue* value, std::string* error_message) {
+    SkipWhitespace();
+    if (ParseValue(value)) {
+      SkipWhitespace();
+      if (pos_ == text_.size()) return true;
+      Fail("unexpected text after the JSON value");
+    }
+    *error_message = error_;
+    return false;
+  }
+
+ private:
+  // Deeper nesting is rejected rather than risking stack exhaustion.
+  static const size_t kMaxDepth = 512;
+
+  bool ParseValue(JsonValue* value) {
+    if (pos_ >= text_.size()) return Fail("unexpected end of input");
+    switch (text_[pos_]) {
+      case '{':
+        return ParseObject(value);
+      case '[':
+        return ParseArray(value);
+      case '"':
+        value->type_ = JsonValue::Type::String;
+        return ParseString(&value->string_value_);
+      case 't':
+        value->type_ = JsonValue::Type::Bool;
+        value->bool_value_ = true;
+        return ConsumeKeyword("true");
+      case 'f':
+        value->type_ = JsonValue::Type::Bool;
+        value->bool_value_ = false;
+        return ConsumeKeyword("false");
+      case 'n':
+        value->type_ = JsonValue::Type::Null;
+        return ConsumeKeyword("null");
+      default:
+        return ParseNumber(value);
+    }
+  }
+
+  bool ParseObject(JsonValue* value) {
+    if (++depth_ > kMaxDepth) return Fail("nesting is too deep");
+    value->type_ = JsonValue::Type::Object;
+    ++pos_;  // '{'
+    SkipWhitespace();
+    if (Consume('}')) {
+      --depth_;
+      return true;
+    }
+    do {
+      SkipWhitespace();
+      if (pos_ >= text_.size() || text_[pos_] != '"') {
+        return Fail("expected a string for the member name");
+      }
+      std::string name;
+      if (!ParseString(&name)) return false;
+      SkipWhitespace();
+      if (!Consume(':')) return Fail("expected ':' after the member name");
+      SkipWhitespace();
+      value->members_.emplace_back(std::move(name), JsonValue());
+      if (!ParseValue(&value->members_.back().second)) return false;
+      SkipWhitespace();
+    } while (Consume(','));
+    if (!Consume('}')) return Fail("expected ',' or '}' in object");
+    --depth_;
+    return true;
+  }
+
+  bool ParseArray(JsonValue* value) {
+    if (++depth_ > kMaxDepth) return Fail("nesting is too deep");
+    value->type_ = JsonValue::Type::Array;
+    ++pos_;  // '['
+    SkipWhitespace();
+    if (Consume(']')) {
+      --depth_;
+      return true;
+    }
+    do {
+      SkipWhitespace();
+      value->elements_.emplace_back();
+      if (!ParseValue(&value->elements_.back())) return false;
+      SkipWhitespace();
+    } while (Consume(','));
+    if (!Consume(']')) return Fail("expected ',' or ']' in array");
+    --depth_;
+    return true;
+  }
+
+  bool ParseString(std::string* str) {
+    ++pos_;  // '"'
+    while (pos_ < text_.size()) {
+      const char c = text_[pos_++];
+      if (c == '"') return true;
+      if (static_cast<unsigned char>(c) < 0x20) {
+        --pos_;
+        return Fail("control character in string");
+      }
+      if (c != '\\') {
+        *str += c;
+        continue;
+      }
+      if (pos_ >= text_.size()) break;
+      switch (text_[pos_++]) {
+        case '"':
+          *str += '"';
+          break;
+        case '\\':
+          *str += '\\';
+          break;
+        case '/':
+          *str += '/';
+          break;
+        case 'b':
+          *str += '\b';
+          break;
+        case 'f':
+          *str += '\f';
+          break;
+        case 'n':
+          *str += '\n';
+          break;
+        case 'r':
+          *str += '\r';
+          break;
+        case 't':
+          *str += '\t';
+          break;
+        case 'u': {
+          uint32_t code_point = 0;
+          if (!ParseHex4(&code_point)) return false;
+          if (code_point >= 0xd800 && code_point < 0xdc00) {
+            // A high surrogate must be followed by an escaped low surrogate.
+            uint32_t low = 0;
+            if (!Consume('\\') || !Consume('u') || !ParseHex4(&low) ||
+                low < 0xdc00 || low >= 0xe000) {
+              return Fail("invalid surrogate pair");
+            }
+            code_point = 0x10000 + ((code_point - 0xd800) << 10) +
+                         (low - 0xdc00);
+          }
+          AppendUtf8(code_point, str);
+          break;
+        }
+        default:
+          --pos_;
+          return Fail("invalid escape sequence");
+      }
+    }
+    return Fail("unterminated string");
+  }
+
+  bool ParseHex4(uint32_t* value) {
+    if (text_.size() - pos_ < 4) return Fail("invalid \\u escape");
+    *value = 0;
+    for (int i = 0; i < 4; ++i) {
+      const char c = text_[pos_++];
+      *value <<= 4;
+      if (c >= '0' && c <= '9') {
+        *value |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        *value |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        *value |= c - 'A' + 10;
+      } else {
+        --pos_;
+        return Fail("invalid \\u escape");
+      }
+    }
+    return true;
+  }
+
+  static void AppendUtf8(uint32_t code_point, std::string* str) {
+    if (code_point < 0x80) {
+      *str += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+      *str += static_cast<char>(0xc0 | (code_point >> 6));
+      *str += static_cast<char>(0x80 | (code_point & 0x3f));
+    } else if (code_point < 0x10000) {
+      *str += static_cast<char>(0xe0 | (code_point >> 12));
+      *str += static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+      *str += static_cast<char>(0x80 | (code_point & 0x3f));
+    } else {
+      *str += static_cast<char>(0xf0 | (code_point >> 18));
+      *str += static_cast<char>(0x80 | ((code_point >> 12) & 0x3f));
+      *str += static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+      *str += static_cast<char>(0x80 | (code_point & 0x3f));
+    }
+  }
+
+  bool ParseNumber(JsonValue* value) {
+    const size_t start = pos_;
+    Consume('-');
+    if (Consume('0')) {
+      // No leading zeros.
+    } else if (!ConsumeDigits()) {
+      pos_ = start;
+      return Fail("unexpected character");
+    }
+    if (Consume('.') && !ConsumeDigits()) {
+      return Fail("expected digits after '.'");
+    }
+    if (Consume('e') || Consume('E')) {
+      if (!Consume('+')) Consume('-');
+      if (!ConsumeDigits()) return Fail("expected digits in exponent");
+    }
+    value->type_ = JsonValue::Type::Number;
+    value->number_value_ =
+        std::strtod(text_.substr(start, pos_ - start).str().c_str(), nullptr);
+    return true;
+  }
+
+  bool ConsumeDigits() {
+    const size_t start = pos_;
+    while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+      ++pos_;
+    }
+    return pos_ != start;
+  }
+
+  bool ConsumeKeyword(const string_piece& keyword) {
+    if (text_.substr(pos_).starts_with(keyword)) {
+      pos_ += keyword.size();
+      return true;
+    }
+    return Fail("unexpected character");
+  }
+
+  bool Consume(char c) {
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  void SkipWhitespace() {
+    while (pos_ < text_.size() &&
+           (text_[pos_] == ' ' || text_[pos_] == '\t' ||
+            text_[pos_] == '\n' || text_[pos_] == '\r')) {
+      ++pos_;
+    }
+  }
+
+  // Records an error at the current position.  Always returns false.
+  bool Fail(const char* reason) {
+    size_t line = 1;
+    size_t column = 1;
+    for (size_t i = 0; i < pos_ && i < text_.size(); ++i) {
+      if (text_[i] == '\n') {
+        ++line;
+        column = 1;
+      } else {
+        ++column;
+      }
+    }
+    std::ostringstream message;
+    message << line << ":" << column << ": " << reason;
+    error_ = message.str();
+    return false;
+  }
+
+  const string_piece text_;
+  size_t pos_;
+  size_t depth_;
+  std::string error_;
+};
+
+bool ParseJson(const string_piece& text, JsonValue* value,
+               std::string* error_message) {
+  *value = JsonValue();
+  return JsonParser(text).Parse(value, error_message);
+}
+
+}  // namespace shaderc_util
@@ -0,0 +1,137 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/json.h"
+
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+using shaderc_util::EscapeJsonString;
+using shaderc_util::JsonValue;
+using shaderc_util::ParseJson;
+using shaderc_util::WriteJsonString;
+using testing::HasSubstr;
+
+TEST(EscapeJsonString, PlainTextIsUnchanged) {
+  EXPECT_EQ("", EscapeJsonString(""));
+  EXPECT_EQ("shader.vert", EscapeJsonString("shader.vert"));
+  EXPECT_EQ("dir/sub dir/a.glsl", EscapeJsonString("dir/sub dir/a.glsl"));
+}
+
+TEST(EscapeJsonString, QuotesAndBackslashes) {
+  EXPECT_EQ("\\\"quoted\\\"", EscapeJsonString("\"quoted\""));
+  EXPECT_EQ("C:\\\\shaders\\\\a.frag", EscapeJsonString("C:\\shaders\\a.frag"));
+}
+
+TEST(EscapeJsonString, ControlCharacters) {
+  EXPECT_EQ("a\\nb\\tc\\r", EscapeJsonString("a\nb\tc\r"));
+  EXPECT_EQ("\\b\\f", EscapeJsonString("\b\f"));
+  EXPECT_EQ("\\u0001\\u001f", EscapeJsonString(std::string("\x01\x1f")));
+  EXPECT_EQ("\\u0000", EscapeJsonString(std::string(1, '\0')));
+}
+
+TEST(EscapeJsonString, NonAsciiBytesPassThrough) {
+  EXPECT_EQ("caf\xc3\xa9", EscapeJsonString("caf\xc3\xa9"));
+}
+
+TEST(WriteJsonString, AddsQuotes) {
+  std::ostringstream out;
+  WriteJsonString(&out, "a\"b");
+  EXPECT_EQ("\"a\\\"b\"", out.str());
+}
+
+TEST(ParseJson, Scalars) {
+  JsonValue value;
+  std::string error;
+  ASSERT_TRUE(ParseJson("null", &value, &error));
+  EXPECT_TRUE(value.is_null());
+  ASSERT_TRUE(ParseJson(" true ", &value, &error));
+  EXPECT_TRUE(value.is_bool());
+  EXPECT_TRUE(value.bool_value());
+  ASSERT_TRUE(ParseJson("false", &value, &error));
+  EXPECT_FALSE(value.bool_value());
+  ASSERT_TRUE(ParseJson("-12.5e1", &value, &error));
+  EXPECT_TRUE(value.is_number());
+  EXPECT_EQ(-125.0, value.number_value());
+  ASSERT_TRUE(ParseJson("0", &value, &error));
+  EXPECT_EQ(0.0, value.number_value());
+}
+
+TEST(ParseJson, StringEscapes) {
+  JsonValue value;
+  std::string error;
+  ASSERT_TRUE(ParseJson("\"a\\\"b\\\\c\\/\\n\"", &value, &error));
+  EXPECT_TRUE(value.is_string());
+  EXPECT_EQ("a\"b\\c/\n", value.string_value());
+  ASSERT_TRUE(ParseJson("\"\\u00e9\\ud83d\\ude00\"", &value, &error));
+  EXPECT_EQ("\xc3\xa9\xf0\x9f\x98\x80", value.string_value());
+}
+
+TEST(ParseJson, EscapedStringRoundTrips) {
+  const std::string original("tab\tquote\"\x01end");
+  JsonValue value;
+  std::string error;
+  ASSERT_TRUE(ParseJson("\"" + EscapeJsonString(original) + "\"", &value,
+                        &error));
+  EXPECT_EQ(original, value.string_value());
+}
+
+TEST(ParseJson, ArraysAndObjects) {
+  JsonValue value;
+  std::string error;
+  ASSERT_TRUE(ParseJson(
+      "{\"jobs\": [1, \"two\", {}], \"b\": [], \"jobs\": null}", &value,
+      &error));
+  ASSERT_TRUE(value.is_object());
+  ASSERT_EQ(3u, value.members().size());
+  EXPECT_EQ("jobs", value.members()[0].first);
+  EXPECT_EQ("b", value.members()[1].first);
+
+  const JsonValue* jobs = value.Find("jobs");
+  ASSERT_NE(nullptr, jobs);
+  ASSERT_TRUE(jobs->is_array());
+  ASSERT_EQ(3u, jobs->elements().size());
+  EXPECT_EQ(1.0, jobs->elements()[0].number_value());
+  EXPECT_EQ("two", jobs->elements()[1].string_value());
+  EXPECT_TRUE(jobs->elements()[2].is_object());
+  EXPECT_TRUE(value.Find("b")->elements().empty());
+  EXPECT_EQ(nullptr, value.Find("missing"));
+  EXPECT_EQ(nullptr, jobs->Find("jobs"));
+}
+
+TEST(ParseJson, ErrorsReportPosition) {
+  JsonValue value;
+  std::string error;
+  EXPECT_FALSE(ParseJson("{\n  \"a\": [1,]\n}", &value, &error));
+  EXPECT_EQ("2:11: unexpected character", error);
+  EXPECT_FALSE(ParseJson("", &value, &error));
+  EXPECT_THAT(error, HasSubstr("unexpected end of input"));
+  EXPECT_FALSE(ParseJson("[1] 2", &value, &error));
+  EXPECT_THAT(error, HasSubstr("unexpected text after the JSON value"));
+  EXPECT_FALSE(ParseJson("\"abc", &value, &error));
+  EXPECT_THAT(error, HasSubstr("unterminated string"));
+  EXPECT_FALSE(ParseJson("{\"a\" 1}", &value, &error));
+  EXPECT_THAT(error, HasSubstr("expected ':'"));
+  EXPECT_FALSE(ParseJson("01", &value, &error));
+  EXPECT_FALSE(ParseJson("\"\\x\"", &value, &error));
+  EXPECT_THAT(error, HasSubstr("invalid escape sequence"));
+  EXPECT_FALSE(ParseJson(std::string(1000, '['), &value, &error));
+  EXPECT_THAT(error, HasSubstr("nesting is too deep"));
+}
+
+}  // anonymous namespace
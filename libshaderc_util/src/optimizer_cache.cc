@@ -0,0 +1,126 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/optimizer_cache.h"
+
+namespace shaderc_util {
+
+namespace {
+
+const uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ull;
+const uint64_t kFnvPrime = 0x100000001b3ull;
+
+// Continues the 64-bit FNV-1a hash hash over size bytes at data.
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+// Returns the key of an entry for the given configuration and input.
+uint64_t EntryKey(const std::string& config,
+                  const std::vector<uint32_t>& input) {
+  const uint64_t size = config.size();
+  uint64_t hash = HashBytes(kFnvOffsetBasis, &size, sizeof(size));
+  hash = HashBytes(hash, config.data(), config.size());
+  return HashBytes(hash, input.data(), input.size() * sizeof(uint32_t));
+}
+
+}  // anonymous namespace
+
+bool OptimizerCache::Lookup(const std::string& config,
+                            const std::vector<uint32_t>& input,
+                            std::vector<uint32_t>* output) {
+  const uint64_t key = EntryKey(config, input);
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto found = index_.find(key);
+  if (found == index_.end() || found->second->config != config ||
+      found->second->input != input) {
+    ++num_misses_;
+    return false;
+  }
+  ++num_hits_;
+  entries_.splice(entries_.begin(), entries_, found->second);
+  *output = found->second->output;
+  return true;
+}
+
+void OptimizerCache::Insert(const std::string& config,
+                            const std::vector<uint32_t>& input,
+                            const std::vector<uint32_t>& output) {
+  Entry entry{EntryKey(config, input), config, input, output};
+  const size_t entry_bytes = EntryBytes(entry);
+  if (entry_bytes > capacity_bytes_) return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // An entry with the same key is replaced, whether it is the same entry
+  // inserted by a concurrent compilation or one whose key collides.
+  const auto found = index_.find(entry.key);
+  if (found != index_.end()) {
+    size_bytes_ -= EntryBytes(*found->second);
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+  Evict(entry_bytes);
+  const uint64_t key = entry.key;
+  entries_.push_front(std::move(entry));
+  index_[key] = entries_.begin();
+  size_bytes_ += entry_bytes;
+}
+
+void OptimizerCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  size_bytes_ = 0;
+}
+
+size_t OptimizerCache::size_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_bytes_;
+}
+
+size_t OptimizerCache::num_entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+size_t OptimizerCache::num_hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_hits_;
+}
+
+size_t OptimizerCache::num_misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_misses_;
+}
+
+size_t OptimizerCache::EntryBytes(const Entry& entry) {
+  return entry.config.size() +
+         (entry.input.size() + entry.output.size()) * sizeof(uint32_t);
+}
+
+void OptimizerCache::Evict(size_t reserve) {
+  while (!entries_.empty() && size_bytes_ + reserve > capacity_bytes_) {
+    const Entry& oldest = entries_.back();
+    size_bytes_ -= EntryBytes(oldest);
+    index_.erase(oldest.key);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace shaderc_util
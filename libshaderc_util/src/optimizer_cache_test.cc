@@ -0,0 +1,103 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/optimizer_cache.h"
+
+#include <gmock/gmock.h>
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+using shaderc_util::OptimizerCache;
+
+const std::vector<uint32_t> kInput = {0x07230203, 0x00010000, 1, 2, 3};
+const std::vector<uint32_t> kOutput = {0x07230203, 0x00010000, 1};
+
+TEST(OptimizerCache, FindsWhatWasInserted) {
+  OptimizerCache cache(1 << 20);
+  std::vector<uint32_t> output;
+  EXPECT_FALSE(cache.Lookup("-O", kInput, &output));
+  cache.Insert("-O", kInput, kOutput);
+  ASSERT_TRUE(cache.Lookup("-O", kInput, &output));
+  EXPECT_EQ(kOutput, output);
+  EXPECT_EQ(1u, cache.num_hits());
+  EXPECT_EQ(1u, cache.num_misses());
+  EXPECT_EQ(1u, cache.num_entries());
+}
+
+TEST(OptimizerCache, MissesForAnotherConfigOrInput) {
+  OptimizerCache cache(1 << 20);
+  cache.Insert("-O", kInput, kOutput);
+  std::vector<uint32_t> output;
+  EXPECT_FALSE(cache.Lookup("-Os", kInput, &output));
+  std::vector<uint32_t> other_input = kInput;
+  other_input.back() = 4;
+  EXPECT_FALSE(cache.Lookup("-O", other_input, &output));
+  EXPECT_TRUE(output.empty());
+}
+
+TEST(OptimizerCache, DropsLeastRecentlyUsedEntries) {
+  // Each entry takes 2 bytes of config and 8 words of modules.
+  OptimizerCache cache(2 * (2 + 8 * 4));
+  std::vector<uint32_t> output;
+  cache.Insert("-A", kInput, kOutput);
+  cache.Insert("-B", kInput, kOutput);
+  ASSERT_TRUE(cache.Lookup("-A", kInput, &output));
+  cache.Insert("-C", kInput, kOutput);
+  EXPECT_EQ(2u, cache.num_entries());
+  EXPECT_TRUE(cache.Lookup("-A", kInput, &output));
+  EXPECT_FALSE(cache.Lookup("-B", kInput, &output));
+  EXPECT_TRUE(cache.Lookup("-C", kInput, &output));
+  EXPECT_EQ(2 * (2 + 8 * 4u), cache.size_bytes());
+}
+
+TEST(OptimizerCache, DoesNotKeepEntriesLargerThanTheCapacity) {
+  OptimizerCache cache(16);
+  cache.Insert("-O", kInput, kOutput);
+  EXPECT_EQ(0u, cache.num_entries());
+  EXPECT_EQ(0u, cache.size_bytes());
+}
+
+TEST(OptimizerCache, ClearDropsAllEntries) {
+  OptimizerCache cache(1 << 20);
+  cache.Insert("-O", kInput, kOutput);
+  cache.Clear();
+  std::vector<uint32_t> output;
+  EXPECT_FALSE(cache.Lookup("-O", kInput, &output));
+  EXPECT_EQ(0u, cache.size_bytes());
+}
+
+TEST(OptimizerCache, CanBeSharedByThreads) {
+  OptimizerCache cache(1 << 20);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&cache]() {
+      for (int j = 0; j < 100; ++j) {
+        std::vector<uint32_t> output;
+        if (!cache.Lookup("-O", kInput, &output)) {
+          cache.Insert("-O", kInput, kOutput);
+        } else {
+          EXPECT_EQ(kOutput, output);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(400u, cache.num_hits() + cache.num_misses());
+  EXPECT_EQ(1u, cache.num_entries());
+}
+
+}  // anonymous namespace
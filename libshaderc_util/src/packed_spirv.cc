@@ -0,0 +1,284 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/packed_spirv.h"
+
+#define SPV_ENABLE_UTILITY_CODE
+#include "spirv/unified1/spirv.hpp"
+
+namespace {
+
+using shaderc_util::kPackedHasResult;
+using shaderc_util::kPackedHasResultType;
+using shaderc_util::kPackedIdOperands;
+
+// The number of words in a SPIR-V header.
+const size_t kSpirvHeaderWords = 5;
+// The number of bytes of the magic of packed SPIR-V.
+const size_t kMagicBytes = 4;
+// The number of bits of the instruction info varint that hold flags.
+const uint32_t kFlagBits = 3;
+
+// Returns a signed 32-bit delta, given as its two's complement, in a form in
+// which small magnitudes are small numbers.
+uint32_t Zigzag(uint32_t delta) { return (delta << 1) ^ (0u - (delta >> 31)); }
+
+uint32_t Unzigzag(uint32_t value) { return (value >> 1) ^ (0u - (value & 1)); }
+
+// Returns the number of words before the remaining operands of an
+// instruction with the given flags.
+size_t ModelledWords(uint32_t flags) {
+  return 1 + ((flags & kPackedHasResultType) ? 1 : 0) +
+         ((flags & kPackedHasResult) ? 1 : 0);
+}
+
+void AppendVarint(uint32_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Reads a varint at *p, which must be before end, and advances *p past it.
+// Returns false if the data ends first or the varint does not fit 32 bits.
+inline bool ReadVarint(const unsigned char** p, const unsigned char* end,
+                       uint32_t* value) {
+  const unsigned char* q = *p;
+  uint32_t result = 0;
+  for (uint32_t shift = 0; q != end; shift += 7) {
+    const uint32_t byte = *q++;
+    if (shift == 28 && byte > 0x0f) return false;
+    result |= (byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      *p = q;
+      *value = result;
+      return true;
+    }
+    if (shift == 28) return false;
+  }
+  return false;
+}
+
+// Returns true if all operands after the result id of instructions with the
+// given opcode are usually ids.  Operands of such instructions are packed as
+// deltas from the result id, which only pays off if they refer to ids.
+bool HasIdOperands(spv::Op opcode) {
+  if (opcode >= spv::OpConvertFToU && opcode <= spv::OpBitcast) return true;
+  if (opcode >= spv::OpSNegate && opcode <= spv::OpDot) return true;
+  if (opcode >= spv::OpAny && opcode <= spv::OpFUnordGreaterThanEqual) {
+    return true;
+  }
+  if (opcode >= spv::OpShiftRightLogical && opcode <= spv::OpNot) return true;
+  switch (opcode) {
+    case spv::OpFunctionCall:
+    case spv::OpLoad:
+    case spv::OpStore:
+    case spv::OpAccessChain:
+    case spv::OpInBoundsAccessChain:
+    case spv::OpPtrAccessChain:
+    case spv::OpCompositeConstruct:
+    case spv::OpCopyObject:
+    case spv::OpSampledImage:
+    case spv::OpPhi:
+    case spv::OpBranch:
+    case spv::OpBranchConditional:
+    case spv::OpReturnValue:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // anonymous namespace
+
+namespace shaderc_util {
+
+bool IsPackedSpirv(const string_piece& data) {
+  if (data.size() < kMagicBytes) return false;
+  const unsigned char* b = reinterpret_cast<const unsigned char*>(data.data());
+  const uint32_t magic = uint32_t(b[0]) | (uint32_t(b[1]) << 8) |
+                         (uint32_t(b[2]) << 16) | (uint32_t(b[3]) << 24);
+  return magic == kPackedSpirvMagic;
+}
+
+bool PackSpirv(const uint32_t* words, size_t num_words, std::string* packed,
+               std::string* error) {
+  if (num_words < kSpirvHeaderWords || words[0] != spv::MagicNumber) {
+    *error = "not a SPIR-V module";
+    return false;
+  }
+  if (num_words > UINT32_MAX) {
+    *error = "SPIR-V module is too large";
+    return false;
+  }
+  // Most instructions pack into a third of their size or less.
+  packed->reserve(packed->size() + num_words * 2);
+  for (uint32_t shift = 0; shift < 32; shift += 8) {
+    packed->push_back(static_cast<char>((kPackedSpirvMagic >> shift) & 0xff));
+  }
+  AppendVarint(kPackedSpirvVersion, packed);
+  AppendVarint(static_cast<uint32_t>(num_words), packed);
+  for (size_t i = 1; i < kSpirvHeaderWords; ++i) AppendVarint(words[i], packed);
+
+  uint32_t last_result_type = 0;
+  uint32_t last_result = 0;
+  for (size_t i = kSpirvHeaderWords; i < num_words;) {
+    const uint32_t opcode = words[i] & 0xffff;
+    const size_t word_count = words[i] >> 16;
+    if (word_count == 0 || word_count > num_words - i) {
+      *error = "instruction at word " + std::to_string(i) +
+               " has an invalid word count";
+      return false;
+    }
+    const uint32_t* operand = words + i + 1;
+    const uint32_t* const end = words + i + word_count;
+
+    bool has_result = false;
+    bool has_result_type = false;
+    spv::HasResultAndType(static_cast<spv::Op>(opcode), &has_result,
+                          &has_result_type);
+    uint32_t flags = 0;
+    if (size_t(has_result_type) + has_result < word_count) {
+      if (has_result_type) flags |= kPackedHasResultType;
+      if (has_result) flags |= kPackedHasResult;
+      if (HasIdOperands(static_cast<spv::Op>(opcode))) {
+        flags |= kPackedIdOperands;
+      }
+    }
+    const uint32_t num_operands =
+        static_cast<uint32_t>(word_count - ModelledWords(flags));
+    AppendVarint(opcode, packed);
+    AppendVarint((num_operands << kFlagBits) | flags, packed);
+
+    if (flags & kPackedHasResultType) {
+      AppendVarint(Zigzag(*operand - last_result_type), packed);
+      last_result_type = *operand++;
+    }
+    if (flags & kPackedHasResult) {
+      AppendVarint(Zigzag(*operand - (last_result + 1)), packed);
+      last_result = *operand++;
+    }
+    if (flags & kPackedIdOperands) {
+      for (; operand != end; ++operand) {
+        AppendVarint(Zigzag(last_result - *operand), packed);
+      }
+    } else {
+      for (; operand != end; ++operand) AppendVarint(*operand, packed);
+    }
+    i += word_count;
+  }
+  return true;
+}
+
+bool UnpackSpirv(const string_piece& packed, std::vector<uint32_t>* words,
+                 std::string* error) {
+  if (!IsPackedSpirv(packed)) {
+    *error = "not packed SPIR-V";
+    return false;
+  }
+  const unsigned char* p =
+      reinterpret_cast<const unsigned char*>(packed.data()) + kMagicBytes;
+  const unsigned char* const end =
+      reinterpret_cast<const unsigned char*>(packed.data()) + packed.size();
+
+  uint32_t version = 0;
+  uint32_t num_words = 0;
+  if (!ReadVarint(&p, end, &version) || !ReadVarint(&p, end, &num_words)) {
+    *error = "packed SPIR-V header is truncated";
+    return false;
+  }
+  if (version != kPackedSpirvVersion) {
+    *error = "unsupported packed SPIR-V version " + std::to_string(version);
+    return false;
+  }
+  // Every word after the header takes at least one byte, which bounds the
+  // size of the module before anything is allocated for it.
+  if (num_words < kSpirvHeaderWords ||
+      num_words - kSpirvHeaderWords > static_cast<size_t>(end - p)) {
+    *error = "packed SPIR-V has an invalid word count";
+    return false;
+  }
+  words->resize(num_words);
+  uint32_t* out = words->data();
+  uint32_t* const out_end = out + num_words;
+  *out++ = spv::MagicNumber;
+  for (size_t i = 1; i < kSpirvHeaderWords; ++i) {
+    if (!ReadVarint(&p, end, out++)) {
+      *error = "packed SPIR-V header is truncated";
+      return false;
+    }
+  }
+
+  uint32_t last_result_type = 0;
+  uint32_t last_result = 0;
+  while (p != end) {
+    const size_t word_index = out - words->data();
+    uint32_t opcode = 0;
+    uint32_t info = 0;
+    if (!ReadVarint(&p, end, &opcode) || !ReadVarint(&p, end, &info) ||
+        opcode > 0xffff) {
+      *error = "instruction at word " + std::to_string(word_index) +
+               " is malformed";
+      return false;
+    }
+    const uint32_t flags = info & ((1u << kFlagBits) - 1);
+    const size_t word_count = ModelledWords(flags) + (info >> kFlagBits);
+    if (word_count > 0xffff ||
+        word_count > static_cast<size_t>(out_end - out)) {
+      *error = "instruction at word " + std::to_string(word_index) +
+               " has an invalid word count";
+      return false;
+    }
+    uint32_t* const instruction_end = out + word_count;
+    *out++ = static_cast<uint32_t>(word_count << 16) | opcode;
+
+    uint32_t value = 0;
+    bool ok = true;
+    if (flags & kPackedHasResultType) {
+      ok = ReadVarint(&p, end, &value);
+      last_result_type += Unzigzag(value);
+      *out++ = last_result_type;
+    }
+    if (ok && (flags & kPackedHasResult)) {
+      ok = ReadVarint(&p, end, &value);
+      last_result += 1 + Unzigzag(value);
+      *out++ = last_result;
+    }
+    if (flags & kPackedIdOperands) {
+      for (; ok && out != instruction_end; ++out) {
+        ok = ReadVarint(&p, end, &value);
+        *out = last_result - Unzigzag(value);
+      }
+    } else {
+      for (; ok && out != instruction_end; ++out) {
+        ok = ReadVarint(&p, end, out);
+      }
+    }
+    if (!ok) {
+      *error = "instruction at word " + std::to_string(word_index) +
+               " is truncated";
+      return false;
+    }
+  }
+  if (out != out_end) {
+    *error = "packed SPIR-V ends at word " +
+             std::to_string(out - words->data()) + " of " +
+             std::to_string(num_words);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace shaderc_util
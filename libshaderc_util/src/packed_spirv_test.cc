@@ -0,0 +1,199 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/packed_spirv.h"
+
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using shaderc_util::IsPackedSpirv;
+using shaderc_util::PackSpirv;
+using shaderc_util::UnpackSpirv;
+using testing::ElementsAreArray;
+using testing::HasSubstr;
+
+// A compute shader with an empty main function.
+const uint32_t kModule[] = {
+    // Header
+    0x07230203, 0x00010000, 0x00080001, 5, 0,
+    // OpCapability Shader
+    (2 << 16) | 17, 1,
+    // OpMemoryModel Logical GLSL450
+    (3 << 16) | 14, 0, 1,
+    // OpEntryPoint GLCompute %1 "main"
+    (5 << 16) | 15, 5, 1, 0x6e69616d, 0,
+    // OpExecutionMode %1 LocalSize 64 1 1
+    (6 << 16) | 16, 1, 17, 64, 1, 1,
+    // %2 = OpTypeVoid
+    (2 << 16) | 19, 2,
+    // %3 = OpTypeFunction %2
+    (3 << 16) | 33, 3, 2,
+    // %1 = OpFunction %2 None %3
+    (5 << 16) | 54, 2, 1, 0, 3,
+    // %4 = OpLabel
+    (2 << 16) | 248, 4,
+    // OpReturn
+    (1 << 16) | 253,
+    // OpFunctionEnd
+    (1 << 16) | 56,
+};
+const size_t kModuleWords = sizeof(kModule) / sizeof(kModule[0]);
+
+// Returns the given module packed, or an empty string if packing fails.
+std::string Pack(const uint32_t* words, size_t num_words) {
+  std::string packed;
+  std::string error;
+  EXPECT_TRUE(PackSpirv(words, num_words, &packed, &error)) << error;
+  return packed;
+}
+
+TEST(PackedSpirv, Roundtrip) {
+  const std::string packed = Pack(kModule, kModuleWords);
+  EXPECT_TRUE(IsPackedSpirv(packed));
+  EXPECT_LT(packed.size(), sizeof(kModule));
+
+  std::vector<uint32_t> words;
+  std::string error;
+  ASSERT_TRUE(UnpackSpirv(packed, &words, &error)) << error;
+  EXPECT_THAT(words, ElementsAreArray(kModule));
+}
+
+TEST(PackedSpirv, RoundtripsAnyOperandValues) {
+  // Unknown opcodes, operands that are not ids and ids far apart must all
+  // come back as they were.
+  const uint32_t module[] = {
+      0x07230203, 0x00010600, 0xffffffff, 0xffffffff, 0xffffffff,
+      // %4000000000 = OpTypeInt 32 0
+      (4 << 16) | 21, 4000000000u, 32, 0,
+      // %1 = OpConstant %4000000000 4294967295
+      (4 << 16) | 43, 4000000000u, 1, 0xffffffff,
+      // %2 = OpIAdd %4000000000 %1 %3999999999
+      (5 << 16) | 128, 4000000000u, 2, 1, 3999999999u,
+      // An unknown opcode.
+      (3 << 16) | 0xffff, 0x80000000, 0x7fffffff,
+      // An instruction too short for its result type and result.
+      (2 << 16) | 128, 7,
+  };
+  const size_t num_words = sizeof(module) / sizeof(module[0]);
+  std::vector<uint32_t> words;
+  std::string error;
+  ASSERT_TRUE(UnpackSpirv(Pack(module, num_words), &words, &error)) << error;
+  EXPECT_THAT(words, ElementsAreArray(module));
+}
+
+TEST(PackedSpirv, RoundtripsAModuleWithOnlyAHeader) {
+  std::vector<uint32_t> words;
+  std::string error;
+  ASSERT_TRUE(UnpackSpirv(Pack(kModule, 5), &words, &error)) << error;
+  EXPECT_THAT(words, ElementsAreArray(kModule, 5));
+}
+
+TEST(PackedSpirv, PackAppends) {
+  std::string packed = "prefix";
+  std::string error;
+  ASSERT_TRUE(PackSpirv(kModule, kModuleWords, &packed, &error)) << error;
+  EXPECT_EQ(Pack(kModule, kModuleWords), packed.substr(6));
+}
+
+TEST(PackedSpirv, UnpackReplacesWords) {
+  std::vector<uint32_t> words(100, 42);
+  std::string error;
+  ASSERT_TRUE(UnpackSpirv(Pack(kModule, kModuleWords), &words, &error));
+  EXPECT_THAT(words, ElementsAreArray(kModule));
+}
+
+TEST(PackedSpirv, PackRejectsWhatIsNotSpirv) {
+  std::string packed;
+  std::string error;
+  EXPECT_FALSE(PackSpirv(kModule, 4, &packed, &error));
+  EXPECT_EQ("not a SPIR-V module", error);
+
+  std::vector<uint32_t> module(kModule, kModule + kModuleWords);
+  module[0] = 0x03022307;
+  EXPECT_FALSE(PackSpirv(module.data(), module.size(), &packed, &error));
+  EXPECT_EQ("not a SPIR-V module", error);
+}
+
+TEST(PackedSpirv, PackRejectsBadWordCounts) {
+  std::vector<uint32_t> module(kModule, kModule + kModuleWords);
+  std::string packed;
+  std::string error;
+  module[7] = 14;  // OpMemoryModel with no words at all.
+  EXPECT_FALSE(PackSpirv(module.data(), module.size(), &packed, &error));
+  EXPECT_EQ("instruction at word 7 has an invalid word count", error);
+
+  module.assign(kModule, kModule + kModuleWords);
+  module.back() = (2 << 16) | 56;  // OpFunctionEnd past the end.
+  EXPECT_FALSE(PackSpirv(module.data(), module.size(), &packed, &error));
+  EXPECT_THAT(error, HasSubstr("has an invalid word count"));
+}
+
+TEST(PackedSpirv, IsPackedSpirv) {
+  EXPECT_FALSE(IsPackedSpirv(""));
+  EXPECT_FALSE(IsPackedSpirv("SPV"));
+  EXPECT_FALSE(IsPackedSpirv(std::string("\x03\x02\x23\x07", 4)));
+  EXPECT_TRUE(IsPackedSpirv("SPVP"));
+}
+
+TEST(PackedSpirv, UnpackRejectsWhatIsNotPacked) {
+  std::vector<uint32_t> words;
+  std::string error;
+  EXPECT_FALSE(UnpackSpirv(std::string("\x03\x02\x23\x07", 4), &words, &error));
+  EXPECT_EQ("not packed SPIR-V", error);
+}
+
+TEST(PackedSpirv, UnpackRejectsOtherVersions) {
+  std::string packed = Pack(kModule, kModuleWords);
+  packed[4] = 2;
+  std::vector<uint32_t> words;
+  std::string error;
+  EXPECT_FALSE(UnpackSpirv(packed, &words, &error));
+  EXPECT_EQ("unsupported packed SPIR-V version 2", error);
+}
+
+TEST(PackedSpirv, UnpackRejectsTruncatedData) {
+  const std::string packed = Pack(kModule, kModuleWords);
+  for (size_t size = 0; size < packed.size(); ++size) {
+    std::vector<uint32_t> words;
+    std::string error;
+    EXPECT_FALSE(UnpackSpirv(packed.substr(0, size), &words, &error)) << size;
+    EXPECT_FALSE(error.empty());
+  }
+}
+
+TEST(PackedSpirv, UnpackRejectsTrailingData) {
+  std::string packed = Pack(kModule, kModuleWords);
+  packed.push_back('\x01');
+  packed.push_back('\x00');
+  std::vector<uint32_t> words;
+  std::string error;
+  EXPECT_FALSE(UnpackSpirv(packed, &words, &error));
+  EXPECT_THAT(error, HasSubstr("has an invalid word count"));
+}
+
+TEST(PackedSpirv, UnpackRejectsAnImpossibleWordCount) {
+  // A module of a billion words cannot fit in a dozen bytes.
+  const std::string packed("SPVP\x01\x80\x94\xeb\xdc\x03\x00\x00\x00\x00", 14);
+  std::vector<uint32_t> words;
+  std::string error;
+  EXPECT_FALSE(UnpackSpirv(packed, &words, &error));
+  EXPECT_EQ("packed SPIR-V has an invalid word count", error);
+  EXPECT_TRUE(words.empty());
+}
+
+}  // anonymous namespace
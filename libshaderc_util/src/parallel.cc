@@ -0,0 +1,46 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace shaderc_util {
+
+unsigned GetNumWorkers(size_t num_jobs) {
+  // hardware_concurrency() is 0 when it is not known.
+  const size_t max_workers = std::max(1u, std::thread::hardware_concurrency());
+  return unsigned(std::max<size_t>(1, std::min(num_jobs, max_workers)));
+}
+
+void RunInParallel(
+    size_t num_jobs,
+    const std::function<void(size_t job, unsigned worker)>& job) {
+  std::atomic<size_t> next_job(0);
+  auto work = [&](unsigned worker) {
+    for (size_t i = next_job++; i < num_jobs; i = next_job++) job(i, worker);
+  };
+  const unsigned num_workers = GetNumWorkers(num_jobs);
+  std::vector<std::thread> threads;
+  for (unsigned worker = 1; worker < num_workers; ++worker) {
+    threads.emplace_back(work, worker);
+  }
+  work(0);
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace shaderc_util
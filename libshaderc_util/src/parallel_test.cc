@@ -0,0 +1,65 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/parallel.h"
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using shaderc_util::GetNumWorkers;
+using shaderc_util::RunInParallel;
+
+TEST(Parallel, NumWorkersIsBoundedByJobsAndHardware) {
+  EXPECT_EQ(1u, GetNumWorkers(0));
+  EXPECT_EQ(1u, GetNumWorkers(1));
+  EXPECT_LE(GetNumWorkers(2), 2u);
+  const unsigned hardware = std::thread::hardware_concurrency();
+  if (hardware > 0) {
+    EXPECT_LE(GetNumWorkers(100000), hardware);
+  }
+}
+
+TEST(Parallel, NoJobsRunsNothing) {
+  bool ran = false;
+  RunInParallel(0, [&](size_t, unsigned) { ran = true; });
+  EXPECT_FALSE(ran);
+}
+
+#ifndef SHADERC_DISABLE_THREADED_TESTS
+
+TEST(Parallel, RunsEveryJobOnceOnAKnownWorker) {
+  const size_t num_jobs = 1000;
+  std::vector<std::atomic<int>> runs(num_jobs);
+  const unsigned num_workers = GetNumWorkers(num_jobs);
+  std::vector<std::atomic<int>> busy(num_workers);
+  std::atomic<bool> overlapped(false);
+  RunInParallel(num_jobs, [&](size_t job, unsigned worker) {
+    ASSERT_LT(worker, num_workers);
+    if (busy[worker]++ != 0) overlapped = true;
+    ++runs[job];
+    --busy[worker];
+  });
+  for (size_t i = 0; i < num_jobs; ++i) EXPECT_EQ(1, runs[i]) << i;
+  // A worker runs one job at a time.
+  EXPECT_FALSE(overlapped);
+}
+
+#endif  // SHADERC_DISABLE_THREADED_TESTS
+
+}  // anonymous namespace
@@ -0,0 +1,240 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/reflection.h"
+
+#include <sstream>
+
+#include "glslang/Include/Types.h"
+#include "glslang/MachineIndependent/localintermediate.h"
+#include "glslang/MachineIndependent/reflection.h"
+#include "libshaderc_util/json.h"
+
+namespace {
+
+// The GLSL names of a scalar type, and the prefix of its vector and matrix
+// types.  Matrices only exist for floating-point types.
+struct ScalarNames {
+  glslang::TBasicType basic_type;
+  const char* scalar;
+  const char* prefix;
+};
+
+const ScalarNames kScalarNames[] = {
+    {glslang::EbtFloat, "float", ""},
+    {glslang::EbtDouble, "double", "d"},
+    {glslang::EbtFloat16, "float16_t", "f16"},
+    {glslang::EbtInt8, "int8_t", "i8"},
+    {glslang::EbtUint8, "uint8_t", "u8"},
+    {glslang::EbtInt16, "int16_t", "i16"},
+    {glslang::EbtUint16, "uint16_t", "u16"},
+    {glslang::EbtInt, "int", "i"},
+    {glslang::EbtUint, "uint", "u"},
+    {glslang::EbtInt64, "int64_t", "i64"},
+    {glslang::EbtUint64, "uint64_t", "u64"},
+    {glslang::EbtBool, "bool", "b"},
+};
+
+// Returns the GLSL name of the given type, without its array dimensions.
+std::string TypeName(const glslang::TType& type) {
+  switch (type.getBasicType()) {
+    case glslang::EbtSampler:
+      return type.getSampler().getString().c_str();
+    case glslang::EbtStruct:
+    case glslang::EbtBlock:
+      return type.getTypeName().c_str();
+    case glslang::EbtAccStruct:
+      return "accelerationStructureEXT";
+    default:
+      break;
+  }
+  for (const ScalarNames& names : kScalarNames) {
+    if (names.basic_type != type.getBasicType()) continue;
+    if (type.isMatrix()) {
+      const int columns = type.getMatrixCols();
+      const int rows = type.getMatrixRows();
+      return std::string(names.prefix) + "mat" + std::to_string(columns) +
+             (columns == rows ? "" : "x" + std::to_string(rows));
+    }
+    if (type.isVector()) {
+      return std::string(names.prefix) + "vec" +
+             std::to_string(type.getVectorSize());
+    }
+    return names.scalar;
+  }
+  return type.getBasicTypeString();
+}
+
+// Returns the kind of descriptor of a uniform that is not in a block.
+const char* UniformKind(const glslang::TType& type) {
+  if (type.getBasicType() == glslang::EbtAccStruct) {
+    return "acceleration_structure";
+  }
+  if (type.getBasicType() != glslang::EbtSampler) return "uniform";
+  const glslang::TSampler& sampler = type.getSampler();
+  if (sampler.isSubpass()) return "input_attachment";
+  if (sampler.isPureSampler()) return "sampler";
+  if (sampler.isImage()) {
+    return sampler.isBuffer() ? "storage_texel_buffer" : "storage_image";
+  }
+  if (sampler.isBuffer()) return "uniform_texel_buffer";
+  return sampler.isCombined() ? "combined_image_sampler" : "sampled_image";
+}
+
+// Returns the number of elements of the outermost array dimension of the
+// given type: 1 if it is not an array, and 0 if it is a runtime array.
+int ArraySize(const glslang::TType& type) {
+  if (!type.isArray()) return 1;
+  return type.isUnsizedArray() ? 0 : type.getOuterArraySize();
+}
+
+// Writes the "name", "type" and "array_size" members of the given object,
+// without the braces around them.
+void WriteVariable(std::ostream* out,
+                   const glslang::TObjectReflection& object) {
+  const glslang::TType& type = *object.getType();
+  *out << "\"name\": ";
+  shaderc_util::WriteJsonString(out, object.name);
+  *out << ", \"type\": ";
+  shaderc_util::WriteJsonString(out, TypeName(type));
+  *out << ", \"array_size\": " << ArraySize(type);
+}
+
+// Writes a resource of the given kind to out, after the given separator,
+// which is then set for the next element of the array.
+void WriteResource(std::ostream* out, const char* kind,
+                   const glslang::TObjectReflection& object, bool is_block,
+                   const char** separator) {
+  const glslang::TQualifier& qualifier = object.getType()->getQualifier();
+  *out << *separator << "{";
+  WriteVariable(out, object);
+  *out << ", \"kind\": \"" << kind << "\"";
+  if (qualifier.hasSet()) *out << ", \"set\": " << qualifier.layoutSet;
+  if (object.getBinding() >= 0) {
+    *out << ", \"binding\": " << object.getBinding();
+  }
+  if (is_block) *out << ", \"size\": " << object.size;
+  *out << "}";
+  *separator = ", ";
+}
+
+// Writes the user-defined stage variables of the given count as a JSON array.
+template <typename GetVariable>
+void WritePipeVariables(std::ostream* out, int count,
+                        const GetVariable& get_variable) {
+  *out << "[";
+  const char* separator = "";
+  for (int i = 0; i < count; ++i) {
+    const glslang::TObjectReflection& object = get_variable(i);
+    const glslang::TQualifier& qualifier = object.getType()->getQualifier();
+    if (qualifier.builtIn != glslang::EbvNone ||
+        object.name.compare(0, 3, "gl_") == 0) {
+      continue;
+    }
+    *out << separator << "{";
+    WriteVariable(out, object);
+    if (qualifier.hasLocation()) {
+      *out << ", \"location\": " << qualifier.layoutLocation;
+    }
+    *out << "}";
+    separator = ", ";
+  }
+  *out << "]";
+}
+
+}  // anonymous namespace
+
+namespace shaderc_util {
+
+bool GetReflectionJson(const glslang::TIntermediate& intermediate,
+                       std::string* json, std::string* errors) {
+  // TProgram::buildReflection() only reflects the inputs of the vertex stage
+  // and the outputs of the fragment stage, so the stage is reflected on its
+  // own, as both the first and the last stage.
+  const EShLanguage stage = intermediate.getStage();
+  glslang::TReflection reflection(
+      static_cast<EShReflectionOptions>(EShReflectionSeparateBuffers |
+                                        EShReflectionAllBlockVariables |
+                                        EShReflectionAllIOVariables),
+      stage, stage);
+  if (!reflection.addStage(stage, intermediate)) {
+    *errors = "cannot build the reflection of the stage";
+    return false;
+  }
+
+  std::ostringstream out;
+  out << "{\"resources\": [";
+  const char* separator = "";
+  for (int i = 0; i < reflection.getNumUniformBlocks(); ++i) {
+    const glslang::TObjectReflection& block = reflection.getUniformBlock(i);
+    if (block.getType()->getQualifier().isPushConstant()) continue;
+    WriteResource(&out, "uniform_buffer", block, true, &separator);
+  }
+  for (int i = 0; i < reflection.getNumStorageBuffers(); ++i) {
+    WriteResource(&out, "storage_buffer", reflection.getStorageBufferBlock(i),
+                  true, &separator);
+  }
+  for (int i = 0; i < reflection.getNumUniforms(); ++i) {
+    const glslang::TObjectReflection& uniform = reflection.getUniform(i);
+    // Members of blocks have the index of their block.
+    if (uniform.index >= 0) continue;
+    WriteResource(&out, UniformKind(*uniform.getType()), uniform, false,
+                  &separator);
+  }
+
+  out << "],\n \"push_constants\": [";
+  separator = "";
+  for (int i = 0; i < reflection.getNumUniformBlocks(); ++i) {
+    const glslang::TObjectReflection& block = reflection.getUniformBlock(i);
+    if (!block.getType()->getQualifier().isPushConstant()) continue;
+    out << separator << "{\"name\": ";
+    WriteJsonString(&out, block.name);
+    out << ", \"size\": " << block.size << ", \"members\": [";
+    const char* member_separator = "";
+    for (int j = 0; j < reflection.getNumUniforms(); ++j) {
+      const glslang::TObjectReflection& member = reflection.getUniform(j);
+      if (member.index != i) continue;
+      out << member_separator << "{";
+      WriteVariable(&out, member);
+      out << ", \"offset\": " << member.offset << "}";
+      member_separator = ", ";
+    }
+    out << "]}";
+    separator = ", ";
+  }
+
+  out << "],\n \"inputs\": ";
+  WritePipeVariables(
+      &out, reflection.getNumPipeInputs(),
+      [&reflection](int i) -> const glslang::TObjectReflection& {
+        return reflection.getPipeInput(i);
+      });
+  out << ",\n \"outputs\": ";
+  WritePipeVariables(
+      &out, reflection.getNumPipeOutputs(),
+      [&reflection](int i) -> const glslang::TObjectReflection& {
+        return reflection.getPipeOutput(i);
+      });
+  if (stage == EShLangCompute || stage == EShLangTask ||
+      stage == EShLangMesh) {
+    out << ",\n \"workgroup_size\": [" << reflection.getLocalSize(0) << ", "
+        << reflection.getLocalSize(1) << ", " << reflection.getLocalSize(2)
+        << "]";
+  }
+  out << "}\n";
+  *json = out.str();
+  return true;
+}
+
+}  // namespace shaderc_util
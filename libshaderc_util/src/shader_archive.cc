@@ -0,0 +1,237 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/shader_archive.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// The number of words in the archive header.
+const size_t kHeaderWords = 5;
+// The number of words in each record of the table of contents.
+const size_t kEntryWords = 6;
+
+// Indices of the words in a record of the table of contents.
+enum EntryWord {
+  kKeyLow = 0,
+  kKeyHigh,
+  kNameOffset,
+  kNameSize,
+  kDataOffset,
+  kDataSize,
+};
+
+size_t AlignUp(size_t value) { return (value + 3) & ~size_t(3); }
+
+void AppendWord(uint32_t word, std::string* out) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    out->push_back(static_cast<char>((word >> shift) & 0xff));
+  }
+}
+
+void AppendPadding(std::string* out) { out->resize(AlignUp(out->size())); }
+
+uint32_t ReadWord(const char* bytes) {
+  const unsigned char* b = reinterpret_cast<const unsigned char*>(bytes);
+  return uint32_t(b[0]) | (uint32_t(b[1]) << 8) | (uint32_t(b[2]) << 16) |
+         (uint32_t(b[3]) << 24);
+}
+
+// Returns true if name a sorts before name b, in the same order as
+// std::string.
+bool NameLess(const shaderc_util::string_piece& a,
+              const shaderc_util::string_piece& b) {
+  return std::lexicographical_compare(
+      a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+        return static_cast<unsigned char>(x) < static_cast<unsigned char>(y);
+      });
+}
+
+}  // anonymous namespace
+
+namespace shaderc_util {
+
+uint64_t ShaderArchiveKey(const string_piece& name) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (char c : name) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+bool ShaderArchiveWriter::Add(const std::string& name,
+                              const string_piece& data) {
+  return entries_.emplace(name, data.str()).second;
+}
+
+std::string ShaderArchiveWriter::Serialize() const {
+  struct Record {
+    uint64_t key;
+    const std::string* name;
+    const std::string* data;
+  };
+  std::vector<Record> records;
+  records.reserve(entries_.size());
+  for (const auto& entry : entries_) {
+    records.push_back({ShaderArchiveKey(entry.first), &entry.first,
+                       &entry.second});
+  }
+  std::sort(records.begin(), records.end(),
+            [](const Record& a, const Record& b) {
+              return a.key != b.key ? a.key < b.key : *a.name < *b.name;
+            });
+
+  const size_t names_offset = 4 * (kHeaderWords + kEntryWords * records.size());
+  size_t names_size = 0;
+  for (const auto& record : records) names_size += record.name->size();
+  size_t data_offset = names_offset + AlignUp(names_size);
+
+  std::string out;
+  AppendWord(kShaderArchiveMagic, &out);
+  AppendWord(kShaderArchiveVersion, &out);
+  AppendWord(static_cast<uint32_t>(records.size()), &out);
+  AppendWord(static_cast<uint32_t>(names_offset), &out);
+  AppendWord(static_cast<uint32_t>(names_size), &out);
+  size_t name_offset = names_offset;
+  for (const auto& record : records) {
+    AppendWord(static_cast<uint32_t>(record.key), &out);
+    AppendWord(static_cast<uint32_t>(record.key >> 32), &out);
+    AppendWord(static_cast<uint32_t>(name_offset), &out);
+    AppendWord(static_cast<uint32_t>(record.name->size()), &out);
+    AppendWord(static_cast<uint32_t>(data_offset), &out);
+    AppendWord(static_cast<uint32_t>(record.data->size()), &out);
+    name_offset += record.name->size();
+    data_offset += AlignUp(record.data->size());
+  }
+  for (const auto& record : records) out += *record.name;
+  AppendPadding(&out);
+  for (const auto& record : records) {
+    out += *record.data;
+    AppendPadding(&out);
+  }
+  return out;
+}
+
+bool ShaderArchiveReader::Open(const string_piece& archive,
+                               std::string* error) {
+  archive_.clear();
+  num_entries_ = 0;
+
+  const size_t size = archive.size();
+  if (size < 4 * kHeaderWords) {
+    *error = "archive is too small";
+    return false;
+  }
+  if (ReadWord(archive.data()) != kShaderArchiveMagic) {
+    *error = "not a shader archive";
+    return false;
+  }
+  if (ReadWord(archive.data() + 4) != kShaderArchiveVersion) {
+    *error = "unsupported shader archive version " +
+             std::to_string(ReadWord(archive.data() + 4));
+    return false;
+  }
+  const size_t num_entries = ReadWord(archive.data() + 8);
+  const size_t names_offset = ReadWord(archive.data() + 12);
+  const size_t names_size = ReadWord(archive.data() + 16);
+  if (num_entries > (size / 4 - kHeaderWords) / kEntryWords ||
+      names_offset != 4 * (kHeaderWords + kEntryWords * num_entries) ||
+      names_size > size - names_offset) {
+    *error = "table of contents is out of bounds";
+    return false;
+  }
+
+  archive_ = archive;
+  num_entries_ = num_entries;
+  for (size_t i = 0; i < num_entries; ++i) {
+    const size_t name_offset = EntryWord(i, kNameOffset);
+    const size_t name_size = EntryWord(i, kNameSize);
+    const size_t data_offset = EntryWord(i, kDataOffset);
+    const size_t data_size = EntryWord(i, kDataSize);
+    const char* reason = nullptr;
+    if (name_offset < names_offset ||
+        name_offset - names_offset > names_size ||
+        name_size > names_size - (name_offset - names_offset)) {
+      reason = "name is out of bounds";
+    } else if (data_offset % 4 != 0) {
+      reason = "data is not aligned";
+    } else if (data_offset > size || data_size > size - data_offset) {
+      reason = "data is out of bounds";
+    } else if (EntryKey(i) != ShaderArchiveKey(GetEntry(i).name)) {
+      reason = "key does not match its name";
+    } else if (i > 0 && (EntryKey(i - 1) > EntryKey(i) ||
+                         (EntryKey(i - 1) == EntryKey(i) &&
+                          !NameLess(GetEntry(i - 1).name,
+                                    GetEntry(i).name)))) {
+      reason = "entries are not sorted";
+    }
+    if (reason) {
+      *error = "entry " + std::to_string(i) + ": " + reason;
+      archive_.clear();
+      num_entries_ = 0;
+      return false;
+    }
+  }
+  return true;
+}
+
+ShaderArchiveReader::Entry ShaderArchiveReader::GetEntry(size_t index) const {
+  const char* base = archive_.data();
+  const size_t name_offset = EntryWord(index, kNameOffset);
+  const size_t data_offset = EntryWord(index, kDataOffset);
+  return {string_piece(base + name_offset,
+                       base + name_offset + EntryWord(index, kNameSize)),
+          string_piece(base + data_offset,
+                       base + data_offset + EntryWord(index, kDataSize))};
+}
+
+bool ShaderArchiveReader::Find(const string_piece& name,
+                               string_piece* data) const {
+  const uint64_t key = ShaderArchiveKey(name);
+  // Binary search for the first entry with the key.
+  size_t first = 0;
+  size_t count = num_entries_;
+  while (count > 0) {
+    const size_t half = count / 2;
+    if (EntryKey(first + half) < key) {
+      first += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+  for (size_t i = first; i < num_entries_ && EntryKey(i) == key; ++i) {
+    const Entry entry = GetEntry(i);
+    if (entry.name == name) {
+      *data = entry.data;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t ShaderArchiveReader::EntryWord(size_t index, size_t word) const {
+  return ReadWord(archive_.data() + 4 * (kHeaderWords + kEntryWords * index +
+                                         word));
+}
+
+uint64_t ShaderArchiveReader::EntryKey(size_t index) const {
+  return uint64_t(EntryWord(index, kKeyLow)) |
+         (uint64_t(EntryWord(index, kKeyHigh)) << 32);
+}
+
+}  // namespace shaderc_util
@@ -0,0 +1,142 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/shader_archive.h"
+
+#include <gmock/gmock.h>
+
+#include <string>
+
+namespace {
+
+using shaderc_util::ShaderArchiveKey;
+using shaderc_util::ShaderArchiveReader;
+using shaderc_util::ShaderArchiveWriter;
+using shaderc_util::string_piece;
+using testing::HasSubstr;
+
+// Returns the archive word at the given byte offset.
+uint32_t WordAt(const std::string& archive, size_t offset) {
+  const unsigned char* b =
+      reinterpret_cast<const unsigned char*>(archive.data() + offset);
+  return uint32_t(b[0]) | (uint32_t(b[1]) << 8) | (uint32_t(b[2]) << 16) |
+         (uint32_t(b[3]) << 24);
+}
+
+TEST(ShaderArchiveKey, IsFnv1a64) {
+  EXPECT_EQ(0xcbf29ce484222325ull, ShaderArchiveKey(""));
+  EXPECT_EQ(0xaf63dc4c8601ec8cull, ShaderArchiveKey("a"));
+  EXPECT_NE(ShaderArchiveKey("a.vert.spv"), ShaderArchiveKey("a.frag.spv"));
+}
+
+TEST(ShaderArchive, EmptyArchive) {
+  const std::string archive = ShaderArchiveWriter().Serialize();
+  EXPECT_EQ(20u, archive.size());
+  ShaderArchiveReader reader;
+  std::string error;
+  ASSERT_TRUE(reader.Open(archive, &error)) << error;
+  EXPECT_EQ(0u, reader.size());
+  string_piece data;
+  EXPECT_FALSE(reader.Find("a", &data));
+}
+
+TEST(ShaderArchive, Roundtrip) {
+  ShaderArchiveWriter writer;
+  EXPECT_TRUE(writer.Add("b.frag.spv", std::string("\x03\x02\x23\x07", 4)));
+  EXPECT_TRUE(writer.Add("a.vert.spv", "odd"));
+  EXPECT_TRUE(writer.Add("empty", ""));
+  EXPECT_FALSE(writer.Add("a.vert.spv", "again"));
+  EXPECT_EQ(3u, writer.size());
+  const std::string archive = writer.Serialize();
+
+  ShaderArchiveReader reader;
+  std::string error;
+  ASSERT_TRUE(reader.Open(archive, &error)) << error;
+  ASSERT_EQ(3u, reader.size());
+  string_piece data;
+  ASSERT_TRUE(reader.Find("a.vert.spv", &data));
+  EXPECT_EQ("odd", data.str());
+  ASSERT_TRUE(reader.Find("b.frag.spv", &data));
+  EXPECT_EQ(std::string("\x03\x02\x23\x07", 4), data.str());
+  ASSERT_TRUE(reader.Find("empty", &data));
+  EXPECT_TRUE(data.empty());
+  EXPECT_FALSE(reader.Find("c.comp.spv", &data));
+}
+
+TEST(ShaderArchive, EntriesAreSortedByKeyAndDataIsAligned) {
+  ShaderArchiveWriter writer;
+  for (int i = 0; i < 20; ++i) {
+    writer.Add("shader" + std::to_string(i), std::string(i, 'x'));
+  }
+  const std::string archive = writer.Serialize();
+  ShaderArchiveReader reader;
+  std::string error;
+  ASSERT_TRUE(reader.Open(archive, &error)) << error;
+  ASSERT_EQ(20u, reader.size());
+  for (size_t i = 0; i < reader.size(); ++i) {
+    const auto entry = reader.GetEntry(i);
+    EXPECT_EQ(0u, (entry.data.data() - archive.data()) % 4);
+    if (i > 0) {
+      EXPECT_LT(ShaderArchiveKey(reader.GetEntry(i - 1).name),
+                ShaderArchiveKey(entry.name));
+    }
+    string_piece data;
+    ASSERT_TRUE(reader.Find(entry.name, &data));
+    EXPECT_EQ(entry.data.data(), data.data());
+  }
+}
+
+TEST(ShaderArchive, RejectsMalformedArchives) {
+  ShaderArchiveWriter writer;
+  writer.Add("a", "data");
+  const std::string archive = writer.Serialize();
+  ShaderArchiveReader reader;
+  std::string error;
+
+  EXPECT_FALSE(reader.Open(archive.substr(0, 8), &error));
+  EXPECT_THAT(error, HasSubstr("too small"));
+
+  std::string bad_magic = archive;
+  bad_magic[0] = 'X';
+  EXPECT_FALSE(reader.Open(bad_magic, &error));
+  EXPECT_THAT(error, HasSubstr("not a shader archive"));
+
+  std::string bad_version = archive;
+  bad_version[4] = 9;
+  EXPECT_FALSE(reader.Open(bad_version, &error));
+  EXPECT_THAT(error, HasSubstr("version 9"));
+
+  std::string bad_count = archive;
+  bad_count[8] = 100;
+  EXPECT_FALSE(reader.Open(bad_count, &error));
+  EXPECT_THAT(error, HasSubstr("out of bounds"));
+
+  // Data offset of the only entry, in its table of contents record.
+  const size_t data_offset = 20 + 16;
+  std::string unaligned = archive;
+  unaligned[data_offset] = static_cast<char>(WordAt(archive, data_offset) + 1);
+  EXPECT_FALSE(reader.Open(unaligned, &error));
+  EXPECT_THAT(error, HasSubstr("entry 0: data is not aligned"));
+
+  EXPECT_FALSE(reader.Open(archive.substr(0, archive.size() - 4), &error));
+  EXPECT_THAT(error, HasSubstr("entry 0: data is out of bounds"));
+  EXPECT_EQ(0u, reader.size());
+
+  std::string bad_key = archive;
+  bad_key[20] ^= 1;
+  EXPECT_FALSE(reader.Open(bad_key, &error));
+  EXPECT_THAT(error, HasSubstr("entry 0: key does not match its name"));
+}
+
+}  // anonymous namespace
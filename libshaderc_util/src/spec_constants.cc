@@ -0,0 +1,316 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/spec_constants.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+#include "spirv/unified1/spirv.hpp"
+
+namespace {
+
+// The number of words in a SPIR-V header.
+const size_t kSpirvHeaderWords = 5;
+
+// The scalar type of a specialization constant.
+struct ScalarType {
+  spv::Op opcode;  // OpTypeBool, OpTypeInt or OpTypeFloat.
+  uint32_t width;  // In bits, for numbers.
+  bool is_signed;  // For integers.
+};
+
+// Returns the IEEE half-precision bits of the given float, rounded to the
+// nearest, ties to even.
+uint32_t FloatToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint32_t sign = (bits >> 16) & 0x8000;
+  const uint32_t exponent = (bits >> 23) & 0xff;
+  uint32_t mantissa = bits & 0x7fffff;
+  if (exponent == 0xff) return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+  const int half_exponent = static_cast<int>(exponent) - 127 + 15;
+  if (half_exponent >= 31) return sign | 0x7c00;
+  uint32_t shift = 13;
+  uint32_t half = (static_cast<uint32_t>(half_exponent) << 10);
+  if (half_exponent <= 0) {
+    // A subnormal, or zero if it is too small for that.
+    if (half_exponent < -10) return sign;
+    mantissa |= 0x800000;
+    shift = static_cast<uint32_t>(14 - half_exponent);
+    half = 0;
+  }
+  half |= mantissa >> shift;
+  const uint32_t rest = mantissa & ((1u << shift) - 1);
+  const uint32_t halfway = 1u << (shift - 1);
+  // Rounding up may carry into the exponent, which gives the right result.
+  if (rest > halfway || (rest == halfway && (half & 1))) ++half;
+  return sign | half;
+}
+
+// Parses text as an integer of the given type, and writes its words to
+// *words.  Returns false if it is not one, or does not fit the type.  As in
+// GLSL, the text is hexadecimal if prefixed with 0x, and octal if prefixed
+// with 0, and such a value may set every bit of a signed type, so that
+// 0xFFFFFFFF is -1 for a 32-bit int.
+bool ParseInteger(const std::string& text, const ScalarType& type,
+                  std::vector<uint32_t>* words) {
+  const bool negative = !text.empty() && text[0] == '-';
+  const size_t digits = negative ? 1 : 0;
+  if (type.width != 8 && type.width != 16 && type.width != 32 &&
+      type.width != 64) {
+    return false;
+  }
+  if (text.size() == digits || (negative && !type.is_signed) ||
+      !std::isxdigit(static_cast<unsigned char>(text[digits]))) {
+    return false;
+  }
+  const bool decimal = text[digits] != '0' || text.size() == digits + 1;
+  char* end = nullptr;
+  errno = 0;
+  uint64_t bits;
+  if (type.is_signed && (negative || decimal)) {
+    const long long value = std::strtoll(text.c_str(), &end, 0);
+    if (type.width < 64 && (value < -(1ll << (type.width - 1)) ||
+                            value >= (1ll << (type.width - 1)))) {
+      return false;
+    }
+    bits = static_cast<uint64_t>(value);
+  } else {
+    bits = std::strtoull(text.c_str(), &end, 0);
+    if (type.width < 64 && bits >= (1ull << type.width)) return false;
+    if (type.is_signed && type.width < 64 &&
+        (bits >> (type.width - 1)) != 0) {
+      bits |= ~0ull << type.width;
+    }
+  }
+  if (errno != 0 || *end != '\0') return false;
+  // Narrow signed integers are sign-extended to a whole word, and unsigned
+  // ones are zero-extended.
+  words->assign(1, static_cast<uint32_t>(bits));
+  if (type.width > 32) words->push_back(static_cast<uint32_t>(bits >> 32));
+  return true;
+}
+
+// Parses text as a float of the given type, and writes its words to *words.
+// Returns false if it is not one.
+bool ParseFloat(const std::string& text, const ScalarType& type,
+                std::vector<uint32_t>* words) {
+  if (text.empty() || std::isspace(static_cast<unsigned char>(text[0]))) {
+    return false;
+  }
+  char* end = nullptr;
+  if (type.width == 64) {
+    const double value = std::strtod(text.c_str(), &end);
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    words->assign({static_cast<uint32_t>(bits),
+                   static_cast<uint32_t>(bits >> 32)});
+  } else if (type.width == 32 || type.width == 16) {
+    const float value = std::strtof(text.c_str(), &end);
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    words->assign(1, type.width == 16 ? FloatToHalf(value) : bits);
+  } else {
+    return false;
+  }
+  return *end == '\0';
+}
+
+// Returns a description of the given type for error messages.
+std::string TypeName(const ScalarType& type) {
+  switch (type.opcode) {
+    case spv::OpTypeBool:
+      return "boolean";
+    case spv::OpTypeInt:
+      return std::to_string(type.width) + "-bit " +
+             (type.is_signed ? "signed" : "unsigned") + " integer";
+    default:
+      return std::to_string(type.width) + "-bit float";
+  }
+}
+
+// Returns true if text is a decimal, octal or hexadecimal integer literal,
+// without a suffix.
+bool IsIntegerLiteral(const std::string& text) {
+  if (text.empty()) return false;
+  if (text.compare(0, 2, "0x") == 0 || text.compare(0, 2, "0X") == 0) {
+    return text.size() > 2 &&
+           std::all_of(text.begin() + 2, text.end(), [](char c) {
+             return std::isxdigit(static_cast<unsigned char>(c));
+           });
+  }
+  const char last_digit = text[0] == '0' ? '7' : '9';
+  return std::all_of(text.begin(), text.end(), [last_digit](char c) {
+    return c >= '0' && c <= last_digit;
+  });
+}
+
+// Returns true if text is a floating-point literal, without a suffix: digits
+// with a decimal point, an exponent, or both.
+bool IsFloatLiteral(const std::string& text) {
+  size_t i = 0;
+  size_t num_digits = 0;
+  for (; i < text.size() && std::isdigit(static_cast<unsigned char>(text[i]));
+       ++i) {
+    ++num_digits;
+  }
+  const bool has_point = i < text.size() && text[i] == '.';
+  if (has_point) {
+    for (++i;
+         i < text.size() && std::isdigit(static_cast<unsigned char>(text[i]));
+         ++i) {
+      ++num_digits;
+    }
+  }
+  if (num_digits == 0) return false;
+  if (i == text.size()) return has_point;
+  if (text[i] != 'e' && text[i] != 'E') return false;
+  ++i;
+  if (i < text.size() && (text[i] == '+' || text[i] == '-')) ++i;
+  return i < text.size() &&
+         std::all_of(text.begin() + i, text.end(), [](char c) {
+           return std::isdigit(static_cast<unsigned char>(c));
+         });
+}
+
+}  // anonymous namespace
+
+namespace shaderc_util {
+
+bool FreezeSpecConstants(const std::map<uint32_t, std::string>& values,
+                         std::vector<uint32_t>* spirv, std::string* errors) {
+  if (values.empty()) return true;
+  const std::vector<uint32_t>& words = *spirv;
+  if (words.size() < kSpirvHeaderWords || words[0] != spv::MagicNumber) {
+    *errors = "not a SPIR-V module";
+    return false;
+  }
+
+  // The SpecIds of the constants to freeze, and the scalar types of the
+  // module, by result id.  Decorations come before types and constants.
+  std::unordered_map<uint32_t, uint32_t> spec_ids;
+  std::unordered_map<uint32_t, ScalarType> types;
+  std::vector<uint32_t> frozen;
+  frozen.reserve(words.size());
+  frozen.insert(frozen.end(), words.begin(), words.begin() + kSpirvHeaderWords);
+  std::vector<uint32_t> value_words;
+  for (size_t i = kSpirvHeaderWords; i < words.size();) {
+    const spv::Op opcode = static_cast<spv::Op>(words[i] & spv::OpCodeMask);
+    const size_t word_count = words[i] >> spv::WordCountShift;
+    if (word_count == 0 || word_count > words.size() - i) {
+      *errors = "instruction at word " + std::to_string(i) +
+                " has an invalid word count";
+      return false;
+    }
+    const uint32_t* instruction = &words[i];
+    i += word_count;
+
+    switch (opcode) {
+      case spv::OpDecorate:
+        if (word_count == 4 && instruction[2] == spv::DecorationSpecId &&
+            values.count(instruction[3])) {
+          // Regular constants must not have a SpecId.
+          spec_ids[instruction[1]] = instruction[3];
+          continue;
+        }
+        break;
+      case spv::OpTypeBool:
+        if (word_count == 2) types[instruction[1]] = {opcode, 1, false};
+        break;
+      case spv::OpTypeInt:
+        if (word_count == 4) {
+          types[instruction[1]] = {opcode, instruction[2], instruction[3] != 0};
+        }
+        break;
+      case spv::OpTypeFloat:
+        if (word_count >= 3) {
+          types[instruction[1]] = {opcode, instruction[2], false};
+        }
+        break;
+      case spv::OpSpecConstantTrue:
+      case spv::OpSpecConstantFalse:
+      case spv::OpSpecConstant: {
+        if (word_count < 3) break;
+        const auto spec_id = spec_ids.find(instruction[2]);
+        if (spec_id == spec_ids.end()) break;
+        const std::string& value = values.at(spec_id->second);
+        const auto type = types.find(instruction[1]);
+        bool parsed = false;
+        ScalarType scalar_type = {spv::OpTypeBool, 1, false};
+        if (type != types.end()) {
+          scalar_type = type->second;
+          if (opcode != spv::OpSpecConstant) {
+            parsed = value == "true" || value == "false";
+          } else if (scalar_type.opcode == spv::OpTypeInt) {
+            parsed = ParseInteger(value, scalar_type, &value_words);
+          } else if (scalar_type.opcode == spv::OpTypeFloat) {
+            parsed = ParseFloat(value, scalar_type, &value_words);
+          }
+        }
+        if (!parsed) {
+          *errors = "invalid value '" + value + "' for " +
+                    TypeName(scalar_type) + " specialization constant " +
+                    std::to_string(spec_id->second);
+          return false;
+        }
+        if (opcode != spv::OpSpecConstant) {
+          const spv::Op constant =
+              value == "true" ? spv::OpConstantTrue : spv::OpConstantFalse;
+          frozen.push_back((3u << spv::WordCountShift) | constant);
+          frozen.insert(frozen.end(), instruction + 1, instruction + 3);
+        } else {
+          const uint32_t constant_word_count =
+              static_cast<uint32_t>(3 + value_words.size());
+          frozen.push_back((constant_word_count << spv::WordCountShift) |
+                           spv::OpConstant);
+          frozen.insert(frozen.end(), instruction + 1, instruction + 3);
+          frozen.insert(frozen.end(), value_words.begin(), value_words.end());
+        }
+        continue;
+      }
+      default:
+        break;
+    }
+    frozen.insert(frozen.end(), instruction, instruction + word_count);
+  }
+  spirv->swap(frozen);
+  return true;
+}
+
+std::string GetLiteralType(const std::string& text) {
+  if (text == "true" || text == "false") return "bool";
+  const std::string number = text.substr(!text.empty() && text[0] == '-');
+  if (number.empty()) return "";
+  const char suffix = number.back();
+  if (IsIntegerLiteral(number)) return "int";
+  if ((suffix == 'u' || suffix == 'U') &&
+      IsIntegerLiteral(number.substr(0, number.size() - 1))) {
+    return "uint";
+  }
+  if (number.size() > 2 && (number.compare(number.size() - 2, 2, "lf") == 0 ||
+                            number.compare(number.size() - 2, 2, "LF") == 0)) {
+    return IsFloatLiteral(number.substr(0, number.size() - 2)) ? "double" : "";
+  }
+  if (suffix == 'f' || suffix == 'F') {
+    return IsFloatLiteral(number.substr(0, number.size() - 1)) ? "float" : "";
+  }
+  return IsFloatLiteral(number) ? "float" : "";
+}
+
+}  // namespace shaderc_util
@@ -0,0 +1,314 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/spec_constants.h"
+
+#include <gmock/gmock.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+using shaderc_util::FreezeSpecConstants;
+using shaderc_util::GetLiteralType;
+using testing::ContainerEq;
+
+// The words of an instruction header.
+constexpr uint32_t Op(uint32_t word_count, uint32_t opcode) {
+  return (word_count << 16) | opcode;
+}
+
+// The module before the types and constants.
+const std::vector<uint32_t> kPreamble = {
+    // Header
+    0x07230203, 0x00010000, 0x000d0001, 30, 0,
+    // OpCapability Shader
+    Op(2, 17), 1,
+    // OpMemoryModel Logical GLSL450
+    Op(3, 14), 0, 1,
+};
+
+// Decorations, types and spec constants with SpecIds 1 to 6.
+const std::vector<uint32_t> kDecorations = {
+    // OpDecorate %10 SpecId 1 ... OpDecorate %15 SpecId 6
+    Op(4, 71), 10, 1, 1,
+    Op(4, 71), 11, 1, 2,
+    Op(4, 71), 12, 1, 3,
+    Op(4, 71), 13, 1, 4,
+    Op(4, 71), 14, 1, 5,
+    Op(4, 71), 15, 1, 6,
+};
+const std::vector<uint32_t> kTypes = {
+    // %1 = OpTypeBool
+    Op(2, 20), 1,
+    // %2 = OpTypeInt 32 1
+    Op(4, 21), 2, 32, 1,
+    // %3 = OpTypeFloat 32
+    Op(3, 22), 3, 32,
+    // %4 = OpTypeInt 64 0
+    Op(4, 21), 4, 64, 0,
+    // %5 = OpTypeInt 16 1
+    Op(4, 21), 5, 16, 1,
+    // %6 = OpTypeFloat 16
+    Op(3, 22), 6, 16,
+};
+// One instruction per SpecId, in order.
+const std::vector<std::vector<uint32_t>> kSpecConstants = {
+    // %10 = OpSpecConstantTrue %1
+    {Op(3, 48), 1, 10},
+    // %11 = OpSpecConstant %2 8
+    {Op(4, 50), 2, 11, 8},
+    // %12 = OpSpecConstant %3 1.0
+    {Op(4, 50), 3, 12, 0x3f800000},
+    // %13 = OpSpecConstant %4 0
+    {Op(5, 50), 4, 13, 0, 0},
+    // %14 = OpSpecConstant %5 1
+    {Op(4, 50), 5, 14, 1},
+    // %15 = OpSpecConstant %6 1.0
+    {Op(4, 50), 6, 15, 0x3c00},
+};
+
+// Returns the test module, with its spec constant of the given SpecId, and its
+// SpecId decoration, replaced by the given constant.  A SpecId of 0 replaces
+// nothing.
+std::vector<uint32_t> Module(uint32_t frozen_spec_id = 0,
+                             const std::vector<uint32_t>& constant = {}) {
+  std::vector<uint32_t> module = kPreamble;
+  for (size_t i = 0; i < kDecorations.size(); i += 4) {
+    if (kDecorations[i + 3] == frozen_spec_id) continue;
+    module.insert(module.end(), kDecorations.begin() + i,
+                  kDecorations.begin() + i + 4);
+  }
+  module.insert(module.end(), kTypes.begin(), kTypes.end());
+  for (size_t i = 0; i < kSpecConstants.size(); ++i) {
+    const std::vector<uint32_t>& instruction =
+        i + 1 == frozen_spec_id ? constant : kSpecConstants[i];
+    module.insert(module.end(), instruction.begin(), instruction.end());
+  }
+  return module;
+}
+
+// Freezes the given SpecId of the test module to the given value, and
+// returns the module.
+std::vector<uint32_t> Freeze(uint32_t spec_id, const std::string& value) {
+  std::vector<uint32_t> module = Module();
+  std::string errors;
+  EXPECT_TRUE(FreezeSpecConstants({{spec_id, value}}, &module, &errors))
+      << errors;
+  return module;
+}
+
+// Returns the error of freezing the given SpecId of the test module to the
+// given value, and checks that the module is unchanged.
+std::string FreezeError(uint32_t spec_id, const std::string& value) {
+  std::vector<uint32_t> module = Module();
+  std::string errors;
+  EXPECT_FALSE(FreezeSpecConstants({{spec_id, value}}, &module, &errors));
+  EXPECT_THAT(module, ContainerEq(Module()));
+  return errors;
+}
+
+TEST(FreezeSpecConstants, NothingToFreeze) {
+  std::vector<uint32_t> module = Module();
+  std::string errors;
+  EXPECT_TRUE(FreezeSpecConstants({}, &module, &errors));
+  EXPECT_THAT(module, ContainerEq(Module()));
+  // SpecIds that the module does not use are ignored.
+  EXPECT_TRUE(FreezeSpecConstants({{7, "1"}}, &module, &errors));
+  EXPECT_THAT(module, ContainerEq(Module()));
+}
+
+TEST(FreezeSpecConstants, Booleans) {
+  EXPECT_THAT(Freeze(1, "false"),
+              ContainerEq(Module(1, {Op(3, 42), 1, 10})));
+  EXPECT_THAT(Freeze(1, "true"), ContainerEq(Module(1, {Op(3, 41), 1, 10})));
+}
+
+TEST(FreezeSpecConstants, Integers) {
+  EXPECT_THAT(Freeze(2, "16"), ContainerEq(Module(2, {Op(4, 43), 2, 11, 16})));
+  EXPECT_THAT(Freeze(2, "-3"),
+              ContainerEq(Module(2, {Op(4, 43), 2, 11, 0xfffffffd})));
+  EXPECT_THAT(Freeze(2, "0x7fffffff"),
+              ContainerEq(Module(2, {Op(4, 43), 2, 11, 0x7fffffff})));
+  EXPECT_THAT(Freeze(4, "0x100000002"),
+              ContainerEq(Module(4, {Op(5, 43), 4, 13, 2, 1})));
+  EXPECT_THAT(Freeze(4, "18446744073709551615"),
+              ContainerEq(Module(4, {Op(5, 43), 4, 13, 0xffffffff,
+                                     0xffffffff})));
+  // Narrow signed integers are sign-extended.
+  EXPECT_THAT(Freeze(5, "-1"),
+              ContainerEq(Module(5, {Op(4, 43), 5, 14, 0xffffffff})));
+}
+
+TEST(FreezeSpecConstants, HexadecimalAndOctalIntegersSetEveryBit) {
+  EXPECT_THAT(Freeze(2, "0xFFFFFFFF"),
+              ContainerEq(Module(2, {Op(4, 43), 2, 11, 0xffffffff})));
+  EXPECT_THAT(Freeze(2, "0x80000000"),
+              ContainerEq(Module(2, {Op(4, 43), 2, 11, 0x80000000})));
+  EXPECT_THAT(Freeze(2, "037777777777"),
+              ContainerEq(Module(2, {Op(4, 43), 2, 11, 0xffffffff})));
+  EXPECT_THAT(Freeze(2, "010"), ContainerEq(Module(2, {Op(4, 43), 2, 11, 8})));
+  EXPECT_THAT(Freeze(2, "-0x10"),
+              ContainerEq(Module(2, {Op(4, 43), 2, 11, 0xfffffff0})));
+  // Narrow signed integers are still sign-extended.
+  EXPECT_THAT(Freeze(5, "0xFFFF"),
+              ContainerEq(Module(5, {Op(4, 43), 5, 14, 0xffffffff})));
+  EXPECT_THAT(Freeze(5, "0x7FFF"),
+              ContainerEq(Module(5, {Op(4, 43), 5, 14, 0x7fff})));
+}
+
+TEST(FreezeSpecConstants, Floats) {
+  EXPECT_THAT(Freeze(3, "0.5"),
+              ContainerEq(Module(3, {Op(4, 43), 3, 12, 0x3f000000})));
+  EXPECT_THAT(Freeze(3, "-2"),
+              ContainerEq(Module(3, {Op(4, 43), 3, 12, 0xc0000000})));
+  EXPECT_THAT(Freeze(6, "1.5"),
+              ContainerEq(Module(6, {Op(4, 43), 6, 15, 0x3e00})));
+  EXPECT_THAT(Freeze(6, "65504"),
+              ContainerEq(Module(6, {Op(4, 43), 6, 15, 0x7bff})));
+  EXPECT_THAT(Freeze(6, "1e6"),
+              ContainerEq(Module(6, {Op(4, 43), 6, 15, 0x7c00})));
+  // The smallest half-precision subnormal.
+  EXPECT_THAT(Freeze(6, "5.9604645e-8"),
+              ContainerEq(Module(6, {Op(4, 43), 6, 15, 0x0001})));
+}
+
+TEST(FreezeSpecConstants, SeveralAtOnce) {
+  std::vector<uint32_t> module = Module();
+  std::string errors;
+  ASSERT_TRUE(FreezeSpecConstants({{1, "false"}, {2, "4"}}, &module, &errors))
+      << errors;
+  std::vector<uint32_t> expected = kPreamble;
+  expected.insert(expected.end(), kDecorations.begin() + 8, kDecorations.end());
+  expected.insert(expected.end(), kTypes.begin(), kTypes.end());
+  expected.insert(expected.end(), {Op(3, 42), 1, 10, Op(4, 43), 2, 11, 4});
+  for (size_t i = 2; i < kSpecConstants.size(); ++i) {
+    expected.insert(expected.end(), kSpecConstants[i].begin(),
+                    kSpecConstants[i].end());
+  }
+  EXPECT_THAT(module, ContainerEq(expected));
+}
+
+TEST(FreezeSpecConstants, InvalidValues) {
+  EXPECT_EQ("invalid value '1' for boolean specialization constant 1",
+            FreezeError(1, "1"));
+  EXPECT_EQ(
+      "invalid value 'eight' for 32-bit signed integer specialization "
+      "constant 2",
+      FreezeError(2, "eight"));
+  EXPECT_EQ(
+      "invalid value '2147483648' for 32-bit signed integer specialization "
+      "constant 2",
+      FreezeError(2, "2147483648"));
+  EXPECT_EQ(
+      "invalid value '0x100000000' for 32-bit signed integer "
+      "specialization constant 2",
+      FreezeError(2, "0x100000000"));
+  EXPECT_EQ(
+      "invalid value '08' for 32-bit signed integer specialization "
+      "constant 2",
+      FreezeError(2, "08"));
+  EXPECT_EQ(
+      "invalid value '-0x80000001' for 32-bit signed integer "
+      "specialization constant 2",
+      FreezeError(2, "-0x80000001"));
+  EXPECT_EQ(
+      "invalid value '1.5' for 32-bit signed integer specialization "
+      "constant 2",
+      FreezeError(2, "1.5"));
+  EXPECT_EQ(
+      "invalid value ' 8' for 32-bit signed integer specialization "
+      "constant 2",
+      FreezeError(2, " 8"));
+  EXPECT_EQ(
+      "invalid value '-1' for 64-bit unsigned integer specialization "
+      "constant 4",
+      FreezeError(4, "-1"));
+  EXPECT_EQ(
+      "invalid value '32768' for 16-bit signed integer specialization "
+      "constant 5",
+      FreezeError(5, "32768"));
+  EXPECT_EQ(
+      "invalid value '0x10000' for 16-bit signed integer specialization "
+      "constant 5",
+      FreezeError(5, "0x10000"));
+  EXPECT_EQ("invalid value '1.0f' for 32-bit float specialization constant 3",
+            FreezeError(3, "1.0f"));
+  EXPECT_EQ("invalid value '' for 16-bit float specialization constant 6",
+            FreezeError(6, ""));
+}
+
+TEST(FreezeSpecConstants, InvalidModules) {
+  std::vector<uint32_t> module = {0x07230203, 0x00010000};
+  std::string errors;
+  EXPECT_FALSE(FreezeSpecConstants({{1, "true"}}, &module, &errors));
+  EXPECT_EQ("not a SPIR-V module", errors);
+
+  module = Module();
+  module.push_back(Op(3, 17));
+  EXPECT_FALSE(FreezeSpecConstants({{1, "true"}}, &module, &errors));
+  EXPECT_THAT(errors, testing::HasSubstr("has an invalid word count"));
+  EXPECT_EQ(Module().size() + 1, module.size());
+}
+
+TEST(GetLiteralType, Booleans) {
+  EXPECT_EQ("bool", GetLiteralType("true"));
+  EXPECT_EQ("bool", GetLiteralType("false"));
+  EXPECT_EQ("", GetLiteralType("True"));
+  EXPECT_EQ("", GetLiteralType("-true"));
+}
+
+TEST(GetLiteralType, Integers) {
+  EXPECT_EQ("int", GetLiteralType("0"));
+  EXPECT_EQ("int", GetLiteralType("16"));
+  EXPECT_EQ("int", GetLiteralType("-16"));
+  EXPECT_EQ("int", GetLiteralType("017"));
+  EXPECT_EQ("int", GetLiteralType("0x1f"));
+  EXPECT_EQ("int", GetLiteralType("0XAB"));
+  EXPECT_EQ("uint", GetLiteralType("16u"));
+  EXPECT_EQ("uint", GetLiteralType("0x10U"));
+  EXPECT_EQ("", GetLiteralType("018"));
+  EXPECT_EQ("", GetLiteralType("0x"));
+  EXPECT_EQ("", GetLiteralType("16uu"));
+  EXPECT_EQ("", GetLiteralType("u"));
+}
+
+TEST(GetLiteralType, Floats) {
+  EXPECT_EQ("float", GetLiteralType("1.5"));
+  EXPECT_EQ("float", GetLiteralType("-1."));
+  EXPECT_EQ("float", GetLiteralType(".5"));
+  EXPECT_EQ("float", GetLiteralType("1e3"));
+  EXPECT_EQ("float", GetLiteralType("1.5E-3f"));
+  EXPECT_EQ("float", GetLiteralType("08.0"));
+  EXPECT_EQ("double", GetLiteralType("2.5lf"));
+  EXPECT_EQ("double", GetLiteralType("1e+3LF"));
+  EXPECT_EQ("", GetLiteralType("1f"));
+  EXPECT_EQ("", GetLiteralType("."));
+  EXPECT_EQ("", GetLiteralType("1e"));
+  EXPECT_EQ("", GetLiteralType("1.5ff"));
+  EXPECT_EQ("", GetLiteralType("lf"));
+}
+
+TEST(GetLiteralType, NotLiterals) {
+  EXPECT_EQ("", GetLiteralType(""));
+  EXPECT_EQ("", GetLiteralType("-"));
+  EXPECT_EQ("", GetLiteralType("TILE_SIZE"));
+  EXPECT_EQ("", GetLiteralType("(8)"));
+  EXPECT_EQ("", GetLiteralType("8 * 2"));
+  EXPECT_EQ("", GetLiteralType(" 8"));
+}
+
+}  // anonymous namespace
@@ -16,9 +16,14 @@
 
 #include <algorithm>
 #include <sstream>
+#include <unordered_set>
 
+#include "libshaderc_util/compile_context.h"
+#include "libshaderc_util/trace.h"
 #include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/linker.hpp"
 #include "spirv-tools/optimizer.hpp"
+#include "spirv/unified1/spirv.hpp"
 
 namespace shaderc_util {
 
@@ -57,122 +62,445 @@ spv_target_env GetSpirvToolsTargetEnv(Compiler::TargetEnv env,
   return SPV_ENV_VULKAN_1_0;
 }
 
+// Returns the name of the span of a pass group in a trace.
+const char* GetPassGroupTraceName(PassId pass) {
+  switch (pass) {
+    case PassId::kLegalizationPasses:
+      return "Optimize: legalization";
+    case PassId::kPerformancePasses:
+      return "Optimize: performance";
+    case PassId::kSizePasses:
+      return "Optimize: size";
+    case PassId::kNullPass:
+      return "Optimize: none";
+    case PassId::kStripDebugInfo:
+      return "Optimize: strip debug info";
+    case PassId::kCompactIds:
+      return "Optimize: compact ids";
+    case PassId::kFoldSpecConstants:
+      return "Optimize: fold spec constants";
+  }
+  return "Optimize";
+}
+
+// Runs the given pass groups, then the passes of the given flags, on binary, in
+// place.  Returns true on success.
+// Otherwise sets errors to the messages of the optimizer.  Uses the optimizer
+// kept by context, if it is not null.
+bool RunOptimizer(Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+                  const std::vector<PassId>& passes,
+                  const std::vector<std::string>& pass_flags,
+                  const spvtools::OptimizerOptions& optimizer_options,
+                  std::vector<uint32_t>* binary, std::string* errors,
+                  CompileContext* context) {
+  std::ostringstream local_messages;
+  std::unique_ptr<spvtools::Optimizer> local_optimizer;
+  std::ostringstream* messages = &local_messages;
+  spvtools::Optimizer* optimizer = nullptr;
+  if (context) {
+    optimizer = context->GetOptimizer(env, version, passes, pass_flags);
+    messages = context->optimizer_messages();
+    messages->str("");
+  } else {
+    local_optimizer = CreateSpirvToolsOptimizer(env, version, passes,
+                                                pass_flags, &local_messages);
+    optimizer = local_optimizer.get();
+  }
+
+  if (!optimizer->Run(binary->data(), binary->size(), binary,
+                      optimizer_options)) {
+    *errors = messages->str();
+    return false;
+  }
+  return true;
+}
+
+// The SPIRV-Tools context that a call uses: the one kept by a compile
+// context, if there is one, or else a new one.
+class ScopedSpirvTools {
+ public:
+  ScopedSpirvTools(Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+                   CompileContext* context) {
+    if (context) {
+      tools_ = context->GetSpirvTools(env, version);
+      messages_ = context->spirv_tools_messages();
+      messages_->str("");
+    } else {
+      local_tools_ = CreateSpirvTools(env, version, &local_messages_);
+      tools_ = local_tools_.get();
+    }
+  }
+
+  spvtools::SpirvTools* operator->() const { return tools_; }
+
+  // Returns the messages of the context since it was taken.
+  std::string messages() const { return messages_->str(); }
+
+ private:
+  std::ostringstream local_messages_;
+  std::unique_ptr<spvtools::SpirvTools> local_tools_;
+  std::ostringstream* messages_ = &local_messages_;
+  spvtools::SpirvTools* tools_ = nullptr;
+};
+
+// Built-in outputs that matter to the fixed-function stages after the last
+// shader stage, whether or not the next shader stage reads them.
+const spv::BuiltIn kFixedFunctionBuiltins[] = {
+    spv::BuiltInPosition,     spv::BuiltInPointSize, spv::BuiltInClipDistance,
+    spv::BuiltInCullDistance, spv::BuiltInLayer,     spv::BuiltInViewportIndex,
+};
+
 }  // anonymous namespace
 
 bool SpirvToolsDisassemble(Compiler::TargetEnv env,
                            Compiler::TargetEnvVersion version,
                            const std::vector<uint32_t>& binary,
-                           std::string* text_or_error) {
-  spvtools::SpirvTools tools(GetSpirvToolsTargetEnv(env, version));
-  std::ostringstream oss;
-  tools.SetMessageConsumer([&oss](spv_message_level_t, const char*,
-                                  const spv_position_t& position,
-                                  const char* message) {
-    oss << position.index << ": " << message;
-  });
-  const bool success =
-      tools.Disassemble(binary, text_or_error,
-                        SPV_BINARY_TO_TEXT_OPTION_INDENT |
-                            SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES);
+                           std::string* text_or_error,
+                           CompileContext* context) {
+  std::string errors;
+  const bool success = SpirvToolsDisassemble(
+      env, version, binary.data(), binary.size(), /* friendly_names = */ true,
+      [text_or_error](string_piece text) {
+        text_or_error->assign(text.begin(), text.end());
+        return true;
+      },
+      &errors, context);
   if (!success) {
-    *text_or_error = oss.str();
+    *text_or_error = std::move(errors);
   }
   return success;
 }
 
-bool SpirvToolsAssemble(Compiler::TargetEnv env,
-                        Compiler::TargetEnvVersion version,
-                        const string_piece assembly, spv_binary* binary,
-                        std::string* errors) {
-  auto spvtools_context =
-      spvContextCreate(GetSpirvToolsTargetEnv(env, version));
+bool SpirvToolsDisassemble(Compiler::TargetEnv env,
+                           Compiler::TargetEnvVersion version,
+                           const uint32_t* binary, size_t binary_word_count,
+                           bool friendly_names,
+                           const std::function<bool(string_piece)>& write,
+                           std::string* errors, CompileContext* context) {
+  std::unique_ptr<spvtools::Context> local_context;
+  spvtools::Context* spvtools_context = nullptr;
+  if (context) {
+    spvtools_context = context->GetSpvContext(env, version);
+  } else {
+    local_context = CreateSpvContext(env, version);
+    spvtools_context = local_context.get();
+  }
+  uint32_t options = SPV_BINARY_TO_TEXT_OPTION_INDENT;
+  if (friendly_names) options |= SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES;
+  spv_text text = nullptr;
   spv_diagnostic spvtools_diagnostic = nullptr;
 
-  *binary = nullptr;
   errors->clear();
-
-  const bool success =
-      spvTextToBinary(spvtools_context, assembly.data(), assembly.size(),
-                      binary, &spvtools_diagnostic) == SPV_SUCCESS;
-  if (!success) {
+  bool success =
+      spvBinaryToText(spvtools_context->CContext(), binary, binary_word_count,
+                      options, &text, &spvtools_diagnostic) == SPV_SUCCESS;
+  if (success) {
+    success = write({text->str, text->str + text->length});
+  } else {
     std::ostringstream oss;
-    oss << spvtools_diagnostic->position.line + 1 << ":"
-        << spvtools_diagnostic->position.column + 1 << ": "
+    oss << spvtools_diagnostic->position.index << ": "
         << spvtools_diagnostic->error;
     *errors = oss.str();
   }
 
+  spvTextDestroy(text);
   spvDiagnosticDestroy(spvtools_diagnostic);
-  spvContextDestroy(spvtools_context);
 
   return success;
 }
 
-bool SpirvToolsOptimize(Compiler::TargetEnv env,
-                        Compiler::TargetEnvVersion version,
-                        const std::vector<PassId>& enabled_passes,
-                        spvtools::OptimizerOptions& optimizer_options,
-                        std::vector<uint32_t>* binary, std::string* errors) {
-  errors->clear();
-  if (enabled_passes.empty()) return true;
-  if (std::all_of(
-          enabled_passes.cbegin(), enabled_passes.cend(),
-          [](const PassId& pass) { return pass == PassId::kNullPass; })) {
-    return true;
-  }
-
-  spvtools::ValidatorOptions val_opts;
+spvtools::ValidatorOptions GetSpirvToolsValidatorOptions(
+    bool skip_block_layout, bool before_hlsl_legalization) {
+  spvtools::ValidatorOptions options;
+  options.SetRelaxBlockLayout(true);
+  options.SetUniformBufferStandardLayout(true);
+  options.SetScalarBlockLayout(true);
+  options.SetWorkgroupScalarBlockLayout(true);
   // This allows flexible memory layout for HLSL.
-  val_opts.SetSkipBlockLayout(true);
+  options.SetSkipBlockLayout(skip_block_layout);
   // This allows HLSL legalization regarding resources.
-  val_opts.SetRelaxLogicalPointer(true);
+  options.SetRelaxLogicalPointer(before_hlsl_legalization);
   // This uses relaxed rules for pre-legalized HLSL.
-  val_opts.SetBeforeHlslLegalization(true);
+  options.SetBeforeHlslLegalization(before_hlsl_legalization);
   // Don't use friendly names when printing validation errors.
   // It incurs a high startup cost whether or not there is an
   // error. Validation failures are compiler bugs, and so they
   // should be rare anyway.
-  val_opts.SetFriendlyNames(false);
+  options.SetFriendlyNames(false);
+  return options;
+}
 
-  // Set additional optimizer options.
-  optimizer_options.set_validator_options(val_opts);
-  optimizer_options.set_run_validator(true);
+bool SpirvToolsValidate(Compiler::TargetEnv env,
+                        Compiler::TargetEnvVersion version,
+                        const std::vector<uint32_t>& binary,
+                        const spvtools::ValidatorOptions& options,
+                        std::string* errors, CompileContext* context) {
+  ScopedSpirvTools tools(env, version, context);
+  const bool success = tools->Validate(binary.data(), binary.size(), options);
+  if (!success) {
+    *errors = tools.messages();
+  }
+  return success;
+}
 
-  spvtools::Optimizer optimizer(GetSpirvToolsTargetEnv(env, version));
+bool SpirvToolsAssemble(Compiler::TargetEnv env,
+                        Compiler::TargetEnvVersion version,
+                        const string_piece assembly, spv_binary* binary,
+                        std::string* errors, CompileContext* context) {
+  std::unique_ptr<spvtools::Context> local_context;
+  spvtools::Context* spvtools_context = nullptr;
+  if (context) {
+    spvtools_context = context->GetSpvContext(env, version);
+  } else {
+    local_context = CreateSpvContext(env, version);
+    spvtools_context = local_context.get();
+  }
+  spv_diagnostic spvtools_diagnostic = nullptr;
+
+  *binary = nullptr;
+  errors->clear();
+
+  const bool success =
+      spvTextToBinary(spvtools_context->CContext(), assembly.data(),
+                      assembly.size(), binary,
+                      &spvtools_diagnostic) == SPV_SUCCESS;
+  if (!success) {
+    std::ostringstream oss;
+    oss << spvtools_diagnostic->position.line + 1 << ":"
+        << spvtools_diagnostic->position.column + 1 << ": "
+        << spvtools_diagnostic->error;
+    *errors = oss.str();
+  }
+
+  spvDiagnosticDestroy(spvtools_diagnostic);
 
-  std::ostringstream oss;
+  return success;
+}
+
+bool ParseSpirvToolsPassFlags(const std::vector<std::string>& passes,
+                              std::vector<std::string>* flags,
+                              std::string* errors) {
+  std::vector<std::string> parsed;
+  // The optimizer that the flags are tried on.  Registering a pass does not
+  // depend on the target environment.
+  spvtools::Optimizer optimizer(SPV_ENV_UNIVERSAL_1_0);
   optimizer.SetMessageConsumer(
-      [&oss](spv_message_level_t, const char*, const spv_position_t&,
-             const char* message) { oss << message << "\n"; });
+      [](spv_message_level_t, const char*, const spv_position_t&,
+         const char*) {});
+  for (const auto& pass : passes) {
+    std::string flag = pass;
+    if (!flag.empty() && flag[0] != '-') flag = "--" + flag;
+    if (flag.empty() || !spvtools::Optimizer::FlagHasValidForm(flag) ||
+        !optimizer.RegisterPassesFromFlags({flag})) {
+      *errors = "unknown optimization pass: '" + pass + "'";
+      return false;
+    }
+    parsed.push_back(std::move(flag));
+  }
+  *flags = std::move(parsed);
+  return true;
+}
 
-  for (const auto& pass : enabled_passes) {
+std::unique_ptr<spvtools::Optimizer> CreateSpirvToolsOptimizer(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+    const std::vector<PassId>& passes,
+    const std::vector<std::string>& pass_flags, std::ostream* messages) {
+  std::unique_ptr<spvtools::Optimizer> optimizer(
+      new spvtools::Optimizer(GetSpirvToolsTargetEnv(env, version)));
+  optimizer->SetMessageConsumer(
+      [messages](spv_message_level_t, const char*, const spv_position_t&,
+                 const char* message) { *messages << message << "\n"; });
+
+  for (const auto& pass : passes) {
     switch (pass) {
       case PassId::kLegalizationPasses:
-        optimizer.RegisterLegalizationPasses();
+        optimizer->RegisterLegalizationPasses();
         break;
       case PassId::kPerformancePasses:
-        optimizer.RegisterPerformancePasses();
+        optimizer->RegisterPerformancePasses();
         break;
       case PassId::kSizePasses:
-        optimizer.RegisterSizePasses();
+        optimizer->RegisterSizePasses();
         break;
       case PassId::kNullPass:
         // We actually don't need to do anything for null pass.
         break;
       case PassId::kStripDebugInfo:
-        optimizer.RegisterPass(spvtools::CreateStripDebugInfoPass());
+        optimizer->RegisterPass(spvtools::CreateStripDebugInfoPass());
         break;
       case PassId::kCompactIds:
-        optimizer.RegisterPass(spvtools::CreateCompactIdsPass());
+        optimizer->RegisterPass(spvtools::CreateCompactIdsPass());
+        break;
+      case PassId::kFoldSpecConstants:
+        optimizer->RegisterPass(
+            spvtools::CreateFoldSpecConstantOpAndCompositePass());
         break;
     }
   }
+  if (!pass_flags.empty()) {
+    // The flags were checked by ParseSpirvToolsPassFlags(), so they register.
+    optimizer->RegisterPassesFromFlags(pass_flags);
+  }
+  return optimizer;
+}
+
+bool SpirvToolsOptimize(Compiler::TargetEnv env,
+                        Compiler::TargetEnvVersion version,
+                        const std::vector<PassId>& enabled_passes,
+                        const std::vector<std::string>& pass_flags,
+                        spvtools::OptimizerOptions& optimizer_options,
+                        bool validate_input, std::vector<uint32_t>* binary,
+                        std::string* errors, CompileContext* context) {
+  errors->clear();
+  if (pass_flags.empty() &&
+      std::all_of(
+          enabled_passes.cbegin(), enabled_passes.cend(),
+          [](const PassId& pass) { return pass == PassId::kNullPass; })) {
+    return true;
+  }
 
-  if (!optimizer.Run(binary->data(), binary->size(), binary,
-                     optimizer_options)) {
-    *errors = oss.str();
+  // The optimizer may be given HLSL before legalization.
+  optimizer_options.set_validator_options(GetSpirvToolsValidatorOptions(
+      /* skip_block_layout = */ true, /* before_hlsl_legalization = */ true));
+  optimizer_options.set_run_validator(validate_input);
+
+  if (!TraceEnabled()) {
+    return RunOptimizer(env, version, enabled_passes, pass_flags,
+                        optimizer_options, binary, errors, context);
+  }
+
+  // When tracing, each pass group runs on its own, so that it gets a span of
+  // its own.  Only the first run validates its input, since the others start
+  // from the output of the optimizer.
+  for (const auto& pass : enabled_passes) {
+    if (pass == PassId::kNullPass) continue;
+    TraceScope trace_scope(GetPassGroupTraceName(pass));
+    if (!RunOptimizer(env, version, {pass}, {}, optimizer_options, binary,
+                      errors, context)) {
+      return false;
+    }
+    optimizer_options.set_run_validator(false);
+  }
+  if (!pass_flags.empty()) {
+    TraceScope trace_scope("Optimize: custom passes");
+    return RunOptimizer(env, version, {}, pass_flags, optimizer_options,
+                        binary, errors, context);
+  }
+  return true;
+}
+
+std::unique_ptr<spvtools::SpirvTools> CreateSpirvTools(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+    std::ostream* messages) {
+  std::unique_ptr<spvtools::SpirvTools> tools(
+      new spvtools::SpirvTools(GetSpirvToolsTargetEnv(env, version)));
+  tools->SetMessageConsumer([messages](spv_message_level_t, const char*,
+                                       const spv_position_t& position,
+                                       const char* message) {
+    *messages << position.index << ": " << message;
+  });
+  return tools;
+}
+
+std::unique_ptr<spvtools::Context> CreateSpvContext(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version) {
+  return std::unique_ptr<spvtools::Context>(
+      new spvtools::Context(GetSpirvToolsTargetEnv(env, version)));
+}
+
+bool SpirvToolsLink(Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+                    const std::vector<const std::vector<uint32_t>*>& libraries,
+                    std::vector<uint32_t>* binary, std::string* errors) {
+  errors->clear();
+  std::ostringstream messages;
+  const spvtools::MessageConsumer consumer =
+      [&messages](spv_message_level_t, const char*, const spv_position_t&,
+                  const char* message) { messages << message << "\n"; };
+  std::vector<const uint32_t*> modules = {binary->data()};
+  std::vector<size_t> module_sizes = {binary->size()};
+  for (const auto* library : libraries) {
+    modules.push_back(library->data());
+    module_sizes.push_back(library->size());
+  }
+  spvtools::Context context(GetSpirvToolsTargetEnv(env, version));
+  context.SetMessageConsumer(consumer);
+  std::vector<uint32_t> linked;
+  if (spvtools::Link(context, modules.data(), module_sizes.data(),
+                     modules.size(), &linked) != SPV_SUCCESS) {
+    *errors = messages.str();
+    return false;
+  }
+
+  spvtools::Optimizer optimizer(GetSpirvToolsTargetEnv(env, version));
+  optimizer.SetMessageConsumer(consumer);
+  optimizer.RegisterPass(spvtools::CreateEliminateDeadFunctionsPass());
+  if (!optimizer.Run(linked.data(), linked.size(), &linked)) {
+    *errors = messages.str();
     return false;
   }
+  binary->swap(linked);
+  return true;
+}
+
+bool HasLinkageCapability(const std::vector<uint32_t>& binary) {
+  // The capabilities are the first instructions after the header.
+  const size_t header_words = 5;
+  for (size_t i = header_words; i < binary.size();) {
+    const uint32_t word_count = binary[i] >> spv::WordCountShift;
+    if ((binary[i] & spv::OpCodeMask) != spv::OpCapability || word_count < 2 ||
+        i + word_count > binary.size()) {
+      break;
+    }
+    if (binary[i + 1] == spv::CapabilityLinkage) return true;
+    i += word_count;
+  }
+  return false;
+}
+
+bool SpirvToolsPruneInterStageVaryings(
+    Compiler::TargetEnv env, Compiler::TargetEnvVersion version,
+    const std::vector<std::vector<uint32_t>*>& modules, std::string* errors) {
+  errors->clear();
+  // The locations and built-ins read by the stage after the current one.
+  std::unordered_set<uint32_t> live_locs;
+  std::unordered_set<uint32_t> live_builtins;
+  for (size_t i = modules.size(); i-- > 0;) {
+    std::ostringstream messages;
+    spvtools::Optimizer optimizer(GetSpirvToolsTargetEnv(env, version));
+    optimizer.SetMessageConsumer(
+        [&messages](spv_message_level_t, const char*, const spv_position_t&,
+                    const char* message) { messages << message << "\n"; });
+    const bool has_next_stage = i + 1 < modules.size();
+    if (has_next_stage) {
+      for (const auto builtin : kFixedFunctionBuiltins) {
+        live_builtins.insert(builtin);
+      }
+      optimizer.RegisterPass(spvtools::CreateEliminateDeadOutputStoresPass(
+          &live_locs, &live_builtins));
+      optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass(
+          /* preserve_interface = */ false, /* remove_outputs = */ true));
+    }
+    std::unordered_set<uint32_t> input_locs;
+    std::unordered_set<uint32_t> input_builtins;
+    if (i > 0) {
+      // An input that is declared but not read leaves the interface, so that
+      // it needs no output of the stage before, which is removed with the
+      // other outputs that are not live.
+      optimizer.RegisterPass(
+          spvtools::CreateRemoveUnusedInterfaceVariablesPass());
+      optimizer.RegisterPass(
+          spvtools::CreateAnalyzeLiveInputPass(&input_locs, &input_builtins));
+    }
+    if (has_next_stage || i > 0) {
+      std::vector<uint32_t>* binary = modules[i];
+      if (!optimizer.Run(binary->data(), binary->size(), binary)) {
+        *errors = messages.str();
+        return false;
+      }
+    }
+    live_locs.swap(input_locs);
+    live_builtins.swap(input_builtins);
+  }
   return true;
 }
 
@@ -0,0 +1,162 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "libshaderc_util/json.h"
+
+namespace {
+
+struct TraceEvent {
+  const char* name;
+  std::string detail;
+  size_t lane;
+  // Start and duration, in nanoseconds.
+  int64_t start;
+  int64_t duration;
+};
+
+// The state of the process-wide recorder.
+struct Recorder {
+  std::atomic<bool> enabled{false};
+  std::mutex mutex;
+  std::chrono::steady_clock::time_point epoch;
+  bool epoch_set = false;
+  std::vector<TraceEvent> events;
+  // The lane of each thread that has recorded spans or been named.
+  std::map<std::thread::id, size_t> lanes;
+  std::map<size_t, std::string> lane_names;
+};
+
+Recorder& GetRecorder() {
+  static Recorder* recorder = new Recorder;
+  return *recorder;
+}
+
+// Returns the lane of the calling thread.  The recorder mutex must be held.
+size_t LaneOfCurrentThread(Recorder* recorder) {
+  const auto inserted = recorder->lanes.emplace(std::this_thread::get_id(),
+                                                recorder->lanes.size());
+  return inserted.first->second;
+}
+
+int64_t Now() {
+  Recorder& recorder = GetRecorder();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - recorder.epoch)
+      .count();
+}
+
+// Writes a time in nanoseconds as microseconds, the unit of the format.
+void WriteMicroseconds(std::ostream* out, int64_t nanoseconds) {
+  *out << nanoseconds / 1000 << "." << std::setw(3) << std::setfill('0')
+       << nanoseconds % 1000 << std::setfill(' ');
+}
+
+}  // anonymous namespace
+
+namespace shaderc_util {
+
+void EnableTrace() {
+  Recorder& recorder = GetRecorder();
+  std::lock_guard<std::mutex> lock(recorder.mutex);
+  if (!recorder.epoch_set) {
+    recorder.epoch = std::chrono::steady_clock::now();
+    recorder.epoch_set = true;
+  }
+  recorder.enabled = true;
+}
+
+bool TraceEnabled() {
+  return GetRecorder().enabled.load(std::memory_order_acquire);
+}
+
+void ResetTrace() {
+  Recorder& recorder = GetRecorder();
+  std::lock_guard<std::mutex> lock(recorder.mutex);
+  recorder.enabled = false;
+  recorder.epoch_set = false;
+  recorder.events.clear();
+  recorder.lanes.clear();
+  recorder.lane_names.clear();
+}
+
+void SetTraceThreadName(const std::string& name) {
+  if (!TraceEnabled()) return;
+  Recorder& recorder = GetRecorder();
+  std::lock_guard<std::mutex> lock(recorder.mutex);
+  recorder.lane_names[LaneOfCurrentThread(&recorder)] = name;
+}
+
+void WriteTrace(std::ostream* out) {
+  Recorder& recorder = GetRecorder();
+  std::lock_guard<std::mutex> lock(recorder.mutex);
+  *out << "{\"traceEvents\": [";
+  const char* separator = "\n";
+  for (const auto& lane_name : recorder.lane_names) {
+    *out << separator << "{\"name\": \"thread_name\", \"ph\": \"M\", "
+         << "\"pid\": 1, \"tid\": " << lane_name.first
+         << ", \"args\": {\"name\": ";
+    WriteJsonString(out, lane_name.second);
+    *out << "}}";
+    separator = ",\n";
+  }
+  for (const auto& event : recorder.events) {
+    *out << separator << "{\"name\": ";
+    WriteJsonString(out, event.name);
+    *out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.lane
+         << ", \"ts\": ";
+    WriteMicroseconds(out, event.start);
+    *out << ", \"dur\": ";
+    WriteMicroseconds(out, event.duration);
+    if (!event.detail.empty()) {
+      *out << ", \"args\": {\"detail\": ";
+      WriteJsonString(out, event.detail);
+      *out << "}";
+    }
+    *out << "}";
+    separator = ",\n";
+  }
+  *out << "\n], \"displayTimeUnit\": \"ms\"}\n";
+}
+
+TraceScope::TraceScope(const char* name, const string_piece& detail)
+    : name_(nullptr), start_(0) {
+  if (!TraceEnabled()) return;
+  name_ = name;
+  detail_ = detail.str();
+  start_ = Now();
+}
+
+TraceScope::~TraceScope() {
+  if (!name_) return;
+  const int64_t end = Now();
+  Recorder& recorder = GetRecorder();
+  std::lock_guard<std::mutex> lock(recorder.mutex);
+  // Spans that end after a reset belong to no trace.
+  if (!recorder.enabled) return;
+  recorder.events.push_back({name_, std::move(detail_),
+                             LaneOfCurrentThread(&recorder), start_,
+                             end - start_});
+}
+
+}  // namespace shaderc_util
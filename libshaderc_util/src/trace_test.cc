@@ -0,0 +1,115 @@
+// Copyright 2026 The Shaderc Authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libshaderc_util/trace.h"
+
+#include <gmock/gmock.h>
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "libshaderc_util/json.h"
+
+namespace {
+
+using shaderc_util::EnableTrace;
+using shaderc_util::JsonValue;
+using shaderc_util::ParseJson;
+using shaderc_util::ResetTrace;
+using shaderc_util::SetTraceThreadName;
+using shaderc_util::TraceEnabled;
+using shaderc_util::TraceScope;
+using shaderc_util::WriteTrace;
+
+class TraceTest : public testing::Test {
+ protected:
+  void SetUp() override { ResetTrace(); }
+  void TearDown() override { ResetTrace(); }
+
+  // Writes the trace and parses it into trace_, returning its events.
+  const std::vector<JsonValue>& ParseTrace() {
+    std::ostringstream out;
+    WriteTrace(&out);
+    std::string error;
+    EXPECT_TRUE(ParseJson(out.str(), &trace_, &error)) << error;
+    static const std::vector<JsonValue> kNoEvents;
+    const JsonValue* events = trace_.Find("traceEvents");
+    return events && events->is_array() ? events->elements() : kNoEvents;
+  }
+
+  // Returns the string member of a trace event, or "" if it has none.
+  static std::string Member(const JsonValue& event, const char* name) {
+    const JsonValue* value = event.Find(name);
+    return value && value->is_string() ? value->string_value() : "";
+  }
+
+  JsonValue trace_;
+};
+
+TEST_F(TraceTest, NothingIsRecordedWhenDisabled) {
+  EXPECT_FALSE(TraceEnabled());
+  { TraceScope scope("Parse", "a.vert"); }
+  SetTraceThreadName("main");
+  EXPECT_TRUE(ParseTrace().empty());
+}
+
+TEST_F(TraceTest, RecordsCompleteEventsWithDetail) {
+  EnableTrace();
+  EXPECT_TRUE(TraceEnabled());
+  {
+    TraceScope outer("Compile", "a.vert");
+    TraceScope inner("Parse");
+  }
+  const auto& events = ParseTrace();
+  ASSERT_EQ(2u, events.size());
+  // Spans are recorded as they end, so the inner one comes first.
+  EXPECT_EQ("Parse", Member(events[0], "name"));
+  EXPECT_EQ(nullptr, events[0].Find("args"));
+  EXPECT_EQ("Compile", Member(events[1], "name"));
+  EXPECT_EQ("X", Member(events[1], "ph"));
+  ASSERT_NE(nullptr, events[1].Find("args"));
+  EXPECT_EQ("a.vert", Member(*events[1].Find("args"), "detail"));
+  const double outer_start = events[1].Find("ts")->number_value();
+  const double outer_end = outer_start + events[1].Find("dur")->number_value();
+  const double inner_start = events[0].Find("ts")->number_value();
+  EXPECT_LE(outer_start, inner_start);
+  EXPECT_LE(inner_start + events[0].Find("dur")->number_value(), outer_end);
+}
+
+TEST_F(TraceTest, EachThreadHasItsOwnLane) {
+  EnableTrace();
+  SetTraceThreadName("main");
+  { TraceScope scope("Main"); }
+  std::thread worker([] {
+    SetTraceThreadName("worker \"1\"");
+    TraceScope scope("Worker");
+  });
+  worker.join();
+
+  std::set<double> span_lanes;
+  std::set<std::string> lane_names;
+  for (const auto& event : ParseTrace()) {
+    if (Member(event, "ph") == "M") {
+      lane_names.insert(Member(*event.Find("args"), "name"));
+    } else {
+      span_lanes.insert(event.Find("tid")->number_value());
+    }
+  }
+  EXPECT_EQ(2u, span_lanes.size());
+  EXPECT_THAT(lane_names, testing::ElementsAre("main", "worker \"1\""));
+}
+
+}  // anonymous namespace